@@ -30,6 +30,8 @@ list (APPEND MAIN_SOURCE_FILES
       src/opm/common/OpmLog/OpmLog.cpp
       src/opm/common/OpmLog/StreamLog.cpp
       src/opm/common/OpmLog/TimerLog.cpp
+      src/opm/common/utility/Executor.cpp
+      src/opm/common/utility/LargeArray.cpp
       src/opm/common/utility/numeric/MonotCubicInterpolator.cpp
       src/opm/common/utility/parameters/Parameter.cpp
       src/opm/common/utility/parameters/ParameterGroup.cpp
@@ -39,11 +41,13 @@ list (APPEND MAIN_SOURCE_FILES
 if(ENABLE_ECL_INPUT)
   list(APPEND MAIN_SOURCE_FILES
     src/opm/json/JsonObject.cpp
+    src/opm/parser/eclipse/CApi.cpp
     src/opm/parser/eclipse/Deck/Deck.cpp
     src/opm/parser/eclipse/Deck/DeckItem.cpp
     src/opm/parser/eclipse/Deck/DeckKeyword.cpp
     src/opm/parser/eclipse/Deck/DeckRecord.cpp
     src/opm/parser/eclipse/Deck/DeckOutput.cpp
+    src/opm/parser/eclipse/Deck/IncludeGraph.cpp
     src/opm/parser/eclipse/Deck/Section.cpp
     src/opm/parser/eclipse/EclipseState/AquiferCT.cpp
     src/opm/parser/eclipse/EclipseState/Aquancon.cpp
@@ -62,6 +66,8 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/Grid/GridDims.cpp
     src/opm/parser/eclipse/EclipseState/Grid/GridProperties.cpp
     src/opm/parser/eclipse/EclipseState/Grid/GridProperty.cpp
+    src/opm/parser/eclipse/EclipseState/Grid/GridPropertyStorage.cpp
+    src/opm/parser/eclipse/EclipseState/Grid/LocalGrid.cpp
     src/opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.cpp
     src/opm/parser/eclipse/EclipseState/Grid/NNC.cpp
     src/opm/parser/eclipse/EclipseState/Grid/PinchMode.cpp
@@ -73,6 +79,9 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/IOConfig/IOConfig.cpp
     src/opm/parser/eclipse/EclipseState/IOConfig/RestartConfig.cpp
     src/opm/parser/eclipse/EclipseState/Runspec.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/ActionProgram.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/Actions.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/ActionX.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/Completion.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/CompletionSet.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/Events.cpp
@@ -86,6 +95,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/Schedule/OilVaporizationProperties.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/Schedule.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/SummaryState.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/TimeMap.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/Tuning.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/Well.cpp
@@ -94,6 +104,9 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/Schedule/WellPolymerProperties.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/WellProductionProperties.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/WellTestConfig.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/WellTracerProperties.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/WList.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/WListManager.cpp
     src/opm/parser/eclipse/EclipseState/SimulationConfig/SimulationConfig.cpp
     src/opm/parser/eclipse/EclipseState/SimulationConfig/ThresholdPressure.cpp
     src/opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.cpp
@@ -107,6 +120,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/Tables/TableManager.cpp
     src/opm/parser/eclipse/EclipseState/Tables/TableSchema.cpp
     src/opm/parser/eclipse/EclipseState/Tables/Tables.cpp
+    src/opm/parser/eclipse/EclipseState/TracerConfig.cpp
     src/opm/parser/eclipse/EclipseState/UDQConfig.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/UDQ.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/UDQExpression.cpp
@@ -124,6 +138,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/Units/Dimension.cpp
     src/opm/parser/eclipse/Units/UnitSystem.cpp
     src/opm/parser/eclipse/Utility/Functional.cpp
+    src/opm/parser/eclipse/Utility/Hash.cpp
     src/opm/parser/eclipse/Utility/Stringview.cpp
   )
 
@@ -143,6 +158,7 @@ if(ENABLE_ECL_OUTPUT)
           src/opm/output/eclipse/WellDataSerializers.cpp
           src/opm/output/eclipse/DoubHEAD.cpp
           src/opm/output/eclipse/EclipseGridInspector.cpp
+          src/opm/output/eclipse/EclBinaryIO.cpp
           src/opm/output/eclipse/EclipseIO.cpp
           src/opm/output/eclipse/InteHEAD.cpp
           src/opm/output/eclipse/LinearisedOutputTable.cpp
@@ -160,6 +176,8 @@ list (APPEND TEST_SOURCE_FILES
       tests/test_calculateCellVol.cpp
       tests/test_cmp.cpp
       tests/test_cubic.cpp
+      tests/test_Executor.cpp
+      tests/test_LargeArray.cpp
       tests/test_messagelimiter.cpp
       tests/test_nonuniformtablelinear.cpp
       tests/test_OpmLog.cpp
@@ -170,11 +188,13 @@ list (APPEND TEST_SOURCE_FILES
 )
 if(ENABLE_ECL_INPUT)
   list(APPEND TEST_SOURCE_FILES
+    tests/parser/ActionTests.cpp
     tests/parser/ADDREGTests.cpp
     tests/parser/AquiferCTTests.cpp
     tests/parser/AqudimsTests.cpp
     tests/parser/AquanconTests.cpp
     tests/parser/BoxTests.cpp
+    tests/parser/CApiTests.cpp
     tests/parser/ColumnSchemaTests.cpp
     tests/parser/CompletionTests.cpp
     tests/parser/COMPSEGUnits.cpp
@@ -219,6 +239,7 @@ if(ENABLE_ECL_INPUT)
     tests/parser/TableSchemaTests.cpp
     tests/parser/ThresholdPressureTest.cpp
     tests/parser/TimeMapTest.cpp
+    tests/parser/TracerTests.cpp
     tests/parser/TransMultTests.cpp
     tests/parser/TuningTests.cpp
     tests/parser/UDQTests.cpp
@@ -226,12 +247,14 @@ if(ENABLE_ECL_INPUT)
     tests/parser/ValueTests.cpp
     tests/parser/WellSolventTests.cpp
     tests/parser/WellTests.cpp
+    tests/parser/WLIST.cpp
     tests/parser/WTEST.cpp)
 endif()
 if(ENABLE_ECL_OUTPUT)
   list (APPEND TEST_SOURCE_FILES
           tests/test_compareSummary.cpp
           tests/test_EclFilesComparator.cpp
+          tests/test_EclBinaryIO.cpp
           tests/test_EclipseIO.cpp
           tests/test_DoubHEAD.cpp
           tests/test_InteHEAD.cpp
@@ -246,6 +269,7 @@ if(ENABLE_ECL_OUTPUT)
           tests/test_Wells.cpp
           tests/test_writenumwells.cpp
           tests/test_serialize_ICON.cpp
+          tests/test_serialize_ISEG.cpp
           tests/test_serialize_SCON.cpp
       )
 endif()
@@ -257,6 +281,7 @@ if(ENABLE_ECL_OUTPUT)
   list (APPEND TEST_DATA_FILES
           tests/FIRST_SIM.DATA
           tests/FIRST_SIM_THPRES.DATA
+          tests/FIRST_SIM_TRACER.DATA
           tests/summary_deck.DATA
           tests/group_group.DATA
           tests/testblackoilstate3.DATA
@@ -264,6 +289,8 @@ if(ENABLE_ECL_OUTPUT)
           tests/table_deck.DATA
           tests/summary_deck_non_constant_porosity.DATA
           tests/SUMMARY_EFF_FAC.DATA
+          tests/summary_deck_msw.DATA
+          tests/summary_deck_tracer.DATA
       )
 endif()
 
@@ -311,6 +338,8 @@ list( APPEND PUBLIC_HEADER_FILES
       opm/common/OpmLog/OpmLog.hpp
       opm/common/OpmLog/StreamLog.hpp
       opm/common/OpmLog/TimerLog.hpp
+      opm/common/utility/Executor.hpp
+      opm/common/utility/LargeArray.hpp
       opm/common/utility/numeric/cmp.hpp
       opm/common/utility/platform_dependent/disable_warnings.h
       opm/common/utility/platform_dependent/reenable_warnings.h
@@ -334,8 +363,10 @@ list( APPEND PUBLIC_HEADER_FILES
 if(ENABLE_ECL_INPUT)
   list(APPEND PUBLIC_HEADER_FILES
        opm/json/JsonObject.hpp
+       opm/parser/eclipse/CApi.h
        opm/parser/eclipse/Utility/Stringview.hpp
        opm/parser/eclipse/Utility/Functional.hpp
+       opm/parser/eclipse/Utility/Hash.hpp
        opm/parser/eclipse/Utility/Typetools.hpp
        opm/parser/eclipse/Utility/String.hpp
        opm/parser/eclipse/Generator/KeywordGenerator.hpp
@@ -366,9 +397,11 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Grid/Fault.hpp
        opm/parser/eclipse/EclipseState/Grid/Box.hpp
        opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp
+       opm/parser/eclipse/EclipseState/Grid/GridPropertyStorage.hpp
        opm/parser/eclipse/EclipseState/Grid/FaultFace.hpp
        opm/parser/eclipse/EclipseState/Grid/NNC.hpp
        opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp
+       opm/parser/eclipse/EclipseState/Grid/LocalGrid.hpp
        opm/parser/eclipse/EclipseState/Grid/BoxManager.hpp
        opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp
        opm/parser/eclipse/EclipseState/Grid/MinpvMode.hpp
@@ -458,6 +491,9 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Schedule/MSW/updatingCompletionsWithSegments.hpp
        opm/parser/eclipse/EclipseState/Schedule/WellProductionProperties.hpp
        opm/parser/eclipse/EclipseState/Schedule/WellTestConfig.hpp
+       opm/parser/eclipse/EclipseState/Schedule/WellTracerProperties.hpp
+       opm/parser/eclipse/EclipseState/Schedule/WList.hpp
+       opm/parser/eclipse/EclipseState/Schedule/WListManager.hpp
        opm/parser/eclipse/EclipseState/Schedule/CompletionSet.hpp
        opm/parser/eclipse/EclipseState/SimulationConfig/ThresholdPressure.hpp
        opm/parser/eclipse/EclipseState/SimulationConfig/SimulationConfig.hpp
@@ -465,15 +501,21 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/IOConfig/IOConfig.hpp
        opm/parser/eclipse/EclipseState/checkDeck.hpp
        opm/parser/eclipse/EclipseState/Runspec.hpp
+       opm/parser/eclipse/EclipseState/TracerConfig.hpp
        opm/parser/eclipse/EclipseState/Schedule/UDQ.hpp
        opm/parser/eclipse/EclipseState/UDQConfig.hpp
        opm/parser/eclipse/EclipseState/Schedule/UDQExpression.hpp
+       opm/parser/eclipse/EclipseState/Schedule/ActionProgram.hpp
+       opm/parser/eclipse/EclipseState/Schedule/Actions.hpp
+       opm/parser/eclipse/EclipseState/Schedule/ActionX.hpp
+       opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp
        opm/parser/eclipse/Deck/DeckItem.hpp
        opm/parser/eclipse/Deck/Deck.hpp
        opm/parser/eclipse/Deck/Section.hpp
        opm/parser/eclipse/Deck/DeckOutput.hpp
        opm/parser/eclipse/Deck/DeckKeyword.hpp
        opm/parser/eclipse/Deck/DeckRecord.hpp
+       opm/parser/eclipse/Deck/IncludeGraph.hpp
        opm/parser/eclipse/RawDeck/StarToken.hpp
        opm/parser/eclipse/RawDeck/RawEnums.hpp
        opm/parser/eclipse/RawDeck/RawRecord.hpp
@@ -487,6 +529,7 @@ if(ENABLE_ECL_OUTPUT)
         opm/output/data/Wells.hpp
         opm/output/eclipse/DoubHEAD.hpp
         opm/output/eclipse/EclipseGridInspector.hpp
+        opm/output/eclipse/EclBinaryIO.hpp
         opm/output/eclipse/EclipseIO.hpp
         opm/output/eclipse/EclipseIOUtil.hpp
         opm/output/eclipse/InteHEAD.hpp
@@ -5,6 +5,7 @@ set(genkw_SOURCES src/opm/json/JsonObject.cpp
                   src/opm/parser/eclipse/Deck/DeckKeyword.cpp
                   src/opm/parser/eclipse/Deck/DeckRecord.cpp
                   src/opm/parser/eclipse/Deck/DeckOutput.cpp
+                  src/opm/parser/eclipse/Deck/IncludeGraph.cpp
                   src/opm/parser/eclipse/Generator/KeywordGenerator.cpp
                   src/opm/parser/eclipse/Generator/KeywordLoader.cpp
                   src/opm/parser/eclipse/Parser/ParseContext.cpp
@@ -17,6 +18,7 @@ set(genkw_SOURCES src/opm/json/JsonObject.cpp
                   src/opm/parser/eclipse/RawDeck/StarToken.cpp
                   src/opm/parser/eclipse/Units/Dimension.cpp
                   src/opm/parser/eclipse/Units/UnitSystem.cpp
+                  src/opm/parser/eclipse/Utility/Hash.cpp
                   src/opm/parser/eclipse/Utility/Stringview.cpp
                   src/opm/common/OpmLog/OpmLog.cpp
                   src/opm/common/OpmLog/Logger.cpp
@@ -0,0 +1,155 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OPM_EXECUTOR_HPP
+#define OPM_EXECUTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      The Executor is the one place where opm-common runs work
+      concurrently; all the modules which do work in parallel go
+      through the shared instance, so the total concurrency is bounded
+      by a single budget.
+
+      The work is split in chunks, and every worker starts on its own
+      contiguous range of chunks and steals chunks from the other
+      workers when it runs out. By default the workers are threads
+      owned by the executor; a simulator which has a thread pool of its
+      own can instead install a host hook and run the workers there.
+
+      Results never depend on the scheduling: the chunk boundaries only
+      depend on the range and the grain size, reductions are combined
+      in chunk order and if several chunks fail the exception from the
+      first of them is rethrown. Parallel calls from within a worker
+      are run serially on that worker.
+    */
+
+    class Executor {
+    public:
+        using Worker = std::function< void( std::size_t worker_index ) >;
+
+        /*
+          The host hook must call worker(i) for every i in [0,
+          num_workers), concurrently, and return when all the calls
+          have returned. The workers do not throw.
+        */
+        using HostHook = std::function< void( std::size_t num_workers, const Worker& worker ) >;
+
+        static Executor& instance();
+
+        Executor();
+        Executor( const Executor& ) = delete;
+        ~Executor();
+
+        /*
+          The maximum number of workers used for one parallel call,
+          including the calling thread; one will run everything
+          serially and zero selects the hardware concurrency.
+        */
+        void setConcurrency( std::size_t max_workers );
+        std::size_t concurrency() const;
+
+        /*
+          An empty hook restores the executor's own threads.
+        */
+        void setHostHook( HostHook hook );
+
+        /*
+          Calls body(chunk) once for every chunk in [0, num_chunks).
+        */
+        void runChunks( std::size_t num_chunks, const std::function< void( std::size_t chunk ) >& body );
+
+        template< typename Func >
+        void parallelFor( std::size_t begin, std::size_t end, Func&& func, std::size_t grain = 1 ) {
+            if (end <= begin)
+                return;
+
+            grain = std::max< std::size_t >( grain, 1 );
+            this->runChunks( (end - begin + grain - 1) / grain, [&]( std::size_t chunk ) {
+                const std::size_t first = begin + chunk * grain;
+                const std::size_t last = std::min( end, first + grain );
+                for (std::size_t index = first; index < last; index++)
+                    func( index );
+            });
+        }
+
+        /*
+          The func( first, last ) function reduces one chunk, and the
+          partial results are combined from left to right starting with
+          init; i.e. the result is the same for any concurrency.
+        */
+        template< typename T, typename Func, typename Combine >
+        T parallelReduce( std::size_t begin, std::size_t end, std::size_t grain,
+                          T init, Func&& func, Combine&& combine ) {
+            if (end <= begin)
+                return init;
+
+            grain = std::max< std::size_t >( grain, 1 );
+            std::vector< T > partial( (end - begin + grain - 1) / grain, init );
+            this->runChunks( partial.size(), [&]( std::size_t chunk ) {
+                const std::size_t first = begin + chunk * grain;
+                partial[chunk] = func( first, std::min( end, first + grain ) );
+            });
+
+            for (const auto& value : partial)
+                init = combine( init, value );
+
+            return init;
+        }
+
+    private:
+        class ThreadPool;
+
+        mutable std::mutex m_config_lock;
+        std::size_t m_concurrency;
+        HostHook m_host_hook;
+        std::unique_ptr< ThreadPool > m_pool;
+    };
+
+
+    /*
+      A group of independent tasks which are run concurrently by
+      wait(). The tasks should write their results to separate slots,
+      e.g. one element of a vector each, to get results in task order.
+    */
+
+    class TaskGroup {
+    public:
+        explicit TaskGroup( Executor& executor = Executor::instance() );
+
+        void run( std::function< void() > task );
+        std::size_t size() const;
+        void wait();
+
+    private:
+        Executor& m_executor;
+        std::vector< std::function< void() > > m_tasks;
+    };
+}
+
+#endif
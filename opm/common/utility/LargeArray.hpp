@@ -0,0 +1,94 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OPM_LARGE_ARRAY_HPP
+#define OPM_LARGE_ARRAY_HPP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      Allocation of arrays with one or more elements per cell. Small
+      allocations go to operator new. Above largeArrayThreshold the
+      default implementation maps memory with 2 MiB alignment and asks
+      for transparent huge pages. The pages are then first touched
+      concurrently through the shared Executor, so on a NUMA machine
+      the array is spread over the nodes of the threads which will
+      later sweep it, instead of all landing on the node of the thread
+      which allocated it.
+
+      A host application can install its own allocation functions,
+      e.g. to use libnuma or a pool. This must happen before any large
+      array is allocated, because memory is always released with the
+      deallocation function which is installed at that time.
+    */
+
+    const std::size_t largeArrayThreshold = 1 << 20;
+
+    using LargeArrayAllocateHook = std::function< void*( std::size_t bytes ) >;
+    using LargeArrayDeallocateHook = std::function< void( void* ptr, std::size_t bytes ) >;
+
+    void* largeArrayAllocate( std::size_t bytes );
+    void largeArrayDeallocate( void* ptr, std::size_t bytes );
+
+    /*
+      Installs the hooks used for allocations of at least
+      largeArrayThreshold bytes; empty hooks restore the default.
+    */
+    void setLargeArrayHooks( LargeArrayAllocateHook allocate, LargeArrayDeallocateHook deallocate );
+
+
+    template< typename T >
+    class LargeArrayAllocator {
+    public:
+        using value_type = T;
+
+        LargeArrayAllocator() = default;
+
+        template< typename U >
+        LargeArrayAllocator( const LargeArrayAllocator< U >& ) {}
+
+        T* allocate( std::size_t n ) {
+            return static_cast< T* >( largeArrayAllocate( n * sizeof( T ) ) );
+        }
+
+        void deallocate( T* ptr, std::size_t n ) {
+            largeArrayDeallocate( ptr, n * sizeof( T ) );
+        }
+    };
+
+    template< typename T, typename U >
+    bool operator==( const LargeArrayAllocator< T >&, const LargeArrayAllocator< U >& ) {
+        return true;
+    }
+
+    template< typename T, typename U >
+    bool operator!=( const LargeArrayAllocator< T >&, const LargeArrayAllocator< U >& ) {
+        return false;
+    }
+
+    template< typename T >
+    using LargeVector = std::vector< T, LargeArrayAllocator< T > >;
+}
+
+#endif
@@ -26,6 +26,7 @@
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Opm {
@@ -119,6 +120,30 @@ namespace Opm {
         void read(MessageBufferType& buffer);
     };
 
+    /*
+      Segment results of a multi segment well, as flat arrays which are
+      dense in the segment number: element n - 1 holds the value for
+      segment n. The rates follow the sign convention of the well rates,
+      i.e. production is negative. Wells which are not multi segment
+      leave the arrays empty.
+    */
+    struct Segments {
+        std::vector< double > oil_rate;
+        std::vector< double > water_rate;
+        std::vector< double > gas_rate;
+        std::vector< double > pressure;
+
+        inline void resize( size_t num_segments );
+        /// The number of segments with a complete set of results.
+        inline size_t size() const noexcept;
+        /// true if results are available for the segment number.
+        inline bool has( int segment_number ) const noexcept;
+        template <class MessageBufferType>
+        void write(MessageBufferType& buffer) const;
+        template <class MessageBufferType>
+        void read(MessageBufferType& buffer);
+    };
+
     struct Well {
         Rates rates;
         double bhp;
@@ -127,7 +152,40 @@ namespace Opm {
         int control;
         std::vector< Completion > completions;
 
+        /*
+          Sorted (global index, position in completions) pairs. The table
+          is built by index_completions(), which is called when the well
+          is deserialised, loaded from a restart file and when the wells
+          are passed to EclipseIO::writeTimeStep(); code which fills the
+          completions vector directly should call it when done.
+
+          The stamp records the buffer and size of the completions
+          vector when the table was built. While they are unchanged the
+          table is trusted, and a completion which is not in the table
+          is not in the well; otherwise find_completion() does a linear
+          search. A hit in the table is checked against the completion
+          it points to, and falls back to the linear search when the
+          global index has been changed in place; call
+          index_completions() again after such edits to keep lookups
+          logarithmic.
+        */
+        std::vector< std::pair< Completion::global_index, size_t > > completion_index;
+        std::pair< const Completion*, size_t > completion_index_stamp{ nullptr, 0 };
+        Segments segments;
+
+        /*
+          The tracer rates of the well, one element for each tracer in the
+          order of the TracerConfig. The rates follow the sign convention
+          of the well rates, i.e. production is negative.
+        */
+        std::vector< double > tracer_rates;
+
         inline bool flowing() const noexcept;
+        inline void index_completions();
+        inline bool completions_indexed() const noexcept;
+        /// The completion in the given cell, or nullptr if the well is
+        /// not completed there.
+        inline const Completion* find_completion( Completion::global_index ) const;
         template <class MessageBufferType>
         void write(MessageBufferType& buffer) const;
         template <class MessageBufferType>
@@ -135,6 +193,17 @@ namespace Opm {
     };
 
 
+    /*
+      A request for a completion level rate, used with the bulk
+      WellRates::gather() method.
+    */
+    struct CompletionRate {
+        std::string well;
+        Completion::global_index index;
+        Rates::opt rate;
+    };
+
+
     class WellRates : public std::map<std::string , Well> {
     public:
 
@@ -150,18 +219,28 @@ namespace Opm {
             const auto& witr = this->find( well_name );
             if( witr == this->end() ) return 0.0;
 
-            const auto& well = witr->second;
-            const auto& completion = std::find_if( well.completions.begin() ,
-                                                   well.completions.end() ,
-                                                   [=]( const Completion& c ) {
-                                                        return c.index == completion_grid_index; });
-
-            if( completion == well.completions.end() )
+            const auto* completion = witr->second.find_completion( completion_grid_index );
+            if( !completion )
                 return 0.0;
 
             return completion->rates.get( m, 0.0 );
         }
 
+        /*
+          Looks up a list of completion level rates; values[i] is set to
+          the rate of requests[i], or zero if the well or completion is
+          not found. Consecutive requests for the same well share the
+          well lookup, and wells without a valid completion index get a
+          temporary one, so each value is found in logarithmic time.
+        */
+        inline void gather( const std::vector< CompletionRate >& requests,
+                            std::vector< double >& values ) const;
+
+        void index_completions() {
+            for( auto& pair : *this )
+                pair.second.index_completions();
+        }
+
         template <class MessageBufferType>
         void write(MessageBufferType& buffer) const {
             unsigned int size = this->size();
@@ -183,7 +262,7 @@ namespace Opm {
                 buffer.read(name);
                 Well well;
                 well.read(buffer);
-                this->emplace(name, well);
+                this->emplace(name, std::move(well));
             }
         }
 
@@ -271,6 +350,110 @@ namespace Opm {
         return this->rates.any();
     }
 
+    using CompletionIndex = std::vector< std::pair< Completion::global_index, size_t > >;
+
+    inline CompletionIndex make_completion_index( const std::vector< Completion >& completions ) {
+        CompletionIndex index;
+        index.reserve( completions.size() );
+        for( size_t pos = 0; pos < completions.size(); ++pos )
+            index.emplace_back( completions[ pos ].index, pos );
+
+        /* A stable sort keeps the first completion for duplicated cells. */
+        std::stable_sort( index.begin(), index.end(),
+                          []( const CompletionIndex::value_type& a,
+                              const CompletionIndex::value_type& b ) {
+                              return a.first < b.first;
+                          } );
+        return index;
+    }
+
+    inline const Completion* find_linear( const std::vector< Completion >& completions,
+                                          Completion::global_index global_index ) {
+        const auto completion = std::find_if( completions.begin(),
+                                              completions.end(),
+                                              [=]( const Completion& c ) {
+                                                  return c.index == global_index; } );
+
+        if( completion == completions.end() )
+            return nullptr;
+
+        return &*completion;
+    }
+
+    inline const Completion* find_in_index( const CompletionIndex& index,
+                                            const std::vector< Completion >& completions,
+                                            Completion::global_index global_index ) {
+        const auto iter = std::lower_bound( index.begin(), index.end(), global_index,
+                                            []( const CompletionIndex::value_type& entry,
+                                                Completion::global_index value ) {
+                                                return entry.first < value;
+                                            } );
+
+        if( iter == index.end() || iter->first != global_index )
+            return nullptr;
+
+        /* The table is stale if the hit no longer points at the cell. */
+        if( iter->second >= completions.size()
+            || completions[ iter->second ].index != global_index )
+            return find_linear( completions, global_index );
+
+        return &completions[ iter->second ];
+    }
+
+    inline void Well::index_completions() {
+        this->completion_index = make_completion_index( this->completions );
+        this->completion_index_stamp = { this->completions.data(), this->completions.size() };
+    }
+
+    inline bool Well::completions_indexed() const noexcept {
+        return this->completion_index_stamp.first == this->completions.data()
+            && this->completion_index_stamp.second == this->completions.size()
+            && this->completion_index.size() == this->completions.size();
+    }
+
+    inline const Completion* Well::find_completion( Completion::global_index global_index ) const {
+        if( this->completions_indexed() )
+            return find_in_index( this->completion_index, this->completions, global_index );
+
+        return find_linear( this->completions, global_index );
+    }
+
+    inline void WellRates::gather( const std::vector< CompletionRate >& requests,
+                                   std::vector< double >& values ) const {
+        values.assign( requests.size(), 0.0 );
+
+        const std::string* well_name = nullptr;
+        const Well* well = nullptr;
+        const CompletionIndex* index = nullptr;
+        CompletionIndex scratch;
+
+        for( size_t i = 0; i < requests.size(); ++i ) {
+            const auto& request = requests[ i ];
+            if( !well_name || *well_name != request.well ) {
+                well_name = &request.well;
+                const auto witr = this->find( request.well );
+                well = witr == this->end() ? nullptr : &witr->second;
+                index = nullptr;
+            }
+
+            if( !well )
+                continue;
+
+            if( !index ) {
+                if( well->completions_indexed() ) {
+                    index = &well->completion_index;
+                } else {
+                    scratch = make_completion_index( well->completions );
+                    index = &scratch;
+                }
+            }
+
+            const auto* completion = find_in_index( *index, well->completions, request.index );
+            if( completion )
+                values[ i ] = completion->rates.get( request.rate, 0.0 );
+        }
+    }
+
     template <class MessageBufferType>
     void Rates::write(MessageBufferType& buffer) const {
             buffer.write(this->mask);
@@ -309,6 +492,55 @@ namespace Opm {
         buffer.write(size);
         for (const Completion& comp : this->completions)
             comp.write(buffer);
+        this->segments.write(buffer);
+
+        unsigned int num_tracers = this->tracer_rates.size();
+        buffer.write(num_tracers);
+        for (const double rate : this->tracer_rates)
+            buffer.write(rate);
+    }
+
+    inline void Segments::resize( size_t num_segments ) {
+        this->oil_rate.resize( num_segments, 0.0 );
+        this->water_rate.resize( num_segments, 0.0 );
+        this->gas_rate.resize( num_segments, 0.0 );
+        this->pressure.resize( num_segments, 0.0 );
+    }
+
+    inline size_t Segments::size() const noexcept {
+        return std::min( { this->oil_rate.size(),
+                           this->water_rate.size(),
+                           this->gas_rate.size(),
+                           this->pressure.size() } );
+    }
+
+    inline bool Segments::has( int segment_number ) const noexcept {
+        return segment_number > 0 && size_t( segment_number ) <= this->size();
+    }
+
+    template <class MessageBufferType>
+    void Segments::write(MessageBufferType& buffer) const {
+        unsigned int size = this->size();
+        buffer.write(size);
+        for (size_t i = 0; i < size; ++i) {
+            buffer.write(this->oil_rate[ i ]);
+            buffer.write(this->water_rate[ i ]);
+            buffer.write(this->gas_rate[ i ]);
+            buffer.write(this->pressure[ i ]);
+        }
+    }
+
+    template <class MessageBufferType>
+    void Segments::read(MessageBufferType& buffer) {
+        unsigned int size = 0;
+        buffer.read(size);
+        this->resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            buffer.read(this->oil_rate[ i ]);
+            buffer.read(this->water_rate[ i ]);
+            buffer.read(this->gas_rate[ i ]);
+            buffer.read(this->pressure[ i ]);
+        }
     }
 
     template <class MessageBufferType>
@@ -353,6 +585,15 @@ namespace Opm {
             auto& comp = this->completions[ i ];
             comp.read(buffer);
         }
+        this->segments.read(buffer);
+
+        unsigned int num_tracers = 0;
+        buffer.read(num_tracers);
+        this->tracer_rates.resize(num_tracers);
+        for (size_t i = 0; i < num_tracers; ++i)
+            buffer.read(this->tracer_rates[ i ]);
+
+        this->index_completions();
     }
 
 }
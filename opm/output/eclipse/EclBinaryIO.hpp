@@ -0,0 +1,182 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OPM_ECL_BINARY_IO_HPP
+#define OPM_ECL_BINARY_IO_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Opm {
+namespace EclIO {
+
+    /*
+      The unformatted Eclipse files (EGRID, INIT, UNRST, SMSPEC, ...)
+      are sequences of named arrays. Every array is stored as a header
+      Fortran record with the name, number of elements and type of the
+      array, followed by the elements split in Fortran records of at
+      most 1000 elements - 105 elements for CHAR arrays. A Fortran
+      record is the payload framed by its byte length as a 32 bit
+      integer on both sides, and all numbers are stored big endian.
+
+      The formatted files (FEGRID, FINIT, FUNRST, ...) hold the same
+      arrays as text; the header is a line with the quoted name, the
+      size and the quoted type, and the elements are written in fixed
+      width columns with a line break after every block.
+    */
+
+    enum class ArrayType {
+        INTE,
+        REAL,
+        DOUB,
+        LOGI,
+        CHAR,
+        MESS
+    };
+
+    const char* typeName( ArrayType type );
+
+
+    /*
+      The EclOutput class writes arrays straight from the caller's
+      buffers; the byte swapping is done in bulk into an internal block
+      buffer which is written to the file when it is full, i.e. the
+      number of write calls does not depend on the number of arrays or
+      records written. With formatted output the blocks of large
+      arrays are formatted concurrently.
+    */
+
+    class EclOutput {
+    public:
+        explicit EclOutput( const std::string& filename,
+                            bool formatted = false,
+                            std::ios_base::openmode mode = std::ios_base::out );
+        EclOutput( const EclOutput& ) = delete;
+        ~EclOutput();
+
+        void write( const std::string& name, const int* data, std::size_t size );
+        void write( const std::string& name, const float* data, std::size_t size );
+        void write( const std::string& name, const double* data, std::size_t size );
+
+        void write( const std::string& name, const std::vector< int >& data );
+        void write( const std::string& name, const std::vector< float >& data );
+        void write( const std::string& name, const std::vector< double >& data );
+        void write( const std::string& name, const std::vector< bool >& data );
+        void write( const std::string& name, const std::vector< std::string >& data );
+
+        /*
+          The double values are written as a REAL array, which is the
+          convention for most of the arrays in the Eclipse files.
+        */
+        void writeFloat( const std::string& name, const double* data, std::size_t size );
+        void writeFloat( const std::string& name, const std::vector< double >& data );
+
+        /*
+          Will write an array header of type MESS without any data,
+          e.g. the STARTSOL and ENDSOL markers in restart files.
+        */
+        void message( const std::string& name );
+
+        void flush();
+
+    private:
+        void writeHeader( const std::string& name, std::size_t size, ArrayType type );
+        void writeBytes( const std::string& bytes );
+
+        template< typename T >
+        void writeFormattedArray( ArrayType type, const T* data, std::size_t size );
+
+        template< typename T >
+        void writeArray( const std::string& name, ArrayType type, const T* data, std::size_t size );
+
+        char* reserve( std::size_t bytes );
+
+        std::string m_filename;
+        bool m_formatted;
+        std::ofstream m_stream;
+        std::vector< char > m_buffer;
+    };
+
+
+    /*
+      The EclFile class maps an Eclipse file into memory and indexes
+      the arrays in it. The elements of an array are only converted
+      when they are asked for. Whether the file is formatted is
+      inferred from the content, not the file name.
+
+      The get methods return a copy of the array; the elements are
+      stored big endian and split in records in the file, so they can
+      not be viewed in place in the mapping.
+    */
+
+    class EclFile {
+    public:
+        struct Array {
+            std::string name;
+            ArrayType type;
+            std::size_t size;
+            std::size_t offset;   // Byte offset of the array header.
+        };
+
+        explicit EclFile( const std::string& filename );
+        EclFile( const EclFile& ) = delete;
+        ~EclFile();
+
+        bool formatted() const;
+        const std::vector< Array >& arrays() const;
+        std::size_t size() const;
+        bool hasKey( const std::string& name ) const;
+
+        /*
+          Index of the occurence'th array with the given name; will
+          throw std::invalid_argument if there is no such array.
+        */
+        std::size_t index( const std::string& name, std::size_t occurence = 0 ) const;
+
+        std::vector< int > getInt( std::size_t index ) const;
+        std::vector< float > getFloat( std::size_t index ) const;
+        std::vector< double > getDouble( std::size_t index ) const;
+        std::vector< bool > getBool( std::size_t index ) const;
+        std::vector< std::string > getString( std::size_t index ) const;
+
+    private:
+        void indexArrays();
+        void indexFormattedArrays();
+        void checkType( std::size_t index, ArrayType type ) const;
+
+        template< typename T >
+        void readData( std::size_t index, T* data ) const;
+
+        template< typename T >
+        void readFormattedData( std::size_t index, T* data ) const;
+
+        std::string m_filename;
+        bool m_formatted = false;
+        const char* m_data = nullptr;
+        std::size_t m_size = 0;
+        std::vector< Array > m_arrays;
+    };
+
+}
+}
+
+#endif
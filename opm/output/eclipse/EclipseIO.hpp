@@ -179,6 +179,24 @@ public:
                         const std::map<std::pair<std::string, int>, double>& block_summary_values,
                         bool write_double = false);
 
+    /*
+      Alternative to passing the simulator supplied summary values in
+      maps keyed by keyword: the simulator registers the values it will
+      supply once, and then passes a vector of SI values indexed by the
+      returned handles to writeTimeStep() at every step. See
+      out::Summary::register_value() for the details.
+    */
+    int registerSummaryValue( const std::string& keyword );
+    int registerRegionSummaryValue( const std::string& keyword, int region );
+    int registerBlockSummaryValue( const std::string& keyword, int block );
+
+    void writeTimeStep( int report_step,
+                        bool isSubstep,
+                        double seconds_elapsed,
+                        RestartValue value,
+                        const std::vector<double>& summary_values,
+                        bool write_double = false);
+
 
     /*
       Will load solution data and wellstate from the restart
@@ -23,8 +23,10 @@
 #ifndef RESTART_IO_HPP
 #define RESTART_IO_HPP
 
-#include <vector>
+#include <cstddef>
 #include <map>
+#include <string>
+#include <vector>
 
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 #include <opm/parser/eclipse/EclipseState/Runspec.hpp>
@@ -38,6 +40,7 @@
 #include <ert/ecl/EclKW.hpp>
 #include <ert/ecl/ecl_rsthead.h>
 #include <ert/ecl/ecl_rst_file.h>
+#include <ert/util/ert_unique_ptr.hpp>
 #include <ert/util/util.h>
 
 namespace Opm {
@@ -82,6 +85,50 @@ void save(const std::string& filename,
           bool write_double = false);
 
 
+/*
+  The UnifiedRestartFile class is used when the same unified restart
+  file is written to repeatedly during a simulation. It keeps an index
+  of the byte offset where each report step starts, so that a new
+  report step can be appended at the end of the file without scanning
+  it. If a report step which has already been written is written
+  again, e.g. when the simulator restarts from an earlier step, the
+  file is truncated at the offset of that step first.
+
+  Only the first report step written through the object has to locate
+  its position in an existing file; that is also the fallback when a
+  report step before all the indexed steps is written.
+*/
+
+class UnifiedRestartFile {
+public:
+    explicit UnifiedRestartFile(const std::string& filename);
+
+    const std::string& filename() const;
+    bool hasStep(int report_step) const;
+    std::size_t offset(int report_step) const;
+
+    /*
+      Will prepare the file for writing report_step and return an
+      ecl_rst_file handle positioned at the start of that step.
+    */
+    ERT::ert_unique_ptr< ecl_rst_file_type, ecl_rst_file_close > openStep(int report_step);
+
+private:
+    std::string m_filename;
+    std::map<int, std::size_t> m_offsets;
+};
+
+
+void save(UnifiedRestartFile& rst_file,
+          int report_step,
+          double seconds_elapsed,
+          RestartValue value,
+          const EclipseState& es,
+          const EclipseGrid& grid,
+          const Schedule& schedule,
+          bool write_double = false);
+
+
 RestartValue load( const std::string& filename,
                    int report_step,
                    const std::vector<RestartKey>& solution_keys,
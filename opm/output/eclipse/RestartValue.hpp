@@ -22,6 +22,7 @@
 #include <map>
 #include <vector>
 
+#include <opm/parser/eclipse/EclipseState/TracerConfig.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 #include <opm/output/data/Solution.hpp>
 #include <opm/output/data/Wells.hpp>
@@ -71,6 +72,14 @@ namespace Opm {
         void addExtra(const std::string& key, UnitSystem::measure dimension, std::vector<double> data);
         void addExtra(const std::string& key, std::vector<double> data);
         const std::vector<double>& getExtra(const std::string& key) const;
+
+        /*
+          The tracer concentrations are stored in the solution, with one
+          value per active cell, under the restart key of the tracer.
+        */
+        void addTracer(const TracerConfig::TracerEntry& tracer, std::vector<double> concentration);
+        bool hasTracer(const TracerConfig::TracerEntry& tracer) const;
+        const std::vector<double>& getTracer(const TracerConfig::TracerEntry& tracer) const;
     };
 
 }
@@ -28,6 +28,7 @@
 #include <ert/ecl/Smspec.hpp>
 
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 
 #include <opm/output/data/Wells.hpp>
 #include <opm/output/eclipse/RegionCache.hpp>
@@ -57,6 +58,35 @@ class Summary {
                            const std::map<std::string, std::vector<double>>& region_values = {},
                            const std::map<std::pair<std::string, int>, double>& block_values = {});
 
+        /*
+          The values which are supplied by the simulator can be
+          registered up front; the register methods return a dense
+          integer handle. For every timestep add_registered_timestep()
+          is then called with a vector of SI values indexed by those
+          handles, instead of add_timestep() with maps keyed by
+          keyword. Registering a value which has not been requested in
+          the SUMMARY section is not an error, the value passed for
+          that handle is just ignored. The region and block arguments
+          are one based, as the NUMS values in the summary file.
+        */
+        int register_value( const std::string& keyword );
+        int register_region_value( const std::string& keyword, int region );
+        int register_block_value( const std::string& keyword, int block );
+        size_t num_registered_values() const;
+
+        void add_registered_timestep(int report_step,
+                                     double secs_elapsed,
+                                     const EclipseState& es,
+                                     const Schedule& schedule,
+                                     const data::Wells&,
+                                     const std::vector<double>& registered_values);
+
+        /*
+          The most recent value of all the summary vectors, in output
+          units; this is the input to Schedule::applyActions().
+        */
+        const SummaryState& get_summary_state() const;
+
         void write();
 
         ~Summary();
@@ -64,12 +94,19 @@ class Summary {
     private:
         class keyword_handlers;
 
+        ecl_sum_tstep_type* add_handler_values( int report_step,
+                                                double secs_elapsed,
+                                                const EclipseState& es,
+                                                const Schedule& schedule,
+                                                const data::Wells& );
+
         const EclipseGrid& grid;
         out::RegionCache regionCache;
         ERT::ert_unique_ptr< ecl_sum_type, ecl_sum_free > ecl_sum;
         std::unique_ptr< keyword_handlers > handlers;
         const ecl_sum_tstep_type* prev_tstep = nullptr;
         double prev_time_elapsed = 0;
+        SummaryState summary_state;
 };
 
 }
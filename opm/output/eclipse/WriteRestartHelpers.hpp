@@ -20,6 +20,7 @@
 #ifndef OPM_WRITE_RESTART_HELPERS_HPP
 #define OPM_WRITE_RESTART_HELPERS_HPP
 
+#include <utility>
 #include <vector>
 
 // Missing definitions (really belong in ert/ecl_well/well_const.h, but not
@@ -37,6 +38,10 @@ namespace Opm {
     class Well;
     class UnitSystem;
 
+    namespace data {
+        class WellRates;
+    }
+
 } // Opm
 
 namespace Opm { namespace RestartIO { namespace Helpers {
@@ -74,6 +79,44 @@ namespace Opm { namespace RestartIO { namespace Helpers {
                                        const std::vector<const Well*>& sched_wells,
                                        const UnitSystem& units);
 
+    /*
+      The segment arrays ISEG, RSEG, ILBS and ILBR hold one block per multi
+      segment well, in the order the wells appear in sched_wells; wells
+      which are not multi segment at lookup_step are skipped. Within a
+      well block the segment entries are indexed by segment number and the
+      branch entries by branch number, so nsegmx and nlbrmx must be at
+      least the largest segment and branch number in use. The functions
+      numSegmentedWells() and maxSegmentDimensions() give the dimensions
+      for the wells at lookup_step.
+    */
+    int numSegmentedWells(int lookup_step,
+                          const std::vector<const Well*>& sched_wells);
+
+    // Largest segment number and largest branch number over all multi segment wells.
+    std::pair<int, int> maxSegmentDimensions(int lookup_step,
+                                             const std::vector<const Well*>& sched_wells);
+
+    std::vector<int> serialize_ISEG(int lookup_step,
+                                    int nsegmx,      // Max number of segments per well, entry 176 in INTEHEAD.
+                                    int nisegz,      // Number of elements per segment in ISEG, entry 178 in INTEHEAD.
+                                    const std::vector<const Well*>& sched_wells);
+
+    std::vector<double> serialize_RSEG(int lookup_step,
+                                       int nsegmx,      // Max number of segments per well, entry 176 in INTEHEAD.
+                                       int nrsegz,      // Number of elements per segment in RSEG, entry 179 in INTEHEAD.
+                                       const std::vector<const Well*>& sched_wells,
+                                       const data::WellRates& wells,
+                                       const UnitSystem& units);
+
+    std::vector<int> serialize_ILBS(int lookup_step,
+                                    int nlbrmx,      // Max number of branches per well, entry 177 in INTEHEAD.
+                                    const std::vector<const Well*>& sched_wells);
+
+    std::vector<int> serialize_ILBR(int lookup_step,
+                                    int nlbrmx,      // Max number of branches per well, entry 177 in INTEHEAD.
+                                    int nilbrz,      // Number of elements per branch in ILBR, entry 180 in INTEHEAD.
+                                    const std::vector<const Well*>& sched_wells);
+
 }}} // Opm::RestartIO::Helpers
 
 #endif  // OPM_WRITE_RESTART_HELPERS_HPP
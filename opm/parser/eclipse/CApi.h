@@ -0,0 +1,120 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OPM_PARSER_C_API_H
+#define OPM_PARSER_C_API_H
+
+#include <stddef.h>
+
+/*
+  A C interface to the parsed input, intended for language bindings
+  and external tools which should not link against the C++ api. All
+  objects are opaque handles which must be released with the
+  corresponding free function.
+
+  Arrays are returned as borrowed views; the view points into memory
+  owned by the handle it was obtained from and remains valid, and
+  unchanged, as long as that handle is alive. The data must not be
+  modified or freed by the caller.
+
+  Functions returning int return 0 on success; functions returning a
+  handle return NULL on failure. The reason for the last failure in
+  the calling thread is available from opm_last_error().
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  The version is incremented when the existing functions or types
+  change in an incompatible way, adding functions does not change it.
+*/
+#define OPM_C_API_VERSION 1
+
+typedef struct opm_parser opm_parser;
+typedef struct opm_deck opm_deck;
+typedef struct opm_eclipse_state opm_eclipse_state;
+typedef struct opm_schedule opm_schedule;
+
+typedef enum {
+    OPM_DTYPE_INT32   = 0,
+    OPM_DTYPE_FLOAT64 = 1
+} opm_dtype;
+
+typedef struct {
+    const void* data;
+    size_t size;
+    opm_dtype dtype;
+} opm_array_view;
+
+typedef struct {
+    const char* name;
+    int head_i;              /* Zero based. */
+    int head_j;              /* Zero based. */
+    double ref_depth;        /* SI units, NaN if it can not be inferred. */
+    int status;              /* WellCommon::StatusEnum, i.e. OPEN = 1, STOP = 2, SHUT = 3, AUTO = 4. */
+    int producer;
+} opm_well_snapshot;
+
+int opm_api_version(void);
+const char* opm_last_error(void);
+
+opm_parser* opm_parser_alloc(void);
+void opm_parser_free(opm_parser* parser);
+opm_deck* opm_parser_parse_file(opm_parser* parser, const char* filename);
+opm_deck* opm_parser_parse_string(opm_parser* parser, const char* data);
+
+void opm_deck_free(opm_deck* deck);
+size_t opm_deck_size(const opm_deck* deck);
+
+opm_eclipse_state* opm_eclipse_state_alloc(const opm_deck* deck);
+void opm_eclipse_state_free(opm_eclipse_state* state);
+int opm_eclipse_state_grid_dims(const opm_eclipse_state* state, int dims[3]);
+int opm_eclipse_state_int_property(const opm_eclipse_state* state, const char* keyword, opm_array_view* view);
+int opm_eclipse_state_double_property(const opm_eclipse_state* state, const char* keyword, opm_array_view* view);
+
+/* Global cell index of each active cell, i.e. an INT32 view with one element per active cell. */
+int opm_eclipse_state_active_map(const opm_eclipse_state* state, opm_array_view* view);
+
+int opm_eclipse_state_table_column(const opm_eclipse_state* state,
+                                   const char* table_name,
+                                   size_t table_index,
+                                   const char* column_name,
+                                   opm_array_view* view);
+
+opm_schedule* opm_schedule_alloc(const opm_deck* deck, const opm_eclipse_state* state);
+void opm_schedule_free(opm_schedule* schedule);
+size_t opm_schedule_num_steps(const opm_schedule* schedule);
+
+/*
+  The wells which are defined at the report step, the snapshot array
+  and the well names are owned by the schedule handle.
+*/
+int opm_schedule_wells(const opm_schedule* schedule,
+                       size_t report_step,
+                       const opm_well_snapshot** wells,
+                       size_t* num_wells);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -20,6 +20,7 @@
 #ifndef DECK_HPP
 #define DECK_HPP
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -29,6 +30,7 @@
 #include <boost/filesystem.hpp>
 
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/IncludeGraph.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
 #ifdef OPM_PARSER_DECK_API_WARNING
@@ -92,6 +94,13 @@ namespace Opm {
             const_iterator begin() const;
             const_iterator end() const;
 
+            /*
+              Aggregated content digest of all the keywords in the
+              view, in order. Two views with the same keywords in the
+              same order will have the same digest.
+            */
+            std::uint64_t hash() const;
+
 
         protected:
             void add( const DeckKeyword*, const_iterator, const_iterator );
@@ -120,6 +129,7 @@ namespace Opm {
             using DeckView::size;
             using DeckView::begin;
             using DeckView::end;
+            using DeckView::hash;
 
             using iterator = std::vector< DeckKeyword >::iterator;
 
@@ -144,6 +154,13 @@ namespace Opm {
             const std::string getDataFile() const;
             void setDataFile(const std::string& dataFile);
 
+            /*
+              The files which were read when parsing the deck, and
+              the INCLUDE relations between them.
+            */
+            const IncludeGraph& getIncludeGraph() const;
+            IncludeGraph& getIncludeGraph();
+
             iterator begin();
             iterator end();
             void write( DeckOutput& output ) const ;
@@ -156,6 +173,7 @@ namespace Opm {
             UnitSystem activeUnits;
 
             std::string m_dataFile;
+            IncludeGraph m_includeGraph;
     };
 }
 #endif  /* DECK_HPP */
@@ -29,6 +29,7 @@
 #include <opm/parser/eclipse/Utility/Typetools.hpp>
 
 namespace Opm {
+    class ContentHash;
     class DeckOutput;
 
     class DeckItem {
@@ -85,6 +86,13 @@ namespace Opm {
         void write(DeckOutput& writer) const;
         friend std::ostream& operator<<(std::ostream& os, const DeckItem& item);
 
+        /*
+          Feed the item name and the raw values to the hasher. The
+          defaulted status is not included, so items which compare
+          equal with operator== and identical values will hash equal.
+        */
+        void hash(ContentHash& hasher) const;
+
 
         /*
           The comparison can be adjusted with the cmp_default and
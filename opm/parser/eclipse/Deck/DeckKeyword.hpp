@@ -20,6 +20,7 @@
 #ifndef DECKKEYWORD_HPP
 #define DECKKEYWORD_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -77,6 +78,17 @@ namespace Opm {
         bool operator!=(const DeckKeyword& other) const;
 
         friend std::ostream& operator<<(std::ostream& os, const DeckKeyword& keyword);
+
+        /*
+          Content digest of the keyword; based on the keyword name and
+          the raw values of all records, the file location is not
+          included. The digest is computed by the parser when the
+          keyword is completed, for keywords assembled by hand it is
+          computed on first call. Adding records or requesting mutable
+          access to a record will invalidate the digest.
+        */
+        std::uint64_t hash() const;
+        void updateHash();
     private:
         std::string m_keywordName;
         std::string m_fileName;
@@ -86,6 +98,8 @@ namespace Opm {
         bool m_knownKeyword;
         bool m_isDataKeyword;
         bool m_slashTerminated;
+        mutable std::uint64_t m_hash = 0;
+        mutable bool m_hashValid = false;
     };
 }
 
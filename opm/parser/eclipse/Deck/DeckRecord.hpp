@@ -29,6 +29,8 @@
 
 namespace Opm {
 
+    class ContentHash;
+
     class DeckRecord {
     public:
         typedef std::vector< DeckItem >::const_iterator const_iterator;
@@ -65,6 +67,7 @@ namespace Opm {
         void write(DeckOutput& writer) const;
         void write_data(DeckOutput& writer) const;
         friend std::ostream& operator<<(std::ostream& os, const DeckRecord& record);
+        void hash(ContentHash& hasher) const;
 
         bool equal(const DeckRecord& other, bool cmp_default, bool cmp_numeric) const;
         bool operator==(const DeckRecord& other) const;
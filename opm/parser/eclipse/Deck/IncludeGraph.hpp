@@ -0,0 +1,88 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_GRAPH_HPP
+#define INCLUDE_GRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      The IncludeGraph records the files which have been read when a
+      deck is parsed, and which file INCLUDE'd which. The same file can
+      be included from several places, hence the graph is a DAG and not
+      a tree; each file is only registered once.
+
+      For every file the canonical path, the size and the modification
+      time at the time of parsing are stored, which makes it possible
+      for external tools to know exactly which files a deck depends on,
+      and whether any of them have changed.
+    */
+
+    class IncludeGraph {
+    public:
+        struct File {
+            std::string path;
+            std::uintmax_t size;
+            std::time_t mtime;
+        };
+
+        static const std::size_t npos = static_cast< std::size_t >( -1 );
+
+        /*
+          Register a file in the graph and return the index of the
+          file; if a file with the same path is already registered
+          the existing index is returned and size and mtime are not
+          updated.
+        */
+        std::size_t addFile( const std::string& path, std::uintmax_t size, std::time_t mtime );
+        std::size_t addFile( const std::string& path );
+        void addInclude( std::size_t parent, std::size_t child );
+
+        bool hasFile( const std::string& path ) const;
+        std::size_t index( const std::string& path ) const;
+        const File& getFile( std::size_t index ) const;
+        std::size_t size() const;
+        bool empty() const;
+
+        /* The files directly included by the file with the given index. */
+        const std::vector< std::size_t >& includes( std::size_t index ) const;
+
+        /* The files which are not included by any other file. */
+        std::vector< std::size_t > roots() const;
+
+        /* All files the deck depends on, in the order they were first read. */
+        std::vector< std::string > dependencies() const;
+
+    private:
+        std::vector< File > files;
+        std::vector< std::vector< std::size_t > > edges;
+        std::vector< bool > included;
+        std::map< std::string, std::size_t > file_index;
+    };
+}
+
+#endif
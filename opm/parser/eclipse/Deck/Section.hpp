@@ -20,7 +20,9 @@
 #ifndef SECTION_HPP
 #define SECTION_HPP
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 
@@ -52,6 +54,17 @@ class Section : public DeckView {
                                          const Parser&,
                                          bool ensureKeywordSectionAffiliation = false);
 
+        /*
+          Combined content digest of the keywords in the listed
+          sections, together with the active unit system of the
+          deck. Keywords found before the first section keyword are
+          always included, that way decks without section keywords get
+          a digest of all their keywords. This is the digest used by
+          the EclipseState components to identify their input.
+        */
+        static std::uint64_t contentHash( const Deck& deck,
+                                          const std::vector< std::string >& sections );
+
     private:
         std::string section_name;
         const UnitSystem& units;
@@ -19,6 +19,7 @@
 #ifndef OPM_ECLIPSE_PROPERTIES_HPP
 #define OPM_ECLIPSE_PROPERTIES_HPP
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -60,6 +61,10 @@ namespace Opm {
         const GridProperty<int>&      getIntGridProperty     ( const std::string& keyword ) const;
         const GridProperty<double>&   getDoubleGridProperty  ( const std::string& keyword ) const;
 
+        /// cell bulk volumes for all cells in the cartesian grid; computed
+        /// in the same pass as the PORV property.
+        const std::vector<double>& getBulkVolume() const;
+
         const GridProperties<int>& getIntProperties() const;
         const GridProperties<double>& getDoubleProperties() const;
 
@@ -67,17 +72,37 @@ namespace Opm {
         bool hasDeckDoubleGridProperty(const std::string& keyword) const;
         bool supportsGridProperty(const std::string& keyword) const;
 
+        /*
+          Content digest of the input the properties have been created
+          from; combines the digest of the grid, the tables and all the
+          sections which can contain grid property keywords.
+        */
+        std::uint64_t hash() const;
+
+        /*
+          The order in which the pending post processors must run before
+          the keyword can be handed out; the post processors in one
+          entry do not depend on each other.
+        */
+        std::vector< std::vector< std::string > > postProcessorSchedule( const std::string& keyword ) const;
+
     private:
+        template< typename T >
+        static bool isDefaultedProperty( const GridProperties< T >& properties, const std::string& keyword );
+
+        void runPostProcessors( const std::string& keyword ) const;
         const GridProperty<int>& getRegion(const DeckItem& regionItem) const;
         void processGridProperties(const Deck& deck,
                                    const EclipseGrid& eclipseGrid);
 
         void scanSection(const Section& section,
                          const EclipseGrid& eclipseGrid);
+        void trimStorage() const;
 
         void handleADDKeyword(     const DeckKeyword& deckKeyword, BoxManager& boxManager);
         void handleBOXKeyword(     const DeckKeyword& deckKeyword, BoxManager& boxManager);
         void handleCOPYKeyword(    const DeckKeyword& deckKeyword, BoxManager& boxManager);
+        void handleCOPYBOXKeyword( const DeckKeyword& deckKeyword );
         void handleENDBOXKeyword(  BoxManager& boxManager);
         void handleEQUALSKeyword(  const DeckKeyword& deckKeyword, BoxManager& boxManager);
         void handleMAXVALUEKeyword(const DeckKeyword& deckKeyword, BoxManager& boxManager);
@@ -89,6 +114,7 @@ namespace Opm {
         void handleEQUALREGKeyword(const DeckKeyword& deckKeyword );
         void handleMULTIREGKeyword(const DeckKeyword& deckKeyword );
         void handleOPERATEKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager);
+        void handleOPERATERKeyword( const DeckKeyword& deckKeyword );
 
         void loadGridPropertyFromDeckKeyword(const Box& inputBox,
                                              const DeckKeyword& deckKeyword);
@@ -97,6 +123,8 @@ namespace Opm {
         UnitSystem             m_deckUnitSystem;
         GridProperties<int>    m_intGridProperties;
         GridProperties<double> m_doubleGridProperties;
+        std::vector<double>    m_bulkVolume;
+        std::uint64_t          m_hash = 0;
     };
 }
 
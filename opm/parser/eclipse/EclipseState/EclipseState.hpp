@@ -31,6 +31,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
 #include <opm/parser/eclipse/EclipseState/Runspec.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/EclipseState/TracerConfig.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/EclipseState/SimulationConfig/SimulationConfig.hpp>
 
@@ -87,6 +88,7 @@ namespace Opm {
 
         const Eclipse3DProperties& get3DProperties() const;
         const TableManager& getTableManager() const;
+        const TracerConfig& tracer() const;
         const EclipseConfig& getEclipseConfig() const;
         const EclipseConfig& cfg() const;
 
@@ -120,6 +122,7 @@ namespace Opm {
         NNC m_inputNnc;
         EclipseGrid m_inputGrid;
         Eclipse3DProperties m_eclipseProperties;
+        TracerConfig m_tracerConfig;
         const SimulationConfig m_simulationConfig;
         TransMult m_transMult;
 
@@ -23,6 +23,7 @@
 
 #include <vector>
 #include <cstddef>
+#include <memory>
 
 namespace Opm {
 
@@ -38,6 +39,17 @@ namespace Opm {
         const std::vector<size_t>& getIndexList() const;
         bool equal(const Box& other) const;
 
+        /*
+          The box can be traversed as getDim(1) * getDim(2) rows, where
+          each row is a run of getDim(0) consecutive global indices.
+          Row number j + k*getDim(1), in box coordinates, starts at
+          global index rowStart(j + k*getDim(1)). Operations which
+          work row by row do not need the index list, which is only
+          built on the first call to getIndexList() or begin().
+        */
+        size_t numRows() const;
+        size_t rowStart(size_t row) const;
+
         explicit operator bool() const;
         std::vector<size_t>::const_iterator begin() const;
         std::vector<size_t>::const_iterator end() const;
@@ -51,13 +63,13 @@ namespace Opm {
         int K2() const;
 
     private:
-        void initIndexList();
+        std::vector<size_t> makeIndexList() const;
         size_t m_dims[3] = { 0, 0, 0 };
         size_t m_offset[3];
         size_t m_stride[3];
 
         bool   m_isGlobal;
-        std::vector<size_t> m_indexList;
+        mutable std::shared_ptr< const std::vector<size_t> > m_indexList;
 
         int lower(int dim) const;
         int upper(int dim) const;
@@ -26,12 +26,15 @@
 #include <opm/parser/eclipse/EclipseState/Grid/MinpvMode.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/PinchMode.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/LocalGrid.hpp>
 
 #include <ert/ecl/ecl_grid.h>
 #include <ert/util/ert_unique_ptr.hpp>
 
 #include <array>
+#include <cstdint>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace Opm {
@@ -175,6 +178,36 @@ namespace Opm {
         bool equal(const EclipseGrid& other) const;
         const ecl_grid_type * c_ptr() const;
 
+        /*
+          Content digest of the input used to create the grid. For
+          grids created from a deck this is the digest of the RUNSPEC
+          and GRID sections, otherwise the digest of the dimensions and
+          geometry arrays. The ACTNUM passed to the constructor or to
+          resetACTNUM() is folded into the digest.
+        */
+        std::uint64_t hash() const;
+
+        /*
+          Local grid refinements defined with CARFIN ... ENDFIN in the
+          GRID section. The local grids are numbered from 1 in the
+          order they are defined, grid number 0 is the main grid.
+        */
+        size_t numLGR() const;
+        bool hasLGR(const std::string& name) const;
+        const LocalGrid& getLGR(size_t lgr_nr) const;
+        const LocalGrid& getLGR(const std::string& name) const;
+
+        /*
+          The hierarchical index space covers all cells of the main
+          grid followed by all cells of each local grid, i.e. it has
+          getTotalSize() elements. The getGridIndex() method returns
+          the pair (grid number, global index in that grid) for a
+          hierarchical index.
+        */
+        size_t getTotalSize() const;
+        size_t getHierarchicalIndex(size_t grid_nr, size_t global_index) const;
+        std::pair<size_t, size_t> getGridIndex(size_t hierarchical_index) const;
+
     private:
         double m_minpvValue;
         MinpvMode::ModeEnum m_minpvMode;
@@ -183,6 +216,9 @@ namespace Opm {
         PinchMode::ModeEnum m_multzMode;
         mutable std::vector< int > activeMap;
         bool m_circle = false;
+        std::uint64_t m_inputHash = 0;
+        std::uint64_t m_hash = 0;
+        std::vector<LocalGrid> m_lgrs;
 
         /*
           The internal class grid_ptr is a a std::unique_ptr with
@@ -207,12 +243,15 @@ namespace Opm {
                                  const int * actnum,
                                  const double * mapaxes);
 
+        void updateHash(const int * actnum);
+
         void initCylindricalGrid(       const std::array<int, 3>&, const Deck&);
         void initCartesianGrid(         const std::array<int, 3>&, const Deck&);
         void initCornerPointGrid(       const std::array<int, 3>&, const Deck&);
         void initDTOPSGrid(             const std::array<int, 3>&, const Deck&);
         void initDVDEPTHZGrid(          const std::array<int, 3>&, const Deck&);
         void initGrid(                  const std::array<int, 3>&, const Deck&);
+        void initLGR(                   const Deck&);
         void assertCornerPointKeywords( const std::array<int, 3>&, const Deck&);
 
         static bool hasDVDEPTHZKeywords(const Deck&);
@@ -105,6 +105,14 @@ namespace Opm {
         const GridProperty<T>& getKeyword(const std::string& keyword) const;
         const GridProperty<T>& getDeckKeyword(const std::string& keyword) const;
 
+        /*
+          The getDefaultedKeyword() method returns the keyword if it
+          exists, otherwise a property with the default values which is
+          *not* added to the container; i.e. hasKeyword() and the
+          iteration are not affected by calling this method.
+        */
+        const GridProperty<T>& getDefaultedKeyword(const std::string& keyword) const;
+
 
         bool addKeyword(const std::string& keywordName);
         void copyKeyword(const std::string& srcField ,
@@ -140,6 +148,7 @@ namespace Opm {
         void handleMINVALUERecord( const DeckRecord& record, BoxManager& boxManager);
         void handleMULTIPLYRecord( const DeckRecord& record, BoxManager& boxManager);
         void handleCOPYRecord( const DeckRecord& record, BoxManager& boxManager);
+        void handleCOPYBOXRecord( const DeckRecord& record);
         void handleEQUALSRecord( const DeckRecord& record, BoxManager& boxManager);
 
         void handleEQUALREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty );
@@ -147,6 +156,7 @@ namespace Opm {
         void handleMULTIREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty );
         void handleCOPYREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty );
         void handleOPERATERecord( const DeckRecord& record , BoxManager& boxManager);
+        void handleOPERATERRecord( const DeckRecord& record , const std::vector<size_t>& regionIndex);
         /*
           Iterators over initialized properties. The overloaded
           operator*() opens the pair which comes natively from the
@@ -182,7 +192,8 @@ namespace Opm {
                             const T defaultValue,
                             std::function< void( std::vector< T >& ) > postProcessor,
                             const std::string& dimString,
-                            const bool defaultInitializable );
+                            const bool defaultInitializable,
+                            const std::vector< std::string >& dependencies = {} );
 
         GridProperty<T>& getKeyword(const std::string& keyword);
         bool addAutoGeneratedKeyword_(const std::string& keywordName) const;
@@ -197,6 +208,7 @@ namespace Opm {
 
         mutable std::unordered_map<std::string, SupportedKeywordInfo> m_supportedKeywords;
         mutable storage m_properties;
+        mutable storage m_defaultProperties;
         mutable std::set<std::string> m_autoGeneratedProperties;
     };
 
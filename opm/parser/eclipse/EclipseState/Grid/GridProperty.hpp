@@ -19,7 +19,9 @@
 #ifndef ECLIPSE_GRIDPROPERTY_HPP_
 #define ECLIPSE_GRIDPROPERTY_HPP_
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -35,6 +37,7 @@ namespace Opm {
     class DeckItem;
     class DeckKeyword;
     class EclipseGrid;
+    class ScratchArray;
     class TableManager;
     template< typename > class GridProperties;
 
@@ -47,12 +50,20 @@ class GridPropertySupportedKeywordInfo {
         using init = std::function< std::vector< T >( size_t ) >;
         using post = std::function< void( std::vector< T >& ) >;
 
+        /*
+          The post processor can declare the properties it reads with
+          the dependencies argument. The post processors of those
+          properties are then guaranteed to have run before this one;
+          the only property a post processor is allowed to write is
+          the property it is registered for.
+        */
         GridPropertySupportedKeywordInfo(
             const std::string& name,
             init initializer,
             post  postProcessor,
             const std::string& dimString,
-            bool m_defaultInitializable = false );
+            bool m_defaultInitializable = false,
+            const std::vector< std::string >& dependencies = {} );
 
         GridPropertySupportedKeywordInfo(
                 const std::string& name,
@@ -74,12 +85,15 @@ class GridPropertySupportedKeywordInfo {
                 const T defaultValue,
                 post postProcessor,
                 const std::string& dimString,
-                bool m_defaultInitializable = false );
+                bool m_defaultInitializable = false,
+                const std::vector< std::string >& dependencies = {} );
 
         const std::string& getKeywordName() const;
         const std::string& getDimensionString() const;
         const init& initializer() const;
         const post& postProcessor() const;
+        bool hasPostProcessor() const;
+        const std::vector< std::string >& dependencies() const;
         bool isDefaultInitializable() const;
 
     private:
@@ -87,6 +101,8 @@ class GridPropertySupportedKeywordInfo {
         std::string m_keywordName;
         init m_initializer;
         post m_postProcessor;
+        bool m_hasPostProcessor = false;
+        std::vector< std::string > m_dependencies;
         std::string m_dimensionString;
         bool m_defaultInitializable;
 };
@@ -97,6 +113,11 @@ public:
     typedef GridPropertySupportedKeywordInfo<T> SupportedKeywordInfo;
 
     GridProperty( size_t nx, size_t ny, size_t nz, const SupportedKeywordInfo& kwInfo );
+    GridProperty( const GridProperty< T >& other );
+    GridProperty( GridProperty< T >&& other );
+    GridProperty< T >& operator=( const GridProperty< T >& other );
+    GridProperty< T >& operator=( GridProperty< T >&& other );
+    ~GridProperty();
 
     size_t getCartesianSize() const;
     size_t getNX() const;
@@ -110,9 +131,20 @@ public:
     void iset(size_t i , size_t j , size_t k , T value);
 
 
+    /*
+      When the GridPropertyStorage is enabled the data of a property
+      which has not been used for a while can be spilled to a scratch
+      file; it is then copied back to memory in full by getData() and
+      the other accessors, including iget(). The returned reference is
+      valid until the next GridPropertyStorage::trim() which covers the
+      property, unless the property is pinned.
+    */
     const std::vector<T>& getData() const;
     std::vector<T>& getData();
 
+    void pin() const;
+    void unpin() const;
+
     bool containsNaN() const;
     const std::string& getDimensionString() const;
 
@@ -135,6 +167,7 @@ public:
     void loadFromDeckKeyword( const Box&, const DeckKeyword& );
 
     void copyFrom( const GridProperty< T >&, const Box& );
+    void copyBox( const Box& source, const Box& target );
     void scale( T scaleFactor, const Box& );
     void maxvalue( T value, const Box& );
     void minvalue( T value, const Box& );
@@ -157,6 +190,7 @@ public:
       assembling the properties.
     */
     void runPostProcessor();
+    bool hasRunPostProcessor() const;
      /*
       Will scan through the roperty and return a vector of all the
       indices where the property value agrees with the input value.
@@ -188,9 +222,15 @@ private:
     const DeckItem& getDeckItem( const DeckKeyword& );
     void setDataPoint(size_t sourceIdx, size_t targetIdx, const DeckItem& deckItem);
 
+    void load() const;
+    void use() const;
+    static void spill( const void* owner, const std::string& directory );
+
     size_t m_nx, m_ny, m_nz;
     SupportedKeywordInfo m_kwInfo;
-    std::vector<T> m_data;
+    mutable std::vector<T> m_data;
+    mutable std::shared_ptr< const ScratchArray > m_scratch;
+    mutable std::atomic< bool > m_spilled{ false };
     bool m_hasRunPostProcessor = false;
 };
 
@@ -0,0 +1,145 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OPM_GRIDPROPERTY_STORAGE_HPP
+#define OPM_GRIDPROPERTY_STORAGE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      The ScratchArray is an immutable copy of a memory block in an
+      anonymous scratch file. The file is unlinked as soon as it has
+      been mapped, so it disappears with the last reference also if the
+      process is killed. Reading the data back only touches the page
+      cache, and the kernel is free to drop the pages under memory
+      pressure.
+    */
+
+    class ScratchArray {
+    public:
+        ScratchArray( const std::string& directory, const void* data, std::size_t size );
+        ~ScratchArray();
+
+        ScratchArray( const ScratchArray& ) = delete;
+        ScratchArray& operator=( const ScratchArray& ) = delete;
+
+        const void* data() const;
+        std::size_t size() const;
+
+    private:
+        void* m_addr = nullptr;
+        std::size_t m_size = 0;
+    };
+
+
+    /*
+      The GridPropertyStorage keeps track of the memory used by the
+      GridProperty arrays, and spills the least recently used arrays to
+      scratch files when the resident size exceeds a budget. A spilled
+      property is read back into memory on the next access; the whole
+      array is copied back from the scratch file, also when only a
+      single element is asked for with GridProperty::iget().
+
+      The storage is disabled by default; it is enabled by calling
+      configure() with a scratch directory and a non zero budget in
+      bytes. Spilling only happens in trim(). Eclipse3DProperties calls
+      trim() between deck keywords, restricted to its own properties,
+      so building one EclipseState never spills the properties of
+      another; otherwise trim() is only called by the host application.
+      A reference obtained from GridProperty::getData() is therefor
+      valid until the next call to trim() which covers the property;
+      properties which are used across such calls should be pinned
+      with GridProperty::pin().
+    */
+
+    class GridPropertyStorage {
+    public:
+        using SpillFunction = void (*)( const void* owner, const std::string& directory );
+
+        static GridPropertyStorage& instance();
+
+        /*
+          A budget of zero disables spilling; arrays which have already
+          been spilled are still read back on access.
+        */
+        void configure( const std::string& directory, std::size_t budget );
+        bool enabled() const;
+        const std::string& directory() const;
+        std::size_t budget() const;
+
+        std::size_t residentBytes() const;
+        std::size_t spilledBytes() const;
+
+        /*
+          Spill unpinned properties, least recently used first, until
+          the resident size is within the budget.
+        */
+        void trim();
+
+        /*
+          As trim(), but only the properties in owners are considered
+          for spilling.
+        */
+        void trim( const std::vector< const void* >& owners );
+
+        /*
+          The remaining methods are the interface used by GridProperty;
+          the owner argument is the address of the property.
+        */
+        void touch( const void* owner, std::size_t bytes, SpillFunction spill );
+        void restore( const void* owner, std::size_t bytes, SpillFunction spill,
+                      const std::function< void() >& reload );
+        void release( const void* owner );
+        void pin( const void* owner, std::size_t bytes, SpillFunction spill );
+        void unpin( const void* owner );
+
+    private:
+        struct Entry {
+            std::size_t bytes = 0;
+            std::uint64_t last_use = 0;
+            int pins = 0;
+            bool spilled = false;
+            SpillFunction spill = nullptr;
+        };
+
+        GridPropertyStorage() = default;
+        Entry& entry( const void* owner, std::size_t bytes, SpillFunction spill );
+        void spillUntilWithinBudget( const std::function< bool( const void* ) >& candidate );
+
+        std::atomic< bool > m_enabled{ false };
+        std::string m_directory;
+        std::size_t m_budget = 0;
+        std::uint64_t m_clock = 0;
+        std::map< const void*, Entry > m_entries;
+        mutable std::mutex m_mutex;
+    };
+}
+
+#endif
@@ -0,0 +1,126 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OPM_PARSER_LOCAL_GRID_HPP
+#define OPM_PARSER_LOCAL_GRID_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
+
+namespace Opm {
+
+    class EclipseGrid;
+
+    /*
+      The LocalGrid class represents one cartesian local grid
+      refinement, i.e. the grid defined by a CARFIN ... ENDFIN block
+      in the GRID section. The refinement replaces the host cells
+      I1..I2, J1..J2, K1..K2 of the parent grid with NX x NY x NZ
+      child cells; the refined cells are distributed as evenly as
+      possible over the host cells along each axis.
+
+      The geometry of the child grid is derived from the corners of
+      the host cells, and is available as a separate EclipseGrid
+      instance through the grid() method. Every child cell has
+      exactly one host cell, the mapping between child cells and host
+      cells is available in both directions.
+
+      Properties are inherited from the host cells, and can then be
+      modified with the keywords found in the CARFIN ... ENDFIN block
+      or in a later REFINE ... ENDFIN block for the same local grid.
+      The supported modifiers are full arrays, EQUALS, ADD, MULTIPLY
+      and BOX/ENDBOX; the box coordinates are local to the child grid.
+    */
+
+    class LocalGrid : public GridDims {
+    public:
+        LocalGrid(const DeckKeyword& carfin, const EclipseGrid& parent, std::size_t lgr_nr, std::size_t offset);
+
+        const std::string& name() const;
+        const std::string& parent() const;
+
+        /*
+          The number of the local grid, starting at 1; number zero is
+          reserved for the main grid. This is the numbering used in
+          the EGRID and INIT files.
+        */
+        std::size_t lgrNumber() const;
+
+        /*
+          The first index of this local grid in the hierarchical index
+          space of EclipseGrid, where the cells of the main grid come
+          first followed by the cells of the local grids in the order
+          they are defined.
+        */
+        std::size_t offset() const;
+        std::size_t getHierarchicalIndex(std::size_t i, std::size_t j, std::size_t k) const;
+
+        const Box& hostBox() const;
+        std::size_t getHostCell(std::size_t global_index) const;
+        const std::vector<int>& getHostCells() const;
+        std::vector<std::size_t> getChildCells(std::size_t host_index) const;
+        bool isHost(std::size_t host_index) const;
+
+        const EclipseGrid& grid() const;
+
+        /*
+          Update the active status of the child cells; a child cell is
+          active if and only if the host cell is active in the parent
+          grid.
+        */
+        void resetACTNUM(const EclipseGrid& parent);
+
+        void addKeyword(const DeckKeyword& keyword);
+        const std::vector<DeckKeyword>& getKeywords() const;
+
+        /*
+          Refine a property from the parent grid to the child grid by
+          copying the host value to all child cells, and then applying
+          the property modifiers registered for the local grid. The
+          si_scaling argument is the factor used to convert scalar
+          EQUALS and ADD values to SI units.
+        */
+        template <typename T>
+        std::vector<T> refine(const std::vector<T>& parent_values) const;
+
+        template <typename T>
+        std::vector<T> property(const std::string& keyword, const std::vector<T>& parent_values, double si_scaling = 1.0) const;
+
+        bool equal(const LocalGrid& other) const;
+
+    private:
+        std::string m_name;
+        std::string m_parent;
+        std::size_t m_lgrNumber;
+        std::size_t m_offset;
+        Box m_hostBox;
+        std::vector<int> m_hostCells;
+        std::vector<DeckKeyword> m_keywords;
+        std::shared_ptr<EclipseGrid> m_grid;
+    };
+}
+
+#endif
@@ -0,0 +1,134 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ACTION_PROGRAM_HPP_
+#define ACTION_PROGRAM_HPP_
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+class SummaryState;
+
+/*
+  The result of evaluating an ACTIONX condition. In addition to the
+  boolean value the result holds the sorted list of wells which
+  satisfied the condition, these are the wells which can later be
+  referred to with the '?' well name in the keywords of the action.
+*/
+
+struct ActionResult {
+    bool value = false;
+    std::vector<std::string> wells;
+
+    explicit operator bool() const {
+        return this->value;
+    }
+};
+
+
+/*
+  The ActionProgram class is the compiled form of the condition lines
+  of an ACTIONX keyword. The conditions are parsed once, when the
+  Schedule is created, to a postfix program which is then evaluated
+  against the current SummaryState at every report step; i.e. there is
+  no string processing involved when the conditions are evaluated.
+
+  The conditions can be combined with AND and OR, where AND binds
+  stronger than OR, and grouped with parentheses. Each condition is a
+  comparison of two operands with one of the operators:
+
+     >  <  >=  <=  =  !=  .GT.  .LT.  .GE.  .LE.  .EQ.  .NE.
+
+  An operand is either a number, a month name like JAN, one of the
+  date quantities DAY, MNTH and YEAR, a field or miscellaneous summary
+  quantity like FOPR, or a well or group quantity followed by an
+  optional well or group name, which can be a pattern like 'OP*'. A
+  well or group quantity without name applies to all wells/groups.
+
+  A comparison involving a well set is true if the comparison holds
+  for at least one of the wells, and the wells for which it holds are
+  recorded in the result. A summary quantity which has no value in the
+  SummaryState is treated like an empty well set, i.e. a comparison
+  involving it is false.
+*/
+
+class ActionProgram {
+public:
+    ActionProgram() = default;
+    explicit ActionProgram(const std::vector<std::string>& tokens);
+
+    ActionResult eval(std::time_t sim_time, const SummaryState& summary_state) const;
+    std::size_t size() const;
+    bool empty() const;
+
+    /*
+      The summary keys the condition refers to, on the form used by
+      SummaryConfig::hasSummaryKey(), e.g. 'FOPR' and 'WOPR:OP1'. A
+      well or group quantity given with a pattern, or without a name,
+      is listed with the keyword only.
+    */
+    std::vector<std::string> summaryKeys() const;
+
+    /*
+      Split the raw condition tokens from the deck into the tokens
+      used by the compiler: quotes are removed and comparison
+      operators and parentheses which have been glued to their
+      operands are split out.
+    */
+    static std::vector<std::string> tokenize(const std::vector<std::string>& input);
+
+private:
+    enum class OpCode {
+        NUMBER,
+        DAY,
+        MONTH,
+        YEAR,
+        SUMMARY,
+        WELL,
+        GROUP,
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL,
+        EQUAL,
+        NOT_EQUAL,
+        AND,
+        OR
+    };
+
+    struct Instruction {
+        OpCode op;
+        double number = 0;
+        std::string quantity;
+        std::string pattern;
+        bool wildcard = false;
+    };
+
+    class Compiler;
+
+    std::vector<Instruction> program;
+};
+
+}
+
+#endif
@@ -0,0 +1,81 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ACTIONX_HPP_
+#define ACTIONX_HPP_
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/ActionProgram.hpp>
+
+namespace Opm {
+
+class SummaryState;
+
+/*
+  The ActionX class represents one ACTIONX keyword from the Schedule
+  section; i.e. the compiled condition, the limits on how many times
+  and how often the action can run, and the block of keywords between
+  ACTIONX and ENDACTIO which should be applied to the Schedule when the
+  condition evaluates to true.
+
+  The action is only considered from the time it is defined in the
+  deck, and after it has triggered it will not be considered again
+  until min_wait seconds of simulation time have elapsed.
+*/
+
+class ActionX {
+public:
+    ActionX(const std::string& name, std::size_t max_run, double min_wait, std::time_t start_time);
+    ActionX(const DeckKeyword& kw, std::time_t start_time);
+
+    void addKeyword(const DeckKeyword& kw);
+    bool ready(std::time_t sim_time) const;
+    ActionResult eval(std::time_t sim_time, const SummaryState& summary_state) const;
+    void markRun(std::time_t sim_time);
+
+    const std::string& name() const;
+    std::size_t maxRun() const;
+    double minWait() const;
+    std::time_t startTime() const;
+    std::size_t runCount() const;
+    const ActionProgram& program() const;
+
+    std::vector<DeckKeyword>::const_iterator begin() const;
+    std::vector<DeckKeyword>::const_iterator end() const;
+    std::size_t size() const;
+
+private:
+    std::string m_name;
+    std::size_t m_max_run;
+    double m_min_wait;
+    std::time_t m_start_time;
+    ActionProgram m_program;
+    std::vector<DeckKeyword> keywords;
+
+    std::size_t run_count = 0;
+    std::time_t last_run = 0;
+};
+
+}
+#endif
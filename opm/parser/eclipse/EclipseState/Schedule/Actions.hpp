@@ -0,0 +1,65 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ACTIONS_HPP_
+#define ACTIONS_HPP_
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/ActionX.hpp>
+
+namespace Opm {
+
+/*
+  The Actions class is the container of all the ACTIONX keywords in
+  the Schedule section, in the order they appear in the deck. An
+  action can be redefined later in the deck by using the same name
+  again; the new definition will then replace the old one from the
+  time it is defined.
+*/
+
+class Actions {
+public:
+    Actions() = default;
+
+    void add(const ActionX& action);
+    std::size_t size() const;
+    bool empty() const;
+    bool has(const std::string& name) const;
+    const ActionX& get(const std::string& name) const;
+
+    /*
+      The actions which are active at time @sim_time, have not run
+      the maximum number of times and are not waiting for min_wait to
+      elapse.
+    */
+    std::vector<ActionX*> pending(std::time_t sim_time);
+
+    std::vector<ActionX>::const_iterator begin() const;
+    std::vector<ActionX>::const_iterator end() const;
+
+private:
+    std::vector<ActionX> actions;
+};
+
+}
+#endif
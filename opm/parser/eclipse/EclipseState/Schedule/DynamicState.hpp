@@ -22,6 +22,7 @@
 #define DYNAMICSTATE_HPP_
 
 #include <stdexcept>
+#include <utility>
 #include <vector>
 #include <algorithm>
 
@@ -49,6 +50,14 @@ namespace Opm {
        The update() method returns true if the updated value is
        different from the current value, this implies that the
        class<T> must support operator!=
+
+       Internally the values after the last updated timestep are not
+       stored explicitly, they are all equal to the value at the last
+       update. An update at a later timestep only has to fill in the
+       steps since the previous update, so a sequence of updates at
+       increasing timesteps costs time linear in the number of
+       timesteps, and not one pass to the end of the schedule for each
+       update.
     */
 
 
@@ -66,14 +75,19 @@ class DynamicState {
 
         void globalReset( T value ) {
             this->m_data.assign( this->m_data.size(), value );
+            this->last_update = 0;
         }
 
         const T& back() const {
-            return m_data.back();
+            return this->m_data[ this->last_update ];
         }
 
         const T& at( size_t index ) const {
-            return this->m_data.at( index );
+            const auto& value = this->m_data.at( index );
+            if( index > this->last_update )
+                return this->m_data[ this->last_update ];
+
+            return value;
         }
 
         const T& operator[](size_t index) const {
@@ -85,6 +99,7 @@ class DynamicState {
         }
 
         void updateInitial( T initial ) {
+            this->materialize();
             std::fill_n( this->m_data.begin(), this->initial_range, initial );
         }
 
@@ -96,13 +111,17 @@ class DynamicState {
             if( this->initial_range == this->m_data.size() )
                 this->initial_range = index;
 
-            const bool change = (value != this->m_data.at( index ));
+            const bool change = (value != this->at( index ));
 
             if( !change ) return false;
 
-            std::fill( this->m_data.begin() + index,
-                       this->m_data.end(),
-                       value );
+            if( index > this->last_update )
+                std::fill( this->m_data.begin() + this->last_update + 1,
+                           this->m_data.begin() + index,
+                           this->m_data[ this->last_update ] );
+
+            this->m_data[ index ] = std::move( value );
+            this->last_update = index;
 
             return true;
         }
@@ -111,14 +130,16 @@ class DynamicState {
             if (this->m_data.size() <= index)
                 throw std::out_of_range("Invalid index for update_elm()");
 
+            this->materialize();
             this->m_data[index] = value;
         }
 
         /// Will return the index of the first occurence of @value, or
         /// -1 if @value is not found.
         int find(const T& value) const {
-            auto iter = std::find( m_data.begin() , m_data.end() , value);
-            if( iter == this->m_data.end() ) return -1;
+            const auto end = this->m_data.begin() + this->last_update + 1;
+            auto iter = std::find( m_data.begin() , end , value);
+            if( iter == end ) return -1;
 
             return std::distance( m_data.begin() , iter );
         }
@@ -126,17 +147,32 @@ class DynamicState {
 
 
         iterator begin() {
+            this->materialize();
             return this->m_data.begin();
         }
 
 
         iterator end() {
+            this->materialize();
             return this->m_data.end();
         }
 
     private:
+        /*
+          Store the values after the last update explicitly; required
+          before the elements are modified individually.
+        */
+        void materialize() {
+            std::fill( this->m_data.begin() + this->last_update + 1,
+                       this->m_data.end(),
+                       this->m_data[ this->last_update ] );
+
+            this->last_update = this->m_data.size() - 1;
+        }
+
         std::vector< T > m_data;
         size_t initial_range;
+        size_t last_update = 0;
 };
 
 }
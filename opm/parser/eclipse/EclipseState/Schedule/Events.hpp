@@ -93,7 +93,20 @@ namespace Opm
 
             /* The VFP tables have changed */
             VFPINJ_UPDATE = 4096,
-            VFPPROD_UPDATE = 8192
+            VFPPROD_UPDATE = 8192,
+
+            /*
+              A new target productivity index has been entered with
+              the WELPI keyword; the connection factors of the well
+              should be rescaled with Schedule::applyWellPI().
+            */
+            WELL_PRODUCTIVITY_INDEX = 16384,
+
+            /*
+              The injected tracer concentrations have been updated
+              with the WTRACER keyword.
+            */
+            WELL_TRACER_UPDATE = 32768
         };
     }
 
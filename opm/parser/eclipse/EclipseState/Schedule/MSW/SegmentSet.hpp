@@ -47,6 +47,8 @@ namespace Opm {
 
         // mapping the segment number to the index in the vector of segments
         int segmentNumberToIndex(const int segment_number) const;
+        // the largest segment number in use, zero if there are no segments
+        int maxSegmentNumber() const;
 
         void addSegment(Segment new_segment);
 
@@ -63,6 +65,7 @@ namespace Opm {
         bool operator!=( const SegmentSet& ) const;
 
     private:
+        void setSegmentIndex(const int segment_number, const int index);
 
         // name of the well
         std::string m_well_name;
@@ -89,9 +92,11 @@ namespace Opm {
         // while they are not supported by the keyword at the moment.
 
         std::vector< Segment > m_segments;
-        // the mapping from the segment number to the
-        // storage index in the vector
-        std::map<int, int> m_segment_number_to_index;
+        // the mapping from the segment number to the storage index in
+        // the vector, dense in the segment number with -1 for the
+        // numbers which are not in use. It is rebuilt when the segments
+        // are ordered, i.e. every time the segment set changes.
+        std::vector<int> m_segment_number_to_index;
     };
 }
 
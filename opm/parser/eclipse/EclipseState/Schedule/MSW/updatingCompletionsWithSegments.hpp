@@ -26,7 +26,16 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/MSW/SegmentSet.hpp>
 
 namespace Opm {
+    class EclipseGrid;
+
     CompletionSet updatingCompletionsWithSegments(const DeckKeyword& compsegs, const CompletionSet& input_completions, const SegmentSet& segments);
+
+    /*
+      With the grid the COMPSEGS records can leave DISTANCE_END
+      defaulted, it is then derived from the cell size along the well.
+    */
+    CompletionSet updatingCompletionsWithSegments(const DeckKeyword& compsegs, const CompletionSet& input_completions,
+                                                  const SegmentSet& segments, const EclipseGrid& grid);
 }
 
 #endif
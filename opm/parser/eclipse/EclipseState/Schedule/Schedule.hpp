@@ -19,11 +19,13 @@
 #ifndef SCHEDULE_HPP
 #define SCHEDULE_HPP
 
+#include <cstdint>
 #include <map>
 #include <memory>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 
+#include <opm/parser/eclipse/EclipseState/Schedule/Actions.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/DynamicState.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/DynamicVector.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Events.hpp>
@@ -40,6 +42,8 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellTestConfig.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WListManager.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
 namespace Opm
 {
@@ -50,8 +54,8 @@ namespace Opm
     class EclipseGrid;
     class Eclipse3DProperties;
     class SCHEDULESection;
+    class SummaryState;
     class TimeMap;
-    class UnitSystem;
     class EclipseState;
 
     class Schedule {
@@ -96,10 +100,17 @@ namespace Opm
           't'.
         */
         std::vector< const Well* > getWells(const std::string& group, size_t timeStep) const;
+
+        /*
+          The argument can be a well name, a well name template like
+          'OP*' or a well list like '*PROD'; a well list matches all
+          the wells which have been on the list at some time.
+        */
         std::vector< const Well* > getWellsMatching( const std::string& ) const;
         const OilVaporizationProperties& getOilVaporizationProperties(size_t timestep) const;
 
         const WellTestConfig& wtestConfig(size_t timestep) const;
+        const WListManager& getWListManager(size_t timeStep) const;
 
         const GroupTree& getGroupTree(size_t t) const;
         size_t numGroups() const;
@@ -123,6 +134,41 @@ namespace Opm
         */
         void filterCompletions(const EclipseGrid& grid);
 
+        const Actions& actions() const;
+
+        /*
+          Will evaluate the conditions of all the pending ACTIONX
+          keywords against the current summary state, and apply the
+          keywords of the actions which trigger to the schedule from
+          report step @reportStep and onwards. In the keywords of a
+          triggered action the well name '?' refers to the wells which
+          satisfied the condition. The names of the actions which
+          triggered are returned.
+        */
+        std::vector<std::string> applyActions(size_t reportStep,
+                                              std::time_t sim_time,
+                                              const SummaryState& summary_state,
+                                              const ParseContext& parseContext = ParseContext());
+
+        /*
+          Will rescale the connection factors of the wells which have
+          a WELPI target entered at report step @reportStep. The
+          well_pi argument holds the productivity index, in SI units,
+          which the simulator computes for the wells with the current
+          connection factors. The ratio between the target and the
+          current productivity index is recorded as a scaling factor
+          on the well, see Well::getConnectionMultipliers(). The names
+          of the rescaled wells are returned.
+        */
+        std::vector<std::string> applyWellPI(size_t reportStep, const std::map<std::string, double>& well_pi);
+
+        /*
+          Content digest of the input used to create the schedule; the
+          digest is updated when filterCompletions() is called with a
+          grid, and when actions or WELPI scaling are applied.
+        */
+        std::uint64_t hash() const;
+
     private:
         TimeMap m_timeMap;
         OrderedMap< Well > m_wells;
@@ -137,10 +183,17 @@ namespace Opm
         std::map<int, DynamicState<std::shared_ptr<VFPProdTable>>> vfpprod_tables;
         std::map<int, DynamicState<std::shared_ptr<VFPInjTable>>> vfpinj_tables;
         DynamicState<std::shared_ptr<WellTestConfig>> wtest_config;
+        DynamicState<std::shared_ptr<WListManager>> wlist_manager;
+        Actions m_actions;
+        UnitSystem m_unit_system;
+        std::vector<std::string> m_action_wells;
+        std::vector<std::string> m_tracer_names;
 
         WellProducer::ControlModeEnum m_controlModeWHISTCTL;
+        std::uint64_t m_hash;
 
-        std::vector< Well* > getWells(const std::string& wellNamePattern);
+        std::vector< size_t > matchingWellIndices(const std::string& wellNamePattern, size_t timeStep) const;
+        std::vector< Well* > matchingWells(const std::string& wellNamePattern, size_t timeStep);
         std::vector< Group* > getGroups(const std::string& groupNamePattern);
 
         void updateWellStatus( Well& well, size_t reportStep , WellCommon::StatusEnum status);
@@ -159,16 +212,17 @@ namespace Opm
         void handleCOMPDAT( const DeckKeyword& keyword,  size_t currentStep, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties, const ParseContext& parseContext);
         void handleCOMPLUMP( const DeckKeyword& keyword,  size_t currentStep );
         void handleWELSEGS( const DeckKeyword& keyword, size_t currentStep);
-        void handleCOMPSEGS( const DeckKeyword& keyword, size_t currentStep);
-        void handleWCONINJE( const SCHEDULESection&,  const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
+        void handleCOMPSEGS( const DeckKeyword& keyword, size_t currentStep, const EclipseGrid& grid);
+        void handleWCONINJE( const UnitSystem& unit_system, const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void handleWPOLYMER( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
+        void handleWTRACER( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void handleWSOLVENT( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void handleWTEMP( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void handleWINJTEMP( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
-        void handleWCONINJH( const SCHEDULESection&,  const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
+        void handleWCONINJH( const UnitSystem& unit_system, const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void handleWELOPEN( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext );
-        void handleWELTARG( const SCHEDULESection&,  const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
-        void handleGCONINJE( const SCHEDULESection&,  const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
+        void handleWELTARG( const UnitSystem& unit_system, const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
+        void handleGCONINJE( const UnitSystem& unit_system, const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void handleGCONPROD( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void handleGEFAC( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void handleWEFAC( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
@@ -177,8 +231,10 @@ namespace Opm
         void handleGRUPNET( const DeckKeyword& keyword, size_t currentStep);
         void handleWRFT( const DeckKeyword& keyword, size_t currentStep);
         void handleWTEST( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
+        void handleWLIST( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void handleWRFTPLT( const DeckKeyword& keyword, size_t currentStep);
         void handleWPIMULT( const DeckKeyword& keyword, size_t currentStep);
+        void handleWELPI( const UnitSystem& unit_system, const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void handleDRSDT( const DeckKeyword& keyword, size_t currentStep);
         void handleDRVDT( const DeckKeyword& keyword, size_t currentStep);
         void handleVAPPARS( const DeckKeyword& keyword, size_t currentStep);
@@ -187,6 +243,8 @@ namespace Opm
         void handleMESSAGES(const DeckKeyword& keyword, size_t currentStep);
         void handleVFPPROD(const DeckKeyword& vfpprodKeyword, const UnitSystem& unit_system, size_t currentStep);
         void handleVFPINJ(const DeckKeyword& vfpprodKeyword, const UnitSystem& unit_system, size_t currentStep);
+        size_t handleACTIONX(const SCHEDULESection& section, size_t keywordIdx, size_t currentStep, const ParseContext& parseContext);
+        void handleActionKeyword(const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext);
         void checkUnhandledKeywords( const SCHEDULESection& ) const;
         void checkIfAllConnectionsIsShut(size_t currentStep);
 
@@ -0,0 +1,68 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SUMMARY_STATE_HPP_
+#define SUMMARY_STATE_HPP_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Opm {
+
+/*
+  The SummaryState class is a small container for the current value of
+  summary quantities; it is filled by the summary output code at the
+  end of every report step and is used as input when the ACTIONX
+  conditions are evaluated.
+
+  Field and miscellaneous quantities are stored by their summary key,
+  e.g. "FOPR" or "TIME", whereas well and group quantities are stored
+  by variable and then by well/group name, so that all wells with a
+  value for e.g. "WWCT" can be iterated over in one go.
+*/
+
+class SummaryState {
+public:
+    void update(const std::string& key, double value);
+    void update_well_var(const std::string& well, const std::string& var, double value);
+    void update_group_var(const std::string& group, const std::string& var, double value);
+
+    bool has(const std::string& key) const;
+    double get(const std::string& key) const;
+
+    bool has_well_var(const std::string& well, const std::string& var) const;
+    double get_well_var(const std::string& well, const std::string& var) const;
+    const std::map<std::string, double>& well_values(const std::string& var) const;
+
+    bool has_group_var(const std::string& group, const std::string& var) const;
+    double get_group_var(const std::string& group, const std::string& var) const;
+    const std::map<std::string, double>& group_values(const std::string& var) const;
+
+    std::size_t size() const;
+private:
+    std::unordered_map<std::string, double> values;
+    std::unordered_map<std::string, std::map<std::string, double>> well_vars;
+    std::unordered_map<std::string, std::map<std::string, double>> group_vars;
+};
+
+}
+#endif
@@ -0,0 +1,56 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef WLIST_HPP_
+#define WLIST_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+/*
+  A well list is represented as a bitset over the well index, i.e. the
+  order in which the wells have been defined in the Schedule. Adding or
+  removing all the wells of another list is then a bitwise operation,
+  and the wells of the list come out in the same order as wells found
+  by pattern matching.
+*/
+
+class WList {
+public:
+    void add(std::size_t well_index);
+    void add(const WList& other);
+    void del(std::size_t well_index);
+    void del(const WList& other);
+    void clear();
+
+    bool has(std::size_t well_index) const;
+    std::size_t size() const;
+    bool empty() const;
+    std::vector<std::size_t> wells() const;
+
+private:
+    std::vector<bool> members;
+};
+
+}
+
+#endif
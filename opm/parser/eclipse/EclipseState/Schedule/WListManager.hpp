@@ -0,0 +1,62 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef WLISTMANAGER_HPP_
+#define WLISTMANAGER_HPP_
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/WList.hpp>
+
+namespace Opm {
+
+/*
+  The WListManager holds all the well lists defined with the WLIST
+  keyword at one point in time. The Schedule keeps one WListManager
+  per report step, shared between report steps until the next WLIST
+  keyword. The names of well lists start with '*', e.g. '*PROD'.
+*/
+
+class WListManager {
+public:
+    bool hasList(const std::string& name) const;
+    WList& newList(const std::string& name);
+    WList& getList(const std::string& name);
+    const WList& getList(const std::string& name) const;
+
+    /*
+      Remove the wells in @wells from all the lists; this is used to
+      implement the MOV operation.
+    */
+    void delWells(const WList& wells);
+
+    std::size_t size() const;
+
+    static bool isListName(const std::string& name);
+
+private:
+    std::map<std::string, WList> wlists;
+};
+
+}
+
+#endif
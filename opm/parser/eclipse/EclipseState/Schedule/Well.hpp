@@ -33,6 +33,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/WellInjectionProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellPolymerProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellProductionProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellTracerProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/MSW/SegmentSet.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
 
@@ -87,6 +88,28 @@ namespace Opm {
         void setEfficiencyFactor (size_t timestep, double efficiencyFactor);
         double getEfficiencyFactor (size_t timestep) const;
 
+        /*
+          The target productivity index from the WELPI keyword, in SI
+          units, and the scaling factor applied to the transmissibility
+          factors of the open connections to reach it. A target of
+          zero means that WELPI has not been entered for the well. The
+          scaling factor is updated by Schedule::applyWellPI().
+        */
+        void setProductivityIndex(size_t timeStep, double productivityIndex);
+        double getProductivityIndex(size_t timeStep) const;
+        void setPIScalingFactor(size_t timeStep, double scalingFactor);
+        double getPIScalingFactor(size_t timeStep) const;
+
+        /*
+          The multipliers for the connection transmissibility factors
+          at the given report step, in completion order: the WPIMULT
+          multiplier of each connection, and for the open connections
+          also the WELPI scaling factor. The multipliers apply equally
+          to connection factors from the deck and to those computed
+          by the simulator.
+        */
+        std::vector<double> getConnectionMultipliers(size_t timeStep) const;
+
         void switchToInjector( size_t timeStep);
         void switchToProducer( size_t timeStep);
 
@@ -125,6 +148,9 @@ namespace Opm {
         WellPolymerProperties          getPolymerPropertiesCopy(size_t timeStep) const;
         const WellPolymerProperties&   getPolymerProperties(size_t timeStep) const;
 
+        bool                           setTracerProperties(size_t timeStep , const WellTracerProperties& properties);
+        const WellTracerProperties&    getTracerProperties(size_t timeStep) const;
+
         bool                           setSolventFraction(size_t timeStep , const double fraction);
         const double&                  getSolventFraction(size_t timeStep) const;
 
@@ -180,12 +206,15 @@ namespace Opm {
         DynamicState< GuideRate::GuideRatePhaseEnum > m_guideRatePhase;
         DynamicState< double > m_guideRateScalingFactor;
         DynamicState< double > m_efficiencyFactors;
+        DynamicState< double > m_productivityIndex;
+        DynamicState< double > m_piScalingFactor;
 
         DynamicState< int > m_isProducer;
         DynamicState< CompletionSet > m_completions;
         DynamicState< WellProductionProperties > m_productionProperties;
         DynamicState< WellInjectionProperties > m_injectionProperties;
         DynamicState< WellPolymerProperties > m_polymerProperties;
+        DynamicState< WellTracerProperties > m_tracerProperties;
         DynamicState< WellEconProductionLimits > m_econproductionlimits;
         DynamicState< double > m_solventFraction;
         DynamicState< std::string > m_groupName;
@@ -0,0 +1,48 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef WELLTRACERPROPERTIES_HPP_HEADER_INCLUDED
+#define WELLTRACERPROPERTIES_HPP_HEADER_INCLUDED
+
+#include <map>
+#include <string>
+
+namespace Opm {
+
+    /*
+      The injection concentration of each tracer, as given with the
+      WTRACER keyword. Tracers which have not been assigned a
+      concentration are injected with concentration zero.
+    */
+    class WellTracerProperties {
+    public:
+        void setConcentration(const std::string& tracer, double concentration);
+        double getConcentration(const std::string& tracer) const;
+        const std::map<std::string, double>& concentrations() const;
+
+        bool operator==(const WellTracerProperties& other) const;
+        bool operator!=(const WellTracerProperties& other) const;
+
+    private:
+        std::map<std::string, double> m_tracerConcentrations;
+    };
+}
+
+#endif
@@ -38,6 +38,7 @@ namespace Opm {
         bool acceptsDefault( ) const;
         bool isIncreasing( ) const;
         bool isDecreasing( ) const;
+        Table::ColumnOrderEnum getOrder( ) const;
         Table::DefaultAction getDefaultMode( ) const;
         double getDefaultValue( ) const;
     private:
@@ -37,6 +37,15 @@ namespace Opm {
         void assertOrder(double value1 , double value2) const;
         void addValue(double);
         void addDefault();
+
+        /*
+          Append a complete set of values to the column; the elements
+          where defaulted[i] is true are treated as if addDefault()
+          had been called. The ordering of the column is validated in
+          one pass over the values after they have been added, instead
+          of checking row by row.
+        */
+        void addValues(const std::vector<double>& values, const std::vector<bool>& defaulted);
         void updateValue(size_t index, double value);
         double operator[](size_t index) const;
         bool defaultApplied(size_t index) const;
@@ -64,6 +73,7 @@ namespace Opm {
         void assertUpdate(size_t index, double value) const;
         void assertPrevious(size_t index , double value) const;
         void assertNext(size_t index , double value) const;
+        void assertOrder(size_t first) const;
 
         ColumnSchema m_schema;
         std::string m_name;
@@ -21,6 +21,9 @@
 #ifndef OPM_TABLE_MANAGER_HPP
 #define OPM_TABLE_MANAGER_HPP
 
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <set>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
@@ -135,12 +138,21 @@ namespace Opm {
         bool useJFunc() const;
 
         double rtemp() const;
+
+        /*
+          Content digest of the deck keywords the tables have been
+          initialized from, i.e. the RUNSPEC, PROPS and SOLUTION
+          sections. Two TableManager instances with equal digest have
+          been created from identical input.
+        */
+        std::uint64_t hash() const;
     private:
         TableContainer& forceGetTables( const std::string& tableName , size_t numTables);
 
         void complainAboutAmbiguousKeyword(const Deck& deck, const std::string& keywordName);
 
         void addTables( const std::string& tableName , size_t numTables);
+        void runTableTasks();
         void initSimpleTables(const Deck& deck);
         void initRTempTables(const Deck& deck);
         void initDims(const Deck& deck);
@@ -173,11 +185,14 @@ namespace Opm {
             }
 
             const auto& tableKeyword = deck.getKeyword(keywordName);
+            const bool jfunc = useJFunc();
             for (size_t tableIdx = 0; tableIdx < tableKeyword.size(); ++tableIdx) {
                 const auto& dataItem = tableKeyword.getRecord( tableIdx ).getItem( 0 );
                 if (dataItem.size() > 0) {
-                    std::shared_ptr<TableType> table = std::make_shared<TableType>( dataItem, useJFunc() );
-                    container.addTable( tableIdx , table );
+                    auto table = std::make_shared< std::shared_ptr< TableType > >();
+                    m_tableTasks.push_back( {
+                        [table, &dataItem, jfunc]() { *table = std::make_shared<TableType>( dataItem, jfunc ); },
+                        [table, &container, tableIdx]() { container.addTable( tableIdx , *table ); } } );
                 }
             }
         }
@@ -203,8 +218,10 @@ namespace Opm {
             for (size_t tableIdx = 0; tableIdx < tableKeyword.size(); ++tableIdx) {
                 const auto& dataItem = tableKeyword.getRecord( tableIdx ).getItem( 0 );
                 if (dataItem.size() > 0) {
-                    std::shared_ptr<TableType> table = std::make_shared<TableType>( dataItem );
-                    container.addTable( tableIdx , table );
+                    auto table = std::make_shared< std::shared_ptr< TableType > >();
+                    m_tableTasks.push_back( {
+                        [table, &dataItem]() { *table = std::make_shared<TableType>( dataItem ); },
+                        [table, &container, tableIdx]() { container.addTable( tableIdx , *table ); } } );
                 }
             }
         }
@@ -273,11 +290,35 @@ namespace Opm {
 
             const auto& tableKeyword = deck.getKeyword(keywordName);
 
-            int numTables = TableType::numTables( tableKeyword );
-            for (int tableIdx = 0; tableIdx < numTables; ++tableIdx)
-                tableVector.emplace_back( tableKeyword , tableIdx );
+            auto tables = std::make_shared< std::vector< TableType > >();
+            m_tableTasks.push_back( {
+                [tables, &tableKeyword]() {
+                    int numTables = TableType::numTables( tableKeyword );
+                    for (int tableIdx = 0; tableIdx < numTables; ++tableIdx)
+                        tables->emplace_back( tableKeyword , tableIdx );
+                },
+                [tables, &tableVector]() {
+                    for (auto& table : *tables)
+                        tableVector.push_back( std::move( table ) );
+                } } );
         }
 
+        /*
+          The table families are independent of each other, and the
+          tables are therefor not created directly when the deck is
+          scanned; instead a task is registered, and all the tasks are
+          run in parallel by runTableTasks(). The build() part of the
+          tasks runs in parallel, the commit() part which stores the
+          tables in the TableManager is run serially in the order the
+          tasks were registered, so the result is deterministic.
+        */
+        struct TableTask {
+            std::function< void() > build;
+            std::function< void() > commit;
+        };
+
+        std::vector< TableTask > m_tableTasks;
+
         std::map<std::string , TableContainer> m_simpleTables;
         std::vector<PvtgTable> m_pvtgTables;
         std::vector<PvtoTable> m_pvtoTables;
@@ -301,6 +342,8 @@ namespace Opm {
         const JFunc m_jfunc;
 
         double m_rtemp;
+
+        std::uint64_t m_inputHash;
     };
 }
 
@@ -0,0 +1,80 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OPM_TRACER_CONFIG_HPP
+#define OPM_TRACER_CONFIG_HPP
+
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Runspec.hpp>
+
+namespace Opm {
+
+    class Deck;
+    class Eclipse3DProperties;
+    class EclipseGrid;
+
+    /*
+      The TracerConfig class holds the tracers declared with the TRACER
+      keyword in the PROPS section. For every tracer the initial free
+      concentration is assembled from the SOLUTION section, either as a
+      full grid array from TBLKF<name> or by depth interpolation in the
+      TVDPF<name> tables, using the EQLNUM region of the cell to select
+      the table. The concentrations are in the tracer units given in the
+      TRACER keyword and are not converted.
+
+      The tracers are numbered in the order they are declared; this
+      index is used when the simulator passes the tracer rates of the
+      wells to the output layer.
+    */
+
+    class TracerConfig {
+    public:
+        struct TracerEntry {
+            std::string name;
+            std::string unit_string;
+            Phase phase;
+            std::vector<double> concentration;
+
+            /// Name of the concentration array in the restart file.
+            std::string restartKey() const;
+        };
+
+        TracerConfig() = default;
+        TracerConfig(const Deck& deck, const EclipseGrid& grid, const Eclipse3DProperties& props);
+
+        size_t size() const;
+        bool empty() const;
+        bool has(const std::string& name) const;
+        size_t index(const std::string& name) const;
+
+        const TracerEntry& operator[](const std::string& name) const;
+        const TracerEntry& operator[](size_t index) const;
+
+        std::vector<TracerEntry>::const_iterator begin() const;
+        std::vector<TracerEntry>::const_iterator end() const;
+
+    private:
+        std::vector<TracerEntry> tracers;
+    };
+}
+
+#endif
@@ -130,6 +130,15 @@ public:
     }
 
 
+    size_t index(const std::string& key) const {
+        auto iter = m_map.find( key );
+        if (iter == m_map.end())
+            throw std::invalid_argument("Key not found:" + key);
+
+        return iter->second;
+    }
+
+
     typename std::vector<T>::const_iterator begin() const {
         return m_vector.begin();
     }
@@ -250,6 +250,25 @@ namespace Opm {
         */
         const static std::string SCHEDULE_INVALID_NAME;
 
+        /*
+          Only a subset of the Schedule keywords can be used in the
+          keyword block of an ACTIONX keyword; i.e. between ACTIONX
+          and ENDACTIO. If another keyword is found in the block the
+          behavior is regulated by this setting; if the error is
+          ignored the keyword is dropped from the action.
+        */
+        const static std::string ACTIONX_ILLEGAL_KEYWORD;
+
+        /*
+          The conditions of an ACTIONX keyword are evaluated against
+          the summary results, so every quantity the conditions refer
+          to must be configured in the SUMMARY section. This setting
+          regulates what happens when the SummaryConfig is created and
+          a quantity is missing; if the error is ignored a comparison
+          involving the missing quantity will evaluate to false.
+        */
+        const static std::string ACTIONX_UNKNOWN_SUMMARY_KEY;
+
     private:
         void initDefault();
         void initEnv();
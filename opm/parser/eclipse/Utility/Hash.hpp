@@ -0,0 +1,81 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPM_UTILITY_HASH_HPP
+#define OPM_UTILITY_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      The ContentHash class is a streaming implementation of the 64 bit
+      xxHash algorithm. It is used to compute stable content digests of
+      the parsed input, i.e. DeckKeyword, Section and the EclipseState
+      components derived from them. The digest only depends on the bytes
+      which have been fed to the hasher, so the same input will give the
+      same digest across runs and processes.
+
+      The digest is not cryptographically secure; it is intended as a
+      fast key for caches and for detecting unchanged input.
+    */
+
+    class ContentHash {
+    public:
+        explicit ContentHash( std::uint64_t seed = 0 );
+
+        ContentHash& update( const void* data, std::size_t size );
+        ContentHash& update( int value );
+        ContentHash& update( std::uint64_t value );
+        ContentHash& update( double value );
+        ContentHash& update( const std::string& value );
+
+        template< typename T >
+        ContentHash& update( const std::vector< T >& data ) {
+            this->update( static_cast< std::uint64_t >( data.size() ) );
+            for( const auto& value : data )
+                this->update( value );
+
+            return *this;
+        }
+
+        ContentHash& update( const std::vector< int >& data );
+        ContentHash& update( const std::vector< double >& data );
+
+        std::uint64_t digest() const;
+
+        /*
+          Combine two digests to one, order matters: combine(a,b) !=
+          combine(b,a).
+        */
+        static std::uint64_t combine( std::uint64_t first, std::uint64_t second );
+
+    private:
+        std::uint64_t seed;
+        std::uint64_t acc[4];
+        unsigned char buffer[32];
+        std::size_t buffer_size = 0;
+        std::uint64_t total_size = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,264 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <system_error>
+#include <thread>
+
+#include <opm/common/utility/Executor.hpp>
+
+namespace Opm {
+
+namespace {
+
+    thread_local bool in_worker = false;
+
+    struct WorkerScope {
+        WorkerScope() : previous( in_worker ) { in_worker = true; }
+        ~WorkerScope() { in_worker = this->previous; }
+
+        bool previous;
+    };
+
+    struct ChunkRange {
+        std::atomic< std::size_t > next;
+        std::size_t end;
+    };
+
+    std::size_t hardwareConcurrency() {
+        return std::max< std::size_t >( 1, std::thread::hardware_concurrency() );
+    }
+
+}
+
+
+    /*
+      The threads are started when they are first needed and then wait
+      for the next parallel call. Only one parallel call can use the
+      pool at a time; a concurrent call from another thread which finds
+      the pool busy is run serially instead of waiting for it.
+    */
+    class Executor::ThreadPool {
+    public:
+        ~ThreadPool();
+        bool tryRun( std::size_t num_workers, const Worker& worker );
+
+    private:
+        void threadMain();
+
+        std::mutex m_run_lock;
+        std::mutex m_lock;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        std::vector< std::thread > m_threads;
+
+        const Worker* m_worker = nullptr;
+        std::size_t m_num_workers = 0;
+        std::size_t m_next_worker = 0;
+        std::size_t m_running = 0;
+        std::size_t m_generation = 0;
+        bool m_stop = false;
+    };
+
+
+    Executor::ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard< std::mutex > guard( this->m_lock );
+            this->m_stop = true;
+        }
+        this->m_wake.notify_all();
+
+        for (auto& thread : this->m_threads)
+            thread.join();
+    }
+
+
+    bool Executor::ThreadPool::tryRun( std::size_t num_workers, const Worker& worker ) {
+        std::unique_lock< std::mutex > run_guard( this->m_run_lock, std::try_to_lock );
+        if (!run_guard.owns_lock())
+            return false;
+
+        {
+            std::lock_guard< std::mutex > guard( this->m_lock );
+            while (this->m_threads.size() + 1 < num_workers) {
+                try {
+                    this->m_threads.emplace_back( [this]() { this->threadMain(); } );
+                } catch (const std::system_error&) {
+                    break;
+                }
+            }
+
+            this->m_worker = &worker;
+            this->m_num_workers = std::min( num_workers, this->m_threads.size() + 1 );
+            this->m_next_worker = 1;
+            this->m_running = this->m_num_workers - 1;
+            this->m_generation++;
+        }
+        this->m_wake.notify_all();
+
+        worker( 0 );
+
+        std::unique_lock< std::mutex > guard( this->m_lock );
+        this->m_done.wait( guard, [this]() { return this->m_running == 0; } );
+        this->m_worker = nullptr;
+        return true;
+    }
+
+
+    void Executor::ThreadPool::threadMain() {
+        std::size_t generation = 0;
+        std::unique_lock< std::mutex > guard( this->m_lock );
+
+        while (true) {
+            this->m_wake.wait( guard, [this, &generation]() {
+                return this->m_stop || this->m_generation != generation;
+            });
+
+            if (this->m_stop)
+                return;
+
+            generation = this->m_generation;
+            if (this->m_next_worker >= this->m_num_workers)
+                continue;
+
+            const auto worker_index = this->m_next_worker++;
+            const Worker& worker = *this->m_worker;
+            guard.unlock();
+            worker( worker_index );
+            guard.lock();
+
+            if (--this->m_running == 0)
+                this->m_done.notify_one();
+        }
+    }
+
+
+
+    Executor& Executor::instance() {
+        static Executor executor;
+        return executor;
+    }
+
+
+    Executor::Executor() :
+        m_concurrency( hardwareConcurrency() ),
+        m_pool( new ThreadPool() )
+    {}
+
+
+    Executor::~Executor() = default;
+
+
+    void Executor::setConcurrency( std::size_t max_workers ) {
+        std::lock_guard< std::mutex > guard( this->m_config_lock );
+        this->m_concurrency = max_workers == 0 ? hardwareConcurrency() : max_workers;
+    }
+
+
+    std::size_t Executor::concurrency() const {
+        std::lock_guard< std::mutex > guard( this->m_config_lock );
+        return this->m_concurrency;
+    }
+
+
+    void Executor::setHostHook( HostHook hook ) {
+        std::lock_guard< std::mutex > guard( this->m_config_lock );
+        this->m_host_hook = std::move( hook );
+    }
+
+
+    void Executor::runChunks( std::size_t num_chunks, const std::function< void( std::size_t ) >& body ) {
+        std::size_t num_workers;
+        HostHook host_hook;
+        {
+            std::lock_guard< std::mutex > guard( this->m_config_lock );
+            num_workers = std::min( this->m_concurrency, num_chunks );
+            host_hook = this->m_host_hook;
+        }
+
+        if (num_workers <= 1 || in_worker) {
+            for (std::size_t chunk = 0; chunk < num_chunks; chunk++)
+                body( chunk );
+
+            return;
+        }
+
+        std::vector< std::exception_ptr > errors( num_chunks );
+        std::unique_ptr< ChunkRange[] > ranges( new ChunkRange[num_workers] );
+        for (std::size_t worker_index = 0; worker_index < num_workers; worker_index++) {
+            ranges[worker_index].next = worker_index * num_chunks / num_workers;
+            ranges[worker_index].end = (worker_index + 1) * num_chunks / num_workers;
+        }
+
+        /*
+          Each worker first drains its own range and then steals from
+          the ranges of the following workers; a worker which is never
+          started will have its range taken over by the others.
+        */
+        const Worker worker = [&]( std::size_t worker_index ) {
+            WorkerScope scope;
+            for (std::size_t offset = 0; offset < num_workers; offset++) {
+                auto& range = ranges[(worker_index + offset) % num_workers];
+                for (auto chunk = range.next++; chunk < range.end; chunk = range.next++) {
+                    try {
+                        body( chunk );
+                    } catch (...) {
+                        errors[chunk] = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        if (host_hook)
+            host_hook( num_workers, worker );
+        else if (!this->m_pool->tryRun( num_workers, worker ))
+            worker( 0 );
+
+        for (const auto& error : errors)
+            if (error)
+                std::rethrow_exception( error );
+    }
+
+
+
+    TaskGroup::TaskGroup( Executor& executor ) :
+        m_executor( executor )
+    {}
+
+
+    void TaskGroup::run( std::function< void() > task ) {
+        this->m_tasks.push_back( std::move( task ) );
+    }
+
+
+    std::size_t TaskGroup::size() const {
+        return this->m_tasks.size();
+    }
+
+
+    void TaskGroup::wait() {
+        auto tasks = std::move( this->m_tasks );
+        this->m_tasks.clear();
+
+        this->m_executor.runChunks( tasks.size(), [&tasks]( std::size_t index ) { tasks[index](); } );
+    }
+}
@@ -0,0 +1,151 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <opm/common/utility/Executor.hpp>
+#include <opm/common/utility/LargeArray.hpp>
+
+namespace Opm {
+
+namespace {
+
+    const std::size_t huge_page_size = 2 << 20;
+    const std::size_t small_page_size = 4096;
+
+    std::mutex hook_lock;
+    LargeArrayAllocateHook allocate_hook;
+    LargeArrayDeallocateHook deallocate_hook;
+
+    std::size_t mappedSize( std::size_t bytes ) {
+        return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+    }
+
+    /*
+      Writes one byte per page, one huge page per chunk; the kernel
+      places each page on the NUMA node of the thread touching it.
+    */
+    void firstTouch( void* ptr, std::size_t bytes ) {
+        char* data = static_cast< char* >( ptr );
+        Executor::instance().parallelFor( 0, bytes / huge_page_size, [data]( std::size_t chunk ) {
+            char* first = data + chunk * huge_page_size;
+            for (std::size_t offset = 0; offset < huge_page_size; offset += small_page_size)
+                first[offset] = 0;
+        });
+    }
+
+#ifdef __linux__
+
+    /*
+      The mapping is over allocated by one huge page and trimmed so the
+      array starts on a huge page boundary.
+    */
+    void* defaultAllocate( std::size_t bytes ) {
+        const std::size_t size = mappedSize( bytes );
+        void* mapping = ::mmap( nullptr, size + huge_page_size, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        if (mapping == MAP_FAILED)
+            throw std::bad_alloc();
+
+        char* base = static_cast< char* >( mapping );
+        const std::size_t misalignment = reinterpret_cast< std::uintptr_t >( base ) % huge_page_size;
+        const std::size_t head = misalignment ? huge_page_size - misalignment : 0;
+        if (head > 0)
+            ::munmap( base, head );
+        ::munmap( base + head + size, huge_page_size - head );
+
+        char* data = base + head;
+#ifdef MADV_HUGEPAGE
+        ::madvise( data, size, MADV_HUGEPAGE );
+#endif
+        firstTouch( data, size );
+        return data;
+    }
+
+    void defaultDeallocate( void* ptr, std::size_t bytes ) {
+        ::munmap( ptr, mappedSize( bytes ) );
+    }
+
+#else
+
+    void* defaultAllocate( std::size_t bytes ) {
+        const std::size_t size = mappedSize( bytes );
+        void* data = ::operator new( size );
+        firstTouch( data, size );
+        return data;
+    }
+
+    void defaultDeallocate( void* ptr, std::size_t ) {
+        ::operator delete( ptr );
+    }
+
+#endif
+
+}
+
+
+    void* largeArrayAllocate( std::size_t bytes ) {
+        if (bytes < largeArrayThreshold)
+            return ::operator new( bytes );
+
+        LargeArrayAllocateHook hook;
+        {
+            std::lock_guard< std::mutex > guard( hook_lock );
+            hook = allocate_hook;
+        }
+
+        return hook ? hook( bytes ) : defaultAllocate( bytes );
+    }
+
+
+    void largeArrayDeallocate( void* ptr, std::size_t bytes ) {
+        if (!ptr)
+            return;
+
+        if (bytes < largeArrayThreshold) {
+            ::operator delete( ptr );
+            return;
+        }
+
+        LargeArrayDeallocateHook hook;
+        {
+            std::lock_guard< std::mutex > guard( hook_lock );
+            hook = deallocate_hook;
+        }
+
+        if (hook)
+            hook( ptr, bytes );
+        else
+            defaultDeallocate( ptr, bytes );
+    }
+
+
+    void setLargeArrayHooks( LargeArrayAllocateHook allocate, LargeArrayDeallocateHook deallocate ) {
+        std::lock_guard< std::mutex > guard( hook_lock );
+        allocate_hook = std::move( allocate );
+        deallocate_hook = std::move( deallocate );
+    }
+}
@@ -0,0 +1,893 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <opm/common/utility/Executor.hpp>
+#include <opm/common/utility/LargeArray.hpp>
+#include <opm/output/eclipse/EclBinaryIO.hpp>
+
+namespace Opm {
+namespace EclIO {
+
+namespace {
+
+    const std::size_t block_buffer_size = 4 << 20;
+    const std::size_t header_size = 16;
+
+    std::size_t elementSize( ArrayType type ) {
+        switch (type) {
+        case ArrayType::INTE:
+        case ArrayType::REAL:
+        case ArrayType::LOGI:
+            return 4;
+        case ArrayType::DOUB:
+        case ArrayType::CHAR:
+            return 8;
+        case ArrayType::MESS:
+            return 0;
+        }
+
+        return 0;
+    }
+
+    std::size_t blockSize( ArrayType type ) {
+        return type == ArrayType::CHAR ? 105 : 1000;
+    }
+
+    bool hostIsBigEndian() {
+        const std::uint32_t one = 1;
+        unsigned char first;
+        std::memcpy( &first, &one, 1 );
+        return first == 0;
+    }
+
+    const bool big_endian_host = hostIsBigEndian();
+
+    inline std::uint32_t swap32( std::uint32_t v ) {
+        return ((v & 0x000000FFU) << 24) | ((v & 0x0000FF00U) << 8)
+             | ((v & 0x00FF0000U) >> 8)  | ((v & 0xFF000000U) >> 24);
+    }
+
+    inline std::uint64_t swap64( std::uint64_t v ) {
+        return (std::uint64_t( swap32( std::uint32_t( v ) ) ) << 32)
+             | swap32( std::uint32_t( v >> 32 ) );
+    }
+
+    /*
+      Copies count elements of the given width between host and big
+      endian byte order; the conversion is symmetric so the same
+      function is used for reading and writing. The loops are kept
+      simple enough for the compiler to vectorise the byte swapping.
+    */
+    void copySwapped( const char* src, char* dst, std::size_t count, std::size_t width ) {
+        if (big_endian_host) {
+            std::memcpy( dst, src, count * width );
+            return;
+        }
+
+        if (width == 4) {
+            for (std::size_t i = 0; i < count; i++) {
+                std::uint32_t v;
+                std::memcpy( &v, src + 4*i, 4 );
+                v = swap32( v );
+                std::memcpy( dst + 4*i, &v, 4 );
+            }
+        } else {
+            for (std::size_t i = 0; i < count; i++) {
+                std::uint64_t v;
+                std::memcpy( &v, src + 8*i, 8 );
+                v = swap64( v );
+                std::memcpy( dst + 8*i, &v, 8 );
+            }
+        }
+    }
+
+    void writeInt( char* dst, std::int32_t value ) {
+        copySwapped( reinterpret_cast< const char* >( &value ), dst, 1, 4 );
+    }
+
+    std::int32_t readInt( const char* src ) {
+        std::int32_t value;
+        copySwapped( src, reinterpret_cast< char* >( &value ), 1, 4 );
+        return value;
+    }
+
+    ArrayType parseType( const char* type ) {
+        for (auto candidate : { ArrayType::INTE, ArrayType::REAL, ArrayType::DOUB,
+                                ArrayType::LOGI, ArrayType::CHAR, ArrayType::MESS })
+            if (std::strncmp( type, typeName( candidate ), 4 ) == 0)
+                return candidate;
+
+        throw std::runtime_error("Unsupported array type: " + std::string( type, 4 ));
+    }
+
+    std::string trimName( const char* data, std::size_t size ) {
+        std::string name( data, size );
+        return name.substr( 0, name.find_last_not_of( ' ' ) + 1 );
+    }
+
+
+    /*
+      Number of elements on each line in the formatted files, this
+      and the element formats below follow the layout written by ERT.
+    */
+    std::size_t formattedColumns( ArrayType type ) {
+        switch (type) {
+        case ArrayType::INTE: return 6;
+        case ArrayType::REAL: return 4;
+        case ArrayType::DOUB: return 3;
+        case ArrayType::LOGI: return 25;
+        case ArrayType::CHAR: return 7;
+        case ArrayType::MESS: return 1;
+        }
+
+        return 1;
+    }
+
+    const char digit_pairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    const unsigned long long powers_of_ten[] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+        10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+        100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+        100000000000000ULL, 1000000000000000ULL
+    };
+
+    /*
+      Writes the decimal digits of value backwards from end, padded
+      with zeros to at least min_digits; returns the first digit.
+    */
+    char* formatDigits( char* end, unsigned long long value, int min_digits ) {
+        char* p = end;
+        while (value >= 100) {
+            const auto pair = 2 * (value % 100);
+            value /= 100;
+            *--p = digit_pairs[pair + 1];
+            *--p = digit_pairs[pair];
+        }
+
+        if (value >= 10) {
+            *--p = digit_pairs[2 * value + 1];
+            *--p = digit_pairs[2 * value];
+        } else
+            *--p = char( '0' + value );
+
+        while (end - p < min_digits)
+            *--p = '0';
+
+        return p;
+    }
+
+    // Equivalent to printf(" %11d", value).
+    void formatInt( std::string& out, int value ) {
+        char buffer[12];
+        char* end = buffer + sizeof buffer;
+        const auto magnitude = value < 0 ? 0ULL - static_cast< unsigned long long >( value )
+                                         : static_cast< unsigned long long >( value );
+        char* p = formatDigits( end, magnitude, 1 );
+        if (value < 0)
+            *--p = '-';
+
+        out.append( sizeof buffer - (end - p), ' ' );
+        out.append( p, end );
+    }
+
+    /*
+      The floating point numbers are written with the mantissa in the
+      interval (0.1, 1], i.e. equivalent to printf("  %11.8fE%+03d")
+      for REAL and printf("  %17.14fD%+03d") for DOUB, where the
+      mantissa and exponent are calculated exactly as ERT does.
+
+      The mantissa is rounded in extended precision; only when the
+      result is too close to a rounding tie to be certain, or for
+      values which are not finite, is the formatting left to snprintf.
+    */
+    void formatScientific( std::string& out, double x, int decimals, char exponent_char ) {
+        double pow_x = std::ceil( std::log10( std::fabs( x ) ) );
+        double arg_x = x / std::pow( 10.0, pow_x );
+        if (x != 0.0) {
+            if (std::fabs( arg_x ) == 1.0) {
+                arg_x *= 0.10;
+                pow_x += 1;
+            }
+        } else {
+            arg_x = 0.0;
+            pow_x = 0.0;
+        }
+
+        // What the double to int conversion gives on x86 for nan and inf.
+        const int exponent = std::isfinite( pow_x ) ? static_cast< int >( pow_x )
+                                                    : std::numeric_limits< int >::min();
+
+        if (std::isfinite( arg_x ) && std::abs( exponent ) < 100) {
+            const auto unit = powers_of_ten[decimals];
+            const long double scaled = std::fabs( static_cast< long double >( arg_x ) ) * unit;
+            const long double whole = std::floor( scaled );
+            const long double fraction = scaled - whole;
+            const long double tolerance = 4 * scaled * std::numeric_limits< long double >::epsilon();
+
+            if (std::fabs( fraction - 0.5L ) > tolerance) {
+                const auto digits = static_cast< unsigned long long >( whole ) + (fraction > 0.5L ? 1 : 0);
+
+                char buffer[32];
+                char* end = buffer + sizeof buffer;
+                char* p = formatDigits( end, std::abs( exponent ), 2 );
+                *--p = exponent < 0 ? '-' : '+';
+                *--p = exponent_char;
+                p = formatDigits( p, digits % unit, decimals );
+                *--p = '.';
+                *--p = char( '0' + digits / unit );
+                *--p = arg_x < 0 ? '-' : ' ';
+                *--p = ' ';
+                *--p = ' ';
+
+                out.append( p, end );
+                return;
+            }
+        }
+
+        char buffer[64];
+        std::snprintf( buffer, sizeof buffer, "  %*.*f%c%+03d",
+                       decimals + 3, decimals, arg_x, exponent_char, exponent );
+        out.append( buffer );
+    }
+
+    void formatElement( std::string& out, ArrayType type, const int* data, std::size_t index ) {
+        if (type == ArrayType::LOGI)
+            out.append( data[index] ? "  T" : "  F" );
+        else
+            formatInt( out, data[index] );
+    }
+
+    void formatElement( std::string& out, ArrayType, const float* data, std::size_t index ) {
+        formatScientific( out, data[index], 8, 'E' );
+    }
+
+    void formatElement( std::string& out, ArrayType, const double* data, std::size_t index ) {
+        formatScientific( out, data[index], 14, 'D' );
+    }
+
+    void formatElement( std::string& out, ArrayType, const char* data, std::size_t index ) {
+        out.append( " '" );
+        out.append( data + 8 * index, 8 );
+        out.append( "'" );
+    }
+
+    /*
+      Formats one block, i.e. what is one Fortran record in the
+      unformatted files; the lines are broken after every column count
+      elements and at the end of the block.
+    */
+    template< typename T >
+    std::string formatBlock( ArrayType type, const T* data, std::size_t first, std::size_t count ) {
+        const auto columns = formattedColumns( type );
+        std::string text;
+        text.reserve( count * 24 + count / columns + 1 );
+
+        for (std::size_t index = 0; index < count; index++) {
+            formatElement( text, type, data, first + index );
+            if ((index + 1) % columns == 0)
+                text.push_back( '\n' );
+        }
+
+        if (count % columns != 0)
+            text.push_back( '\n' );
+
+        return text;
+    }
+
+
+    bool isSpace( char c ) {
+        return std::isspace( static_cast< unsigned char >( c ) ) != 0;
+    }
+
+    /*
+      The tokens are copied to a terminated buffer before conversion,
+      the mapped file is not null terminated.
+    */
+    const char* terminatedToken( char* buffer, std::size_t buffer_size, const char* token, std::size_t size ) {
+        if (size >= buffer_size)
+            throw std::runtime_error("Invalid number: " + std::string( token, size ) + " in formatted file");
+
+        std::memcpy( buffer, token, size );
+        buffer[size] = '\0';
+        return buffer;
+    }
+
+    void parseValue( const char* token, std::size_t size, int& value ) {
+        if (token[0] == 'T' || token[0] == 'F') {
+            value = token[0] == 'T' ? -1 : 0;
+            return;
+        }
+
+        char buffer[32];
+        value = std::strtol( terminatedToken( buffer, sizeof buffer, token, size ), nullptr, 10 );
+    }
+
+    void parseValue( const char* token, std::size_t size, float& value ) {
+        char buffer[64];
+        value = std::strtof( terminatedToken( buffer, sizeof buffer, token, size ), nullptr );
+    }
+
+    void parseValue( const char* token, std::size_t size, double& value ) {
+        char buffer[64];
+        terminatedToken( buffer, sizeof buffer, token, size );
+        for (auto* p = buffer; *p; p++)
+            if (*p == 'D' || *p == 'd')
+                *p = 'E';
+
+        value = std::strtod( buffer, nullptr );
+    }
+
+    void parseValue( const char*, std::size_t, char& ) {
+        throw std::logic_error("Character data should not be parsed as a number");
+    }
+
+}
+
+
+    const char* typeName( ArrayType type ) {
+        switch (type) {
+        case ArrayType::INTE: return "INTE";
+        case ArrayType::REAL: return "REAL";
+        case ArrayType::DOUB: return "DOUB";
+        case ArrayType::LOGI: return "LOGI";
+        case ArrayType::CHAR: return "CHAR";
+        case ArrayType::MESS: return "MESS";
+        }
+
+        return "    ";
+    }
+
+
+    EclOutput::EclOutput( const std::string& filename, bool formatted, std::ios_base::openmode mode ) :
+        m_filename( filename ),
+        m_formatted( formatted ),
+        m_stream( filename, mode | std::ios_base::binary )
+    {
+        if (!this->m_stream)
+            throw std::runtime_error("Could not open file: " + filename + " for writing");
+
+        this->m_buffer.reserve( block_buffer_size );
+    }
+
+
+    EclOutput::~EclOutput() {
+        try {
+            this->flush();
+        } catch (...) {
+        }
+    }
+
+
+    void EclOutput::flush() {
+        if (this->m_buffer.empty())
+            return;
+
+        this->m_stream.write( this->m_buffer.data(), this->m_buffer.size() );
+        this->m_stream.flush();
+        this->m_buffer.clear();
+
+        if (!this->m_stream)
+            throw std::runtime_error("Writing to file: " + this->m_filename + " failed");
+    }
+
+
+    char* EclOutput::reserve( std::size_t bytes ) {
+        if (this->m_buffer.size() + bytes > block_buffer_size)
+            this->flush();
+
+        const auto offset = this->m_buffer.size();
+        this->m_buffer.resize( offset + bytes );
+        return this->m_buffer.data() + offset;
+    }
+
+
+    void EclOutput::writeHeader( const std::string& name, std::size_t size, ArrayType type ) {
+        if (name.size() > 8)
+            throw std::invalid_argument("Array name: " + name + " is longer than eight characters");
+
+        if (this->m_formatted) {
+            std::string line( " '" );
+            line.append( name );
+            line.append( 8 - name.size(), ' ' );
+            line.append( "'" );
+            formatInt( line, size );
+            line.append( " '" );
+            line.append( typeName( type ) );
+            line.append( "'\n" );
+            this->writeBytes( line );
+            return;
+        }
+
+        char* dst = this->reserve( header_size + 8 );
+        writeInt( dst, header_size );
+
+        std::memset( dst + 4, ' ', 8 );
+        std::memcpy( dst + 4, name.data(), name.size() );
+        writeInt( dst + 12, size );
+        std::memcpy( dst + 16, typeName( type ), 4 );
+
+        writeInt( dst + 20, header_size );
+    }
+
+
+    void EclOutput::writeBytes( const std::string& bytes ) {
+        std::memcpy( this->reserve( bytes.size() ), bytes.data(), bytes.size() );
+    }
+
+
+    /*
+      The blocks are formatted concurrently in batches, bounding the
+      amount of text which is kept in memory for large arrays.
+    */
+    template< typename T >
+    void EclOutput::writeFormattedArray( ArrayType type, const T* data, std::size_t size ) {
+        const std::size_t block = blockSize( type );
+        const std::size_t num_blocks = (size + block - 1) / block;
+        const std::size_t batch_size = 64;
+        std::vector< std::string > text( std::min( batch_size, num_blocks ) );
+
+        for (std::size_t first_block = 0; first_block < num_blocks; first_block += batch_size) {
+            const std::size_t batch = std::min( batch_size, num_blocks - first_block );
+
+            Executor::instance().parallelFor( 0, batch, [&]( std::size_t b ) {
+                const std::size_t first = (first_block + b) * block;
+                text[b] = formatBlock( type, data, first, std::min( block, size - first ) );
+            });
+
+            for (std::size_t b = 0; b < batch; b++)
+                this->writeBytes( text[b] );
+        }
+    }
+
+
+    template< typename T >
+    void EclOutput::writeArray( const std::string& name, ArrayType type, const T* data, std::size_t size ) {
+        this->writeHeader( name, size, type );
+        if (this->m_formatted) {
+            this->writeFormattedArray( type, data, size );
+            return;
+        }
+
+        const auto width = elementSize( type );
+        const auto block = blockSize( type );
+        const char* src = reinterpret_cast< const char* >( data );
+
+        for (std::size_t first = 0; first < size; first += block) {
+            const auto count = std::min( block, size - first );
+            const auto bytes = count * width;
+            char* dst = this->reserve( bytes + 8 );
+
+            writeInt( dst, bytes );
+            if (type == ArrayType::CHAR)
+                std::memcpy( dst + 4, src + first * width, bytes );
+            else
+                copySwapped( src + first * width, dst + 4, count, width );
+            writeInt( dst + 4 + bytes, bytes );
+        }
+    }
+
+
+    void EclOutput::write( const std::string& name, const int* data, std::size_t size ) {
+        this->writeArray( name, ArrayType::INTE, data, size );
+    }
+
+
+    void EclOutput::write( const std::string& name, const float* data, std::size_t size ) {
+        this->writeArray( name, ArrayType::REAL, data, size );
+    }
+
+
+    void EclOutput::write( const std::string& name, const double* data, std::size_t size ) {
+        this->writeArray( name, ArrayType::DOUB, data, size );
+    }
+
+
+    void EclOutput::write( const std::string& name, const std::vector< int >& data ) {
+        this->write( name, data.data(), data.size() );
+    }
+
+
+    void EclOutput::write( const std::string& name, const std::vector< float >& data ) {
+        this->write( name, data.data(), data.size() );
+    }
+
+
+    void EclOutput::write( const std::string& name, const std::vector< double >& data ) {
+        this->write( name, data.data(), data.size() );
+    }
+
+
+    void EclOutput::write( const std::string& name, const std::vector< bool >& data ) {
+        LargeVector< int > logi( data.size() );
+        for (std::size_t i = 0; i < data.size(); i++)
+            logi[i] = data[i] ? -1 : 0;
+
+        this->writeArray( name, ArrayType::LOGI, logi.data(), logi.size() );
+    }
+
+
+    void EclOutput::write( const std::string& name, const std::vector< std::string >& data ) {
+        std::vector< char > chars( 8 * data.size(), ' ' );
+        for (std::size_t i = 0; i < data.size(); i++) {
+            if (data[i].size() > 8)
+                throw std::invalid_argument("String: " + data[i] + " in array: " + name + " is longer than eight characters");
+
+            std::memcpy( chars.data() + 8*i, data[i].data(), data[i].size() );
+        }
+
+        this->writeArray( name, ArrayType::CHAR, chars.data(), data.size() );
+    }
+
+
+    void EclOutput::writeFloat( const std::string& name, const double* data, std::size_t size ) {
+        const LargeVector< float > float_data( data, data + size );
+        this->write( name, float_data.data(), float_data.size() );
+    }
+
+
+    void EclOutput::writeFloat( const std::string& name, const std::vector< double >& data ) {
+        this->writeFloat( name, data.data(), data.size() );
+    }
+
+
+    void EclOutput::message( const std::string& name ) {
+        this->writeHeader( name, 0, ArrayType::MESS );
+    }
+
+
+
+    EclFile::EclFile( const std::string& filename ) :
+        m_filename( filename )
+    {
+        const int fd = ::open( filename.c_str(), O_RDONLY );
+        if (fd < 0)
+            throw std::invalid_argument("Could not open file: " + filename + " for reading");
+
+        struct stat st;
+        if (::fstat( fd, &st ) != 0) {
+            ::close( fd );
+            throw std::runtime_error("Could not stat file: " + filename);
+        }
+
+        this->m_size = st.st_size;
+        if (this->m_size > 0) {
+            void* data = ::mmap( nullptr, this->m_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if (data == MAP_FAILED) {
+                ::close( fd );
+                throw std::runtime_error("Could not map file: " + filename);
+            }
+            this->m_data = static_cast< const char* >( data );
+        }
+        ::close( fd );
+
+        this->m_formatted = this->m_size >= 4 && readInt( this->m_data ) != int( header_size );
+        try {
+            if (this->m_formatted)
+                this->indexFormattedArrays();
+            else
+                this->indexArrays();
+        } catch (...) {
+            if (this->m_data)
+                ::munmap( const_cast< char* >( this->m_data ), this->m_size );
+            throw;
+        }
+    }
+
+
+    void EclFile::indexArrays() {
+        const auto corrupt = [this]( std::size_t pos ) {
+            return std::runtime_error("File: " + this->m_filename + " is corrupt at byte offset "
+                                      + std::to_string( pos ));
+        };
+
+        std::size_t pos = 0;
+        while (pos < this->m_size) {
+            if (pos + header_size + 8 > this->m_size || readInt( this->m_data + pos ) != int( header_size )
+                || readInt( this->m_data + pos + 4 + header_size ) != int( header_size ))
+                throw corrupt( pos );
+
+            const char* header = this->m_data + pos + 4;
+            const int size = readInt( header + 8 );
+            Array array;
+            array.name = trimName( header, 8 );
+            array.type = parseType( header + 12 );
+            array.offset = pos;
+
+            const auto width = elementSize( array.type );
+            if (size < 0 || (width == 0 && size != 0))
+                throw corrupt( pos );
+
+            array.size = size;
+            pos += header_size + 8;
+
+            std::size_t remaining = array.size;
+            while (remaining > 0) {
+                if (pos + 4 > this->m_size)
+                    throw corrupt( pos );
+
+                const std::size_t bytes = readInt( this->m_data + pos );
+                const std::size_t count = bytes / width;
+                if (count == 0 || count > remaining || bytes % width != 0
+                    || pos + bytes + 8 > this->m_size
+                    || std::size_t( readInt( this->m_data + pos + 4 + bytes ) ) != bytes)
+                    throw corrupt( pos );
+
+                remaining -= count;
+                pos += bytes + 8;
+            }
+
+            this->m_arrays.push_back( array );
+        }
+    }
+
+
+    void EclFile::indexFormattedArrays() {
+        const auto corrupt = [this]( std::size_t pos ) {
+            return std::runtime_error("Formatted file: " + this->m_filename + " is corrupt at byte offset "
+                                      + std::to_string( pos ));
+        };
+
+        std::size_t pos = 0;
+        const auto skipSpace = [this, &pos]() {
+            while (pos < this->m_size && isSpace( this->m_data[pos] ))
+                pos++;
+        };
+
+        const auto quoted = [this, &pos, &corrupt]( std::size_t width ) {
+            if (pos + width + 2 > this->m_size || this->m_data[pos] != '\''
+                || this->m_data[pos + width + 1] != '\'')
+                throw corrupt( pos );
+
+            const char* text = this->m_data + pos + 1;
+            pos += width + 2;
+            return text;
+        };
+
+        while (true) {
+            skipSpace();
+            if (pos == this->m_size)
+                break;
+
+            Array array;
+            array.offset = pos;
+            array.name = trimName( quoted( 8 ), 8 );
+
+            skipSpace();
+            const std::size_t size_start = pos;
+            while (pos < this->m_size && !isSpace( this->m_data[pos] ))
+                pos++;
+
+            int size;
+            parseValue( this->m_data + size_start, pos - size_start, size );
+            if (size < 0)
+                throw corrupt( size_start );
+            array.size = size;
+
+            skipSpace();
+            array.type = parseType( quoted( 4 ) );
+            if (array.type == ArrayType::MESS && array.size != 0)
+                throw corrupt( size_start );
+
+            for (std::size_t index = 0; index < array.size; index++) {
+                skipSpace();
+                if (pos == this->m_size)
+                    throw corrupt( pos );
+
+                if (array.type == ArrayType::CHAR)
+                    quoted( 8 );
+                else
+                    while (pos < this->m_size && !isSpace( this->m_data[pos] ))
+                        pos++;
+            }
+
+            this->m_arrays.push_back( array );
+        }
+    }
+
+
+    EclFile::~EclFile() {
+        if (this->m_data)
+            ::munmap( const_cast< char* >( this->m_data ), this->m_size );
+    }
+
+
+    bool EclFile::formatted() const {
+        return this->m_formatted;
+    }
+
+
+    const std::vector< EclFile::Array >& EclFile::arrays() const {
+        return this->m_arrays;
+    }
+
+
+    std::size_t EclFile::size() const {
+        return this->m_arrays.size();
+    }
+
+
+    bool EclFile::hasKey( const std::string& name ) const {
+        return std::any_of( this->m_arrays.begin(), this->m_arrays.end(),
+                            [&name]( const Array& array ) { return array.name == name; } );
+    }
+
+
+    std::size_t EclFile::index( const std::string& name, std::size_t occurence ) const {
+        for (std::size_t index = 0; index < this->m_arrays.size(); index++) {
+            if (this->m_arrays[index].name != name)
+                continue;
+
+            if (occurence == 0)
+                return index;
+
+            occurence--;
+        }
+
+        throw std::invalid_argument("No array: " + name + " in file: " + this->m_filename);
+    }
+
+
+    void EclFile::checkType( std::size_t index, ArrayType type ) const {
+        const auto& array = this->m_arrays.at( index );
+        if (array.type != type)
+            throw std::invalid_argument("Array: " + array.name + " is of type " + typeName( array.type )
+                                        + " not " + typeName( type ));
+    }
+
+
+    /*
+      The formatted arrays have already been validated when the file
+      was indexed.
+    */
+    template< typename T >
+    void EclFile::readFormattedData( std::size_t index, T* data ) const {
+        const auto& array = this->m_arrays.at( index );
+        const char* end = this->m_data + this->m_size;
+
+        // Skip the quoted name, the size and the quoted type.
+        const char* p = this->m_data + array.offset + 10;
+        while (isSpace( *p ))
+            p++;
+        while (!isSpace( *p ))
+            p++;
+        while (isSpace( *p ))
+            p++;
+        p += 6;
+
+        for (std::size_t i = 0; i < array.size; i++) {
+            while (isSpace( *p ))
+                p++;
+
+            if (array.type == ArrayType::CHAR) {
+                std::memcpy( reinterpret_cast< char* >( data ) + 8 * i, p + 1, 8 );
+                p += 10;
+            } else {
+                const char* token = p;
+                while (p < end && !isSpace( *p ))
+                    p++;
+
+                parseValue( token, p - token, data[i] );
+            }
+        }
+    }
+
+
+    template< typename T >
+    void EclFile::readData( std::size_t index, T* data ) const {
+        if (this->m_formatted) {
+            this->readFormattedData( index, data );
+            return;
+        }
+
+        const auto& array = this->m_arrays.at( index );
+        const auto width = elementSize( array.type );
+        char* dst = reinterpret_cast< char* >( data );
+        std::size_t pos = array.offset + header_size + 8;
+        std::size_t remaining = array.size;
+
+        while (remaining > 0) {
+            const std::size_t bytes = readInt( this->m_data + pos );
+            const std::size_t count = bytes / width;
+
+            if (array.type == ArrayType::CHAR)
+                std::memcpy( dst, this->m_data + pos + 4, bytes );
+            else
+                copySwapped( this->m_data + pos + 4, dst, count, width );
+
+            dst += bytes;
+            remaining -= count;
+            pos += bytes + 8;
+        }
+    }
+
+
+    std::vector< int > EclFile::getInt( std::size_t index ) const {
+        this->checkType( index, ArrayType::INTE );
+        std::vector< int > data( this->m_arrays[index].size );
+        this->readData( index, data.data() );
+        return data;
+    }
+
+
+    std::vector< float > EclFile::getFloat( std::size_t index ) const {
+        this->checkType( index, ArrayType::REAL );
+        std::vector< float > data( this->m_arrays[index].size );
+        this->readData( index, data.data() );
+        return data;
+    }
+
+
+    std::vector< double > EclFile::getDouble( std::size_t index ) const {
+        this->checkType( index, ArrayType::DOUB );
+        std::vector< double > data( this->m_arrays[index].size );
+        this->readData( index, data.data() );
+        return data;
+    }
+
+
+    std::vector< bool > EclFile::getBool( std::size_t index ) const {
+        this->checkType( index, ArrayType::LOGI );
+        std::vector< int > logi( this->m_arrays[index].size );
+        this->readData( index, logi.data() );
+        return std::vector< bool >( logi.begin(), logi.end() );
+    }
+
+
+    std::vector< std::string > EclFile::getString( std::size_t index ) const {
+        this->checkType( index, ArrayType::CHAR );
+        const auto size = this->m_arrays[index].size;
+        std::vector< char > chars( 8 * size );
+        this->readData( index, chars.data() );
+
+        std::vector< std::string > data( size );
+        for (std::size_t i = 0; i < size; i++)
+            data[i] = trimName( chars.data() + 8*i, 8 );
+
+        return data;
+    }
+
+}
+}
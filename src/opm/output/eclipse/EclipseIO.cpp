@@ -26,6 +26,9 @@
 
 #include <opm/output/eclipse/EclipseIO.hpp>
 
+#include <opm/common/utility/Executor.hpp>
+#include <opm/common/utility/LargeArray.hpp>
+
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Units/Dimension.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
@@ -41,8 +44,11 @@
 #include <opm/output/eclipse/Summary.hpp>
 #include <opm/output/eclipse/Tables.hpp>
 #include <opm/output/eclipse/RestartIO.hpp>
+#include <opm/output/eclipse/EclBinaryIO.hpp>
 
+#include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <memory>     // unique_ptr
 #include <utility>    // move
 
@@ -93,6 +99,163 @@ void writeKeyword( ERT::FortIO& fortio ,
 }
 
 
+void writeStringKeyword( ERT::FortIO& fortio ,
+                         const std::string& keywordName,
+                         const std::vector<const char*>& data ) {
+    ERT::EclKW< const char* > kw( keywordName, data );
+    kw.fwrite( fortio );
+}
+
+
+void writeKeyword( EclIO::EclOutput& output,
+                   const std::string& keywordName,
+                   const std::vector<int>& data ) {
+    output.write( keywordName, data );
+}
+
+
+void writeKeyword( EclIO::EclOutput& output,
+                   const std::string& keywordName,
+                   const std::vector<double>& data ) {
+    output.writeFloat( keywordName, data );
+}
+
+
+void writeStringKeyword( EclIO::EclOutput& output,
+                         const std::string& keywordName,
+                         const std::vector<const char*>& data ) {
+    output.write( keywordName, std::vector<std::string>( data.begin(), data.end() ));
+}
+
+
+void writeGridGeometry( EclIO::EclOutput& output,
+                        const EclipseGrid& grid,
+                        const UnitSystem& units ) {
+    {
+        std::vector<double> coord;
+        grid.exportCOORD( coord );
+        units.from_si( UnitSystem::measure::length, coord );
+        writeKeyword( output, "COORD", coord );
+    }
+
+    {
+        LargeVector<double> zcorn( ecl_grid_get_zcorn_size( grid.c_ptr() ));
+        ecl_grid_init_zcorn_data_double( grid.c_ptr(), zcorn.data() );
+        const double length = units.from_si( UnitSystem::measure::length, 1.0 );
+        Executor::instance().parallelFor( 0, zcorn.size(), [&zcorn, length]( size_t index ) {
+            zcorn[index] *= length;
+        }, 65536 );
+        output.writeFloat( "ZCORN", zcorn.data(), zcorn.size() );
+    }
+
+    {
+        std::vector<int> actnum( grid.getCartesianSize() );
+        for (size_t global_index = 0; global_index < actnum.size(); global_index++)
+            actnum[global_index] = grid.cellActive( global_index ) ? 1 : 0;
+
+        writeKeyword( output, "ACTNUM", actnum );
+    }
+}
+
+
+/*
+  The EGRID file is assembled directly from the grid and the NNC
+  container, the ecl_grid instance owned by the EclipseGrid is only
+  read from. The local grid refinements are written as LGR sections
+  following the main grid, where HOSTNUM holds the (one based) global
+  index of the host cell of each refined cell.
+*/
+
+void writeEGRID( EclIO::EclOutput& output,
+                 const EclipseGrid& grid,
+                 const UnitSystem& units,
+                 const NNC& nnc ) {
+    const char* unit_name = "METRES";
+    if (units.getType() == UnitSystem::UnitType::UNIT_TYPE_FIELD)
+        unit_name = "FEET";
+    else if (units.getType() == UnitSystem::UnitType::UNIT_TYPE_LAB)
+        unit_name = "CM";
+
+    {
+        std::vector<int> filehead( 100, 0 );
+        filehead[0] = 3;     // File format version.
+        filehead[1] = 2007;  // Release year.
+        filehead[6] = 1;     // Original grid format: corner point.
+        writeKeyword( output, "FILEHEAD", filehead );
+    }
+
+    {
+        std::vector<double> mapaxes;
+        grid.exportMAPAXES( mapaxes );
+        if (!mapaxes.empty()) {
+            writeStringKeyword( output, "MAPUNITS", { unit_name } );
+            writeKeyword( output, "MAPAXES", mapaxes );
+        }
+    }
+
+    writeStringKeyword( output, "GRIDUNIT", { unit_name, "" } );
+
+    {
+        std::vector<int> gridhead( 100, 0 );
+        gridhead[0]  = 1;    // Grid type: corner point.
+        gridhead[1]  = grid.getNX();
+        gridhead[2]  = grid.getNY();
+        gridhead[3]  = grid.getNZ();
+        gridhead[24] = 1;    // Number of reservoirs.
+        writeKeyword( output, "GRIDHEAD", gridhead );
+    }
+
+    writeGridGeometry( output, grid, units );
+    writeKeyword( output, "ENDGRID", std::vector<int>() );
+
+    for (size_t lgr_nr = 1; lgr_nr <= grid.numLGR(); lgr_nr++) {
+        const auto& lgr = grid.getLGR( lgr_nr );
+
+        writeStringKeyword( output, LGR_KW, { lgr.name().c_str() } );
+        {
+            std::vector<int> gridhead( 100, 0 );
+            gridhead[0]  = 1;
+            gridhead[1]  = lgr.getNX();
+            gridhead[2]  = lgr.getNY();
+            gridhead[3]  = lgr.getNZ();
+            gridhead[4]  = lgr_nr;
+            gridhead[24] = 1;
+            writeKeyword( output, "GRIDHEAD", gridhead );
+        }
+
+        writeGridGeometry( output, lgr.grid(), units );
+        {
+            std::vector<int> hostnum( lgr.getHostCells() );
+            for (auto& host : hostnum)
+                host += 1;
+
+            writeKeyword( output, "HOSTNUM", hostnum );
+        }
+        writeKeyword( output, "ENDGRID", std::vector<int>() );
+        writeKeyword( output, ENDLGR_KW, std::vector<int>() );
+    }
+
+    if (nnc.hasNNC()) {
+        std::vector<int> nnchead( 10, 0 );
+        std::vector<int> nnc1;
+        std::vector<int> nnc2;
+
+        nnchead[0] = nnc.numNNC();
+        nnc1.reserve( nnc.numNNC() );
+        nnc2.reserve( nnc.numNNC() );
+        for (const NNCdata& n : nnc.nncdata()) {
+            nnc1.push_back( n.cell1 + 1 );
+            nnc2.push_back( n.cell2 + 1 );
+        }
+
+        writeKeyword( output, "NNCHEAD", nnchead );
+        writeKeyword( output, "NNC1", nnc1 );
+        writeKeyword( output, "NNC2", nnc2 );
+    }
+}
+
+
+
 
 
 
@@ -167,12 +330,8 @@ void RFT::writeTimeStep( std::vector< const Well* > wells,
             const auto index = grid.getGlobalIndex( i, j, k );
             const double depth = grid.getCellDepth( i, j, k );
 
-            const auto& completionData = std::find_if( wellData.completions.begin(),
-                                                   wellData.completions.end(),
-                                                   [=]( const data::Completion& c ) {
-                                                        return c.index == index;
-                                                   } );
-
+            const auto* completionData = wellData.find_completion( index );
+            if( !completionData ) continue;
 
             const double press = units.from_si(UnitSystem::measure::pressure,completionData->cell_pressure);
             const double satwat = units.from_si(UnitSystem::measure::identity, completionData->cell_saturation_water);
@@ -205,6 +364,7 @@ class EclipseIO::Impl {
     Impl( const EclipseState&, EclipseGrid, const Schedule&, const SummaryConfig& );
         void writeINITFile( const data::Solution& simProps, std::map<std::string, std::vector<int> > int_data, const NNC& nnc) const;
         void writeEGRIDFile( const NNC& nnc ) const;
+        void writeRestartAndRFT( int report_step, bool isSubstep, double secs_elapsed, RestartValue value, bool write_double );
 
         const EclipseState& es;
         EclipseGrid grid;
@@ -213,6 +373,7 @@ class EclipseIO::Impl {
         std::string baseName;
         out::Summary summary;
         RFT rft;
+        std::unique_ptr< RestartIO::UnifiedRestartFile > unified_restart;
         bool output_enabled;
 };
 
@@ -228,7 +389,14 @@ EclipseIO::Impl::Impl( const EclipseState& eclipseState,
     , summary( eclipseState, summary_config, grid , schedule )
     , rft( outputDir.c_str(), baseName.c_str(), es.getIOConfig().getFMTOUT() )
     , output_enabled( eclipseState.getIOConfig().getOutputEnabled() )
-{}
+{
+    const auto& ioConfig = eclipseState.getIOConfig();
+    if (ioConfig.getUNIFOUT())
+        this->unified_restart.reset( new RestartIO::UnifiedRestartFile( ERT::EclFilename( this->outputDir,
+                                                                                          this->baseName,
+                                                                                          ECL_UNIFIED_RESTART_FILE,
+                                                                                          ioConfig.getFMTOUT() ) ) );
+}
 
 
 void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<std::string, std::vector<int> > int_data, const NNC& nnc) const {
@@ -277,20 +445,21 @@ void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<st
     ecl_grid_fwrite_depth( this->grid.c_ptr() , fortio.get() , units.getEclType( ) );
     ecl_grid_fwrite_dims( this->grid.c_ptr() , fortio.get() , units.getEclType( ) );
 
+    /*
+      This is a rather arbitrary hardcoded list of 3D keywords which
+      are written to the INIT file, if they are in the current
+      EclipseState.
+    */
+    using double_kw = std::pair<std::string, UnitSystem::measure>;
+    const std::vector<double_kw> doubleKeywords = {{"PORO"  , UnitSystem::measure::identity },
+                                                   {"PERMX" , UnitSystem::measure::permeability },
+                                                   {"PERMY" , UnitSystem::measure::permeability },
+                                                   {"PERMZ" , UnitSystem::measure::permeability },
+                                                   {"NTG"   , UnitSystem::measure::identity }};
+
     // Write properties from the input deck.
     {
         const auto& properties = this->es.get3DProperties().getDoubleProperties();
-        using double_kw = std::pair<std::string, UnitSystem::measure>;
-        /*
-          This is a rather arbitrary hardcoded list of 3D keywords
-          which are written to the INIT file, if they are in the
-          current EclipseState.
-        */
-        std::vector<double_kw> doubleKeywords = {{"PORO"  , UnitSystem::measure::identity },
-                                                 {"PERMX" , UnitSystem::measure::permeability },
-                                                 {"PERMY" , UnitSystem::measure::permeability },
-                                                 {"PERMZ" , UnitSystem::measure::permeability },
-                                                 {"NTG"   , UnitSystem::measure::identity }};
 
         // The INIT file should always contain the NTG property, we
         // therefor invoke the auto create functionality to ensure
@@ -370,6 +539,93 @@ void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<st
         units.from_si( UnitSystem::measure::transmissibility , tran );
         writeKeyword( fortio, "TRANNNC" , tran );
     }
+
+    // Write the local grid refinements; the properties are inherited
+    // from the host cells and modified by the keywords in the LGR
+    // block. The pore volume of a refined cell is computed from the
+    // refined PORO, NTG and MULTPV and the volume of the refined cell,
+    // unless PORV is given in the LGR block. Host cells with PORV from
+    // the deck and no PORO have their pore volume distributed over the
+    // refined cells in proportion to the cell volume.
+    for (size_t lgr_nr = 1; lgr_nr <= this->grid.numLGR(); lgr_nr++) {
+        const auto& lgr = this->grid.getLGR( lgr_nr );
+        const auto& lgr_grid = lgr.grid();
+        const auto& deck_units = this->es.getDeckUnitSystem();
+
+        writeStringKeyword( fortio, LGR_KW, { lgr.name().c_str() } );
+        {
+            std::vector<int> lgrheadi( 45, 0 );
+            lgrheadi[0] = lgr_nr;
+            writeKeyword( fortio, "LGRHEADI", lgrheadi );
+        }
+
+        {
+            // Only the properties in the deck are looked up, the host
+            // values of absent properties are given explicitly.
+            const auto& props = this->es.get3DProperties();
+            const auto& double_props = props.getDoubleProperties();
+            const auto host_values = [&]( const std::string& keyword, double default_value ) {
+                if (double_props.hasKeyword( keyword ))
+                    return double_props.getKeyword( keyword ).getData();
+
+                return std::vector<double>( this->grid.getCartesianSize(), default_value );
+            };
+
+            const auto& porv = props.getDoubleGridProperty("PORV").getData();
+            const auto host_multpv = host_values( "MULTPV", 1.0 );
+            const auto poro = lgr.property( "PORO", host_values( "PORO", std::numeric_limits<double>::quiet_NaN() ));
+            const auto ntg = lgr.property( "NTG", host_values( "NTG", 1.0 ));
+            const auto multpv = lgr.property( "MULTPV", host_multpv );
+            const auto lgr_porv = lgr.property( "PORV",
+                                                std::vector<double>( this->grid.getCartesianSize(), std::numeric_limits<double>::quiet_NaN() ),
+                                                deck_units.getDimension( "ReservoirVolume" ).getSIScaling() );
+            std::vector<double> ecl_data( lgr.getCartesianSize(), 0 );
+
+            for (size_t global_index = 0; global_index < ecl_data.size(); global_index++) {
+                if (!lgr_grid.cellActive( global_index ))
+                    continue;
+
+                const double cell_volume = lgr_grid.getCellVolume( global_index );
+                if (std::isfinite( lgr_porv[global_index] ))
+                    ecl_data[global_index] = lgr_porv[global_index] * multpv[global_index];
+                else if (std::isfinite( poro[global_index] ))
+                    ecl_data[global_index] = poro[global_index] * ntg[global_index] * cell_volume * multpv[global_index];
+                else {
+                    const size_t host = lgr.getHostCell( global_index );
+                    const double host_volume = this->grid.getCellVolume( host );
+                    if (host_volume > 0 && host_multpv[host] != 0)
+                        ecl_data[global_index] = porv[host] * cell_volume / host_volume * multpv[global_index] / host_multpv[host];
+                }
+            }
+
+            units.from_si( UnitSystem::measure::volume, ecl_data );
+            writeKeyword( fortio, "PORV" , ecl_data );
+        }
+
+        ecl_grid_fwrite_depth( lgr_grid.c_ptr() , fortio.get() , units.getEclType( ) );
+        ecl_grid_fwrite_dims( lgr_grid.c_ptr() , fortio.get() , units.getEclType( ) );
+
+        {
+            const auto& properties = this->es.get3DProperties().getDoubleProperties();
+            for (const auto& kw_pair : doubleKeywords) {
+                if (properties.hasKeyword( kw_pair.first)) {
+                    const auto& opm_property = properties.getKeyword(kw_pair.first);
+                    const double si_scaling = deck_units.getDimension( opm_property.getDimensionString() ).getSIScaling();
+                    auto ecl_data = lgr_grid.compressedVector( lgr.property( kw_pair.first, opm_property.getData(), si_scaling ));
+
+                    units.from_si( kw_pair.second, ecl_data );
+                    writeKeyword( fortio, kw_pair.first, ecl_data );
+                }
+            }
+        }
+
+        for (const auto& property : this->es.get3DProperties().getIntProperties()) {
+            auto ecl_data = lgr_grid.compressedVector( lgr.property( property.getKeywordName(), property.getData() ));
+            writeKeyword( fortio , property.getKeywordName() , ecl_data );
+        }
+
+        writeKeyword( fortio, ENDLGR_KW, std::vector<int>() );
+    }
 }
 
 
@@ -381,14 +637,9 @@ void EclipseIO::Impl::writeEGRIDFile( const NNC& nnc ) const {
                                               ECL_EGRID_FILE,
                                               ioConfig.getFMTOUT() ));
 
-    {
-        int idx = 0;
-        auto* ecl_grid = const_cast< ecl_grid_type* >( this->grid.c_ptr() );
-        for (const NNCdata& n : nnc.nncdata())
-            ecl_grid_add_self_nnc( ecl_grid, n.cell1, n.cell2, idx++);
-
-        ecl_grid_fwrite_EGRID2(ecl_grid, egridFile.c_str(), this->es.getDeckUnitSystem().getEclType() );
-    }
+    const auto& units = this->es.getDeckUnitSystem();
+    EclIO::EclOutput output( egridFile, ioConfig.getFMTOUT() );
+    writeEGRID( output, this->grid, units, nnc );
 }
 
 /*
@@ -415,6 +666,59 @@ void EclipseIO::writeInitial( data::Solution simProps, std::map<std::string, std
 }
 
 // implementation of the writeTimeStep method
+void EclipseIO::Impl::writeRestartAndRFT(int report_step,
+                                         bool isSubstep,
+                                         double secs_elapsed,
+                                         RestartValue value,
+                                         bool write_double)
+{
+    const auto& units = this->es.getUnits();
+    const auto& ioConfig = this->es.getIOConfig();
+    const auto& restart = this->es.cfg().restart();
+
+    /*
+      Current implementation will not write restart files for substep,
+      but there is an unsupported option to the RPTSCHED keyword which
+      will request restart output from every timestep.
+    */
+    if(!isSubstep && restart.getWriteRestartFile(report_step))
+    {
+        if (this->unified_restart)
+            RestartIO::save( *this->unified_restart , report_step, secs_elapsed, value, this->es , this->grid , this->schedule, write_double);
+        else {
+            std::string filename = ERT::EclFilename( this->outputDir,
+                                                     this->baseName,
+                                                     ECL_RESTART_FILE,
+                                                     report_step,
+                                                     ioConfig.getFMTOUT() );
+
+            RestartIO::save( filename , report_step, secs_elapsed, value, this->es , this->grid , this->schedule, write_double);
+        }
+    }
+
+
+    /*
+      RFT files are not written for substep.
+    */
+    if( isSubstep )
+        return;
+
+    {
+        std::vector<const Well*> sched_wells = this->schedule.getWells( report_step );
+        const auto rft_active = [report_step] (const Well* w) { return w->getRFTActive( report_step ) || w->getPLTActive( report_step ); };
+        if (std::any_of(sched_wells.begin(), sched_wells.end(), rft_active)) {
+            this->rft.writeTimeStep( sched_wells,
+                                     this->grid,
+                                     report_step,
+                                     secs_elapsed + this->schedule.posixStartTime(),
+                                     units.from_si( UnitSystem::measure::time, secs_elapsed ),
+                                     units,
+                                     value.wells );
+        }
+    }
+}
+
+
 void EclipseIO::writeTimeStep(int report_step,
                               bool  isSubstep,
                               double secs_elapsed,
@@ -428,15 +732,11 @@ void EclipseIO::writeTimeStep(int report_step,
     if( !this->impl->output_enabled )
         return;
 
-
-    const auto& es = this->impl->es;
-    const auto& grid = this->impl->grid;
-    const auto& schedule = this->impl->schedule;
-    const auto& units = es.getUnits();
-    const auto& ioConfig = es.getIOConfig();
-    const auto& restart = es.cfg().restart();
-
-
+    /*
+      The simulator fills the wells directly; index the completions
+      once here for the summary, RFT and restart lookups.
+    */
+    value.wells.index_completions();
 
     /*
       Summary data is written unconditionally for every timestep.
@@ -444,8 +744,8 @@ void EclipseIO::writeTimeStep(int report_step,
     {
         this->impl->summary.add_timestep( report_step,
                                           secs_elapsed,
-                                          es,
-                                          schedule,
+                                          this->impl->es,
+                                          this->impl->schedule,
                                           value.wells ,
                                           single_summary_values ,
                                           region_summary_values,
@@ -453,44 +753,46 @@ void EclipseIO::writeTimeStep(int report_step,
         this->impl->summary.write();
     }
 
+    this->impl->writeRestartAndRFT( report_step, isSubstep, secs_elapsed, std::move( value ), write_double );
+ }
 
-    /*
-      Current implementation will not write restart files for substep,
-      but there is an unsupported option to the RPTSCHED keyword which
-      will request restart output from every timestep.
-    */
-    if(!isSubstep && restart.getWriteRestartFile(report_step))
-    {
-        std::string filename = ERT::EclFilename( this->impl->outputDir,
-                                                 this->impl->baseName,
-                                                 ioConfig.getUNIFOUT() ? ECL_UNIFIED_RESTART_FILE : ECL_RESTART_FILE,
-                                                 report_step,
-                                                 ioConfig.getFMTOUT() );
 
-        RestartIO::save( filename , report_step, secs_elapsed, value, es , grid , schedule, write_double);
-    }
+int EclipseIO::registerSummaryValue( const std::string& keyword ) {
+    return this->impl->summary.register_value( keyword );
+}
 
 
-    /*
-      RFT files are not written for substep.
-    */
-    if( isSubstep )
+int EclipseIO::registerRegionSummaryValue( const std::string& keyword, int region ) {
+    return this->impl->summary.register_region_value( keyword, region );
+}
+
+
+int EclipseIO::registerBlockSummaryValue( const std::string& keyword, int block ) {
+    return this->impl->summary.register_block_value( keyword, block );
+}
+
+
+void EclipseIO::writeTimeStep(int report_step,
+                              bool  isSubstep,
+                              double secs_elapsed,
+                              RestartValue value,
+                              const std::vector<double>& summary_values,
+                              bool write_double)
+ {
+
+    if( !this->impl->output_enabled )
         return;
 
-    {
-        std::vector<const Well*> sched_wells = this->impl->schedule.getWells( report_step );
-        const auto rft_active = [report_step] (const Well* w) { return w->getRFTActive( report_step ) || w->getPLTActive( report_step ); };
-        if (std::any_of(sched_wells.begin(), sched_wells.end(), rft_active)) {
-            this->impl->rft.writeTimeStep( sched_wells,
-                                           grid,
-                                           report_step,
-                                           secs_elapsed + this->impl->schedule.posixStartTime(),
-                                           units.from_si( UnitSystem::measure::time, secs_elapsed ),
-                                           units,
-                                           value.wells );
-        }
-    }
+    value.wells.index_completions();
+    this->impl->summary.add_registered_timestep( report_step,
+                                                 secs_elapsed,
+                                                 this->impl->es,
+                                                 this->impl->schedule,
+                                                 value.wells ,
+                                                 summary_values );
+    this->impl->summary.write();
 
+    this->impl->writeRestartAndRFT( report_step, isSubstep, secs_elapsed, std::move( value ), write_double );
  }
 
 
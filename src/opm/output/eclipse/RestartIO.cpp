@@ -23,12 +23,16 @@
 #include <string>
 #include <vector>
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/Eqldims.hpp>
 
 #include <opm/output/eclipse/RestartIO.hpp>
+#include <opm/output/eclipse/WriteRestartHelpers.hpp>
 
 #include <ert/ecl/EclKW.hpp>
 #include <ert/ecl/FortIO.hpp>
@@ -55,17 +59,24 @@ namespace RestartIO  {
 
 namespace {
 
-    static const int NIWELZ = 11; //Number of data elements per well in IWEL array in restart file
+    static const int NIWELZ = IWEL_SEGMENTED_WELL_NR_INDEX + 1; //Number of data elements per well in IWEL array in restart file
     static const int NZWELZ = 3;  //Number of 8-character words per well in ZWEL array restart file
     static const int NICONZ = 15; //Number of data elements per completion in ICON array restart file
+    static const int NISEGZ = 22; //Number of data elements per segment in ISEG array restart file
+    static const int NRSEGZ = 140; //Number of data elements per segment in RSEG array restart file
+    static const int NILBRZ = 10; //Number of data elements per branch in ILBR array restart file
 
     /**
      * The constants NIWELZ and NZWELZ referes to the number of
      * elements per well that we write to the IWEL and ZWEL eclipse
      * restart file data arrays. The constant NICONZ refers to the
      * number of elements per completion in the eclipse restart file
-     * ICON data array.These numbers are written to the INTEHEAD
-     * header.
+     * ICON data array, and NISEGZ, NRSEGZ and NILBRZ to the number of
+     * elements per segment and branch in the ISEG, RSEG and ILBR
+     * arrays of the multi segment wells. These numbers are written to
+     * the INTEHEAD header. IWEL extends to the segmented well number,
+     * which links a multi segment well to its records in ISEG and
+     * RSEG.
      *
      * Observe that all of these values are our "current-best-guess"
      * for how many numbers are needed; there might very well be third
@@ -211,6 +222,7 @@ data::Wells restore_wells( const ecl_kw_type * opm_xwel,
         }
     }
 
+    wells.index_completions();
     return wells;
 }
 }
@@ -246,7 +258,13 @@ RestartValue load( const std::string& filename,
     const ecl_kw_type * opm_iwel = ecl_file_view_iget_named_kw( file_view, "OPM_IWEL", 0 );
 
     UnitSystem units( static_cast<ert_ecl_unit_enum>(ecl_kw_iget_int( intehead , INTEHEAD_UNIT_INDEX )));
-    RestartValue rst_value( restoreSOLUTION( file_view, solution_keys, grid.getNumActive( )),
+
+    // The tracer concentrations are restored when present in the file.
+    auto restart_keys = solution_keys;
+    for (const auto& tracer : es.tracer())
+        restart_keys.emplace_back( tracer.restartKey(), UnitSystem::measure::identity, false );
+
+    RestartValue rst_value( restoreSOLUTION( file_view, restart_keys, grid.getNumActive( )),
                             restore_wells( opm_xwel, opm_iwel, sim_step , es, grid, schedule));
 
     for (const auto& extra : extra_keys) {
@@ -312,11 +330,17 @@ std::vector<int> serialize_ICON( int sim_step,
     return data;
 }
 
+/*
+  The segmented well number is the one based position of the well among
+  the multi segment wells, which is the order of the wells in ISEG and
+  RSEG; it is -1 for a well which is not multi segment.
+*/
 std::vector<int> serialize_IWEL( size_t step,
                                  const std::vector<const Well *>& wells) {
 
     std::vector<int> data( wells.size() * NIWELZ , 0 );
     size_t offset = 0;
+    int segmented_well_nr = 0;
     for (const auto well : wells) {
         const auto& completions = well->getCompletions( step );
 
@@ -328,6 +352,8 @@ std::vector<int> serialize_IWEL( size_t step,
         data[ offset + IWEL_TYPE_INDEX ] = to_ert_welltype( *well, step );
         data[ offset + IWEL_STATUS_INDEX ] =
             well->getStatus( step ) == WellCommon::OPEN ? 1 : 0;
+        data[ offset + IWEL_SEGMENTED_WELL_NR_INDEX ] =
+            well->isMultiSegment( step ) ? ++segmented_well_nr : -1;
 
         offset += NIWELZ;
     }
@@ -400,14 +426,9 @@ std::vector< double > serialize_OPM_XWEL( const data::Wells& wells,
             }
 
             const auto active_index = grid.activeIndex( i, j, k );
-            const auto at_index = [=]( const data::Completion& c ) {
-                return c.index == active_index;
-            };
-            const auto& completion = std::find_if( well.completions.begin(),
-                                                   well.completions.end(),
-                                                   at_index );
-
-            if( completion == well.completions.end() ) {
+            const auto* completion = well.find_completion( active_index );
+
+            if( !completion ) {
                 xwel.insert( xwel.end(), rs_size, 0.0 );
                 continue;
             }
@@ -465,6 +486,18 @@ void writeHeader(ecl_rst_file_type * rst_file,
     rsthead_data.nzwelz      = NZWELZ;
     rsthead_data.niconz      = NICONZ;
     rsthead_data.ncwmax      = schedule.getMaxNumCompletionsForWells(sim_step);
+
+    {
+        const auto sched_wells = schedule.getWells(sim_step);
+        const auto segment_dims = Helpers::maxSegmentDimensions(sim_step, sched_wells);
+        rsthead_data.nswlmx  = Helpers::numSegmentedWells(sim_step, sched_wells);
+        rsthead_data.nsegmx  = segment_dims.first;
+        rsthead_data.nlbrmx  = segment_dims.second;
+        rsthead_data.nisegz  = NISEGZ;
+        rsthead_data.nrsegz  = NRSEGZ;
+        rsthead_data.nilbrz  = NILBRZ;
+    }
+
     rsthead_data.phase_sum   = ert_phase_mask;
     rsthead_data.sim_days    = sim_days;
     rsthead_data.unit_system = units.getEclType( );
@@ -526,6 +559,25 @@ void writeHeader(ecl_rst_file_type * rst_file,
 
 
 
+/*
+  The segment arrays are only written if there are multi segment wells.
+  The per well segment and branch tables are dense in the segment and
+  branch numbers, so the work is proportional to the number of segments.
+*/
+void writeSegments(ecl_rst_file_type* rst_file, int sim_step, const UnitSystem& units, const std::vector<const Well*>& sched_wells, const data::Wells& wells) {
+    if (Helpers::numSegmentedWells(sim_step, sched_wells) == 0)
+        return;
+
+    const auto segment_dims = Helpers::maxSegmentDimensions(sim_step, sched_wells);
+    const int nsegmx = segment_dims.first;
+    const int nlbrmx = segment_dims.second;
+
+    write_kw( rst_file, ERT::EclKW< int >( ISEG_KW, Helpers::serialize_ISEG( sim_step, nsegmx, NISEGZ, sched_wells ) ) );
+    write_kw( rst_file, ERT::EclKW< double >( RSEG_KW, Helpers::serialize_RSEG( sim_step, nsegmx, NRSEGZ, sched_wells, wells, units ) ) );
+    write_kw( rst_file, ERT::EclKW< int >( ILBS_KW, Helpers::serialize_ILBS( sim_step, nlbrmx, sched_wells ) ) );
+    write_kw( rst_file, ERT::EclKW< int >( ILBR_KW, Helpers::serialize_ILBR( sim_step, nlbrmx, NILBRZ, sched_wells ) ) );
+}
+
 void writeWell(ecl_rst_file_type* rst_file, int sim_step, const EclipseState& es , const EclipseGrid& grid, const Schedule& schedule, const data::Wells& wells) {
     const auto sched_wells  = schedule.getWells(sim_step);
     const auto& phases = es.runspec().phases();
@@ -542,6 +594,8 @@ void writeWell(ecl_rst_file_type* rst_file, int sim_step, const EclipseState& es
     write_kw( rst_file, ERT::EclKW< double >( OPM_XWEL, opm_xwel ) );
     write_kw( rst_file, ERT::EclKW< int >( OPM_IWEL, opm_iwel ) );
     write_kw( rst_file, ERT::EclKW< int >( ICON_KW, icon_data ) );
+
+    writeSegments( rst_file, sim_step, es.getUnits(), sched_wells, wells );
 }
 
 void checkSaveArguments(const EclipseState& es,
@@ -568,9 +622,105 @@ void checkSaveArguments(const EclipseState& es,
           throw std::runtime_error("THPRES vector has invalid size - should have num_region * num_regions.");
   }
 }
+
+
+void writeStep(ecl_rst_file_type * rst_file,
+               int report_step,
+               double seconds_elapsed,
+               RestartValue value,
+               const EclipseState& es,
+               const EclipseGrid& grid,
+               const Schedule& schedule,
+               bool write_double)
+{
+    int sim_step = std::max(report_step - 1, 0);
+    int ert_phase_mask = es.runspec().eclPhaseMask( );
+    const auto& units = es.getUnits();
+    time_t posix_time = schedule.posixStartTime() + seconds_elapsed;
+    const auto sim_time = units.from_si( UnitSystem::measure::time, seconds_elapsed );
+
+    // Convert solution fields and extra values from SI to user units.
+    value.solution.convertFromSI(units);
+    for (auto & extra_value : value.extra) {
+        const auto& restart_key = extra_value.first;
+        auto & data = extra_value.second;
+
+        units.from_si(restart_key.dim, data);
+    }
+
+    writeHeader( rst_file, sim_step, report_step, posix_time , sim_time, ert_phase_mask, units, schedule , grid );
+    writeWell( rst_file, sim_step, es , grid, schedule, value.wells);
+    writeSolution( rst_file, value.solution, write_double );
+    writeExtraData( rst_file, value.extra );
+}
+
+
+std::size_t fileSize(const std::string& filename) {
+    struct stat st;
+    if (::stat( filename.c_str(), &st ) != 0)
+        return 0;
+
+    return st.st_size;
+}
 } // Anonymous namespace
 
 
+UnifiedRestartFile::UnifiedRestartFile(const std::string& filename) :
+    m_filename( filename )
+{
+    if (ERT::EclFiletype( filename ) != ECL_UNIFIED_RESTART_FILE)
+        throw std::invalid_argument("The file: " + filename + " is not a unified restart file");
+}
+
+
+const std::string& UnifiedRestartFile::filename() const {
+    return this->m_filename;
+}
+
+
+bool UnifiedRestartFile::hasStep(int report_step) const {
+    return this->m_offsets.count( report_step ) > 0;
+}
+
+
+std::size_t UnifiedRestartFile::offset(int report_step) const {
+    const auto iter = this->m_offsets.find( report_step );
+    if (iter == this->m_offsets.end())
+        throw std::invalid_argument("Report step " + std::to_string( report_step ) + " has not been written to: " + this->m_filename);
+
+    return iter->second;
+}
+
+
+ERT::ert_unique_ptr< ecl_rst_file_type, ecl_rst_file_close > UnifiedRestartFile::openStep(int report_step) {
+    ERT::ert_unique_ptr< ecl_rst_file_type, ecl_rst_file_close > rst_file;
+
+    if (this->m_offsets.empty() || report_step < this->m_offsets.begin()->first) {
+        /*
+          The file can contain report steps we have no offsets for,
+          i.e. from an earlier run; ERT will locate the report step and
+          truncate the file there.
+        */
+        rst_file.reset( ecl_rst_file_open_write_seek( this->m_filename.c_str(), report_step ) );
+        this->m_offsets.clear();
+        this->m_offsets[report_step] = fileSize( this->m_filename );
+        return rst_file;
+    }
+
+    const auto first_stale = this->m_offsets.lower_bound( report_step );
+    if (first_stale != this->m_offsets.end()) {
+        if (::truncate( this->m_filename.c_str(), first_stale->second ) != 0)
+            throw std::runtime_error("Truncating the restart file: " + this->m_filename + " failed");
+
+        this->m_offsets.erase( first_stale, this->m_offsets.end() );
+    }
+
+    this->m_offsets[report_step] = fileSize( this->m_filename );
+    rst_file.reset( ecl_rst_file_open_append( this->m_filename.c_str() ) );
+    return rst_file;
+}
+
+
 void save(const std::string& filename,
           int report_step,
           double seconds_elapsed,
@@ -582,11 +732,6 @@ void save(const std::string& filename,
 {
     checkSaveArguments(es, value, grid);
     {
-        int sim_step = std::max(report_step - 1, 0);
-        int ert_phase_mask = es.runspec().eclPhaseMask( );
-        const auto& units = es.getUnits();
-        time_t posix_time = schedule.posixStartTime() + seconds_elapsed;
-        const auto sim_time = units.from_si( UnitSystem::measure::time, seconds_elapsed );
         ERT::ert_unique_ptr< ecl_rst_file_type, ecl_rst_file_close > rst_file;
 
         if (ERT::EclFiletype( filename ) == ECL_UNIFIED_RESTART_FILE)
@@ -594,19 +739,24 @@ void save(const std::string& filename,
         else
             rst_file.reset( ecl_rst_file_open_write( filename.c_str() ) );
 
-        // Convert solution fields and extra values from SI to user units.
-        value.solution.convertFromSI(units);
-        for (auto & extra_value : value.extra) {
-            const auto& restart_key = extra_value.first;
-            auto & data = extra_value.second;
+        writeStep( rst_file.get(), report_step, seconds_elapsed, std::move( value ), es, grid, schedule, write_double );
+    }
+}
 
-            units.from_si(restart_key.dim, data);
-        }
 
-        writeHeader( rst_file.get(), sim_step, report_step, posix_time , sim_time, ert_phase_mask, units, schedule , grid );
-        writeWell( rst_file.get(), sim_step, es , grid, schedule, value.wells);
-        writeSolution( rst_file.get(), value.solution, write_double );
-        writeExtraData( rst_file.get(), value.extra );
+void save(UnifiedRestartFile& rst_file,
+          int report_step,
+          double seconds_elapsed,
+          RestartValue value,
+          const EclipseState& es,
+          const EclipseGrid& grid,
+          const Schedule& schedule,
+          bool write_double)
+{
+    checkSaveArguments(es, value, grid);
+    {
+        auto ecl_rst_file = rst_file.openStep( report_step );
+        writeStep( ecl_rst_file.get(), report_step, seconds_elapsed, std::move( value ), es, grid, schedule, write_double );
     }
 }
 }
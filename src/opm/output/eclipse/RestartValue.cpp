@@ -81,5 +81,24 @@ namespace Opm {
         this->addExtra(key, UnitSystem::measure::identity, std::move(data));
     }
 
+    void RestartValue::addTracer(const TracerConfig::TracerEntry& tracer, std::vector<double> concentration) {
+        const auto key = tracer.restartKey();
+        if (key.size() > 8)
+            throw std::runtime_error("The keys used for Eclipse output must be maximum 8 characters long.");
+
+        if (this->hasExtra(key))
+            throw std::runtime_error("The key " + key + " is already present in the extra vector.");
+
+        this->solution.insert(key, UnitSystem::measure::identity, std::move(concentration), data::TargetType::RESTART_SOLUTION);
+    }
+
+    bool RestartValue::hasTracer(const TracerConfig::TracerEntry& tracer) const {
+        return this->solution.has(tracer.restartKey());
+    }
+
+    const std::vector<double>& RestartValue::getTracer(const TracerConfig::TracerEntry& tracer) const {
+        return this->solution.data(tracer.restartKey());
+    }
+
 
 }
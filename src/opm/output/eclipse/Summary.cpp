@@ -245,14 +245,8 @@ inline quantity crate( const fn_args& args ) {
     const auto& name = args.schedule_wells.front()->name();
     if( args.wells.count( name ) == 0 ) return zero;
 
-    const auto& well = args.wells.at( name );
-    const auto& completion = std::find_if( well.completions.begin(),
-                                           well.completions.end(),
-                                           [=]( const data::Completion& c ) {
-                                                return c.index == global_index;
-                                           } );
-
-    if( completion == well.completions.end() ) return zero;
+    const auto* completion = args.wells.at( name ).find_completion( global_index );
+    if( !completion ) return zero;
 
     double eff_fac = efac( args.eff_factors, name );
 
@@ -263,6 +257,49 @@ inline quantity crate( const fn_args& args ) {
     return { v, rate_unit< phase >() };
 }
 
+inline const std::vector< double >& segment_rates( const data::Segments& segments,
+                                                   rt phase ) {
+    switch( phase ) {
+        case rt::wat: return segments.water_rate;
+        case rt::gas: return segments.gas_rate;
+        default:      return segments.oil_rate;
+    }
+}
+
+/*
+ * The segment rates are reported positive in the direction of production,
+ * i.e. towards the well head.
+ */
+template< rt phase >
+inline quantity srate( const fn_args& args ) {
+    const quantity zero = { 0, rate_unit< phase >() };
+    // The args.num value is the segment number, which is the NUMS value
+    // of the summary vector.
+    if( args.schedule_wells.empty() ) return zero;
+
+    const auto itr = args.wells.find( args.schedule_wells.front()->name() );
+    if( itr == args.wells.end() ) return zero;
+
+    const auto& segments = itr->second.segments;
+    if( !segments.has( args.num ) ) return zero;
+
+    const auto v = segment_rates( segments, phase )[ args.num - 1 ];
+    return { -v, rate_unit< phase >() };
+}
+
+inline quantity spress( const fn_args& args ) {
+    const quantity zero = { 0, measure::pressure };
+    if( args.schedule_wells.empty() ) return zero;
+
+    const auto itr = args.wells.find( args.schedule_wells.front()->name() );
+    if( itr == args.wells.end() ) return zero;
+
+    const auto& segments = itr->second.segments;
+    if( !segments.has( args.num ) ) return zero;
+
+    return { segments.pressure[ args.num - 1 ], measure::pressure };
+}
+
 inline quantity bhp( const fn_args& args ) {
     const quantity zero = { 0, measure::pressure };
     if( args.schedule_wells.empty() ) return zero;
@@ -605,6 +642,11 @@ static const std::unordered_map< std::string, ofun > funs = {
     { "CGPT", mul( crate< rt::gas, producer >, duration ) },
     { "CNPT", mul( crate< rt::solvent, producer >, duration ) },
 
+    { "SOFR", srate< rt::oil > },
+    { "SWFR", srate< rt::wat > },
+    { "SGFR", srate< rt::gas > },
+    { "SPR",  spress },
+
     { "FWPR", rate< rt::wat, producer > },
     { "FOPR", rate< rt::oil, producer > },
     { "FGPR", rate< rt::gas, producer > },
@@ -747,6 +789,65 @@ static const std::unordered_map< std::string, UnitSystem::measure> block_units =
   {"BGSAS"      , UnitSystem::measure::identity},
 };
 
+template< bool injection >
+inline quantity tracer_rate( const fn_args& args, size_t tracer_index, measure unit ) {
+    double sum = 0.0;
+
+    for( const auto* sched_well : args.schedule_wells ) {
+        const auto& name = sched_well->name();
+        if( args.wells.count( name ) == 0 ) continue;
+
+        const auto& tracer_rates = args.wells.at( name ).tracer_rates;
+        if( tracer_rates.size() <= tracer_index ) continue;
+
+        const auto v = tracer_rates[ tracer_index ] * efac( args.eff_factors, name );
+        if( ( v > 0 ) == injection )
+            sum += v;
+    }
+
+    if( !injection ) sum *= -1;
+    return { sum, unit };
+}
+
+/*
+  The tracer keywords are formed from the W, G or F prefix, one of TPR,
+  TPT, TIR or TIT and the name of the tracer, e.g. WTPRSEA. The tracer
+  rates are given in the units of the surface rate of the carrier
+  phase. The function is empty if the keyword is not a tracer keyword.
+*/
+struct tracer_keyword {
+    ofun fn;
+    bool total;
+};
+
+inline tracer_keyword tracer_function( const TracerConfig& tracers, const std::string& keyword ) {
+    if( keyword.size() < 5 ) return { nullptr, false };
+    if( keyword[0] != 'W' && keyword[0] != 'G' && keyword[0] != 'F' ) return { nullptr, false };
+
+    const auto kind = keyword.substr( 1, 3 );
+    const auto name = keyword.substr( 4 );
+    if( !tracers.has( name ) ) return { nullptr, false };
+
+    const auto index = tracers.index( name );
+    const auto unit = tracers[ index ].phase == Phase::GAS
+        ? measure::gas_surface_rate
+        : measure::liquid_surface_rate;
+
+    const ofun injection = [index, unit]( const fn_args& args ) {
+        return tracer_rate< injector >( args, index, unit );
+    };
+    const ofun production = [index, unit]( const fn_args& args ) {
+        return tracer_rate< producer >( args, index, unit );
+    };
+
+    if( kind == "TIR" ) return { injection, false };
+    if( kind == "TPR" ) return { production, false };
+    if( kind == "TIT" ) return { mul( injection, duration ), true };
+    if( kind == "TPT" ) return { mul( production, duration ), true };
+
+    return { nullptr, false };
+}
+
 inline std::vector< const Well* > find_wells( const Schedule& schedule,
                                               const smspec_node_type* node,
                                               const int sim_step,
@@ -755,7 +856,9 @@ inline std::vector< const Well* > find_wells( const Schedule& schedule,
     const auto* name = smspec_node_get_wgname( node );
     const auto type = smspec_node_get_var_type( node );
 
-    if( type == ECL_SMSPEC_WELL_VAR || type == ECL_SMSPEC_COMPLETION_VAR ) {
+    if( type == ECL_SMSPEC_WELL_VAR
+        || type == ECL_SMSPEC_COMPLETION_VAR
+        || type == ECL_SMSPEC_SEGMENT_VAR ) {
         const auto* well = schedule.getWell( name );
         if( !well ) return {};
         return { well };
@@ -804,6 +907,22 @@ class Summary::keyword_handlers {
         std::map< std::pair <std::string, int>, smspec_node_type* > region_nodes;
         std::map< std::pair <std::string, int>, smspec_node_type* > block_nodes;
 
+        /*
+          The tracer totals are accumulated here, ert does not know
+          them as totals.
+        */
+        std::set< const smspec_node_type* > tracer_totals;
+
+        /*
+          The values registered with the register_xxx() methods; the
+          node pointer is nullptr for values which have not been
+          requested in the SUMMARY section.
+        */
+        struct registered_value {
+            smspec_node_type* node;
+            UnitSystem::measure unit;
+        };
+        std::vector< registered_value > registered_values;
 
 };
 
@@ -867,6 +986,7 @@ Summary::Summary( const EclipseState& st,
         const auto funs_pair = funs.find( keyword );
         const auto region_pair = region_units.find( keyword );
         const auto block_pair = block_units.find( keyword );
+        const auto tracer = tracer_function( st.tracer(), keyword );
 
         /*
       All summary values of the type ECL_SMSPEC_MISC_VAR
@@ -918,7 +1038,7 @@ Summary::Summary( const EclipseState& st,
 
 
 
-        } else if (funs_pair != funs.end()) {
+        } else if (funs_pair != funs.end() || tracer.fn) {
 
             if ((node.type() == ECL_SMSPEC_COMPLETION_VAR) || (node.type() == ECL_SMSPEC_BLOCK_VAR)) {
                 int global_index = node.num() - 1;
@@ -927,7 +1047,7 @@ Summary::Summary( const EclipseState& st,
             }
 
             /* get unit strings by calling each function with dummy input */
-            const auto handle = funs_pair->second;
+            const auto handle = funs_pair != funs.end() ? funs_pair->second : tracer.fn;
             const std::vector< const Well* > dummy_wells;
 
             const fn_args no_args { dummy_wells, // Wells from Schedule object
@@ -947,6 +1067,9 @@ Summary::Summary( const EclipseState& st,
                                              st.getUnits().name( val.unit ),
                                              0 );
 
+            if (tracer.total)
+                this->handlers->tracer_totals.insert( nodeptr );
+
             this->handlers->handlers.emplace_back( nodeptr, handle );
         } else {
             unsupported_keywords.insert(keyword);
@@ -1017,14 +1140,39 @@ well_efficiency_factors( const smspec_node_type* type,
     return efac;
 }
 
-void Summary::add_timestep( int report_step,
-                            double secs_elapsed,
-                            const EclipseState& es,
-                            const Schedule& schedule,
-                            const data::Wells& wells ,
-                            const std::map<std::string, double>& single_values,
-                            const std::map<std::string, std::vector<double>>& region_values,
-                            const std::map<std::pair<std::string, int>, double>& block_values) {
+/*
+ * The SummaryState holds the values in output units, as the ACTIONX
+ * conditions are given in the units of the deck.
+ */
+void update_summary_state( SummaryState& summary_state,
+                           const smspec_node_type* node,
+                           double value ) {
+    const std::string keyword = smspec_node_get_keyword( node );
+
+    switch( smspec_node_get_var_type( node ) ) {
+        case ECL_SMSPEC_WELL_VAR:
+            summary_state.update_well_var( smspec_node_get_wgname( node ), keyword, value );
+            break;
+
+        case ECL_SMSPEC_GROUP_VAR:
+            summary_state.update_group_var( smspec_node_get_wgname( node ), keyword, value );
+            break;
+
+        case ECL_SMSPEC_FIELD_VAR:
+        case ECL_SMSPEC_MISC_VAR:
+            summary_state.update( keyword, value );
+            break;
+
+        default:
+            summary_state.update( smspec_node_get_gen_key1( node ), value );
+    }
+}
+
+ecl_sum_tstep_type* Summary::add_handler_values( int report_step,
+                                                 double secs_elapsed,
+                                                 const EclipseState& es,
+                                                 const Schedule& schedule,
+                                                 const data::Wells& wells ) {
 
     auto* tstep = ecl_sum_add_tstep( this->ecl_sum.get(), report_step, secs_elapsed );
     const double duration = secs_elapsed - this->prev_time_elapsed;
@@ -1052,13 +1200,30 @@ void Summary::add_timestep( int report_step,
                                      eff_factors});
 
         const auto unit_applied_val = es.getUnits().from_si( val.unit, val.value );
-        const auto res = smspec_node_is_total( f.first ) && prev_tstep
+        const bool total = smspec_node_is_total( f.first )
+            || this->handlers->tracer_totals.count( f.first ) > 0;
+        const auto res = total && prev_tstep
             ? ecl_sum_tstep_get_from_key( prev_tstep, genkey ) + unit_applied_val
             : unit_applied_val;
 
 	ecl_sum_tstep_set_from_node( tstep, f.first, res );
+        update_summary_state( this->summary_state, f.first, res );
     }
 
+    return tstep;
+}
+
+void Summary::add_timestep( int report_step,
+                            double secs_elapsed,
+                            const EclipseState& es,
+                            const Schedule& schedule,
+                            const data::Wells& wells ,
+                            const std::map<std::string, double>& single_values,
+                            const std::map<std::string, std::vector<double>>& region_values,
+                            const std::map<std::pair<std::string, int>, double>& block_values) {
+
+    auto* tstep = this->add_handler_values( report_step, secs_elapsed, es, schedule, wells );
+
     for( const auto& value_pair : single_values ) {
         const std::string key = value_pair.first;
         const auto node_pair = this->handlers->single_value_nodes.find( key );
@@ -1068,6 +1233,7 @@ void Summary::add_timestep( int report_step,
             double si_value = value_pair.second;
             double output_value = es.getUnits().from_si(unit , si_value );
             ecl_sum_tstep_set_from_node( tstep, nodeptr , output_value );
+            update_summary_state( this->summary_state, nodeptr, output_value );
         }
     }
 
@@ -1082,6 +1248,7 @@ void Summary::add_timestep( int report_step,
                 double si_value = value_pair.second[reg];
                 double output_value = es.getUnits().from_si(unit , si_value );
                 ecl_sum_tstep_set_from_node( tstep, nodeptr , output_value );
+                update_summary_state( this->summary_state, nodeptr, output_value );
             }
         }
     }
@@ -1095,6 +1262,7 @@ void Summary::add_timestep( int report_step,
             double si_value = value_pair.second;
             double output_value = es.getUnits().from_si(unit , si_value );
             ecl_sum_tstep_set_from_node( tstep, nodeptr , output_value );
+            update_summary_state( this->summary_state, nodeptr, output_value );
         }
     }
 
@@ -1102,6 +1270,79 @@ void Summary::add_timestep( int report_step,
     this->prev_time_elapsed = secs_elapsed;
 }
 
+int Summary::register_value( const std::string& keyword ) {
+    const auto unit_pair = single_values_units.find( keyword );
+    if (unit_pair == single_values_units.end())
+        throw std::invalid_argument("The keyword: " + keyword + " can not be supplied by the simulator");
+
+    const auto node_pair = this->handlers->single_value_nodes.find( keyword );
+    smspec_node_type* nodeptr = node_pair == this->handlers->single_value_nodes.end() ? nullptr : node_pair->second;
+
+    this->handlers->registered_values.push_back( { nodeptr, unit_pair->second } );
+    return this->handlers->registered_values.size() - 1;
+}
+
+int Summary::register_region_value( const std::string& keyword, int region ) {
+    const auto unit_pair = region_units.find( keyword );
+    if (unit_pair == region_units.end())
+        throw std::invalid_argument("The keyword: " + keyword + " can not be supplied by the simulator");
+
+    const auto node_pair = this->handlers->region_nodes.find( std::make_pair( keyword, region ) );
+    smspec_node_type* nodeptr = node_pair == this->handlers->region_nodes.end() ? nullptr : node_pair->second;
+
+    this->handlers->registered_values.push_back( { nodeptr, unit_pair->second } );
+    return this->handlers->registered_values.size() - 1;
+}
+
+int Summary::register_block_value( const std::string& keyword, int block ) {
+    const auto unit_pair = block_units.find( keyword );
+    if (unit_pair == block_units.end())
+        throw std::invalid_argument("The keyword: " + keyword + " can not be supplied by the simulator");
+
+    const auto node_pair = this->handlers->block_nodes.find( std::make_pair( keyword, block ) );
+    smspec_node_type* nodeptr = node_pair == this->handlers->block_nodes.end() ? nullptr : node_pair->second;
+
+    this->handlers->registered_values.push_back( { nodeptr, unit_pair->second } );
+    return this->handlers->registered_values.size() - 1;
+}
+
+size_t Summary::num_registered_values() const {
+    return this->handlers->registered_values.size();
+}
+
+void Summary::add_registered_timestep( int report_step,
+                                       double secs_elapsed,
+                                       const EclipseState& es,
+                                       const Schedule& schedule,
+                                       const data::Wells& wells ,
+                                       const std::vector<double>& registered_values) {
+
+    const auto& registered = this->handlers->registered_values;
+    if (registered_values.size() != registered.size())
+        throw std::invalid_argument("Wrong number of registered summary values: "
+                                    + std::to_string( registered_values.size() ) + " expected: "
+                                    + std::to_string( registered.size() ));
+
+    auto* tstep = this->add_handler_values( report_step, secs_elapsed, es, schedule, wells );
+    const auto& units = es.getUnits();
+
+    for (size_t handle = 0; handle < registered.size(); ++handle) {
+        const auto& value = registered[handle];
+        if (value.node) {
+            const double output_value = units.from_si( value.unit, registered_values[handle] );
+            ecl_sum_tstep_set_from_node( tstep, value.node, output_value );
+            update_summary_state( this->summary_state, value.node, output_value );
+        }
+    }
+
+    this->prev_tstep = tstep;
+    this->prev_time_elapsed = secs_elapsed;
+}
+
+const SummaryState& Summary::get_summary_state() const {
+    return this->summary_state;
+}
+
 void Summary::write() {
     ecl_sum_fwrite( this->ecl_sum.get() );
 }
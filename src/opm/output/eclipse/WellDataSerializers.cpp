@@ -19,8 +19,12 @@
 
 #include <opm/output/eclipse/WriteRestartHelpers.hpp>
 #include <ert/ecl_well/well_const.h> // containts ICON_XXX_INDEX
+#include <opm/output/data/Wells.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 // ----------------------------------------------------------------------------
@@ -38,7 +42,9 @@ serialize_SCON(int lookup_step,
     size_t well_offset = 0;
     for (const Opm::Well* well : sched_wells) {
         const auto& completions = well->getCompletions( lookup_step );
+        const auto multipliers = well->getConnectionMultipliers( lookup_step );
         size_t completion_offset = 0;
+        size_t completion_index = 0;
         bool explicit_ctf_not_found = false;
         for (const auto& completion : completions) {
             const size_t offset = well_offset + completion_offset;
@@ -49,7 +55,9 @@ serialize_SCON(int lookup_step,
                 // factor, we output an explicitly invalid value
                 // instead. This is acceptable since it will not be
                 // used (the explicit CTF factor is used instead).
-                const double ctf_SI = ctf.getValue();
+                // The CTF is written as used by the simulator, i.e.
+                // with the WPIMULT and WELPI multipliers applied.
+                const double ctf_SI = ctf.getValue() * multipliers[ completion_index ];
                 const double ctf_output = units.from_si(UnitSystem::measure::transmissibility, ctf_SI);
                 data[ offset + SCON_CF_INDEX ] = ctf_output;
                 data[ offset + SCON_KH_INDEX ] = UNIMPLEMENTED_VALUE;
@@ -66,6 +74,7 @@ serialize_SCON(int lookup_step,
                 explicit_ctf_not_found = true;
             }
             completion_offset += nsconz;
+            completion_index++;
         }
         if (explicit_ctf_not_found) {
             OpmLog::warning("restart output completion data missing",
@@ -113,3 +122,326 @@ serialize_ICON(int lookup_step,
 
     return data;
 }
+
+
+namespace {
+
+    // Item positions within the per segment records of ISEG and RSEG and
+    // the per branch records of ILBR. Only the leading items are written,
+    // the remaining items are left as zero.
+    namespace ISEG {
+        enum index : std::vector<int>::size_type {
+            SegOrder  = 0,  // Position of segment in search order, 1-based
+            OutletSeg = 1,  // Outlet segment number, zero for top segment
+            InletSeg  = 2,  // First inlet segment on the same branch
+            BranchNo  = 3,  // Branch number, zero for unused segment numbers
+            NumInlets = 4,  // Number of inlet segments
+        };
+    }
+
+    namespace RSEG {
+        enum index : std::vector<double>::size_type {
+            Length      =  0,  // Length of segment
+            DepthChange =  1,  // Depth difference to outlet segment
+            Diameter    =  2,  // Internal diameter
+            Roughness   =  3,  // Roughness
+            CrossArea   =  4,  // Cross sectional area
+            Volume      =  5,  // Segment volume
+            TotalLength =  6,  // Length down the tubing to the segment node
+            Depth       =  7,  // Depth of the segment node
+            TotalRate   =  8,  // Sum of the surface phase rates
+            WaterFrac   =  9,  // Water fraction of the total rate
+            GasFrac     = 10,  // Gas fraction of the total rate
+            Pressure    = 11,  // Segment pressure
+        };
+    }
+
+    namespace ILBR {
+        enum index : std::vector<int>::size_type {
+            OutletSeg = 0,  // Outlet segment of the branch, zero for the main stem
+            NumSegs   = 1,  // Number of segments in the branch
+            FirstSeg  = 2,  // Segment number of the first (heel) segment
+            LastSeg   = 3,  // Segment number of the last (toe) segment
+            FirstPos  = 4,  // Position of the first segment in search order, 0-based
+        };
+    }
+
+    std::vector<const Opm::Well*>
+    segmentedWells(const int lookup_step,
+                   const std::vector<const Opm::Well*>& sched_wells)
+    {
+        std::vector<const Opm::Well*> wells;
+        for (const Opm::Well* well : sched_wells) {
+            if (well->isMultiSegment(lookup_step))
+                wells.push_back(well);
+        }
+
+        return wells;
+    }
+
+    int firstInletOnBranch(const Opm::SegmentSet& segments,
+                           const Opm::Segment& segment)
+    {
+        for (const int inlet : segment.inletSegments()) {
+            const int index = segments.segmentNumberToIndex(inlet);
+            if (index >= 0 && segments[index].branchNumber() == segment.branchNumber())
+                return inlet;
+        }
+
+        return 0;
+    }
+
+    int maxBranchNumber(const Opm::SegmentSet& segments)
+    {
+        int max_branch = 0;
+        for (int i = 0; i < segments.numberSegment(); ++i)
+            max_branch = std::max(max_branch, segments[i].branchNumber());
+
+        return max_branch;
+    }
+
+    // The top segment has no diameter, roughness or area; write zero.
+    double segmentValue(const double value)
+    {
+        return (value == Opm::Segment::invalidValue()) ? 0.0 : value;
+    }
+
+    struct Branch {
+        int outlet = 0;
+        int count = 0;
+        int first = 0;
+        int last = 0;
+        int first_position = 0;
+    };
+
+    /*
+      Branch records indexed by branch number - 1. The segments are stored
+      in search order, so a single pass is sufficient; a segment starts a
+      branch if its outlet is on another branch, and ends it if none of its
+      inlets are on the same branch.
+    */
+    std::vector<Branch> branchTable(const Opm::SegmentSet& segments)
+    {
+        std::vector<Branch> branches(maxBranchNumber(segments));
+
+        for (int i = 0; i < segments.numberSegment(); ++i) {
+            const auto& segment = segments[i];
+            if (segment.branchNumber() < 1)
+                continue;
+
+            auto& branch = branches[segment.branchNumber() - 1];
+            branch.count += 1;
+
+            const int outlet_index = segments.segmentNumberToIndex(segment.outletSegment());
+            if (outlet_index < 0 || segments[outlet_index].branchNumber() != segment.branchNumber()) {
+                branch.outlet = outlet_index < 0 ? 0 : segment.outletSegment();
+                branch.first = segment.segmentNumber();
+                branch.first_position = i;
+            }
+
+            if (firstInletOnBranch(segments, segment) == 0)
+                branch.last = segment.segmentNumber();
+        }
+
+        return branches;
+    }
+
+} // Anonymous
+
+// ----------------------------------------------------------------------------
+int
+Opm::RestartIO::Helpers::
+numSegmentedWells(int lookup_step,
+                  const std::vector<const Opm::Well*>& sched_wells)
+// ----------------------------------------------------------------------------
+{
+    return segmentedWells(lookup_step, sched_wells).size();
+}
+
+// ----------------------------------------------------------------------------
+std::pair<int, int>
+Opm::RestartIO::Helpers::
+maxSegmentDimensions(int lookup_step,
+                     const std::vector<const Opm::Well*>& sched_wells)
+// ----------------------------------------------------------------------------
+{
+    int nsegmx = 0;
+    int nlbrmx = 0;
+    for (const Opm::Well* well : segmentedWells(lookup_step, sched_wells)) {
+        const auto& segments = well->getSegmentSet(lookup_step);
+        nsegmx = std::max(nsegmx, segments.maxSegmentNumber());
+        nlbrmx = std::max(nlbrmx, maxBranchNumber(segments));
+    }
+
+    return { nsegmx, nlbrmx };
+}
+
+// ----------------------------------------------------------------------------
+std::vector<int>
+Opm::RestartIO::Helpers::
+serialize_ISEG(int lookup_step,
+               int nsegmx,
+               int nisegz,
+               const std::vector<const Opm::Well*>& sched_wells)
+// ----------------------------------------------------------------------------
+{
+    const auto wells = segmentedWells(lookup_step, sched_wells);
+    const size_t well_field_size = nsegmx * nisegz;
+    std::vector<int> data(wells.size() * well_field_size, 0);
+    size_t well_offset = 0;
+    for (const Opm::Well* well : wells) {
+        const auto& segments = well->getSegmentSet(lookup_step);
+        for (int i = 0; i < segments.numberSegment(); ++i) {
+            const auto& segment = segments[i];
+            if (segment.segmentNumber() > nsegmx)
+                throw std::invalid_argument("Segment number " + std::to_string(segment.segmentNumber())
+                                            + " of well " + well->name() + " exceeds NSEGMX");
+
+            const size_t offset = well_offset + (segment.segmentNumber() - 1) * nisegz;
+
+            data[ offset + ISEG::SegOrder ] = i + 1;
+            data[ offset + ISEG::OutletSeg ] = segment.outletSegment();
+            data[ offset + ISEG::InletSeg ] = firstInletOnBranch(segments, segment);
+            data[ offset + ISEG::BranchNo ] = segment.branchNumber();
+            data[ offset + ISEG::NumInlets ] = segment.inletSegments().size();
+        }
+
+        well_offset += well_field_size;
+    }
+
+    return data;
+}
+
+// ----------------------------------------------------------------------------
+std::vector<double>
+Opm::RestartIO::Helpers::
+serialize_RSEG(int lookup_step,
+               int nsegmx,
+               int nrsegz,
+               const std::vector<const Opm::Well*>& sched_wells,
+               const data::WellRates& well_data,
+               const UnitSystem& units)
+// ----------------------------------------------------------------------------
+{
+    using M = UnitSystem::measure;
+
+    const auto wells = segmentedWells(lookup_step, sched_wells);
+    const size_t well_field_size = nsegmx * nrsegz;
+    std::vector<double> data(wells.size() * well_field_size, 0);
+    const auto area = units.parse("Length*Length");
+    size_t well_offset = 0;
+    for (const Opm::Well* well : wells) {
+        const auto& segments = well->getSegmentSet(lookup_step);
+        const auto result = well_data.find(well->name());
+        const data::Segments* results = (result == well_data.end())
+            ? nullptr
+            : &result->second.segments;
+
+        for (int i = 0; i < segments.numberSegment(); ++i) {
+            const auto& segment = segments[i];
+            const int segment_number = segment.segmentNumber();
+            if (segment_number > nsegmx)
+                throw std::invalid_argument("Segment number " + std::to_string(segment_number)
+                                            + " of well " + well->name() + " exceeds NSEGMX");
+
+            const size_t offset = well_offset + (segment_number - 1) * nrsegz;
+
+            const int outlet_index = segments.segmentNumberToIndex(segment.outletSegment());
+            if (outlet_index >= 0) {
+                const auto& outlet = segments[outlet_index];
+                data[ offset + RSEG::Length ] = units.from_si(M::length, segment.totalLength() - outlet.totalLength());
+                data[ offset + RSEG::DepthChange ] = units.from_si(M::length, segment.depth() - outlet.depth());
+            }
+
+            data[ offset + RSEG::Diameter ] = units.from_si(M::length, segmentValue(segment.internalDiameter()));
+            data[ offset + RSEG::Roughness ] = units.from_si(M::length, segmentValue(segment.roughness()));
+            data[ offset + RSEG::CrossArea ] = area.convertSiToRaw(segmentValue(segment.crossArea()));
+            data[ offset + RSEG::Volume ] = units.from_si(M::volume, segment.volume());
+            data[ offset + RSEG::TotalLength ] = units.from_si(M::length, segment.totalLength());
+            data[ offset + RSEG::Depth ] = units.from_si(M::length, segment.depth());
+
+            if (results && results->has(segment_number)) {
+                // Rates are written positive in the direction of production.
+                const size_t index = segment_number - 1;
+                const double oil = -units.from_si(M::liquid_surface_rate, results->oil_rate[index]);
+                const double water = -units.from_si(M::liquid_surface_rate, results->water_rate[index]);
+                const double gas = -units.from_si(M::gas_surface_rate, results->gas_rate[index]);
+                const double total = oil + water + gas;
+
+                data[ offset + RSEG::TotalRate ] = total;
+                data[ offset + RSEG::WaterFrac ] = (total == 0) ? 0 : water / total;
+                data[ offset + RSEG::GasFrac ] = (total == 0) ? 0 : gas / total;
+                data[ offset + RSEG::Pressure ] = units.from_si(M::pressure, results->pressure[index]);
+            }
+        }
+
+        well_offset += well_field_size;
+    }
+
+    return data;
+}
+
+// ----------------------------------------------------------------------------
+std::vector<int>
+Opm::RestartIO::Helpers::
+serialize_ILBS(int lookup_step,
+               int nlbrmx,
+               const std::vector<const Opm::Well*>& sched_wells)
+// ----------------------------------------------------------------------------
+{
+    // First segment of each lateral branch, i.e. branch 2 and upwards.
+    const auto wells = segmentedWells(lookup_step, sched_wells);
+    std::vector<int> data(wells.size() * nlbrmx, 0);
+    size_t well_offset = 0;
+    for (const Opm::Well* well : wells) {
+        const auto branches = branchTable(well->getSegmentSet(lookup_step));
+        if (branches.size() > size_t(nlbrmx))
+            throw std::invalid_argument("Number of branches of well " + well->name() + " exceeds NLBRMX");
+
+        for (size_t b = 1; b < branches.size(); ++b)
+            data[ well_offset + b - 1 ] = branches[b].first;
+
+        well_offset += nlbrmx;
+    }
+
+    return data;
+}
+
+// ----------------------------------------------------------------------------
+std::vector<int>
+Opm::RestartIO::Helpers::
+serialize_ILBR(int lookup_step,
+               int nlbrmx,
+               int nilbrz,
+               const std::vector<const Opm::Well*>& sched_wells)
+// ----------------------------------------------------------------------------
+{
+    const auto wells = segmentedWells(lookup_step, sched_wells);
+    const size_t well_field_size = nlbrmx * nilbrz;
+    std::vector<int> data(wells.size() * well_field_size, 0);
+    size_t well_offset = 0;
+    for (const Opm::Well* well : wells) {
+        const auto branches = branchTable(well->getSegmentSet(lookup_step));
+        if (branches.size() > size_t(nlbrmx))
+            throw std::invalid_argument("Number of branches of well " + well->name() + " exceeds NLBRMX");
+
+        size_t branch_offset = 0;
+        for (const auto& branch : branches) {
+            const size_t offset = well_offset + branch_offset;
+
+            if (branch.count > 0) {
+                data[ offset + ILBR::OutletSeg ] = branch.outlet;
+                data[ offset + ILBR::NumSegs ] = branch.count;
+                data[ offset + ILBR::FirstSeg ] = branch.first;
+                data[ offset + ILBR::LastSeg ] = branch.last;
+                data[ offset + ILBR::FirstPos ] = branch.first_position;
+            }
+
+            branch_offset += nilbrz;
+        }
+
+        well_offset += well_field_size;
+    }
+
+    return data;
+}
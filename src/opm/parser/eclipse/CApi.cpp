@@ -0,0 +1,348 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <opm/common/utility/LargeArray.hpp>
+
+#include <opm/parser/eclipse/CApi.h>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/SimpleTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableColumn.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableContainer.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+struct opm_parser {
+    Opm::Parser parser;
+    Opm::ParseContext parse_context;
+};
+
+struct opm_deck {
+    Opm::Deck deck;
+};
+
+/*
+  The grid properties which have been handed out as views are pinned,
+  so they can not be spilled by the GridPropertyStorage while the
+  handle is alive; they are unpinned when the handle is freed.
+*/
+struct opm_eclipse_state {
+    Opm::EclipseState state;
+    Opm::LargeVector< int > active_map;
+    mutable std::mutex pin_lock;
+    mutable std::set< const Opm::GridProperty< int >* > pinned_int;
+    mutable std::set< const Opm::GridProperty< double >* > pinned_double;
+
+    ~opm_eclipse_state() {
+        for (const auto* property : this->pinned_int)
+            property->unpin();
+
+        for (const auto* property : this->pinned_double)
+            property->unpin();
+    }
+};
+
+/*
+  The well snapshots are assembled when a report step is first asked
+  for, and then kept for the lifetime of the handle.
+*/
+struct opm_schedule {
+    Opm::Schedule schedule;
+    mutable std::mutex snapshot_lock;
+    mutable std::map< size_t, std::vector< opm_well_snapshot > > snapshots;
+};
+
+namespace {
+
+    thread_local std::string last_error;
+
+    void checkArgument( const void* arg, const char* name ) {
+        if (!arg)
+            throw std::invalid_argument(std::string("Argument: ") + name + " can not be NULL");
+    }
+
+    /*
+      No exceptions are allowed to propagate through the C interface;
+      they are translated to an error code and the message is stored
+      for opm_last_error().
+    */
+    template< typename Func >
+    int guarded( Func func ) {
+        try {
+            func();
+            return 0;
+        } catch (const std::exception& e) {
+            last_error = e.what();
+        } catch (...) {
+            last_error = "Unknown error";
+        }
+
+        return -1;
+    }
+
+    template< typename Handle, typename Func >
+    Handle* guardedAlloc( Func func ) {
+        Handle* handle = nullptr;
+        guarded( [&handle, &func]() { handle = func(); } );
+        return handle;
+    }
+
+    /*
+      The reference depth of a well without any completions can not be
+      inferred when it was defaulted, it is then given as NaN.
+    */
+    double refDepth( const Opm::Well& well, size_t report_step ) {
+        try {
+            return well.getRefDepth( report_step );
+        } catch (const std::invalid_argument&) {
+            return std::numeric_limits< double >::quiet_NaN();
+        }
+    }
+
+    template< typename Vector >
+    void setView( opm_array_view* view, const Vector& data, opm_dtype dtype ) {
+        view->data = data.empty() ? nullptr : data.data();
+        view->size = data.size();
+        view->dtype = dtype;
+    }
+
+    /*
+      Pins the property the first time it is handed out from the state;
+      the data must be resident before the view is set up.
+    */
+    template< typename T >
+    void pinProperty( std::mutex& lock,
+                      std::set< const Opm::GridProperty< T >* >& pinned,
+                      const Opm::GridProperty< T >& property ) {
+        std::lock_guard< std::mutex > guard( lock );
+        if (pinned.insert( std::addressof( property ) ).second)
+            property.pin();
+    }
+
+}
+
+
+extern "C" {
+
+int opm_api_version(void) {
+    return OPM_C_API_VERSION;
+}
+
+
+const char* opm_last_error(void) {
+    return last_error.c_str();
+}
+
+
+opm_parser* opm_parser_alloc(void) {
+    return guardedAlloc< opm_parser >( []() { return new opm_parser(); } );
+}
+
+
+void opm_parser_free(opm_parser* parser) {
+    delete parser;
+}
+
+
+opm_deck* opm_parser_parse_file(opm_parser* parser, const char* filename) {
+    return guardedAlloc< opm_deck >( [=]() {
+        checkArgument( parser, "parser" );
+        checkArgument( filename, "filename" );
+        return new opm_deck{ parser->parser.parseFile( filename, parser->parse_context ) };
+    });
+}
+
+
+opm_deck* opm_parser_parse_string(opm_parser* parser, const char* data) {
+    return guardedAlloc< opm_deck >( [=]() {
+        checkArgument( parser, "parser" );
+        checkArgument( data, "data" );
+        return new opm_deck{ parser->parser.parseString( data, parser->parse_context ) };
+    });
+}
+
+
+void opm_deck_free(opm_deck* deck) {
+    delete deck;
+}
+
+
+size_t opm_deck_size(const opm_deck* deck) {
+    return deck ? deck->deck.size() : 0;
+}
+
+
+opm_eclipse_state* opm_eclipse_state_alloc(const opm_deck* deck) {
+    return guardedAlloc< opm_eclipse_state >( [=]() {
+        checkArgument( deck, "deck" );
+        std::unique_ptr< opm_eclipse_state > state( new opm_eclipse_state{ Opm::EclipseState( deck->deck ), {} } );
+
+        const auto& grid = state->state.getInputGrid();
+        state->active_map.resize( grid.getNumActive() );
+        for (size_t active_index = 0; active_index < state->active_map.size(); active_index++)
+            state->active_map[active_index] = grid.getGlobalIndex( active_index );
+
+        return state.release();
+    });
+}
+
+
+void opm_eclipse_state_free(opm_eclipse_state* state) {
+    delete state;
+}
+
+
+int opm_eclipse_state_grid_dims(const opm_eclipse_state* state, int dims[3]) {
+    return guarded( [=]() {
+        checkArgument( state, "state" );
+        checkArgument( dims, "dims" );
+        const auto& grid = state->state.getInputGrid();
+        dims[0] = grid.getNX();
+        dims[1] = grid.getNY();
+        dims[2] = grid.getNZ();
+    });
+}
+
+
+int opm_eclipse_state_int_property(const opm_eclipse_state* state, const char* keyword, opm_array_view* view) {
+    return guarded( [=]() {
+        checkArgument( state, "state" );
+        checkArgument( keyword, "keyword" );
+        checkArgument( view, "view" );
+        const auto& property = state->state.get3DProperties().getIntGridProperty( keyword );
+        pinProperty( state->pin_lock, state->pinned_int, property );
+        setView( view, property.getData(), OPM_DTYPE_INT32 );
+    });
+}
+
+
+int opm_eclipse_state_double_property(const opm_eclipse_state* state, const char* keyword, opm_array_view* view) {
+    return guarded( [=]() {
+        checkArgument( state, "state" );
+        checkArgument( keyword, "keyword" );
+        checkArgument( view, "view" );
+        const auto& property = state->state.get3DProperties().getDoubleGridProperty( keyword );
+        pinProperty( state->pin_lock, state->pinned_double, property );
+        setView( view, property.getData(), OPM_DTYPE_FLOAT64 );
+    });
+}
+
+
+int opm_eclipse_state_active_map(const opm_eclipse_state* state, opm_array_view* view) {
+    return guarded( [=]() {
+        checkArgument( state, "state" );
+        checkArgument( view, "view" );
+        setView( view, state->active_map, OPM_DTYPE_INT32 );
+    });
+}
+
+
+int opm_eclipse_state_table_column(const opm_eclipse_state* state,
+                                   const char* table_name,
+                                   size_t table_index,
+                                   const char* column_name,
+                                   opm_array_view* view) {
+    return guarded( [=]() {
+        checkArgument( state, "state" );
+        checkArgument( table_name, "table_name" );
+        checkArgument( column_name, "column_name" );
+        checkArgument( view, "view" );
+
+        const auto& tables = state->state.getTableManager().getTables( table_name );
+        if (!tables.hasTable( table_index ))
+            throw std::invalid_argument("No table: " + std::to_string( table_index ) + " in " + table_name);
+
+        const auto& column = tables.getTable( table_index ).getColumn( column_name );
+        view->data = column.size() > 0 ? &(*column.begin()) : nullptr;
+        view->size = column.size();
+        view->dtype = OPM_DTYPE_FLOAT64;
+    });
+}
+
+
+opm_schedule* opm_schedule_alloc(const opm_deck* deck, const opm_eclipse_state* state) {
+    return guardedAlloc< opm_schedule >( [=]() {
+        checkArgument( deck, "deck" );
+        checkArgument( state, "state" );
+        std::unique_ptr< opm_schedule > schedule( new opm_schedule{ Opm::Schedule( deck->deck, state->state ), {}, {} } );
+        return schedule.release();
+    });
+}
+
+
+void opm_schedule_free(opm_schedule* schedule) {
+    delete schedule;
+}
+
+
+size_t opm_schedule_num_steps(const opm_schedule* schedule) {
+    return schedule ? schedule->schedule.getTimeMap().size() : 0;
+}
+
+
+int opm_schedule_wells(const opm_schedule* schedule,
+                       size_t report_step,
+                       const opm_well_snapshot** wells,
+                       size_t* num_wells) {
+    return guarded( [=]() {
+        checkArgument( schedule, "schedule" );
+        checkArgument( wells, "wells" );
+        checkArgument( num_wells, "num_wells" );
+        if (report_step >= schedule->schedule.getTimeMap().size())
+            throw std::invalid_argument("Report step: " + std::to_string( report_step ) + " is out of range");
+
+        std::lock_guard< std::mutex > guard( schedule->snapshot_lock );
+        auto iter = schedule->snapshots.find( report_step );
+        if (iter == schedule->snapshots.end()) {
+            std::vector< opm_well_snapshot > snapshot;
+            for (const auto* well : schedule->schedule.getWells( report_step ))
+                snapshot.push_back( { well->name().c_str(),
+                                      well->getHeadI( report_step ),
+                                      well->getHeadJ( report_step ),
+                                      refDepth( *well, report_step ),
+                                      static_cast< int >( well->getStatus( report_step ) ),
+                                      well->isProducer( report_step ) ? 1 : 0 } );
+
+            iter = schedule->snapshots.emplace( report_step, std::move( snapshot ) ).first;
+        }
+
+        *wells = iter->second.empty() ? nullptr : iter->second.data();
+        *num_wells = iter->second.size();
+    });
+}
+
+}
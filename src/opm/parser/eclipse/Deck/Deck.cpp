@@ -25,6 +25,7 @@
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
+#include <opm/parser/eclipse/Utility/Hash.hpp>
 
 namespace Opm {
 
@@ -96,6 +97,15 @@ namespace Opm {
         return this->last;
     }
 
+    std::uint64_t DeckView::hash() const {
+        ContentHash hasher;
+        hasher.update( static_cast< std::uint64_t >( this->size() ) );
+        for( const auto& kw : *this )
+            hasher.update( kw.hash() );
+
+        return hasher.digest();
+    }
+
     void DeckView::add( const DeckKeyword* kw, const_iterator f, const_iterator l ) {
         this->keywordMap[ kw->name() ].push_back( std::distance( f, l ) - 1 );
         this->first = f;
@@ -169,7 +179,8 @@ namespace Opm {
         keywordList( d.keywordList ),
         defaultUnits( d.defaultUnits ),
         activeUnits( d.activeUnits ),
-        m_dataFile( d.m_dataFile ) {
+        m_dataFile( d.m_dataFile ),
+        m_includeGraph( d.m_includeGraph ) {
 
         this->reinit(this->keywordList.begin(), this->keywordList.end());
     }
@@ -217,6 +228,14 @@ namespace Opm {
         m_dataFile = dataFile;
     }
 
+    const IncludeGraph& Deck::getIncludeGraph() const {
+        return m_includeGraph;
+    }
+
+    IncludeGraph& Deck::getIncludeGraph() {
+        return m_includeGraph;
+    }
+
     Deck::iterator Deck::begin() {
         return this->keywordList.begin();
     }
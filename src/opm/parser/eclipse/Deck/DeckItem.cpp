@@ -20,6 +20,7 @@
 #include <opm/parser/eclipse/Deck/DeckOutput.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Units/Dimension.hpp>
+#include <opm/parser/eclipse/Utility/Hash.hpp>
 
 #include <boost/algorithm/string.hpp>
 
@@ -277,6 +278,25 @@ void DeckItem::write(DeckOutput& stream) const {
     }
 }
 
+void DeckItem::hash(ContentHash& hasher) const {
+    hasher.update( this->item_name );
+    hasher.update( static_cast< int >( this->type ) );
+
+    switch( this->type ) {
+    case type_tag::integer:
+        hasher.update( this->ival );
+        break;
+    case type_tag::fdouble:
+        hasher.update( this->dval );
+        break;
+    case type_tag::string:
+        hasher.update( this->sval );
+        break;
+    default:
+        break;
+    }
+}
+
 std::ostream& operator<<(std::ostream& os, const DeckItem& item) {
     DeckOutput stream(os);
     item.write( stream );
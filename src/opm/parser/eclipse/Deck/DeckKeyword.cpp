@@ -21,6 +21,7 @@
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Utility/Hash.hpp>
 
 namespace Opm {
 
@@ -83,6 +84,7 @@ namespace Opm {
 
     void DeckKeyword::addRecord(DeckRecord&& record) {
         this->m_recordList.push_back( std::move( record ) );
+        this->m_hashValid = false;
     }
 
     DeckKeyword::const_iterator DeckKeyword::begin() const {
@@ -98,6 +100,7 @@ namespace Opm {
     }
 
     DeckRecord& DeckKeyword::getRecord(size_t index) {
+        this->m_hashValid = false;
         return this->m_recordList.at( index );
     }
 
@@ -162,6 +165,26 @@ namespace Opm {
         return os;
     }
 
+    void DeckKeyword::updateHash() {
+        this->m_hashValid = false;
+        this->hash();
+    }
+
+    std::uint64_t DeckKeyword::hash() const {
+        if (!this->m_hashValid) {
+            ContentHash hasher;
+            hasher.update( this->m_keywordName );
+            hasher.update( static_cast< std::uint64_t >( this->size() ) );
+            for (const auto& record : *this)
+                record.hash( hasher );
+
+            this->m_hash = hasher.digest();
+            this->m_hashValid = true;
+        }
+
+        return this->m_hash;
+    }
+
     bool DeckKeyword::equal_data(const DeckKeyword& other, bool cmp_default, bool cmp_numeric) const {
         if (this->size() != other.size())
             return false;
@@ -26,6 +26,7 @@
 #include <opm/parser/eclipse/Deck/DeckOutput.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Utility/Hash.hpp>
 
 
 namespace Opm {
@@ -144,6 +145,13 @@ namespace Opm {
     }
 
 
+    void DeckRecord::hash(ContentHash& hasher) const {
+        hasher.update( static_cast< std::uint64_t >( this->size() ) );
+        for (const auto& item : *this)
+            item.hash( hasher );
+    }
+
+
     std::ostream& operator<<(std::ostream& os, const DeckRecord& record) {
         DeckOutput output(os);
         record.write( output );
@@ -0,0 +1,114 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include <opm/parser/eclipse/Deck/IncludeGraph.hpp>
+
+namespace Opm {
+
+    const std::size_t IncludeGraph::npos;
+
+    std::size_t IncludeGraph::addFile( const std::string& path, std::uintmax_t size, std::time_t mtime ) {
+        const auto iter = this->file_index.find( path );
+        if( iter != this->file_index.end() )
+            return iter->second;
+
+        const auto index = this->files.size();
+        this->files.push_back( { path, size, mtime } );
+        this->edges.emplace_back( );
+        this->included.push_back( false );
+        this->file_index.emplace( path, index );
+        return index;
+    }
+
+    std::size_t IncludeGraph::addFile( const std::string& path ) {
+        const auto iter = this->file_index.find( path );
+        if( iter != this->file_index.end() )
+            return iter->second;
+
+        boost::system::error_code ec;
+        auto size = boost::filesystem::file_size( path, ec );
+        if( ec ) size = 0;
+
+        auto mtime = boost::filesystem::last_write_time( path, ec );
+        if( ec ) mtime = 0;
+
+        return this->addFile( path, size, mtime );
+    }
+
+    void IncludeGraph::addInclude( std::size_t parent, std::size_t child ) {
+        if( parent >= this->files.size() || child >= this->files.size() )
+            throw std::invalid_argument( "Invalid file index in include graph" );
+
+        auto& children = this->edges[ parent ];
+        if( std::find( children.begin(), children.end(), child ) == children.end() )
+            children.push_back( child );
+
+        this->included[ child ] = true;
+    }
+
+    bool IncludeGraph::hasFile( const std::string& path ) const {
+        return this->file_index.count( path ) > 0;
+    }
+
+    std::size_t IncludeGraph::index( const std::string& path ) const {
+        const auto iter = this->file_index.find( path );
+        if( iter == this->file_index.end() )
+            return npos;
+
+        return iter->second;
+    }
+
+    const IncludeGraph::File& IncludeGraph::getFile( std::size_t index ) const {
+        return this->files.at( index );
+    }
+
+    std::size_t IncludeGraph::size() const {
+        return this->files.size();
+    }
+
+    bool IncludeGraph::empty() const {
+        return this->files.empty();
+    }
+
+    const std::vector< std::size_t >& IncludeGraph::includes( std::size_t index ) const {
+        return this->edges.at( index );
+    }
+
+    std::vector< std::size_t > IncludeGraph::roots() const {
+        std::vector< std::size_t > r;
+        for( std::size_t i = 0; i < this->files.size(); ++i )
+            if( !this->included[ i ] ) r.push_back( i );
+
+        return r;
+    }
+
+    std::vector< std::string > IncludeGraph::dependencies() const {
+        std::vector< std::string > deps;
+        deps.reserve( this->files.size() );
+        for( const auto& file : this->files )
+            deps.push_back( file.path );
+
+        return deps;
+    }
+}
@@ -29,6 +29,8 @@
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+#include <opm/parser/eclipse/Utility/Hash.hpp>
 
 namespace Opm {
 
@@ -84,4 +86,21 @@ namespace Opm {
     bool Section::hasSUMMARY(const Deck& deck) { return deck.hasKeyword( "SUMMARY" ); }
     bool Section::hasSCHEDULE(const Deck& deck) { return deck.hasKeyword( "SCHEDULE" ); }
 
+    std::uint64_t Section::contentHash( const Deck& deck,
+                                        const std::vector< std::string >& sections ) {
+        ContentHash hasher;
+        hasher.update( static_cast< int >( deck.getActiveUnitSystem().getType() ) );
+
+        bool include = true;
+        for( const auto& kw : deck ) {
+            if( isSectionDelimiter( kw ) )
+                include = std::find( sections.begin(), sections.end(), kw.name() ) != sections.end();
+
+            if( include )
+                hasher.update( kw.hash() );
+        }
+
+        return hasher.digest();
+    }
+
 }
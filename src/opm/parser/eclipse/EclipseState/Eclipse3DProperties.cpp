@@ -18,8 +18,15 @@
 
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
+#include <map>
+#include <memory>
 #include <set>
+#include <vector>
+
+#include <opm/common/utility/Executor.hpp>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
@@ -28,9 +35,11 @@
 #include <opm/parser/eclipse/EclipseState/Grid/BoxManager.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridPropertyStorage.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/SatfuncPropertyInitializers.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/Utility/Hash.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
 
 #include "Grid/setKeywordBox.hpp"
@@ -51,105 +60,170 @@ namespace Opm {
             }
         }
 
-        // this funcion applies a single pore volume multiplier (i.e., it deals with a single
-        // record of the MULTREGP keyword)
-        void applyPorosityRegionMultiplier_(std::vector<double>& porev,
-                                            const std::vector<int>& regionId,
-                                            int multRegionId,
-                                            double multValue)
-        {
-            for (unsigned i = 0; i < porev.size(); ++i) {
-                if (regionId[i] == multRegionId)
-                    porev[i] *= multValue;
+        /*
+          The MULTREGP keyword is resolved once, when the properties
+          are constructed, to dense region -> multiplier lookup tables;
+          one table for each of the region types MULTNUM, FLUXNUM and
+          OPERNUM. An empty table means that no multipliers apply for
+          that region type.
+        */
+        struct PorvRegionMultipliers {
+            std::vector<double> multnum;
+            std::vector<double> fluxnum;
+            std::vector<double> opernum;
+        };
+
+        PorvRegionMultipliers resolveMULTREGP( const Deck& deck ) {
+            PorvRegionMultipliers multipliers;
+            if (!deck.hasKeyword("MULTREGP"))
+                return multipliers;
+
+            // implement a (documented) ECL bug: the region index must be unique
+            // (i.e., it is impossible to specify multipliers for different
+            // region types with the same index). Also, only the last occurence
+            // of each region counts.
+            std::map<int, std::pair<std::string, double>> lastRecord;
+            const DeckKeyword& multregpKeyword = deck.getKeyword("MULTREGP");
+            for (const auto& multregpRecord : multregpKeyword) {
+                int regionId = multregpRecord.getItem("REGION").template get<int>(0);
+                std::string regionType = multregpRecord.getItem("REGION_TYPE").template get<std::string>(0);
+                double multValue = multregpRecord.getItem("MULTIPLIER").template get<double>(0);
+                uppercase(regionType, regionType);
+
+                // deal with the "convenience" feature of ECL: if the region index is
+                // zero or negative, the record is ignored.
+                if (regionId <= 0)
+                    continue;
+
+                lastRecord[regionId] = std::make_pair(regionType, multValue);
+            }
+
+            for (const auto& pair : lastRecord) {
+                const int regionId = pair.first;
+                const std::string& regionType = pair.second.first;
+                std::vector<double>* table;
+
+                if (regionType == "M")
+                    table = &multipliers.multnum;
+                else if (regionType == "F")
+                    table = &multipliers.fluxnum;
+                else if (regionType == "O")
+                    table = &multipliers.opernum;
+                else
+                    throw std::logic_error("Unknown or illegal region type for MULTREGP keyword: '"+regionType+"'");
+
+                if (table->size() <= static_cast<size_t>(regionId))
+                    table->resize(regionId + 1, 1.0);
+
+                (*table)[regionId] = pair.second.second;
             }
+
+            return multipliers;
+        }
+
+        /// the properties read by initPORV(), given the resolved MULTREGP
+        /// multipliers.
+        std::vector<std::string> PORVDependencies( const PorvRegionMultipliers& multipliers ) {
+            std::vector<std::string> dependencies = { "PORO", "NTG", "MULTPV" };
+            if (!multipliers.multnum.empty())
+                dependencies.push_back( "MULTNUM" );
+
+            if (!multipliers.fluxnum.empty())
+                dependencies.push_back( "FLUXNUM" );
+
+            if (!multipliers.opernum.empty())
+                dependencies.push_back( "OPERNUM" );
+
+            return dependencies;
+        }
+
+        const int* regionData( const GridProperties<int>* intGridProperties,
+                               const std::vector<double>& table,
+                               const std::string& keyword ) {
+            if (table.empty())
+                return nullptr;
+
+            return intGridProperties->getKeyword(keyword).getData().data();
+        }
+
+        inline double regionMultiplier( const int* region,
+                                        const std::vector<double>& table,
+                                        size_t globalIndex ) {
+            if (!region)
+                return 1.0;
+
+            const int regionId = region[globalIndex];
+            if (regionId < 0 || static_cast<size_t>(regionId) >= table.size())
+                return 1.0;
+
+            return table[regionId];
         }
 
-        /// this function initializes the pore volume of all cells. it uses the raw keyword
-        /// 'MULTREGP', the integer grid properties 'FLUXNUM', 'MULTNUM' and 'OPERNUM' as
-        /// well as the double grid properties 'PORV', 'PORO', 'NTG' and 'MULTPV'
+        /// this function initializes the pore volume of all cells. it uses the
+        /// resolved 'MULTREGP' multipliers, the integer grid properties 'FLUXNUM',
+        /// 'MULTNUM' and 'OPERNUM' as well as the double grid properties 'PORV',
+        /// 'PORO', 'NTG' and 'MULTPV'. All the contributions are applied in one
+        /// pass over the grid, and the cell bulk volumes computed along the way
+        /// are stored in the bulkVolume vector.
         void initPORV( std::vector<double>&    values,
-                       const Deck* deck,
+                       const PorvRegionMultipliers& multipliers,
                        const EclipseGrid*      eclipseGrid,
                        const GridProperties<int>* intGridProperties,
-                       const GridProperties<double>* doubleGridProperties)
+                       const GridProperties<double>* doubleGridProperties,
+                       std::vector<double>* bulkVolume)
         {
-            if ( doubleGridProperties->hasKeyword("PORO") ) {
-                const auto& poro = doubleGridProperties->getKeyword("PORO");
-                const auto& ntg =  doubleGridProperties->getKeyword("NTG");
-
-                const auto& poroData = poro.getData();
-                for (size_t globalIndex = 0; globalIndex < poro.getCartesianSize(); globalIndex++) {
-                    if (!std::isfinite(values[globalIndex])) {
-                        double cell_poro = poroData[globalIndex];
-                        if (std::isnan(cell_poro))
-                            throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
-
-                        double cell_ntg = ntg.iget(globalIndex);
-                        double cell_volume = eclipseGrid->getCellVolume(globalIndex);
-                        values[globalIndex] = cell_poro * cell_volume * cell_ntg;
-                    }
-                }
-            }
-            else {
+            const bool hasPoro = doubleGridProperties->hasKeyword("PORO");
+            const double* poroData = nullptr;
+            const double* ntgData = nullptr;
+            const double* multpvData = nullptr;
+
+            if (hasPoro) {
+                poroData = doubleGridProperties->getKeyword("PORO").getData().data();
+                ntgData = doubleGridProperties->getDefaultedKeyword("NTG").getData().data();
+            } else {
                 for (size_t globalIndex = 0; globalIndex < values.size(); globalIndex++)
                     if ( !std::isfinite(values[globalIndex]) )
                         throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
             }
 
-            if (doubleGridProperties->hasKeyword("MULTPV")) {
-                const GridProperty<double>& multpvKeyword = doubleGridProperties->getKeyword("MULTPV");
-                const auto& multpvData = multpvKeyword.getData();
-                for (size_t globalIndex = 0; globalIndex < multpvData.size(); globalIndex++)
-                    values[globalIndex] *= multpvData[globalIndex];
-            }
+            if (doubleGridProperties->hasKeyword("MULTPV"))
+                multpvData = doubleGridProperties->getKeyword("MULTPV").getData().data();
 
-            // deal with the region multiplier for porosity
-            if (deck->hasKeyword("MULTREGP")) {
-                const DeckKeyword& multregpKeyword = deck->getKeyword("MULTREGP");
-                for (unsigned recordIdx = 0; recordIdx < multregpKeyword.size(); ++recordIdx) {
-                    const DeckRecord& multregpRecord = multregpKeyword.getRecord(recordIdx);
-
-                    int regionId = multregpRecord.getItem("REGION").template get<int>(0);
-                    std::string regionType = multregpRecord.getItem("REGION_TYPE").template get<std::string>(0);
-                    double multValue = multregpRecord.getItem("MULTIPLIER").template get<double>(0);
-                    uppercase(regionType, regionType);
-
-                    // deal with the "convenience" feature of ECL: if the region index is
-                    // zero or negative, the record is ignored.
-                    if (regionId <= 0)
-                        continue;
-
-                    // implement a (documented) ECL bug: the region index must be unique
-                    // (i.e., it is impossible to specify multipliers for different
-                    // region types with the same index). Also, only the last occurence
-                    // of each region counts.
-                    unsigned record2Idx = recordIdx + 1;
-                    for (; record2Idx < multregpKeyword.size(); ++record2Idx) {
-                        const DeckRecord& multregpRecord2 = multregpKeyword.getRecord(record2Idx);
-                        int region2Idx = multregpRecord2.getItem("REGION").template get<int>(0);
-                        if (region2Idx == regionId)
-                            break;
-                    }
-                    if (record2Idx < multregpKeyword.size())
-                        // the region was specified twice
-                        continue;
+            const int* multnum = regionData(intGridProperties, multipliers.multnum, "MULTNUM");
+            const int* fluxnum = regionData(intGridProperties, multipliers.fluxnum, "FLUXNUM");
+            const int* opernum = regionData(intGridProperties, multipliers.opernum, "OPERNUM");
 
-                    if (regionType == "M") {
-                        const GridProperty<int>& multnumProp = intGridProperties->getKeyword("MULTNUM");
-                        applyPorosityRegionMultiplier_(values, multnumProp.getData(), regionId, multValue);
-                    }
-                    else if (regionType == "F") {
-                        const GridProperty<int>& fluxnumProp = intGridProperties->getKeyword("FLUXNUM");
-                        applyPorosityRegionMultiplier_(values, fluxnumProp.getData(), regionId, multValue);
-                    }
-                    else if (regionType == "O") {
-                        const GridProperty<int>& opernumProp = intGridProperties->getKeyword("OPERNUM");
-                        applyPorosityRegionMultiplier_(values, opernumProp.getData(), regionId, multValue);
+            const size_t size = values.size();
+            bulkVolume->resize(size);
+            double* volume = bulkVolume->data();
+            std::atomic< bool > missingPoro( false );
+
+            Executor::instance().parallelFor( 0, size, [&]( size_t globalIndex ) {
+                const double cell_volume = eclipseGrid->getCellVolume(globalIndex);
+                volume[globalIndex] = cell_volume;
+
+                double porv = values[globalIndex];
+                if (!std::isfinite(porv)) {
+                    const double cell_poro = poroData[globalIndex];
+                    if (std::isnan(cell_poro)) {
+                        missingPoro = true;
+                        return;
                     }
-                    else
-                        throw std::logic_error("Unknown or illegal region type for MULTREGP keyword: '"+regionType+"'");
+                    porv = cell_poro * cell_volume * ntgData[globalIndex];
                 }
-            }
+
+                if (multpvData)
+                    porv *= multpvData[globalIndex];
+
+                porv *= regionMultiplier(multnum, multipliers.multnum, globalIndex);
+                porv *= regionMultiplier(fluxnum, multipliers.fluxnum, globalIndex);
+                porv *= regionMultiplier(opernum, multipliers.opernum, globalIndex);
+
+                values[globalIndex] = porv;
+            }, 4096 );
+
+            if (missingPoro)
+                throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
         }
 
 
@@ -497,18 +571,21 @@ namespace Opm {
 
 
         {
+            const auto multipliers = resolveMULTREGP(deck);
             auto initPORVProcessor =  std::bind(&initPORV,
                                       std::placeholders::_1,
-                                      &deck,
+                                      multipliers,
                                       &eclipseGrid,
                                       &m_intGridProperties,
-                                      &m_doubleGridProperties);
+                                      &m_doubleGridProperties,
+                                      &m_bulkVolume);
 
             m_doubleGridProperties.postAddKeyword( "PORV",
                                                    std::numeric_limits<double>::quiet_NaN(),
                                                    initPORVProcessor,
                                                    "ReservoirVolume",
-                                                   true );
+                                                   true,
+                                                   PORVDependencies( multipliers ) );
         }
 
         {
@@ -520,10 +597,18 @@ namespace Opm {
                                                 1,
                                                 actnumPP ,
                                                 "1",
-                                                true );
+                                                true,
+                                                { "PORV" } );
         }
 
         processGridProperties(deck, eclipseGrid);
+
+        const auto sectionHash = Section::contentHash( deck, { "RUNSPEC", "GRID", "EDIT", "PROPS", "REGIONS", "SOLUTION" } );
+        m_hash = ContentHash::combine( ContentHash::combine( eclipseGrid.hash(), tableManager.hash() ), sectionHash );
+    }
+
+    std::uint64_t Eclipse3DProperties::hash() const {
+        return m_hash;
     }
 
     bool Eclipse3DProperties::supportsGridProperty(const std::string& keyword) const {
@@ -547,9 +632,31 @@ namespace Opm {
     }
 
 
+    template< typename T >
+    bool Eclipse3DProperties::isDefaultedProperty( const GridProperties< T >& properties, const std::string& keyword ) {
+        if (properties.hasKeyword( keyword ))
+            return false;
+
+        const auto info = properties.m_supportedKeywords.find( uppercase( keyword ) );
+        return info == properties.m_supportedKeywords.end() || info->second.dependencies().empty();
+    }
+
+
+    /*
+      Reading a property which is not in the deck returns the default
+      values without adding the property to the container, so the
+      result of hasKeyword() - and thereby which properties are
+      written to the INIT file - does not depend on which properties
+      have been read. Only the derived properties, i.e. those with a
+      post processor which reads other properties (PORV and ACTNUM),
+      are created and processed on first access.
+    */
     const GridProperty<int>& Eclipse3DProperties::getIntGridProperty( const std::string& keyword ) const {
+        if (isDefaultedProperty( m_intGridProperties, keyword ))
+            return m_intGridProperties.getDefaultedKeyword( keyword );
+
         auto& gridProperty = const_cast< Eclipse3DProperties* >( this )->m_intGridProperties.getKeyword( keyword );
-        gridProperty.runPostProcessor();
+        this->runPostProcessors( gridProperty.getKeywordName() );
         return gridProperty;
     }
 
@@ -557,11 +664,112 @@ namespace Opm {
 
     /// gets property from doubleGridProperty --- and calls the runPostProcessor
     const GridProperty<double>& Eclipse3DProperties::getDoubleGridProperty( const std::string& keyword ) const {
+        if (isDefaultedProperty( m_doubleGridProperties, keyword ))
+            return m_doubleGridProperties.getDefaultedKeyword( keyword );
+
         auto& gridProperty = const_cast< Eclipse3DProperties* >( this )->m_doubleGridProperties.getKeyword( keyword );
-        gridProperty.runPostProcessor();
+        this->runPostProcessors( gridProperty.getKeywordName() );
         return gridProperty;
     }
 
+
+    /*
+      A post processor is only run after the post processors of the
+      properties it depends on. Dependencies are followed into the
+      properties which have already been created, a post processor is
+      itself responsible for inputs which are absent. The pending post
+      processors are grouped in levels where all the dependencies of a
+      level have been processed by the previous levels; the post
+      processors within one level are independent of each other and
+      are run in parallel.
+    */
+    std::vector< std::vector< std::string > > Eclipse3DProperties::postProcessorSchedule( const std::string& keyword ) const {
+        std::map< std::string, int > levels;
+        std::set< std::string > visiting;
+
+        std::function< int( const std::string& ) > visit = [&]( const std::string& kw ) -> int {
+            const auto iter = levels.find( kw );
+            if (iter != levels.end())
+                return iter->second;
+
+            const std::vector< std::string >* dependencies;
+            if (m_intGridProperties.m_supportedKeywords.count( kw )) {
+                const auto& info = m_intGridProperties.m_supportedKeywords.at( kw );
+                const auto prop = m_intGridProperties.m_properties.find( kw );
+                if (!info.hasPostProcessor())
+                    return -1;
+
+                if (prop == m_intGridProperties.m_properties.end() ? kw != keyword : prop->second.hasRunPostProcessor())
+                    return -1;
+
+                dependencies = &info.dependencies();
+            } else if (m_doubleGridProperties.m_supportedKeywords.count( kw )) {
+                const auto& info = m_doubleGridProperties.m_supportedKeywords.at( kw );
+                const auto prop = m_doubleGridProperties.m_properties.find( kw );
+                if (!info.hasPostProcessor())
+                    return -1;
+
+                if (prop == m_doubleGridProperties.m_properties.end() ? kw != keyword : prop->second.hasRunPostProcessor())
+                    return -1;
+
+                dependencies = &info.dependencies();
+            } else
+                return -1;
+
+            if (!visiting.insert( kw ).second)
+                throw std::logic_error("The post processor of " + kw + " depends on itself");
+
+            int level = 0;
+            for (const auto& dependency : *dependencies)
+                level = std::max( level, visit( dependency ) + 1 );
+
+            visiting.erase( kw );
+            levels[kw] = level;
+            return level;
+        };
+
+        std::vector< std::vector< std::string > > schedule;
+        visit( keyword );
+        for (const auto& pair : levels) {
+            if (schedule.size() <= static_cast< size_t >( pair.second ))
+                schedule.resize( pair.second + 1 );
+
+            schedule[pair.second].push_back( pair.first );
+        }
+
+        return schedule;
+    }
+
+
+    void Eclipse3DProperties::runPostProcessors( const std::string& keyword ) const {
+        auto& self = *const_cast< Eclipse3DProperties* >( this );
+
+        for (const auto& level : this->postProcessorSchedule( keyword )) {
+            /*
+              The properties are looked up before entering the parallel
+              region, the post processors then only see properties which
+              already exist.
+            */
+            TaskGroup group;
+            for (const auto& kw : level) {
+                if (m_intGridProperties.supportsKeyword( kw )) {
+                    auto* property = &self.m_intGridProperties.getKeyword( kw );
+                    group.run( [property]() { property->runPostProcessor(); } );
+                } else {
+                    auto* property = &self.m_doubleGridProperties.getKeyword( kw );
+                    group.run( [property]() { property->runPostProcessor(); } );
+                }
+            }
+
+            group.wait();
+        }
+    }
+
+    const std::vector<double>& Eclipse3DProperties::getBulkVolume() const {
+        getDoubleGridProperty("PORV");
+        return m_bulkVolume;
+    }
+
     const GridProperties<int>& Eclipse3DProperties::getIntProperties() const {
         return m_intGridProperties;
     }
@@ -722,14 +930,48 @@ namespace Opm {
 
 
 
+    void Eclipse3DProperties::trimStorage() const {
+        auto& storage = GridPropertyStorage::instance();
+        if (!storage.enabled())
+            return;
+
+        std::vector< const void* > owners;
+        for (const auto& property : this->m_intGridProperties)
+            owners.push_back( std::addressof( property ) );
+
+        for (const auto& property : this->m_doubleGridProperties)
+            owners.push_back( std::addressof( property ) );
+
+        storage.trim( owners );
+    }
+
+
     void Eclipse3DProperties::scanSection(const Section& section,
                                           const EclipseGrid& eclipseGrid) {
         BoxManager boxManager(eclipseGrid.getNX(),
                               eclipseGrid.getNY(),
                               eclipseGrid.getNZ());
+        bool inLGR = false;
 
         for( const auto& deckKeyword : section ) {
 
+            /*
+              The keywords in a CARFIN/REFINE ... ENDFIN block apply to
+              a local grid, they are handled by the LocalGrid class.
+            */
+            if (deckKeyword.name() == "CARFIN" || deckKeyword.name() == "REFINE") {
+                inLGR = true;
+                continue;
+            }
+
+            if (deckKeyword.name() == "ENDFIN") {
+                inLGR = false;
+                continue;
+            }
+
+            if (inLGR)
+                continue;
+
             if (supportsGridProperty(deckKeyword.name()) )
                 loadGridPropertyFromDeckKeyword( boxManager.getActiveBox(),
                                                  deckKeyword);
@@ -744,6 +986,9 @@ namespace Opm {
                 else if (deckKeyword.name() == "COPY")
                     handleCOPYKeyword( deckKeyword , boxManager);
 
+                else if (deckKeyword.name() == "COPYBOX")
+                    handleCOPYBOXKeyword( deckKeyword );
+
                 else if (deckKeyword.name() == "EQUALS")
                     handleEQUALSKeyword(deckKeyword, boxManager);
 
@@ -776,8 +1021,19 @@ namespace Opm {
                 else if (deckKeyword.name() == "OPERATE")
                     handleOPERATEKeyword( deckKeyword , boxManager);
 
+                else if (deckKeyword.name() == "OPERATER")
+                    handleOPERATERKeyword( deckKeyword );
+
                 boxManager.endKeyword();
             }
+
+            /*
+              No references to property data are held between keywords,
+              so this is a safe point to spill cold properties. Only the
+              properties of this object are considered; the properties
+              of other live EclipseState instances are left alone.
+            */
+            this->trimStorage();
         }
         boxManager.endSection();
     }
@@ -813,6 +1069,51 @@ namespace Opm {
         }
     }
 
+    /*
+      The OPERATER operations apply to one region of the OPERNUM array,
+      or of the region array named in the record. The cells of all the
+      regions are collected in one sweep over the region array, and the
+      index lists are reused by the following records; unless a record
+      modifies the region array itself.
+    */
+    void Eclipse3DProperties::handleOPERATERKeyword( const DeckKeyword& deckKeyword) {
+        std::map< std::string, std::map< int, std::vector< size_t > > > regionIndex;
+        const std::vector< size_t > emptyRegion;
+
+        for( const auto& record : deckKeyword ) {
+            const std::string& targetArray = record.getItem("RESULT_ARRAY").get< std::string >(0);
+            const auto& regionItem = record.getItem("FIP_REGION_NAME");
+            const std::string regionArray = regionItem.defaultApplied(0) ? "OPERNUM" : regionItem.getTrimmedString(0);
+
+            if (!m_intGridProperties.hasKeyword( regionArray ))
+                throw std::invalid_argument("Fatal error processing OPERATER keyword - region array " + regionArray + " has not been defined");
+
+            auto regions = regionIndex.find( regionArray );
+            if (regions == regionIndex.end()) {
+                std::map< int, std::vector< size_t > > index;
+                const auto& regionData = m_intGridProperties.getKeyword( regionArray ).getData();
+                for (size_t g = 0; g < regionData.size(); g++)
+                    index[ regionData[g] ].push_back( g );
+
+                regions = regionIndex.emplace( regionArray, std::move( index ) ).first;
+            }
+
+            const int regionValue = record.getItem("OPERATION_REGION_NUMBER").get< int >(0);
+            const auto region = regions->second.find( regionValue );
+            const auto& cells = (region == regions->second.end()) ? emptyRegion : region->second;
+
+            if (m_intGridProperties.supportsKeyword( targetArray ))
+                m_intGridProperties.handleOPERATERRecord( record , cells );
+            else if (m_doubleGridProperties.supportsKeyword( targetArray ))
+                m_doubleGridProperties.handleOPERATERRecord( record , cells );
+            else
+                throw std::invalid_argument("Fatal error processing OPERATER keyword - invalid/undefined keyword: " + targetArray);
+
+            if (targetArray == regionArray)
+                regionIndex.erase( regionArray );
+        }
+    }
+
     void Eclipse3DProperties::handleEQUALREGKeyword( const DeckKeyword& deckKeyword) {
        for( const auto& record : deckKeyword ) {
            const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
@@ -956,6 +1257,20 @@ namespace Opm {
     }
 
 
+    void Eclipse3DProperties::handleCOPYBOXKeyword( const DeckKeyword& deckKeyword) {
+        for( const auto& record : deckKeyword ) {
+            const std::string& field = record.getItem("ARRAY").get< std::string >(0);
+
+            if (m_doubleGridProperties.hasKeyword( field ))
+                m_doubleGridProperties.handleCOPYBOXRecord( record );
+            else if (m_intGridProperties.hasKeyword( field ))
+                m_intGridProperties.handleCOPYBOXRecord( record );
+            else
+                throw std::invalid_argument("Fatal error processing COPYBOX keyword. Tried to copy not defined keyword " + field);
+        }
+    }
+
+
     void Eclipse3DProperties::handleEQUALSKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
         for( const auto& record : deckKeyword ) {
             const std::string& field = record.getItem("field").get< std::string >(0);
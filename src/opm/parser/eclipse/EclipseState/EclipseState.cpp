@@ -58,6 +58,7 @@ namespace Opm {
         m_inputNnc(          deck ),
         m_inputGrid(         deck, nullptr ),
         m_eclipseProperties( deck, m_tables, m_inputGrid ),
+        m_tracerConfig(      deck, m_inputGrid, m_eclipseProperties ),
         m_simulationConfig(  deck, m_eclipseProperties ),
         m_transMult(         GridDims(deck), deck, m_eclipseProperties )
     {
@@ -112,6 +113,10 @@ namespace Opm {
         return m_tables;
     }
 
+    const TracerConfig& EclipseState::tracer() const {
+        return m_tracerConfig;
+    }
+
     const ParseContext& EclipseState::getParseContext() const {
         return m_parseContext;
     }
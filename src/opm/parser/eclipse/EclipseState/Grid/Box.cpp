@@ -17,6 +17,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <atomic>
 #include <stdexcept>
 
 #include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
@@ -62,7 +63,6 @@ namespace Opm {
         m_stride[2] = m_dims[0] * m_dims[1];
 
         m_isGlobal = true;
-        initIndexList();
     }
 
 
@@ -87,8 +87,6 @@ namespace Opm {
             m_isGlobal = true;
         else
             m_isGlobal = false;
-
-        initIndexList();
     }
 
 
@@ -118,38 +116,56 @@ namespace Opm {
 
 
     std::vector<size_t>::const_iterator Box::begin() const {
-        return m_indexList.begin();
+        return getIndexList().begin();
     }
 
     std::vector<size_t>::const_iterator Box::end() const {
-        return m_indexList.end();
+        return getIndexList().end();
     }
 
 
+    /*
+      The index list is built on first use. If several threads race to
+      build it, only the first list is installed and the others are
+      discarded; an installed list is never replaced, so the returned
+      reference stays valid for the lifetime of the box.
+    */
     const std::vector<size_t>& Box::getIndexList() const {
-        return m_indexList;
-    }
+        auto list = std::atomic_load( &m_indexList );
+        if (list)
+            return *list;
 
+        std::shared_ptr< const std::vector<size_t> > new_list = std::make_shared< const std::vector<size_t> >( makeIndexList() );
+        if (std::atomic_compare_exchange_strong( &m_indexList, &list, new_list ))
+            return *new_list;
 
-    void Box::initIndexList() {
-        m_indexList.resize( size() );
+        return *list;
+    }
 
-        size_t ii,ij,ik;
-        size_t l = 0;
 
-        for (ik=0; ik < m_dims[2]; ik++) {
-            size_t k = ik + m_offset[2];
-            for (ij=0; ij < m_dims[1]; ij++) {
-                size_t j = ij + m_offset[1];
-                for (ii=0; ii < m_dims[0]; ii++) {
-                    size_t i = ii + m_offset[0];
-                    size_t g = i * m_stride[0] + j*m_stride[1] + k*m_stride[2];
+    std::vector<size_t> Box::makeIndexList() const {
+        std::vector<size_t> indexList;
+        indexList.reserve( size() );
 
-                    m_indexList[l] = g;
-                    l++;
-                }
-            }
+        for (size_t row = 0; row < numRows(); row++) {
+            const size_t start = rowStart( row );
+            for (size_t ii = 0; ii < m_dims[0]; ii++)
+                indexList.push_back( start + ii );
         }
+
+        return indexList;
+    }
+
+
+    size_t Box::numRows() const {
+        return m_dims[1] * m_dims[2];
+    }
+
+
+    size_t Box::rowStart(size_t row) const {
+        const size_t j = row % m_dims[1] + m_offset[1];
+        const size_t k = row / m_dims[1] + m_offset[2];
+        return m_offset[0] + j*m_stride[1] + k*m_stride[2];
     }
 
     bool Box::equal(const Box& other) const {
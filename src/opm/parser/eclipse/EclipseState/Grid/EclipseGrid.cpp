@@ -20,6 +20,7 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 
+#include <fstream>
 #include <iostream>
 #include <tuple>
 #include <functional>
@@ -33,6 +34,7 @@
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
 
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
+#include <opm/parser/eclipse/Utility/Hash.hpp>
 
 #include <opm/parser/eclipse/Parser/ParserKeywords/A.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/C.hpp>
@@ -51,6 +53,31 @@
 
 namespace Opm {
 
+namespace {
+
+    /*
+      The last ACTNUM keyword in the deck which is not inside a
+      CARFIN/REFINE ... ENDFIN block; an ACTNUM in such a block
+      applies to the local grid.
+    */
+    const DeckKeyword* globalACTNUM(const Deck& deck) {
+        const DeckKeyword* actnum = nullptr;
+        bool in_lgr = false;
+
+        for (const auto& keyword : deck) {
+            if (keyword.name() == "CARFIN" || keyword.name() == "REFINE")
+                in_lgr = true;
+            else if (keyword.name() == "ENDFIN")
+                in_lgr = false;
+            else if (!in_lgr && keyword.name() == ParserKeywords::ACTNUM::keywordName)
+                actnum = &keyword;
+        }
+
+        return actnum;
+    }
+
+}
+
 
     EclipseGrid::EclipseGrid(std::array<int, 3>& dims ,
 			     const std::vector<double>& coord , 
@@ -64,6 +91,19 @@ namespace Opm {
 	  m_multzMode(PinchMode::ModeEnum::TOP)
     {
         initCornerPointGrid( dims, coord , zcorn , actnum , mapaxes );
+
+        ContentHash hasher;
+        for (int d : dims)
+            hasher.update( d );
+        hasher.update( coord );
+        hasher.update( zcorn );
+        if (mapaxes) {
+            for (size_t i = 0; i < 6; i++)
+                hasher.update( mapaxes[i] );
+        }
+
+        m_inputHash = hasher.digest();
+        updateHash( actnum );
     }
 
 
@@ -89,6 +129,18 @@ namespace Opm {
         m_nx = ecl_grid_get_nx( c_ptr() );
         m_ny = ecl_grid_get_ny( c_ptr() );
         m_nz = ecl_grid_get_nz( c_ptr() );
+
+        {
+            ContentHash hasher;
+            std::ifstream stream( filename, std::ios::binary );
+            char buffer[1 << 16];
+            while (stream) {
+                stream.read( buffer , sizeof buffer );
+                hasher.update( buffer , stream.gcount() );
+            }
+            m_inputHash = hasher.digest();
+            m_hash = m_inputHash;
+        }
     }
 
 
@@ -102,6 +154,16 @@ namespace Opm {
           m_multzMode(PinchMode::ModeEnum::TOP),
           m_grid( ecl_grid_alloc_rectangular(nx, ny, nz, dx, dy, dz, NULL) )
     {
+        ContentHash hasher;
+        hasher.update( static_cast< std::uint64_t >( nx ) );
+        hasher.update( static_cast< std::uint64_t >( ny ) );
+        hasher.update( static_cast< std::uint64_t >( nz ) );
+        hasher.update( dx );
+        hasher.update( dy );
+        hasher.update( dz );
+
+        m_inputHash = hasher.digest();
+        m_hash = m_inputHash;
     }
 
     EclipseGrid::EclipseGrid(const EclipseGrid& src, const double* zcorn , const std::vector<int>& actnum)
@@ -110,10 +172,24 @@ namespace Opm {
           m_minpvMode( src.m_minpvMode ),
           m_pinch( src.m_pinch ),
           m_pinchoutMode( src.m_pinchoutMode ),
-          m_multzMode( src.m_multzMode )
+          m_multzMode( src.m_multzMode ),
+          m_lgrs( src.m_lgrs )
     {
         const int * actnum_data = (actnum.empty()) ? nullptr : actnum.data();
         m_grid.reset( ecl_grid_alloc_processed_copy( src.c_ptr(), zcorn , actnum_data ));
+        if (actnum_data) {
+            for (auto& lgr : m_lgrs)
+                lgr.resetACTNUM( *this );
+        }
+
+        m_inputHash = src.m_inputHash;
+        if (zcorn) {
+            ContentHash hasher( m_inputHash );
+            for (size_t i = 0; i < this->zcornMapper().size(); i++)
+                hasher.update( zcorn[i] );
+            m_inputHash = hasher.digest();
+        }
+        updateHash( actnum_data );
     }
 
 
@@ -169,11 +245,15 @@ namespace Opm {
         const std::array<int, 3> dims = getNXYZ();
         initGrid(dims, deck);
 
+        m_inputHash = Section::contentHash( deck, { "RUNSPEC", "GRID" } );
+        m_hash = m_inputHash;
+
         if (actnum != nullptr)
             resetACTNUM(actnum);
         else {
-            if (deck.hasKeyword<ParserKeywords::ACTNUM>()) {
-                const auto& actnumData = deck.getKeyword<ParserKeywords::ACTNUM>().getIntData();
+            const auto* actnum_keyword = globalACTNUM( deck );
+            if (actnum_keyword != nullptr) {
+                const auto& actnumData = actnum_keyword->getIntData();
                 if (actnumData.size() == getCartesianSize())
                     resetACTNUM( actnumData.data());
                 else {
@@ -182,6 +262,120 @@ namespace Opm {
                 }
             }
         }
+
+        initLGR(deck);
+    }
+
+    /*
+      The local grids are defined by CARFIN ... ENDFIN blocks in the
+      GRID section; the keywords inside the block are property
+      modifiers for the local grid. In the later sections a REFINE
+      ... ENDFIN block adds more property modifiers to an existing
+      local grid.
+    */
+    void EclipseGrid::initLGR(const Deck& deck) {
+        int current = -1;
+        auto scanSection = [this, &current](const Section& section) {
+            for (const auto& keyword : section) {
+                if (keyword.name() == "CARFIN") {
+                    if (current >= 0)
+                        throw std::invalid_argument("CARFIN: missing ENDFIN for local grid " + m_lgrs[current].name());
+
+                    LocalGrid lgr( keyword, *this, m_lgrs.size() + 1, this->getTotalSize() );
+                    if (this->hasLGR( lgr.name() ))
+                        throw std::invalid_argument("CARFIN: local grid " + lgr.name() + " is already defined");
+
+                    m_lgrs.push_back( std::move( lgr ));
+                    current = m_lgrs.size() - 1;
+                } else if (keyword.name() == "REFINE") {
+                    if (current >= 0)
+                        throw std::invalid_argument("REFINE: missing ENDFIN for local grid " + m_lgrs[current].name());
+
+                    const auto& name = keyword.getRecord(0).getItem(0).get< std::string >(0);
+                    const auto& lgr = this->getLGR( name );
+                    current = lgr.lgrNumber() - 1;
+                } else if (keyword.name() == "ENDFIN")
+                    current = -1;
+                else if (current >= 0)
+                    m_lgrs[current].addKeyword( keyword );
+            }
+
+            if (current >= 0)
+                throw std::invalid_argument("Missing ENDFIN for local grid " + m_lgrs[current].name());
+        };
+
+        if (Section::hasGRID(deck))
+            scanSection( GRIDSection( deck ));
+
+        if (Section::hasEDIT(deck))
+            scanSection( EDITSection( deck ));
+
+        if (Section::hasPROPS(deck))
+            scanSection( PROPSSection( deck ));
+
+        if (Section::hasREGIONS(deck))
+            scanSection( REGIONSSection( deck ));
+
+        if (Section::hasSOLUTION(deck))
+            scanSection( SOLUTIONSection( deck ));
+    }
+
+    size_t EclipseGrid::numLGR() const {
+        return m_lgrs.size();
+    }
+
+    bool EclipseGrid::hasLGR(const std::string& name) const {
+        for (const auto& lgr : m_lgrs) {
+            if (lgr.name() == name)
+                return true;
+        }
+        return false;
+    }
+
+    const LocalGrid& EclipseGrid::getLGR(size_t lgr_nr) const {
+        if (lgr_nr == 0 || lgr_nr > m_lgrs.size())
+            throw std::invalid_argument("No local grid with number " + std::to_string( lgr_nr ));
+
+        return m_lgrs[lgr_nr - 1];
+    }
+
+    const LocalGrid& EclipseGrid::getLGR(const std::string& name) const {
+        for (const auto& lgr : m_lgrs) {
+            if (lgr.name() == name)
+                return lgr;
+        }
+        throw std::invalid_argument("No such local grid: " + name);
+    }
+
+    size_t EclipseGrid::getTotalSize() const {
+        if (m_lgrs.empty())
+            return this->getCartesianSize();
+
+        const auto& last = m_lgrs.back();
+        return last.offset() + last.getCartesianSize();
+    }
+
+    size_t EclipseGrid::getHierarchicalIndex(size_t grid_nr, size_t global_index) const {
+        if (grid_nr == 0) {
+            assertGlobalIndex( global_index );
+            return global_index;
+        }
+
+        const auto& lgr = this->getLGR( grid_nr );
+        lgr.assertGlobalIndex( global_index );
+        return lgr.offset() + global_index;
+    }
+
+    std::pair<size_t, size_t> EclipseGrid::getGridIndex(size_t hierarchical_index) const {
+        if (hierarchical_index < this->getCartesianSize())
+            return std::make_pair( size_t(0), hierarchical_index );
+
+        for (const auto& lgr : m_lgrs) {
+            if (hierarchical_index < lgr.offset() + lgr.getCartesianSize())
+                return std::make_pair( lgr.lgrNumber(), hierarchical_index - lgr.offset() );
+        }
+
+        throw std::invalid_argument("Hierarchical index " + std::to_string( hierarchical_index ) + " out of range");
     }
 
     bool EclipseGrid::circle( ) const{
@@ -705,6 +899,11 @@ namespace Opm {
         if(m_minpvMode!=MinpvMode::ModeEnum::Inactive){
             status = status && (m_minpvValue == other.getMinpvValue());
         }
+
+        status = status && (m_lgrs.size() == other.m_lgrs.size());
+        for (size_t index = 0; status && index < m_lgrs.size(); index++)
+            status = m_lgrs[index].equal( other.m_lgrs[index] );
+
         return status;
     }
 
@@ -894,6 +1093,26 @@ namespace Opm {
         /* re-build the active map cache */
         this->activeMap.clear();
         this->getActiveMap();
+        for (auto& lgr : m_lgrs)
+            lgr.resetACTNUM( *this );
+        updateHash( actnum );
+    }
+
+    void EclipseGrid::updateHash( const int * actnum ) {
+        if (!actnum) {
+            m_hash = m_inputHash;
+            return;
+        }
+
+        ContentHash hasher( m_inputHash );
+        for (size_t g = 0; g < getCartesianSize(); g++)
+            hasher.update( actnum[g] != 0 ? 1 : 0 );
+
+        m_hash = hasher.digest();
+    }
+
+    std::uint64_t EclipseGrid::hash() const {
+        return m_hash;
     }
 
     ZcornMapper EclipseGrid::zcornMapper() const {
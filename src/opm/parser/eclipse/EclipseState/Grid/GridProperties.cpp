@@ -21,6 +21,7 @@
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
@@ -314,6 +315,34 @@ namespace Opm {
         }
     }
 
+    /*
+      COPYBOX copies the values of one array from a source box to a
+      target box of the same shape in the same array; the box indices
+      in the deck are one based.
+    */
+    template< typename T >
+    void GridProperties<T>::handleCOPYBOXRecord( const DeckRecord& record) {
+        const std::string& field = record.getItem("ARRAY").get< std::string >(0);
+        if (!hasKeyword( field ))
+            throw std::invalid_argument("Fatal error processing COPYBOX keyword. Tried to copy not defined keyword " + field);
+
+        const auto item = [&record]( const std::string& name ) {
+            return record.getItem( name ).get< int >(0) - 1;
+        };
+
+        const Box source( this->nx, this->ny, this->nz,
+                          item("IX1"), item("IX2"),
+                          item("JY1"), item("JY2"),
+                          item("KZ1"), item("KZ2") );
+
+        const Box target( this->nx, this->ny, this->nz,
+                          item("IX1D"), item("IX2D"),
+                          item("JY1D"), item("JY2D"),
+                          item("KZ1D"), item("KZ2D") );
+
+        getKeyword( field ).copyBox( source, target );
+    }
+
     template< typename T >
     void GridProperties<T>::handleEQUALSRecord( const DeckRecord& record, BoxManager& boxManager) {
         const std::string& field = record.getItem("field").get< std::string >(0);
@@ -465,27 +494,64 @@ namespace Opm {
         double ABS(double, double X, double, double) {
             return std::abs(X);
         }
+
+        using operate_fptr = decltype( &MULTA );
+
+        /*
+          The OPERATE and OPERATER keywords share one kernel for each
+          operation, which applies the operation to all the cells in an
+          index list; for OPERATE the index list is the cells of the box,
+          for OPERATER the cells of the region. The operation is a
+          template argument, so it is inlined in the loop.
+        */
+        template< typename T, operate_fptr op >
+        void operate_kernel( std::vector<T>& target,
+                             const std::vector<T>& src,
+                             const std::vector<size_t>& index_list,
+                             double alpha,
+                             double beta ) {
+            T* target_data = target.data();
+            const T* src_data = src.data();
+            const size_t* index = index_list.data();
+            const size_t size = index_list.size();
+
+            for (size_t i = 0; i < size; i++) {
+                const size_t g = index[i];
+                target_data[g] = static_cast<T>( op( target_data[g], src_data[g], alpha, beta ) );
+            }
+        }
+
+        template< typename T >
+        using operate_kernel_fptr = void (*)( std::vector<T>&, const std::vector<T>&, const std::vector<size_t>&, double, double );
+
+        template< typename T >
+        operate_kernel_fptr<T> operate_kernel_lookup( const std::string& operation ) {
+            static const std::map<std::string , operate_kernel_fptr<T>> kernels = {{"MULTA"  , &operate_kernel<T, &MULTA>},
+                                                                                  {"POLY"   , &operate_kernel<T, &POLY>},
+                                                                                  {"SLOG"   , &operate_kernel<T, &SLOG>},
+                                                                                  {"LOG10"  , &operate_kernel<T, &LOG10>},
+                                                                                  {"LOGE"   , &operate_kernel<T, &LOGE>},
+                                                                                  {"INV"    , &operate_kernel<T, &INV>},
+                                                                                  {"MULTX"  , &operate_kernel<T, &MULTX>},
+                                                                                  {"ADDX"   , &operate_kernel<T, &ADDX>},
+                                                                                  {"COPY"   , &operate_kernel<T, &COPY>},
+                                                                                  {"MAXLIM" , &operate_kernel<T, &MAXLIM>},
+                                                                                  {"MINLIM" , &operate_kernel<T, &MINLIM>},
+                                                                                  {"MULTP"  , &operate_kernel<T, &MULTP>},
+                                                                                  {"ABS"    , &operate_kernel<T, &ABS>},
+                                                                                  {"MULTIPLY" , &operate_kernel<T, &MULTIPLY>}};
+
+            const auto iter = kernels.find( operation );
+            if (iter == kernels.end())
+                throw std::invalid_argument("Unknown operation: " + operation);
+
+            return iter->second;
+        }
     }
 
 
     template <typename T>
     void GridProperties<T>::handleOPERATERecord( const DeckRecord& record, BoxManager& boxManager) {
-        using  operate_fptr = decltype( &MULTA );
-        static const std::map<std::string , operate_fptr> operations = {{"MULTA"  , &MULTA},
-                                                                        {"POLY"   , &POLY},
-                                                                        {"SLOG"   , &SLOG},
-                                                                        {"LOG10"  , &LOG10},
-                                                                        {"LOGE"   , &LOGE},
-                                                                        {"INV"    , &INV},
-                                                                        {"MULTX"  , &MULTX},
-                                                                        {"ADDX"   , &ADDX},
-                                                                        {"COPY"   , &COPY},
-                                                                        {"MAXLIM" , &MAXLIM},
-                                                                        {"MINLIM" , &MINLIM},
-                                                                        {"MULTP"  , &MULTP},
-                                                                        {"ABS"    , &ABS},
-                                                                        {"MULTIPLY" , &MULTIPLY}};
-
         const std::string& srcArray    = record.getItem("ARRAY").get< std::string >(0);
         const std::string& targetArray = record.getItem("TARGET_ARRAY").get< std::string >(0);
         const std::string& operation   = record.getItem("OPERATION").get< std::string >(0);
@@ -493,19 +559,42 @@ namespace Opm {
         double beta = record.getItem("PARAM2").get< double >(0);
 
         if (!supportsKeyword( targetArray))
-            throw std::invalid_argument("Fatal error processing COPYREG record - invalid/undefined keyword: " + targetArray);
+            throw std::invalid_argument("Fatal error processing OPERATE record - invalid/undefined keyword: " + targetArray);
 
         if (!hasKeyword( srcArray ))
-            throw std::invalid_argument("Fatal error processing COPYREG record - invalid/undefined keyword: " + srcArray);
+            throw std::invalid_argument("Fatal error processing OPERATE record - invalid/undefined keyword: " + srcArray);
 
         {
             const std::vector<T>& srcData = getKeyword( srcArray ).getData();
             std::vector<T>& targetData = getOrCreateProperty( targetArray ).getData();
-            operate_fptr func = operations.at( operation );
+            const auto kernel = operate_kernel_lookup<T>( operation );
 
             setKeywordBox(record, boxManager);
-            for (auto index : boxManager.getActiveBox())
-                targetData[index] = func( targetData[index] , srcData[index] , alpha, beta );
+            kernel( targetData, srcData, boxManager.getActiveBox().getIndexList(), alpha, beta );
+        }
+    }
+
+
+    template <typename T>
+    void GridProperties<T>::handleOPERATERRecord( const DeckRecord& record, const std::vector<size_t>& regionIndex) {
+        const std::string& srcArray    = record.getItem("ARRAY_PARAMETER").get< std::string >(0);
+        const std::string& targetArray = record.getItem("RESULT_ARRAY").get< std::string >(0);
+        const std::string& operation   = record.getItem("OPERATION_TYPE").get< std::string >(0);
+        double alpha = record.getItem("SCALAR_PARAMETER").get< double >(0);
+        double beta = record.getItem("SCALAR_PARAMETER2").get< double >(0);
+
+        if (!supportsKeyword( targetArray))
+            throw std::invalid_argument("Fatal error processing OPERATER record - invalid/undefined keyword: " + targetArray);
+
+        if (!hasKeyword( srcArray ))
+            throw std::invalid_argument("Fatal error processing OPERATER record - invalid/undefined keyword: " + srcArray);
+
+        {
+            const std::vector<T>& srcData = getKeyword( srcArray ).getData();
+            std::vector<T>& targetData = getOrCreateProperty( targetArray ).getData();
+            const auto kernel = operate_kernel_lookup<T>( operation );
+
+            kernel( targetData, srcData, regionIndex, alpha, beta );
         }
     }
 
@@ -515,14 +604,16 @@ namespace Opm {
                                            const T defaultValue,
                                            std::function< void( std::vector< T >& ) > postProcessor,
                                            const std::string& dimString,
-                                           const bool defaultInitializable )
+                                           const bool defaultInitializable,
+                                           const std::vector< std::string >& dependencies )
     {
         m_supportedKeywords.emplace(name,
                                     SupportedKeywordInfo( name,
                                                           defaultValue,
                                                           postProcessor,
                                                           dimString,
-                                                          defaultInitializable ));
+                                                          defaultInitializable,
+                                                          dependencies ));
     }
 
     template< typename T >
@@ -536,6 +627,27 @@ namespace Opm {
     }
 
 
+    template< typename T >
+    const GridProperty<T>& GridProperties<T>::getDefaultedKeyword(const std::string& keyword) const {
+        const std::string kw = normalize(keyword);
+
+        if (m_properties.count( kw ) > 0)
+            return m_properties.at( kw );
+
+        if (!supportsKeyword( kw ))
+            throw std::invalid_argument("The keyword: " + kw + " is not supported in this container");
+
+        auto iter = m_defaultProperties.find( kw );
+        if (iter == m_defaultProperties.end()) {
+            const auto info = m_supportedKeywords.count( kw ) > 0 ? m_supportedKeywords.at( kw ) : SupportedKeywordInfo( kw , 1, "1" );
+            iter = m_defaultProperties.emplace( kw, GridProperty<T>( this->nx, this->ny , this->nz , info )).first;
+            iter->second.runPostProcessor( );
+        }
+
+        return iter->second;
+    }
+
+
     /*
       This is const because of the auto-generation of keywords on get().
     */
@@ -17,15 +17,19 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include <opm/common/utility/Executor.hpp>
+
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridPropertyStorage.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/RtempvdTable.hpp>
@@ -43,16 +47,39 @@ namespace Opm {
         return []( std::vector< T >& ) { return; };
     }
 
+    /*
+      The box operations below work on one row, i.e. a contiguous run
+      of getDim(0) cells, at a time so the inner loops can be
+      vectorized by the compiler. The K layers are distributed over the
+      shared executor; the rows of different layers never overlap.
+    */
+    template< typename Func >
+    static void forEachRow( const Box& box, Func&& op ) {
+        const size_t ny = box.getDim(1);
+        const size_t layer_size = box.getDim(0) * ny;
+        if (layer_size == 0)
+            return;
+
+        const size_t grain = std::max< size_t >( 1, 65536 / layer_size );
+        Executor::instance().parallelFor( 0, box.getDim(2), [&]( size_t k ) {
+            for (size_t j = 0; j < ny; j++)
+                op( j + k*ny );
+        }, grain );
+    }
+
     template< typename T >
     GridPropertySupportedKeywordInfo< T >::GridPropertySupportedKeywordInfo(
             const std::string& name,
             std::function< std::vector< T >( size_t ) > init,
             std::function< void( std::vector< T >& ) > post,
             const std::string& dimString,
-            bool defaultInitializable ) :
+            bool defaultInitializable,
+            const std::vector< std::string >& dependencies ) :
         m_keywordName( name ),
         m_initializer( init ),
         m_postProcessor( post ),
+        m_hasPostProcessor( true ),
+        m_dependencies( dependencies ),
         m_dimensionString( dimString ),
         m_defaultInitializable ( defaultInitializable )
     {}
@@ -89,10 +116,13 @@ namespace Opm {
             const T defaultValue,
             std::function< void( std::vector< T >& ) > post,
             const std::string& dimString,
-            bool defaultInitializable ) :
+            bool defaultInitializable,
+            const std::vector< std::string >& dependencies ) :
         m_keywordName( name ),
         m_initializer( constant( defaultValue ) ),
         m_postProcessor( post ),
+        m_hasPostProcessor( true ),
+        m_dependencies( dependencies ),
         m_dimensionString( dimString ),
         m_defaultInitializable ( defaultInitializable )
     {}
@@ -117,6 +147,16 @@ namespace Opm {
         return this->m_postProcessor;
     }
 
+    template< typename T >
+    bool GridPropertySupportedKeywordInfo< T >::hasPostProcessor() const {
+        return this->m_hasPostProcessor;
+    }
+
+    template< typename T >
+    const std::vector< std::string >& GridPropertySupportedKeywordInfo< T >::dependencies() const {
+        return this->m_dependencies;
+    }
+
     template<typename T>
     bool GridPropertySupportedKeywordInfo< T >::isDefaultInitializable() const {
         return m_defaultInitializable;
@@ -132,9 +172,131 @@ namespace Opm {
         m_hasRunPostProcessor( false )
     {}
 
+    template< typename T >
+    GridProperty< T >::GridProperty( const GridProperty< T >& other ) :
+        m_nx( other.m_nx ),
+        m_ny( other.m_ny ),
+        m_nz( other.m_nz ),
+        m_kwInfo( other.m_kwInfo ),
+        m_data( other.m_data ),
+        m_scratch( other.m_scratch ),
+        m_spilled( other.m_spilled.load() ),
+        m_hasRunPostProcessor( other.m_hasRunPostProcessor )
+    {}
+
+    template< typename T >
+    GridProperty< T >::GridProperty( GridProperty< T >&& other ) :
+        m_nx( other.m_nx ),
+        m_ny( other.m_ny ),
+        m_nz( other.m_nz ),
+        m_kwInfo( std::move( other.m_kwInfo ) ),
+        m_data( std::move( other.m_data ) ),
+        m_scratch( std::move( other.m_scratch ) ),
+        m_spilled( other.m_spilled.exchange( false ) ),
+        m_hasRunPostProcessor( other.m_hasRunPostProcessor )
+    {
+        GridPropertyStorage::instance().release( &other );
+    }
+
+    template< typename T >
+    GridProperty< T >& GridProperty< T >::operator=( const GridProperty< T >& other ) {
+        if (this == &other)
+            return *this;
+
+        GridPropertyStorage::instance().release( this );
+        this->m_nx = other.m_nx;
+        this->m_ny = other.m_ny;
+        this->m_nz = other.m_nz;
+        this->m_kwInfo = other.m_kwInfo;
+        this->m_data = other.m_data;
+        this->m_scratch = other.m_scratch;
+        this->m_spilled.store( other.m_spilled.load() );
+        this->m_hasRunPostProcessor = other.m_hasRunPostProcessor;
+        return *this;
+    }
+
+    template< typename T >
+    GridProperty< T >& GridProperty< T >::operator=( GridProperty< T >&& other ) {
+        if (this == &other)
+            return *this;
+
+        auto& storage = GridPropertyStorage::instance();
+        storage.release( this );
+        storage.release( &other );
+        this->m_nx = other.m_nx;
+        this->m_ny = other.m_ny;
+        this->m_nz = other.m_nz;
+        this->m_kwInfo = std::move( other.m_kwInfo );
+        this->m_data = std::move( other.m_data );
+        this->m_scratch = std::move( other.m_scratch );
+        this->m_spilled.store( other.m_spilled.exchange( false ) );
+        this->m_hasRunPostProcessor = other.m_hasRunPostProcessor;
+        return *this;
+    }
+
+    template< typename T >
+    GridProperty< T >::~GridProperty() {
+        GridPropertyStorage::instance().release( this );
+    }
+
+    /*
+      The spill function is called by GridPropertyStorage::trim() with
+      the storage mutex held, and load() restores the data under the
+      same mutex. The m_spilled flag is only checked without the lock
+      as a fast path; all the bulk accessors go through use(), which
+      also updates the LRU information in the storage.
+    */
+    template< typename T >
+    void GridProperty< T >::spill( const void* owner, const std::string& directory ) {
+        const auto* self = static_cast< const GridProperty< T >* >( owner );
+        self->m_scratch = std::make_shared< const ScratchArray >( directory,
+                                                                  self->m_data.data(),
+                                                                  self->m_data.size() * sizeof( T ) );
+        std::vector< T >().swap( self->m_data );
+        self->m_spilled.store( true, std::memory_order_release );
+    }
+
+    template< typename T >
+    void GridProperty< T >::load() const {
+        if (!this->m_spilled.load( std::memory_order_acquire ))
+            return;
+
+        const auto bytes = this->getCartesianSize() * sizeof( T );
+        GridPropertyStorage::instance().restore( this, bytes, &GridProperty< T >::spill, [this]() {
+            if (!this->m_spilled.load( std::memory_order_relaxed ))
+                return;
+
+            const auto* begin = static_cast< const T* >( this->m_scratch->data() );
+            this->m_data.assign( begin, begin + this->m_scratch->size() / sizeof( T ) );
+            this->m_scratch.reset();
+            this->m_spilled.store( false, std::memory_order_release );
+        });
+    }
+
+    template< typename T >
+    void GridProperty< T >::use() const {
+        this->load();
+        GridPropertyStorage::instance().touch( this,
+                                               this->getCartesianSize() * sizeof( T ),
+                                               &GridProperty< T >::spill );
+    }
+
+    template< typename T >
+    void GridProperty< T >::pin() const {
+        GridPropertyStorage::instance().pin( this,
+                                             this->getCartesianSize() * sizeof( T ),
+                                             &GridProperty< T >::spill );
+        this->load();
+    }
+
+    template< typename T >
+    void GridProperty< T >::unpin() const {
+        GridPropertyStorage::instance().unpin( this );
+    }
+
     template< typename T >
     size_t GridProperty< T >::getCartesianSize() const {
-        return m_data.size();
+        return m_nx * m_ny * m_nz;
     }
 
     template< typename T >
@@ -154,6 +316,7 @@ namespace Opm {
 
     template< typename T >
     T GridProperty< T >::iget( size_t index ) const {
+        this->load();
         return this->m_data.at( index );
     }
 
@@ -165,6 +328,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::iset(size_t index, T value) {
+        this->load();
         this->m_data.at( index ) = value;
     }
 
@@ -176,18 +340,22 @@ namespace Opm {
 
     template< typename T >
     const std::vector< T >& GridProperty< T >::getData() const {
+        this->use();
         return m_data;
     }
 
 
     template< typename T >
     std::vector< T >& GridProperty< T >::getData() {
+        this->use();
         return m_data;
     }
 
     template< typename T >
     void GridProperty< T >::multiplyWith( const GridProperty< T >& other ) {
         if ((m_nx == other.m_nx) && (m_ny == other.m_ny) && (m_nz == other.m_nz)) {
+            this->use();
+            other.use();
             for (size_t g=0; g < m_data.size(); g++)
                 m_data[g] *= other.m_data[g];
         } else
@@ -196,6 +364,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::multiplyValueAtIndex(size_t index, T factor) {
+        this->load();
         m_data[index] *= factor;
     }
 
@@ -203,6 +372,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::maskedSet( T value, const std::vector< bool >& mask ) {
+        this->use();
         for (size_t g = 0; g < getCartesianSize(); g++) {
             if (mask[g])
                 m_data[g] = value;
@@ -211,6 +381,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::maskedMultiply( T value, const std::vector<bool>& mask ) {
+        this->use();
         for (size_t g = 0; g < getCartesianSize(); g++) {
             if (mask[g])
                 m_data[g] *= value;
@@ -220,6 +391,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::maskedAdd( T value, const std::vector<bool>& mask ) {
+        this->use();
         for (size_t g = 0; g < getCartesianSize(); g++) {
             if (mask[g])
                 m_data[g] += value;
@@ -228,6 +400,8 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::maskedCopy( const GridProperty< T >& other, const std::vector< bool >& mask) {
+        this->use();
+        other.use();
         for (size_t g = 0; g < getCartesianSize(); g++) {
             if (mask[g])
                 m_data[g] = other.m_data[g];
@@ -236,6 +410,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::initMask( T value, std::vector< bool >& mask ) const {
+        this->use();
         mask.resize(getCartesianSize());
         for (size_t g = 0; g < getCartesianSize(); g++) {
             if (m_data[g] == value)
@@ -247,6 +422,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::loadFromDeckKeyword( const DeckKeyword& deckKeyword ) {
+        this->use();
         const auto& deckItem = getDeckItem(deckKeyword);
         const auto size = deckItem.size();
         for (size_t dataPointIdx = 0; dataPointIdx < size; ++dataPointIdx) {
@@ -257,6 +433,7 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::loadFromDeckKeyword( const Box& inputBox, const DeckKeyword& deckKeyword) {
+        this->use();
         if (inputBox.isGlobal())
             loadFromDeckKeyword( deckKeyword );
         else {
@@ -282,84 +459,125 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::copyFrom( const GridProperty< T >& src, const Box& inputBox ) {
-        if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < src.getCartesianSize(); ++i)
-                m_data[i] = src.m_data[i];
+        this->use();
+        src.use();
+        T* data = this->m_data.data();
+        const T* src_data = src.m_data.data();
+        const size_t nx = inputBox.getDim(0);
+        forEachRow( inputBox, [&]( size_t row ) {
+            const size_t start = inputBox.rowStart( row );
+            T* target = data + start;
+            const T* source = src_data + start;
+            for (size_t i = 0; i < nx; i++)
+                target[i] = source[i];
+        });
+    }
+
+    template< typename T >
+    void GridProperty< T >::copyBox( const Box& sourceBox, const Box& targetBox ) {
+        for (size_t d = 0; d < 3; d++) {
+            if (sourceBox.getDim(d) != targetBox.getDim(d))
+                throw std::invalid_argument("COPYBOX: source and target box for " + this->getKeywordName() + " must have the same shape");
+        }
+
+        this->use();
+        T* data = this->m_data.data();
+        const size_t nx = sourceBox.getDim(0);
+
+        /*
+          When the two boxes overlap the source is gathered to a
+          temporary before it is written back, otherwise the rows can be
+          copied directly.
+        */
+        const bool overlap =
+            sourceBox.I1() <= targetBox.I2() && targetBox.I1() <= sourceBox.I2() &&
+            sourceBox.J1() <= targetBox.J2() && targetBox.J1() <= sourceBox.J2() &&
+            sourceBox.K1() <= targetBox.K2() && targetBox.K1() <= sourceBox.K2();
+
+        if (overlap) {
+            std::vector< T > tmp( sourceBox.size() );
+            forEachRow( sourceBox, [&]( size_t row ) {
+                const T* source = data + sourceBox.rowStart( row );
+                T* target = tmp.data() + row * nx;
+                for (size_t i = 0; i < nx; i++)
+                    target[i] = source[i];
+            });
+            forEachRow( targetBox, [&]( size_t row ) {
+                const T* source = tmp.data() + row * nx;
+                T* target = data + targetBox.rowStart( row );
+                for (size_t i = 0; i < nx; i++)
+                    target[i] = source[i];
+            });
         } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] = src.m_data[targetIndex];
-            }
+            forEachRow( targetBox, [&]( size_t row ) {
+                const T* source = data + sourceBox.rowStart( row );
+                T* target = data + targetBox.rowStart( row );
+                for (size_t i = 0; i < nx; i++)
+                    target[i] = source[i];
+            });
         }
     }
 
     template< typename T >
     void GridProperty< T >::maxvalue( T value, const Box& inputBox ) {
-        if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < m_data.size(); ++i)
-                m_data[i] = std::min(value,m_data[i]);
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] = std::min(value,m_data[targetIndex]);
-            }
-        }
+        this->use();
+        T* data = this->m_data.data();
+        const size_t nx = inputBox.getDim(0);
+        forEachRow( inputBox, [&]( size_t row ) {
+            T* target = data + inputBox.rowStart( row );
+            for (size_t i = 0; i < nx; i++)
+                target[i] = std::min(value, target[i]);
+        });
     }
 
     template< typename T >
     void GridProperty< T >::minvalue( T value, const Box& inputBox ) {
-        if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < m_data.size(); ++i)
-                m_data[i] = std::max(value,m_data[i]);
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] = std::max(value,m_data[targetIndex]);
-            }
-        }
+        this->use();
+        T* data = this->m_data.data();
+        const size_t nx = inputBox.getDim(0);
+        forEachRow( inputBox, [&]( size_t row ) {
+            T* target = data + inputBox.rowStart( row );
+            for (size_t i = 0; i < nx; i++)
+                target[i] = std::max(value, target[i]);
+        });
     }
 
     template< typename T >
     void GridProperty< T >::scale( T scaleFactor, const Box& inputBox ) {
-        if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < m_data.size(); ++i)
-                m_data[i] *= scaleFactor;
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] *= scaleFactor;
-            }
-        }
+        this->use();
+        T* data = this->m_data.data();
+        const size_t nx = inputBox.getDim(0);
+        forEachRow( inputBox, [&]( size_t row ) {
+            T* target = data + inputBox.rowStart( row );
+            for (size_t i = 0; i < nx; i++)
+                target[i] *= scaleFactor;
+        });
     }
 
     template< typename T >
     void GridProperty< T >::add( T shiftValue, const Box& inputBox ) {
-        if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < m_data.size(); ++i)
-                m_data[i] += shiftValue;
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] += shiftValue;
-            }
-        }
+        this->use();
+        T* data = this->m_data.data();
+        const size_t nx = inputBox.getDim(0);
+        forEachRow( inputBox, [&]( size_t row ) {
+            T* target = data + inputBox.rowStart( row );
+            for (size_t i = 0; i < nx; i++)
+                target[i] += shiftValue;
+        });
     }
 
     template< typename T >
     void GridProperty< T >::setScalar( T value, const Box& inputBox ) {
+        this->use();
         if (inputBox.isGlobal()) {
             std::fill(m_data.begin(), m_data.end(), value);
         } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] = value;
-            }
+            T* data = this->m_data.data();
+            const size_t nx = inputBox.getDim(0);
+            forEachRow( inputBox, [&]( size_t row ) {
+                T* target = data + inputBox.rowStart( row );
+                std::fill( target, target + nx, value );
+            });
         }
     }
 
@@ -378,11 +596,18 @@ namespace Opm {
     void GridProperty< T >::runPostProcessor() {
         if( this->m_hasRunPostProcessor ) return;
         this->m_hasRunPostProcessor = true;
+        this->use();
         this->m_kwInfo.postProcessor()( m_data );
     }
 
+    template< typename T >
+    bool GridProperty< T >::hasRunPostProcessor() const {
+        return this->m_hasRunPostProcessor;
+    }
+
     template< typename T >
     void GridProperty< T >::checkLimits( T min, T max ) const {
+        this->use();
         for (size_t g=0; g < m_data.size(); g++) {
             T value = m_data[g];
             if ((value < min) || (value > max))
@@ -403,10 +628,10 @@ namespace Opm {
 
         const auto& deckItem = deckKeyword.getRecord(0).getItem(0);
 
-        if (deckItem.size() > m_data.size())
+        if (deckItem.size() > getCartesianSize())
             throw std::invalid_argument("Size mismatch when setting data for:" + getKeywordName()
                                         + " keyword size: " + std::to_string( deckItem.size() )
-                                        + " input size: " + std::to_string( m_data.size()) );
+                                        + " input size: " + std::to_string( getCartesianSize()) );
 
         return deckItem;
     }
@@ -428,6 +653,7 @@ bool GridProperty<int>::containsNaN( ) const {
 
 template<>
 bool GridProperty<double>::containsNaN( ) const {
+    this->use();
     bool return_value = false;
     size_t size = m_data.size();
     size_t index = 0;
@@ -457,6 +683,7 @@ const std::string& GridProperty<double>::getDimensionString() const {
 
 template<typename T>
 std::vector<T> GridProperty<T>::compressedCopy(const EclipseGrid& grid) const {
+    this->use();
     if (grid.allActive())
         return m_data;
     else {
@@ -468,6 +695,7 @@ std::vector<T> GridProperty<T>::compressedCopy(const EclipseGrid& grid) const {
 
 template<typename T>
 std::vector<size_t> GridProperty<T>::cellsEqual(T value, const std::vector<int>& activeMap) const {
+    this->use();
     std::vector<size_t> cells;
     for (size_t active_index = 0; active_index < activeMap.size(); active_index++) {
         size_t global_index = activeMap[ active_index ];
@@ -480,6 +708,7 @@ std::vector<size_t> GridProperty<T>::cellsEqual(T value, const std::vector<int>&
 
 template<typename T>
 std::vector<size_t> GridProperty<T>::indexEqual(T value) const {
+    this->use();
     std::vector<size_t> index_list;
     for (size_t index = 0; index < m_data.size(); index++) {
         if (m_data[index] == value)
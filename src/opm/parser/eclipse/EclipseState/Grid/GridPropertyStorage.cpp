@@ -0,0 +1,269 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define OPM_HAVE_SCRATCH_MMAP 1
+#endif
+
+#include <opm/parser/eclipse/EclipseState/Grid/GridPropertyStorage.hpp>
+
+namespace Opm {
+
+#ifdef OPM_HAVE_SCRATCH_MMAP
+
+    ScratchArray::ScratchArray( const std::string& directory, const void* data, std::size_t size ) :
+        m_size( size )
+    {
+        if (size == 0)
+            return;
+
+        std::string path = directory + "/opm-gridproperty-XXXXXX";
+        std::vector< char > name( path.begin(), path.end() );
+        name.push_back( '\0' );
+
+        int fd = mkstemp( name.data() );
+        if (fd < 0)
+            throw std::runtime_error("Could not create scratch file in " + directory + ": " + std::strerror( errno ));
+
+        unlink( name.data() );
+
+        const char* p = static_cast< const char* >( data );
+        std::size_t left = size;
+        while (left > 0) {
+            const auto written = write( fd, p, left );
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                const std::string msg = std::strerror( errno );
+                close( fd );
+                throw std::runtime_error("Could not write scratch file in " + directory + ": " + msg);
+            }
+
+            p += written;
+            left -= written;
+        }
+
+        void* addr = mmap( nullptr, size, PROT_READ, MAP_SHARED, fd, 0 );
+        close( fd );
+        if (addr == MAP_FAILED)
+            throw std::runtime_error("Could not map scratch file: " + std::string( std::strerror( errno ) ));
+
+        this->m_addr = addr;
+    }
+
+
+    ScratchArray::~ScratchArray() {
+        if (this->m_addr)
+            munmap( this->m_addr, this->m_size );
+    }
+
+#else
+
+    ScratchArray::ScratchArray( const std::string&, const void*, std::size_t ) {
+        throw std::runtime_error("Scratch files for grid properties are not supported on this platform");
+    }
+
+    ScratchArray::~ScratchArray() {
+    }
+
+#endif
+
+    const void* ScratchArray::data() const {
+        return this->m_addr;
+    }
+
+    std::size_t ScratchArray::size() const {
+        return this->m_size;
+    }
+
+
+
+    GridPropertyStorage& GridPropertyStorage::instance() {
+        static GridPropertyStorage storage;
+        return storage;
+    }
+
+
+    void GridPropertyStorage::configure( const std::string& directory, std::size_t budget ) {
+        if (budget > 0 && directory.empty())
+            throw std::invalid_argument("A scratch directory is required to spill grid properties");
+
+        std::lock_guard< std::mutex > lock( this->m_mutex );
+        this->m_directory = directory;
+        this->m_budget = budget;
+        this->m_enabled.store( budget > 0 );
+    }
+
+
+    bool GridPropertyStorage::enabled() const {
+        return this->m_enabled.load();
+    }
+
+
+    const std::string& GridPropertyStorage::directory() const {
+        return this->m_directory;
+    }
+
+
+    std::size_t GridPropertyStorage::budget() const {
+        return this->m_budget;
+    }
+
+
+    std::size_t GridPropertyStorage::residentBytes() const {
+        std::lock_guard< std::mutex > lock( this->m_mutex );
+        std::size_t bytes = 0;
+        for (const auto& pair : this->m_entries) {
+            if (!pair.second.spilled)
+                bytes += pair.second.bytes;
+        }
+
+        return bytes;
+    }
+
+
+    std::size_t GridPropertyStorage::spilledBytes() const {
+        std::lock_guard< std::mutex > lock( this->m_mutex );
+        std::size_t bytes = 0;
+        for (const auto& pair : this->m_entries) {
+            if (pair.second.spilled)
+                bytes += pair.second.bytes;
+        }
+
+        return bytes;
+    }
+
+
+    GridPropertyStorage::Entry& GridPropertyStorage::entry( const void* owner, std::size_t bytes, SpillFunction spill ) {
+        auto& entry = this->m_entries[owner];
+        entry.bytes = bytes;
+        entry.spill = spill;
+        entry.last_use = ++this->m_clock;
+        return entry;
+    }
+
+
+    void GridPropertyStorage::touch( const void* owner, std::size_t bytes, SpillFunction spill ) {
+        if (!this->m_enabled.load( std::memory_order_relaxed ))
+            return;
+
+        std::lock_guard< std::mutex > lock( this->m_mutex );
+        this->entry( owner, bytes, spill );
+    }
+
+
+    void GridPropertyStorage::restore( const void* owner, std::size_t bytes, SpillFunction spill,
+                                       const std::function< void() >& reload ) {
+        std::lock_guard< std::mutex > lock( this->m_mutex );
+        reload();
+        this->entry( owner, bytes, spill ).spilled = false;
+    }
+
+
+    void GridPropertyStorage::release( const void* owner ) {
+        std::lock_guard< std::mutex > lock( this->m_mutex );
+        this->m_entries.erase( owner );
+    }
+
+
+    void GridPropertyStorage::pin( const void* owner, std::size_t bytes, SpillFunction spill ) {
+        std::lock_guard< std::mutex > lock( this->m_mutex );
+        this->entry( owner, bytes, spill ).pins += 1;
+    }
+
+
+    void GridPropertyStorage::unpin( const void* owner ) {
+        std::lock_guard< std::mutex > lock( this->m_mutex );
+        auto iter = this->m_entries.find( owner );
+        if (iter == this->m_entries.end() || iter->second.pins == 0)
+            throw std::logic_error("Grid property unpinned without being pinned");
+
+        iter->second.pins -= 1;
+    }
+
+
+    void GridPropertyStorage::trim() {
+        if (!this->m_enabled.load())
+            return;
+
+        std::lock_guard< std::mutex > lock( this->m_mutex );
+        this->spillUntilWithinBudget( []( const void* ) { return true; } );
+    }
+
+
+    void GridPropertyStorage::trim( const std::vector< const void* >& owners ) {
+        if (!this->m_enabled.load())
+            return;
+
+        std::vector< const void* > sorted_owners( owners );
+        std::sort( sorted_owners.begin(), sorted_owners.end() );
+
+        std::lock_guard< std::mutex > lock( this->m_mutex );
+        this->spillUntilWithinBudget( [&sorted_owners]( const void* owner ) {
+            return std::binary_search( sorted_owners.begin(), sorted_owners.end(), owner );
+        });
+    }
+
+
+    /*
+      Must be called with the mutex held.
+    */
+    void GridPropertyStorage::spillUntilWithinBudget( const std::function< bool( const void* ) >& candidate ) {
+        std::size_t resident = 0;
+        std::vector< std::pair< const void*, Entry* > > candidates;
+        for (auto& pair : this->m_entries) {
+            if (pair.second.spilled)
+                continue;
+
+            resident += pair.second.bytes;
+            if (pair.second.pins == 0 && pair.second.bytes > 0 && candidate( pair.first ))
+                candidates.emplace_back( pair.first, &pair.second );
+        }
+
+        if (resident <= this->m_budget)
+            return;
+
+        std::sort( candidates.begin(), candidates.end(),
+                   []( const std::pair< const void*, Entry* >& a,
+                       const std::pair< const void*, Entry* >& b ) {
+                       return a.second->last_use < b.second->last_use;
+                   });
+
+        for (const auto& candidate : candidates) {
+            if (resident <= this->m_budget)
+                break;
+
+            auto& entry = *candidate.second;
+            entry.spill( candidate.first, this->m_directory );
+            entry.spilled = true;
+            resident -= entry.bytes;
+        }
+    }
+}
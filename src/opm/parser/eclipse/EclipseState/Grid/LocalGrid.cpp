@@ -0,0 +1,355 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/BoxManager.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/LocalGrid.hpp>
+
+#include "setKeywordBox.hpp"
+
+namespace Opm {
+
+namespace {
+
+    /*
+      Position of one refined node along an axis: the offset of the
+      host cell in the host box, and the fractional position inside
+      the host cell.
+    */
+    struct AxisNode {
+        int host;
+        double frac;
+    };
+
+    std::vector<AxisNode> axisNodes(int host_cells, int refined_cells, const std::string& axis) {
+        if (refined_cells < host_cells)
+            throw std::invalid_argument("CARFIN: N" + axis + " must be at least the number of host cells in the " + axis + " direction");
+
+        std::vector<AxisNode> nodes;
+        for (int h = 0; h < host_cells; h++) {
+            int n = refined_cells / host_cells + ((h < refined_cells % host_cells) ? 1 : 0);
+            for (int c = 0; c < n; c++)
+                nodes.push_back( { h , static_cast<double>(c) / n } );
+        }
+        nodes.push_back( { host_cells - 1 , 1.0 } );
+        return nodes;
+    }
+
+    /*
+      The fractional extent [lower, upper] of refined cell c inside
+      its host cell.
+    */
+    std::array<double,2> cellExtent(const std::vector<AxisNode>& nodes, size_t c) {
+        double upper = (nodes[c + 1].host == nodes[c].host) ? nodes[c + 1].frac : 1.0;
+        return {{ nodes[c].frac , upper }};
+    }
+
+    using CellCorners = std::array<std::array<double,3>, 8>;
+
+    /*
+      Trilinear interpolation between the eight corners of a cell,
+      the corners are numbered as in EclipseGrid::getCornerPos().
+    */
+    std::array<double,3> interpolate(const CellCorners& corners, double u, double v, double w) {
+        std::array<double,3> pos = {{ 0, 0, 0 }};
+        for (int c = 0; c < 8; c++) {
+            double weight = ((c & 1) ? u : 1 - u) * ((c & 2) ? v : 1 - v) * ((c & 4) ? w : 1 - w);
+            for (int d = 0; d < 3; d++)
+                pos[d] += weight * corners[c][d];
+        }
+        return pos;
+    }
+
+    template <typename T>
+    std::vector<T> keywordData(const DeckKeyword& keyword);
+
+    template <>
+    std::vector<int> keywordData(const DeckKeyword& keyword) {
+        return keyword.getIntData();
+    }
+
+    template <>
+    std::vector<double> keywordData(const DeckKeyword& keyword) {
+        return keyword.getSIDoubleData();
+    }
+
+    template <typename T>
+    T scalarValue(double value, double si_scaling);
+
+    template <>
+    int scalarValue(double value, double /* si_scaling */) {
+        if (std::fabs( std::nearbyint( value ) - value ) > 1e-6)
+            throw std::invalid_argument("Expected integer argument - got: " + std::to_string( value ));
+        return static_cast<int>( std::nearbyint( value ));
+    }
+
+    template <>
+    double scalarValue(double value, double si_scaling) {
+        return value * si_scaling;
+    }
+}
+
+
+    LocalGrid::LocalGrid(const DeckKeyword& carfin, const EclipseGrid& parent, std::size_t lgr_nr, std::size_t offset) :
+        m_lgrNumber(lgr_nr),
+        m_offset(offset)
+    {
+        const auto& record = carfin.getRecord(0);
+        m_name = record.getItem("NAME").get<std::string>(0);
+        m_parent = record.getItem("PARENT").get<std::string>(0);
+        if (m_parent != "GLOBAL")
+            throw std::invalid_argument("CARFIN " + m_name + ": only refinement of the GLOBAL grid is supported");
+
+        const int i1 = record.getItem("I1").get<int>(0) - 1;
+        const int i2 = record.getItem("I2").get<int>(0) - 1;
+        const int j1 = record.getItem("J1").get<int>(0) - 1;
+        const int j2 = record.getItem("J2").get<int>(0) - 1;
+        const int k1 = record.getItem("K1").get<int>(0) - 1;
+        const int k2 = record.getItem("K2").get<int>(0) - 1;
+        m_hostBox = Box( parent.getNX(), parent.getNY(), parent.getNZ(), i1, i2, j1, j2, k1, k2 );
+
+        m_nx = record.getItem("NX").get<int>(0);
+        m_ny = record.getItem("NY").get<int>(0);
+        m_nz = record.getItem("NZ").get<int>(0);
+
+        const auto inodes = axisNodes( i2 - i1 + 1, m_nx, "X" );
+        const auto jnodes = axisNodes( j2 - j1 + 1, m_ny, "Y" );
+        const auto knodes = axisNodes( k2 - k1 + 1, m_nz, "Z" );
+
+        std::vector<CellCorners> hostCorners( m_hostBox.size() );
+        for (int k = k1; k <= k2; k++)
+            for (int j = j1; j <= j2; j++)
+                for (int i = i1; i <= i2; i++) {
+                    auto& corners = hostCorners[ (i - i1) + (j - j1) * m_hostBox.getDim(0) + (k - k1) * m_hostBox.getDim(0) * m_hostBox.getDim(1) ];
+                    for (int c = 0; c < 8; c++)
+                        corners[c] = parent.getCornerPos( i, j, k, c );
+                }
+
+        ZcornMapper zm( m_nx, m_ny, m_nz );
+        CoordMapper cm( m_nx, m_ny );
+        std::vector<double> zcorn( zm.size() );
+        std::vector<double> coord( cm.size() );
+        std::vector<int> actnum( this->getCartesianSize() );
+        m_hostCells.resize( this->getCartesianSize() );
+
+        for (size_t k = 0; k < m_nz; k++) {
+            const auto wk = cellExtent( knodes, k );
+            for (size_t j = 0; j < m_ny; j++) {
+                const auto vj = cellExtent( jnodes, j );
+                for (size_t i = 0; i < m_nx; i++) {
+                    const auto ui = cellExtent( inodes, i );
+                    const size_t hi = inodes[i].host;
+                    const size_t hj = jnodes[j].host;
+                    const size_t hk = knodes[k].host;
+                    const auto& corners = hostCorners[ hi + hj * m_hostBox.getDim(0) + hk * m_hostBox.getDim(0) * m_hostBox.getDim(1) ];
+                    const size_t g = this->getGlobalIndex( i, j, k );
+
+                    m_hostCells[g] = parent.getGlobalIndex( i1 + hi, j1 + hj, k1 + hk );
+                    actnum[g] = parent.cellActive( m_hostCells[g] ) ? 1 : 0;
+
+                    for (int c = 0; c < 8; c++) {
+                        const auto pos = interpolate( corners, ui[c & 1 ? 1 : 0], vj[c & 2 ? 1 : 0], wk[c & 4 ? 1 : 0] );
+                        zcorn[ zm.index( i, j, k, c ) ] = pos[2];
+
+                        const size_t pi = i + (c & 1 ? 1 : 0);
+                        const size_t pj = j + (c & 2 ? 1 : 0);
+                        if (k == 0 && !(c & 4)) {
+                            for (int d = 0; d < 3; d++)
+                                coord[ cm.index( pi, pj, d, 0 ) ] = pos[d];
+                        }
+                        if (k == m_nz - 1 && (c & 4)) {
+                            for (int d = 0; d < 3; d++)
+                                coord[ cm.index( pi, pj, d, 1 ) ] = pos[d];
+                        }
+                    }
+                }
+            }
+        }
+
+        std::array<int,3> dims = this->getNXYZ();
+        m_grid = std::make_shared<EclipseGrid>( dims, coord, zcorn, actnum.data() );
+    }
+
+
+    const std::string& LocalGrid::name() const {
+        return m_name;
+    }
+
+    const std::string& LocalGrid::parent() const {
+        return m_parent;
+    }
+
+    std::size_t LocalGrid::lgrNumber() const {
+        return m_lgrNumber;
+    }
+
+    std::size_t LocalGrid::offset() const {
+        return m_offset;
+    }
+
+    std::size_t LocalGrid::getHierarchicalIndex(std::size_t i, std::size_t j, std::size_t k) const {
+        assertIJK(i,j,k);
+        return m_offset + this->getGlobalIndex(i,j,k);
+    }
+
+    const Box& LocalGrid::hostBox() const {
+        return m_hostBox;
+    }
+
+    std::size_t LocalGrid::getHostCell(std::size_t global_index) const {
+        assertGlobalIndex( global_index );
+        return m_hostCells[global_index];
+    }
+
+    const std::vector<int>& LocalGrid::getHostCells() const {
+        return m_hostCells;
+    }
+
+    bool LocalGrid::isHost(std::size_t host_index) const {
+        for (auto index : m_hostBox) {
+            if (index == host_index)
+                return true;
+        }
+        return false;
+    }
+
+    std::vector<std::size_t> LocalGrid::getChildCells(std::size_t host_index) const {
+        std::vector<std::size_t> children;
+        for (std::size_t g = 0; g < m_hostCells.size(); g++) {
+            if (static_cast<std::size_t>(m_hostCells[g]) == host_index)
+                children.push_back( g );
+        }
+        return children;
+    }
+
+    const EclipseGrid& LocalGrid::grid() const {
+        return *m_grid;
+    }
+
+    void LocalGrid::resetACTNUM(const EclipseGrid& parent) {
+        std::vector<int> actnum( m_hostCells.size() );
+        for (std::size_t g = 0; g < m_hostCells.size(); g++)
+            actnum[g] = parent.cellActive( m_hostCells[g] ) ? 1 : 0;
+
+        m_grid = std::make_shared<EclipseGrid>( *m_grid, actnum );
+    }
+
+    void LocalGrid::addKeyword(const DeckKeyword& keyword) {
+        m_keywords.push_back( keyword );
+    }
+
+    const std::vector<DeckKeyword>& LocalGrid::getKeywords() const {
+        return m_keywords;
+    }
+
+
+    template <typename T>
+    std::vector<T> LocalGrid::refine(const std::vector<T>& parent_values) const {
+        std::vector<T> values( m_hostCells.size() );
+        for (std::size_t g = 0; g < m_hostCells.size(); g++)
+            values[g] = parent_values.at( m_hostCells[g] );
+
+        return values;
+    }
+
+
+    template <typename T>
+    std::vector<T> LocalGrid::property(const std::string& keyword, const std::vector<T>& parent_values, double si_scaling) const {
+        std::vector<T> values = this->refine( parent_values );
+        BoxManager boxManager( m_nx, m_ny, m_nz );
+
+        for (const auto& deckKeyword : m_keywords) {
+            const auto& name = deckKeyword.name();
+
+            if (name == keyword) {
+                const auto data = keywordData<T>( deckKeyword );
+                const auto& box = boxManager.getActiveBox();
+                if (data.size() != box.size())
+                    throw std::invalid_argument("LGR " + m_name + ": keyword " + keyword + " has " + std::to_string( data.size() )
+                                                + " elements - expected " + std::to_string( box.size() ));
+
+                const auto& index_list = box.getIndexList();
+                for (std::size_t index = 0; index < index_list.size(); index++)
+                    values[ index_list[index] ] = data[index];
+
+            } else if (name == "BOX") {
+                const auto& record = deckKeyword.getRecord(0);
+                boxManager.setInputBox( record.getItem("I1").get< int >(0) - 1,
+                                        record.getItem("I2").get< int >(0) - 1,
+                                        record.getItem("J1").get< int >(0) - 1,
+                                        record.getItem("J2").get< int >(0) - 1,
+                                        record.getItem("K1").get< int >(0) - 1,
+                                        record.getItem("K2").get< int >(0) - 1 );
+
+            } else if (name == "ENDBOX") {
+                boxManager.endInputBox();
+
+            } else if (name == "EQUALS" || name == "ADD" || name == "MULTIPLY") {
+                for (const auto& record : deckKeyword) {
+                    if (record.getItem("field").get< std::string >(0) != keyword)
+                        continue;
+
+                    setKeywordBox( record, boxManager );
+                    const auto& box = boxManager.getActiveBox();
+                    const double input = record.getItem(1).get< double >(0);
+
+                    if (name == "EQUALS") {
+                        const T value = scalarValue<T>( input, si_scaling );
+                        for (auto index : box)
+                            values[index] = value;
+                    } else if (name == "ADD") {
+                        const T shift = scalarValue<T>( input, si_scaling );
+                        for (auto index : box)
+                            values[index] += shift;
+                    } else {
+                        const T factor = scalarValue<T>( input, 1.0 );
+                        for (auto index : box)
+                            values[index] *= factor;
+                    }
+                    boxManager.endKeyword();
+                }
+            }
+        }
+
+        return values;
+    }
+
+
+    bool LocalGrid::equal(const LocalGrid& other) const {
+        return m_name == other.m_name
+            && m_parent == other.m_parent
+            && m_offset == other.m_offset
+            && m_hostBox.equal( other.m_hostBox )
+            && m_hostCells == other.m_hostCells
+            && m_grid->equal( *other.m_grid );
+    }
+
+
+    template std::vector<int> LocalGrid::refine(const std::vector<int>&) const;
+    template std::vector<double> LocalGrid::refine(const std::vector<double>&) const;
+    template std::vector<int> LocalGrid::property(const std::string&, const std::vector<int>&, double) const;
+    template std::vector<double> LocalGrid::property(const std::string&, const std::vector<double>&, double) const;
+}
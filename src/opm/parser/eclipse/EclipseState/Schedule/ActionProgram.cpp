@@ -0,0 +1,521 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+#include <ert/util/util.h>
+
+#include <boost/algorithm/string.hpp>
+
+#include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/ActionProgram.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /*
+      An operand is either a scalar value or a set of (name, value)
+      pairs sorted by name; the latter is used for well and group
+      quantities.
+    */
+    struct Operand {
+        bool is_set = false;
+        bool wells = false;
+        double scalar = 0;
+        std::vector<std::pair<std::string, double>> values;
+    };
+
+
+    struct PartialResult {
+        ActionResult result;
+        bool well_set = false;
+    };
+
+
+    Operand scalar_operand(double value) {
+        Operand operand;
+        operand.scalar = value;
+        return operand;
+    }
+
+
+    Operand empty_operand() {
+        Operand operand;
+        operand.is_set = true;
+        return operand;
+    }
+
+
+    Operand set_operand(const std::map<std::string, double>& values,
+                        const std::string& pattern,
+                        bool wildcard,
+                        bool wells) {
+        Operand operand;
+        operand.is_set = true;
+        operand.wells = wells;
+
+        if (!wildcard) {
+            const auto iter = values.find(pattern);
+            if (iter != values.end())
+                operand.values.push_back(*iter);
+        } else if (pattern == "*")
+            operand.values.assign(values.begin(), values.end());
+        else {
+            for (const auto& pair : values) {
+                if (util_fnmatch(pattern.c_str(), pair.first.c_str()) == 0)
+                    operand.values.push_back(pair);
+            }
+        }
+
+        return operand;
+    }
+
+
+    template <typename Compare>
+    PartialResult compare_operands(const Operand& lhs, const Operand& rhs, Compare cmp) {
+        PartialResult partial;
+        if (!lhs.is_set && !rhs.is_set) {
+            partial.result.value = cmp(lhs.scalar, rhs.scalar);
+            return partial;
+        }
+
+        std::vector<std::string> names;
+        if (lhs.is_set && rhs.is_set) {
+            auto lhs_iter = lhs.values.begin();
+            auto rhs_iter = rhs.values.begin();
+            while (lhs_iter != lhs.values.end() && rhs_iter != rhs.values.end()) {
+                if (lhs_iter->first < rhs_iter->first)
+                    ++lhs_iter;
+                else if (rhs_iter->first < lhs_iter->first)
+                    ++rhs_iter;
+                else {
+                    if (cmp(lhs_iter->second, rhs_iter->second))
+                        names.push_back(lhs_iter->first);
+                    ++lhs_iter;
+                    ++rhs_iter;
+                }
+            }
+        } else if (lhs.is_set) {
+            for (const auto& pair : lhs.values) {
+                if (cmp(pair.second, rhs.scalar))
+                    names.push_back(pair.first);
+            }
+        } else {
+            for (const auto& pair : rhs.values) {
+                if (cmp(lhs.scalar, pair.second))
+                    names.push_back(pair.first);
+            }
+        }
+
+        partial.result.value = !names.empty();
+        if (lhs.wells || rhs.wells) {
+            partial.well_set = true;
+            partial.result.wells = std::move(names);
+        }
+        return partial;
+    }
+
+
+    PartialResult combine_and(const PartialResult& lhs, const PartialResult& rhs) {
+        PartialResult partial;
+        partial.result.value = lhs.result.value && rhs.result.value;
+        partial.well_set = lhs.well_set || rhs.well_set;
+        if (!partial.result.value)
+            return partial;
+
+        if (lhs.well_set && rhs.well_set)
+            std::set_intersection(lhs.result.wells.begin(), lhs.result.wells.end(),
+                                  rhs.result.wells.begin(), rhs.result.wells.end(),
+                                  std::back_inserter(partial.result.wells));
+        else if (lhs.well_set)
+            partial.result.wells = lhs.result.wells;
+        else
+            partial.result.wells = rhs.result.wells;
+
+        return partial;
+    }
+
+
+    PartialResult combine_or(const PartialResult& lhs, const PartialResult& rhs) {
+        PartialResult partial;
+        partial.result.value = lhs.result.value || rhs.result.value;
+        partial.well_set = lhs.well_set || rhs.well_set;
+
+        static const std::vector<std::string> no_wells;
+        const auto& lhs_wells = lhs.result.value ? lhs.result.wells : no_wells;
+        const auto& rhs_wells = rhs.result.value ? rhs.result.wells : no_wells;
+        std::set_union(lhs_wells.begin(), lhs_wells.end(),
+                       rhs_wells.begin(), rhs_wells.end(),
+                       std::back_inserter(partial.result.wells));
+        return partial;
+    }
+
+
+    std::string join(const std::vector<std::string>& tokens) {
+        return boost::algorithm::join(tokens, " ");
+    }
+
+}
+
+
+    class ActionProgram::Compiler {
+    public:
+        Compiler(const std::vector<std::string>& tokens_arg, std::vector<Instruction>& program_arg) :
+            tokens(tokens_arg),
+            program(program_arg)
+        {}
+
+        void compile() {
+            if (this->tokens.empty())
+                throw std::invalid_argument("Empty ACTIONX condition");
+
+            this->expression();
+            if (this->pos != this->tokens.size())
+                this->error("Unexpected token '" + this->tokens[this->pos] + "'");
+        }
+
+    private:
+        const std::vector<std::string>& tokens;
+        std::vector<Instruction>& program;
+        std::size_t pos = 0;
+
+        static const std::map<std::string, OpCode>& comparators() {
+            static const std::map<std::string, OpCode> ops = {{"<"   , OpCode::LESS},
+                                                              {"<="  , OpCode::LESS_EQUAL},
+                                                              {">"   , OpCode::GREATER},
+                                                              {">="  , OpCode::GREATER_EQUAL},
+                                                              {"="   , OpCode::EQUAL},
+                                                              {"!="  , OpCode::NOT_EQUAL},
+                                                              {".LT.", OpCode::LESS},
+                                                              {".LE.", OpCode::LESS_EQUAL},
+                                                              {".GT.", OpCode::GREATER},
+                                                              {".GE.", OpCode::GREATER_EQUAL},
+                                                              {".EQ.", OpCode::EQUAL},
+                                                              {".NE.", OpCode::NOT_EQUAL}};
+            return ops;
+        }
+
+        void error(const std::string& msg) const {
+            throw std::invalid_argument(msg + " in ACTIONX condition: " + join(this->tokens));
+        }
+
+        bool done() const {
+            return this->pos == this->tokens.size();
+        }
+
+        std::string current() const {
+            return boost::to_upper_copy(this->tokens[this->pos]);
+        }
+
+        bool accept(const std::string& token) {
+            if (this->done() || this->current() != token)
+                return false;
+
+            this->pos++;
+            return true;
+        }
+
+        /*
+          Whether the current token can be the name argument of a well or
+          group quantity.
+        */
+        bool name_follows() const {
+            if (this->done())
+                return false;
+
+            const auto token = this->current();
+            if (token == "(" || token == ")" || token == "AND" || token == "OR")
+                return false;
+
+            return comparators().count(token) == 0;
+        }
+
+        void emit(OpCode op) {
+            Instruction instruction;
+            instruction.op = op;
+            this->program.push_back(instruction);
+        }
+
+        void expression() {
+            this->term();
+            while (this->accept("OR")) {
+                this->term();
+                this->emit(OpCode::OR);
+            }
+        }
+
+        void term() {
+            this->factor();
+            while (this->accept("AND")) {
+                this->factor();
+                this->emit(OpCode::AND);
+            }
+        }
+
+        void factor() {
+            if (this->accept("(")) {
+                this->expression();
+                if (!this->accept(")"))
+                    this->error("Missing ')'");
+                return;
+            }
+
+            this->operand();
+            if (this->done())
+                this->error("Missing comparison operator");
+
+            const auto iter = comparators().find(this->current());
+            if (iter == comparators().end())
+                this->error("Invalid comparison operator '" + this->tokens[this->pos] + "'");
+
+            this->pos++;
+            this->operand();
+            this->emit(iter->second);
+        }
+
+        void operand() {
+            if (this->done())
+                this->error("Missing operand");
+
+            const auto& token = this->tokens[this->pos++];
+            Instruction instruction;
+
+            char* end_ptr;
+            const double value = std::strtod(token.c_str(), &end_ptr);
+            if (!token.empty() && *end_ptr == '\0') {
+                instruction.op = OpCode::NUMBER;
+                instruction.number = value;
+                this->program.push_back(instruction);
+                return;
+            }
+
+            const auto upper = boost::to_upper_copy(token);
+            const auto& months = TimeMap::eclipseMonthIndices();
+            const auto month_iter = months.find(upper);
+            if (month_iter != months.end()) {
+                instruction.op = OpCode::NUMBER;
+                instruction.number = month_iter->second;
+                this->program.push_back(instruction);
+                return;
+            }
+
+            if (upper == "(" || upper == ")" || upper == "AND" || upper == "OR" || comparators().count(upper) > 0)
+                this->error("Unexpected token '" + token + "'");
+
+            if (upper == "DAY")
+                instruction.op = OpCode::DAY;
+            else if (upper == "MNTH")
+                instruction.op = OpCode::MONTH;
+            else if (upper == "YEAR")
+                instruction.op = OpCode::YEAR;
+            else if (upper[0] == 'W' || upper[0] == 'G') {
+                instruction.op = (upper[0] == 'W') ? OpCode::WELL : OpCode::GROUP;
+                instruction.quantity = upper;
+                instruction.pattern = "*";
+                if (this->name_follows())
+                    instruction.pattern = this->tokens[this->pos++];
+                instruction.wildcard = (instruction.pattern.find_first_of("*?[") != std::string::npos);
+            } else {
+                instruction.op = OpCode::SUMMARY;
+                instruction.quantity = upper;
+            }
+
+            this->program.push_back(instruction);
+        }
+    };
+
+
+
+    ActionProgram::ActionProgram(const std::vector<std::string>& tokens) {
+        Compiler compiler(tokens, this->program);
+        compiler.compile();
+    }
+
+
+    std::size_t ActionProgram::size() const {
+        return this->program.size();
+    }
+
+
+    bool ActionProgram::empty() const {
+        return this->program.empty();
+    }
+
+
+    std::vector<std::string> ActionProgram::summaryKeys() const {
+        std::vector<std::string> keys;
+        for (const auto& instruction : this->program) {
+            switch (instruction.op) {
+            case OpCode::SUMMARY:
+                keys.push_back(instruction.quantity);
+                break;
+
+            case OpCode::WELL:
+            case OpCode::GROUP:
+                if (instruction.wildcard)
+                    keys.push_back(instruction.quantity);
+                else
+                    keys.push_back(instruction.quantity + ":" + instruction.pattern);
+                break;
+
+            default:
+                break;
+            }
+        }
+        return keys;
+    }
+
+
+    ActionResult ActionProgram::eval(std::time_t sim_time, const SummaryState& summary_state) const {
+        if (this->program.empty())
+            return ActionResult{};
+
+        int day, month, year;
+        util_set_date_values_utc(sim_time, &day, &month, &year);
+
+        auto compare = [](OpCode op, double lhs, double rhs) {
+            switch (op) {
+            case OpCode::LESS:
+                return lhs < rhs;
+            case OpCode::LESS_EQUAL:
+                return lhs <= rhs;
+            case OpCode::GREATER:
+                return lhs > rhs;
+            case OpCode::GREATER_EQUAL:
+                return lhs >= rhs;
+            case OpCode::EQUAL:
+                return lhs == rhs;
+            case OpCode::NOT_EQUAL:
+                return lhs != rhs;
+            default:
+                throw std::logic_error("Not a comparison operator");
+            }
+        };
+
+        std::vector<Operand> operands;
+        std::vector<PartialResult> results;
+        for (const auto& instruction : this->program) {
+            switch (instruction.op) {
+            case OpCode::NUMBER:
+                operands.push_back(scalar_operand(instruction.number));
+                break;
+
+            case OpCode::DAY:
+                operands.push_back(scalar_operand(day));
+                break;
+
+            case OpCode::MONTH:
+                operands.push_back(scalar_operand(month));
+                break;
+
+            case OpCode::YEAR:
+                operands.push_back(scalar_operand(year));
+                break;
+
+            case OpCode::SUMMARY:
+                if (summary_state.has(instruction.quantity))
+                    operands.push_back(scalar_operand(summary_state.get(instruction.quantity)));
+                else
+                    operands.push_back(empty_operand());
+                break;
+
+            case OpCode::WELL:
+                operands.push_back(set_operand(summary_state.well_values(instruction.quantity),
+                                               instruction.pattern, instruction.wildcard, true));
+                break;
+
+            case OpCode::GROUP:
+                operands.push_back(set_operand(summary_state.group_values(instruction.quantity),
+                                               instruction.pattern, instruction.wildcard, false));
+                break;
+
+            case OpCode::AND:
+            case OpCode::OR: {
+                const auto rhs = std::move(results.back());
+                results.pop_back();
+                const auto lhs = std::move(results.back());
+                results.pop_back();
+
+                if (instruction.op == OpCode::AND)
+                    results.push_back(combine_and(lhs, rhs));
+                else
+                    results.push_back(combine_or(lhs, rhs));
+                break;
+            }
+
+            default: {
+                const auto rhs = std::move(operands.back());
+                operands.pop_back();
+                const auto lhs = std::move(operands.back());
+                operands.pop_back();
+
+                const auto op = instruction.op;
+                results.push_back(compare_operands(lhs, rhs, [&compare, op](double x, double y) { return compare(op, x, y); }));
+            }
+            }
+        }
+
+        return results.back().result;
+    }
+
+
+    std::vector<std::string> ActionProgram::tokenize(const std::vector<std::string>& input) {
+        const std::vector<std::string> splitters = {"(", ")", ">=", "<=", "!=", "=", ">", "<"};
+        std::vector<std::string> tokens;
+
+        for (const auto& item : input) {
+            if (item.empty())
+                continue;
+
+            if (RawConsts::is_quote()(item[0])) {
+                tokens.push_back(item.substr(1, item.size() - 2));
+                continue;
+            }
+
+            std::size_t offset = 0;
+            std::size_t pos = 0;
+            while (pos < item.size()) {
+                auto splitter = std::find_if(splitters.begin(), splitters.end(),
+                                             [&item, pos](const std::string& s) { return item.compare(pos, s.size(), s) == 0; });
+                if (splitter == splitters.end()) {
+                    pos += 1;
+                    continue;
+                }
+
+                if (pos > offset)
+                    tokens.push_back(item.substr(offset, pos - offset));
+                tokens.push_back(*splitter);
+                pos += splitter->size();
+                offset = pos;
+            }
+            if (pos > offset)
+                tokens.push_back(item.substr(offset, pos - offset));
+        }
+
+        return tokens;
+    }
+}
@@ -0,0 +1,135 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdexcept>
+
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/A.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/ActionX.hpp>
+
+namespace Opm {
+
+namespace {
+
+    std::vector<std::string> condition_tokens(const DeckKeyword& kw) {
+        std::vector<std::string> input;
+        for (std::size_t record_index = 1; record_index < kw.size(); record_index++) {
+            const auto& item = kw.getRecord(record_index).getItem<ParserKeywords::ACTIONX::CONDITION>();
+            const auto& data = item.getData<std::string>();
+            input.insert(input.end(), data.begin(), data.end());
+        }
+        return ActionProgram::tokenize(input);
+    }
+
+}
+
+    ActionX::ActionX(const std::string& name, std::size_t max_run, double min_wait, std::time_t start_time) :
+        m_name(name),
+        m_max_run(max_run),
+        m_min_wait(min_wait),
+        m_start_time(start_time)
+    {}
+
+
+    ActionX::ActionX(const DeckKeyword& kw, std::time_t start_time) :
+        ActionX(kw.getRecord(0).getItem<ParserKeywords::ACTIONX::NAME>().getTrimmedString(0),
+                kw.getRecord(0).getItem<ParserKeywords::ACTIONX::NUM>().get<int>(0),
+                kw.getRecord(0).getItem<ParserKeywords::ACTIONX::MIN_WAIT>().getSIDouble(0),
+                start_time)
+    {
+        try {
+            this->m_program = ActionProgram(condition_tokens(kw));
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument("ACTIONX " + this->m_name + ": " + e.what());
+        }
+    }
+
+
+    void ActionX::addKeyword(const DeckKeyword& kw) {
+        this->keywords.push_back(kw);
+    }
+
+
+    bool ActionX::ready(std::time_t sim_time) const {
+        if (this->run_count >= this->m_max_run)
+            return false;
+
+        if (sim_time < this->m_start_time)
+            return false;
+
+        if (this->run_count == 0)
+            return true;
+
+        return std::difftime(sim_time, this->last_run) >= this->m_min_wait;
+    }
+
+
+    ActionResult ActionX::eval(std::time_t sim_time, const SummaryState& summary_state) const {
+        if (!this->ready(sim_time))
+            return ActionResult{};
+
+        return this->m_program.eval(sim_time, summary_state);
+    }
+
+
+    void ActionX::markRun(std::time_t sim_time) {
+        this->run_count += 1;
+        this->last_run = sim_time;
+    }
+
+
+    const std::string& ActionX::name() const {
+        return this->m_name;
+    }
+
+    std::size_t ActionX::maxRun() const {
+        return this->m_max_run;
+    }
+
+    double ActionX::minWait() const {
+        return this->m_min_wait;
+    }
+
+    std::time_t ActionX::startTime() const {
+        return this->m_start_time;
+    }
+
+    std::size_t ActionX::runCount() const {
+        return this->run_count;
+    }
+
+    const ActionProgram& ActionX::program() const {
+        return this->m_program;
+    }
+
+
+    std::vector<DeckKeyword>::const_iterator ActionX::begin() const {
+        return this->keywords.begin();
+    }
+
+    std::vector<DeckKeyword>::const_iterator ActionX::end() const {
+        return this->keywords.end();
+    }
+
+    std::size_t ActionX::size() const {
+        return this->keywords.size();
+    }
+}
@@ -0,0 +1,92 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <stdexcept>
+#include <memory>
+#include <unordered_set>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/Actions.hpp>
+
+namespace Opm {
+
+    void Actions::add(const ActionX& action) {
+        this->actions.push_back(action);
+    }
+
+
+    std::size_t Actions::size() const {
+        return this->actions.size();
+    }
+
+
+    bool Actions::empty() const {
+        return this->actions.empty();
+    }
+
+
+    bool Actions::has(const std::string& name) const {
+        return std::any_of(this->actions.begin(), this->actions.end(),
+                           [&name](const ActionX& action) { return action.name() == name; });
+    }
+
+
+    /*
+      Will return the last definition of the action.
+    */
+    const ActionX& Actions::get(const std::string& name) const {
+        const auto iter = std::find_if(this->actions.rbegin(), this->actions.rend(),
+                                       [&name](const ActionX& action) { return action.name() == name; });
+        if (iter == this->actions.rend())
+            throw std::invalid_argument("No such action: " + name);
+
+        return *iter;
+    }
+
+
+    std::vector<ActionX*> Actions::pending(std::time_t sim_time) {
+        std::vector<ActionX*> pending_actions;
+        std::unordered_set<std::string> seen;
+
+        for (auto iter = this->actions.rbegin(); iter != this->actions.rend(); ++iter) {
+            if (iter->startTime() > sim_time)
+                continue;
+
+            if (!seen.insert(iter->name()).second)
+                continue;
+
+            if (iter->ready(sim_time))
+                pending_actions.push_back(std::addressof(*iter));
+        }
+
+        std::reverse(pending_actions.begin(), pending_actions.end());
+        return pending_actions;
+    }
+
+
+    std::vector<ActionX>::const_iterator Actions::begin() const {
+        return this->actions.begin();
+    }
+
+
+    std::vector<ActionX>::const_iterator Actions::end() const {
+        return this->actions.end();
+    }
+}
@@ -17,11 +17,16 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <iterator>
+#include <map>
 
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/CompletionSet.hpp>
 #include "Compsegs.hpp"
 #include <opm/parser/eclipse/EclipseState/Schedule/MSW/SegmentSet.hpp>
@@ -45,7 +50,32 @@ namespace Opm {
     {
     }
 
-    std::vector< Compsegs > Compsegs::compsegsFromCOMPSEGSKeyword( const DeckKeyword& compsegsKeyword ) {
+    namespace {
+
+        /*
+          The length of the cell (i,j,k) along the well direction. Without
+          a grid all cells get unit length, which is only used to split an
+          explicitly given distance range evenly.
+        */
+        double cellLength( const EclipseGrid* grid, int i, int j, int k, WellCompletion::DirectionEnum direction ) {
+            if (!grid)
+                return 1.0;
+
+            const auto dims = grid->getCellDims( i, j, k );
+            switch (direction) {
+            case WellCompletion::X: return dims[0];
+            case WellCompletion::Y: return dims[1];
+            case WellCompletion::Z: return dims[2];
+            }
+
+            throw std::invalid_argument("Unhandled well direction");
+        }
+
+    }
+
+
+    std::vector< Compsegs > Compsegs::compsegsFromCOMPSEGSKeyword( const DeckKeyword& compsegsKeyword,
+                                                                  const EclipseGrid* grid ) {
 
         // only handle the second record here
         // The first record here only contains the well name
@@ -59,32 +89,15 @@ namespace Opm {
             const int K = record.getItem<ParserKeywords::COMPSEGS::K>().get< int >(0) - 1;
             const int branch = record.getItem<ParserKeywords::COMPSEGS::BRANCH>().get< int >(0);
 
-            double distance_start;
-            double distance_end;
-            if (record.getItem<ParserKeywords::COMPSEGS::DISTANCE_START>().hasValue(0)) {
-                distance_start = record.getItem<ParserKeywords::COMPSEGS::DISTANCE_START>().getSIDouble(0);
-            } else if (recordIndex == 1) {
-                distance_start = 0.;
-            } else {
-                // TODO: the end of the previous connection or range
-                // 'previous' should be in term of the input order
-                // since basically no specific order for the completions
-                throw std::runtime_error("this way to obtain DISTANCE_START not implemented yet!");
-            }
-            if (record.getItem<ParserKeywords::COMPSEGS::DISTANCE_END>().hasValue(0)) {
-                distance_end = record.getItem<ParserKeywords::COMPSEGS::DISTANCE_END>().getSIDouble(0);
-            } else {
-                // TODO: the distance_start plus the thickness of the grid block
-                throw std::runtime_error("this way to obtain DISTANCE_END not implemented yet!");
-            }
+            const bool has_distance_end = record.getItem<ParserKeywords::COMPSEGS::DISTANCE_END>().hasValue(0);
+            const bool has_direction = record.getItem< ParserKeywords::COMPSEGS::DIRECTION >().hasValue( 0 );
+            const bool has_range = record.getItem< ParserKeywords::COMPSEGS::END_IJK >().hasValue( 0 );
 
-            if( !record.getItem< ParserKeywords::COMPSEGS::DIRECTION >().hasValue( 0 ) &&
-                !record.getItem< ParserKeywords::COMPSEGS::DISTANCE_END >().hasValue( 0 ) ) {
+            if( !has_direction && !has_distance_end ) {
                 throw std::runtime_error("the direction has to be specified when DISTANCE_END in the record is not specified");
             }
 
-            if( record.getItem< ParserKeywords::COMPSEGS::END_IJK >().hasValue( 0 ) &&
-               !record.getItem< ParserKeywords::COMPSEGS::DIRECTION >().hasValue( 0 ) ) {
+            if( has_range && !has_direction ) {
                 throw std::runtime_error("the direction has to be specified when END_IJK in the record is specified");
             }
 
@@ -93,10 +106,20 @@ namespace Opm {
              * is set or a range is specified. If not this is effectively ignored.
              */
             WellCompletion::DirectionEnum direction = WellCompletion::X;
-            if( record.getItem< ParserKeywords::COMPSEGS::DIRECTION >().hasValue( 0 ) ) {
+            if( has_direction ) {
                 direction = WellCompletion::DirectionEnumFromString(record.getItem<ParserKeywords::COMPSEGS::DIRECTION>().get< std::string >(0));
             }
 
+            double distance_start;
+            if (record.getItem<ParserKeywords::COMPSEGS::DISTANCE_START>().hasValue(0)) {
+                distance_start = record.getItem<ParserKeywords::COMPSEGS::DISTANCE_START>().getSIDouble(0);
+            } else if (compsegs.empty()) {
+                distance_start = 0.;
+            } else {
+                // the end of the previous connection or range, in input order
+                distance_start = compsegs.back().m_distance_end;
+            }
+
             double center_depth;
             if (!record.getItem<ParserKeywords::COMPSEGS::CENTER_DEPTH>().defaultApplied(0)) {
                 center_depth = record.getItem<ParserKeywords::COMPSEGS::CENTER_DEPTH>().getSIDouble(0);
@@ -105,11 +128,8 @@ namespace Opm {
                 // which is used to indicate to obtain the final value through related segment
                 center_depth = 0.;
             }
-
-            if (center_depth < 0.) {
-                //TODO: get the depth from COMPDAT data.
-                throw std::runtime_error("this way to obtain CENTER_DISTANCE not implemented yet either!");
-            }
+            // a negative value means the depth is taken from the COMPDAT data,
+            // that is handled in updateCompletionsWithSegment().
 
             int segment_number;
             if (record.getItem<ParserKeywords::COMPSEGS::SEGMENT_NUMBER>().hasValue(0)) {
@@ -119,15 +139,51 @@ namespace Opm {
                 // will decide the segment number based on the distance in a process later.
             }
 
-            if (!record.getItem<ParserKeywords::COMPSEGS::END_IJK>().hasValue(0)) { // only one compsegs
-                compsegs.emplace_back( I, J, K,
+            // the cells covered by the record, a single one unless a range is given
+            std::vector< std::array< int, 3 > > cells;
+            if (!has_range) {
+                cells.push_back( {{ I, J, K }} );
+            } else {
+                const int end_ijk = record.getItem<ParserKeywords::COMPSEGS::END_IJK>().get< int >(0) - 1;
+                std::array< int, 3 > cell = {{ I, J, K }};
+                const int axis = static_cast< int >( direction ) - 1;
+                const int step = end_ijk >= cell[axis] ? 1 : -1;
+                for (; cell[axis] != end_ijk + step; cell[axis] += step)
+                    cells.push_back( cell );
+            }
+
+            if (!grid && !has_distance_end)
+                throw std::runtime_error("the grid is required to obtain DISTANCE_END from the cell size in COMPSEGS");
+
+            std::vector< double > lengths;
+            double total_length = 0.;
+            for (const auto& cell : cells) {
+                lengths.push_back( cellLength( grid, cell[0], cell[1], cell[2], direction ) );
+                total_length += lengths.back();
+            }
+
+            // with an explicit DISTANCE_END the cells of a range share the
+            // distance in proportion to their length along the well
+            double scale = 1.;
+            if (has_distance_end) {
+                const double distance_end = record.getItem<ParserKeywords::COMPSEGS::DISTANCE_END>().getSIDouble(0);
+                scale = (distance_end - distance_start) / total_length;
+            }
+
+            double distance = distance_start;
+            for (size_t c = 0; c < cells.size(); ++c) {
+                const double distance_end = c + 1 == cells.size() && has_distance_end
+                    ? record.getItem<ParserKeywords::COMPSEGS::DISTANCE_END>().getSIDouble(0)
+                    : distance + scale * lengths[c];
+
+                compsegs.emplace_back( cells[c][0], cells[c][1], cells[c][2],
                                        branch,
-                                       distance_start, distance_end,
+                                       distance, distance_end,
                                        direction,
                                        center_depth,
                                        segment_number );
-            } else { // a range is defined. genrate a range of Compsegs
-                throw std::runtime_error("entering COMPSEGS entries with a range is not supported yet!");
+                compsegs.back().m_in_range = has_range;
+                distance = distance_end;
             }
         }
 
@@ -137,37 +193,71 @@ namespace Opm {
     void Compsegs::processCOMPSEGS(std::vector< Compsegs >& compsegs, const SegmentSet& segment_set) {
         // for the current cases we have at the moment, the distance information is specified explicitly,
         // while the depth information is defaulted though, which need to be obtained from the related segment
+        //
+        // The perforations are attached to the segment on the same branch with the node closest to the
+        // centre of the perforation. The segment nodes of each branch are sorted by the distance along
+        // the tubing, so the closest one is found with a binary search. Ties are resolved in favour of
+        // the segment stored first in the segment set.
+        struct Node {
+            double distance;
+            int index;
+            int segment_number;
+        };
+
+        std::map< int, std::vector< Node > > branches;
+        for (int i_segment = 0; i_segment < segment_set.numberSegment(); ++i_segment) {
+            const Segment& segment = segment_set[i_segment];
+            branches[ segment.branchNumber() ].push_back( { segment.totalLength(), i_segment, segment.segmentNumber() } );
+        }
+
+        const auto node_less = []( const Node& a, const Node& b ) {
+            return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+        };
+
+        for (auto& branch : branches)
+            std::sort( branch.second.begin(), branch.second.end(), node_less );
+
         for( auto& compseg : compsegs ) {
 
             // need to determine the related segment number first
             if (compseg.m_segment_number != 0) continue;
 
             const double center_distance = (compseg.m_distance_start + compseg.m_distance_end) / 2.0;
-            const int branch_number = compseg.m_branch_number;
-
-            int segment_number = 0;
-            double min_distance_difference = 1.e100; // begin with a big value
-            for (int i_segment = 0; i_segment < segment_set.numberSegment(); ++i_segment) {
-                const Segment& current_segment = segment_set[i_segment];
-                if( branch_number != current_segment.branchNumber() ) continue;
-
-                const double distance = current_segment.totalLength();
-                const double distance_difference = std::abs(center_distance - distance);
-                if (distance_difference < min_distance_difference) {
-                    min_distance_difference = distance_difference;
-                    segment_number = current_segment.segmentNumber();
-                }
-            }
-
-            if (segment_number == 0) {
+            const auto branch = branches.find( compseg.m_branch_number );
+            if (branch == branches.end()) {
                 throw std::runtime_error("The perforation failed in finding a related segment \n");
             }
 
-            if (compseg.m_center_depth < 0.) {
-                throw std::runtime_error("Obtaining perforation depth from COMPDAT data is not supported yet");
+            const auto& nodes = branch->second;
+            const auto above = std::lower_bound( nodes.begin(), nodes.end(), center_distance,
+                                                 []( const Node& node, double value ) {
+                                                     return node.distance < value;
+                                                 } );
+
+            const Node* best = nullptr;
+            double best_difference = 0.;
+            const auto consider = [&]( const Node& node ) {
+                const double difference = std::abs(center_distance - node.distance);
+                if (!best || difference < best_difference
+                    || (difference == best_difference && node.index < best->index)) {
+                    best = &node;
+                    best_difference = difference;
+                }
+            };
+
+            // the closest node below the centre, the first of any nodes at the same distance
+            if (above != nodes.begin()) {
+                auto below = std::prev( above );
+                while (below != nodes.begin() && std::prev( below )->distance == below->distance)
+                    --below;
+                consider( *below );
             }
 
-            compseg.m_segment_number = segment_number;
+            // the closest node at or above the centre
+            if (above != nodes.end())
+                consider( *above );
+
+            compseg.m_segment_number = best->segment_number;
 
             // when depth is default or zero, we obtain the depth of the completion based on the information
             // of the related segments
@@ -232,13 +322,33 @@ namespace Opm {
     void Compsegs::updateCompletionsWithSegment(const std::vector< Compsegs >& compsegs,
                                                 CompletionSet& completion_set) {
 
+        std::map< std::array< int, 3 >, size_t > completion_positions;
+        for (size_t ic = 0; ic < completion_set.size(); ++ic) {
+            const auto& completion = completion_set.get( ic );
+            completion_positions.emplace( std::array< int, 3 >{{ completion.getI(), completion.getJ(), completion.getK() }}, ic );
+        }
+
         for( const auto& compseg : compsegs ) {
             const int i = compseg.m_i;
             const int j = compseg.m_j;
             const int k = compseg.m_k;
 
-            const Completion& completion = completion_set.getFromIJK( i, j, k );
-            completion_set.add(Completion(completion, compseg.m_segment_number, compseg.m_center_depth) );
+            const auto position = completion_positions.find( {{ i, j, k }} );
+            if (position == completion_positions.end()) {
+                // cells in a COMPSEGS range which the well is not completed in are skipped
+                if (compseg.m_in_range)
+                    continue;
+
+                throw std::runtime_error(" the completion is not found! \n ");
+            }
+
+            const Completion& completion = completion_set.get( position->second );
+            // a negative depth means the depth is taken from COMPDAT
+            const double center_depth = compseg.m_center_depth < 0.
+                ? completion.getCenterDepth()
+                : compseg.m_center_depth;
+
+            completion_set.add(Completion(completion, compseg.m_segment_number, center_depth) );
         }
 
         for (size_t ic = 0; ic < completion_set.size(); ++ic) {
@@ -23,6 +23,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
 
@@ -30,6 +31,7 @@ namespace Opm {
 
     class CompletionSet;
     class DeckKeyword;
+    class EclipseGrid;
     class SegmentSet;
 
     struct Compsegs {
@@ -48,13 +50,17 @@ namespace Opm {
         // we do not handle thermal length for the moment
         // double m_thermal_length;
         int m_segment_number;
+        // generated from a range record; the well need not be completed in the cell
+        bool m_in_range = false;
 
         Compsegs(int i_in, int j_in, int k_in, int branch_number_in, double distance_start_in, double distance_end_in,
                  WellCompletion::DirectionEnum dir_in, double center_depth_in, int segment_number_in);
 
         void calculateCenterDepthWithSegments(const SegmentSet& segment_set);
 
-        static std::vector< Compsegs > compsegsFromCOMPSEGSKeyword( const DeckKeyword& compsegsKeyword );
+        // the grid is used for the cell sizes when DISTANCE_END is defaulted
+        static std::vector< Compsegs > compsegsFromCOMPSEGSKeyword( const DeckKeyword& compsegsKeyword,
+                                                                    const EclipseGrid* grid = nullptr );
 
         // get the segment number information and depth information based on the information from SegmentSet
         static void processCOMPSEGS(std::vector< Compsegs >& compsegs, const SegmentSet& segment_set );
@@ -16,10 +16,12 @@
   You should have received a copy of the GNU General Public License
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 #include <cmath>
 #include <map>
+#include <set>
 
 #ifdef _WIN32
 #define _USE_MATH_DEFINES
@@ -76,12 +78,21 @@ namespace Opm {
     }
 
     int SegmentSet::segmentNumberToIndex(const int segment_number) const {
-        const auto it = m_segment_number_to_index.find(segment_number);
-        if (it != m_segment_number_to_index.end()) {
-            return it->second;
-        } else {
+        if (segment_number < 0 || size_t(segment_number) >= m_segment_number_to_index.size())
             return -1;
-        }
+
+        return m_segment_number_to_index[segment_number];
+    }
+
+    int SegmentSet::maxSegmentNumber() const {
+        return std::max( int( m_segment_number_to_index.size() ) - 1, 0 );
+    }
+
+    void SegmentSet::setSegmentIndex(const int segment_number, const int index) {
+        if (size_t(segment_number) >= m_segment_number_to_index.size())
+            m_segment_number_to_index.resize(segment_number + 1, -1);
+
+        m_segment_number_to_index[segment_number] = index;
     }
 
     void SegmentSet::addSegment( Segment new_segment ) {
@@ -91,7 +102,7 @@ namespace Opm {
        const int segment_index = segmentNumberToIndex(segment_number);
 
        if (segment_index < 0) { // it is a new segment
-           m_segment_number_to_index[segment_number] = numberSegment();
+           setSegmentIndex(segment_number, numberSegment());
            m_segments.push_back(new_segment);
        } else { // the segment already exists
            m_segments[segment_index] = new_segment;
@@ -203,7 +214,7 @@ namespace Opm {
             if (index >= 0) { // found in the existing m_segments already
                 throw std::logic_error("Segments with same segment number are found!\n");
             }
-            m_segment_number_to_index[segment_number] = i_segment;
+            setSegmentIndex(segment_number, i_segment);
         }
 
         for (size_t i_segment = 0; i_segment < m_segments.size(); ++i_segment) {
@@ -212,7 +223,10 @@ namespace Opm {
             if (outlet_segment <= 0) { // no outlet segment
                 continue;
             }
-            const int outlet_segment_index = m_segment_number_to_index[outlet_segment];
+            const int outlet_segment_index = segmentNumberToIndex(outlet_segment);
+            if (outlet_segment_index < 0) {
+                continue;
+            }
             m_segments[outlet_segment_index].addInletSegment(segment_number);
         }
 
@@ -344,55 +358,106 @@ namespace Opm {
         // two principles
         // 1. the index of the outlet segment will be stored in the lower index than the segment.
         // 2. the segments belong to the same branch will be continuously stored.
+        //
+        // The segments are placed one at a time, in a topological order
+        // from the top segment. The next segment is the one whose outlet
+        // has been placed and which is on the same branch as the last
+        // placed segment; if there is no such segment it is the candidate
+        // at the lowest position. The candidates are kept in ordered sets
+        // so the whole ordering is O(S log S).
+
+        const int num_segments = numberSegment();
+
+        // the segments (original indices) with a given outlet segment
+        std::map< int, std::vector< int > > inlets;
+        for (int index = 1; index < num_segments; ++index)
+            inlets[ m_segments[index].outletSegment() ].push_back( index );
+
+        // position[index] is the current position of segment index, and
+        // at_position the inverse; the placed segments are swapped into
+        // the front as in the original search-and-swap formulation.
+        std::vector< int > position( num_segments );
+        std::vector< int > at_position( num_segments );
+        for (int index = 0; index < num_segments; ++index) {
+            position[index] = index;
+            at_position[index] = index;
+        }
 
-        // top segment will always be the first one
-        // before this index, the reordering is done.
-        int current_index= 1;
+        using Candidate = std::pair< int, int >; // (position, index)
+        std::set< Candidate > candidates;
+        std::map< int, std::set< Candidate > > branch_candidates;
 
-        // clear the mapping from segment number to store index
-        m_segment_number_to_index.clear();
-        // for the top segment
-        m_segment_number_to_index[1] = 0;
+        const auto add_inlets = [&]( int segment_number ) {
+            const auto iter = inlets.find( segment_number );
+            if (iter == inlets.end())
+                return;
 
-        while (current_index< numberSegment()) {
-            // the branch number of the last segment that is done re-ordering
-            const int last_branch_number = m_segments[current_index-1].branchNumber();
-            // the one need to be swapped to the current_index.
-            int target_segment_index= -1;
-
-            // looking for target_segment_index
-            for (int i_index= current_index; i_index< numberSegment(); ++i_index) {
-                const int outlet_segment_number = m_segments[i_index].outletSegment();
-                const int outlet_segment_index = segmentNumberToIndex(outlet_segment_number);
-                if (outlet_segment_index < 0) { // not found the outlet_segment in the done re-ordering segments
-                    continue;
-                }
-                if (target_segment_index< 0) { // first time found a candidate
-                    target_segment_index= i_index;
-                } else { // there is already a candidate, chosing the one with the same branch number with last_branch_number
-                    const int old_target_segment_index_branch = m_segments[target_segment_index].branchNumber();
-                    const int new_target_segment_index_branch = m_segments[i_index].branchNumber();
-                    if (new_target_segment_index_branch == last_branch_number) {
-                        if (old_target_segment_index_branch != last_branch_number) {
-                            target_segment_index= i_index;
-                        } else {
-                            throw std::logic_error("two segments in the same branch share the same outlet segment !!\n");
-                        }
-                    }
-                }
+            for (const int index : iter->second) {
+                const Candidate candidate( position[index], index );
+                candidates.insert( candidate );
+                branch_candidates[ m_segments[index].branchNumber() ].insert( candidate );
             }
+        };
 
-            if (target_segment_index< 0) {
+        // clear the mapping from segment number to store index
+        m_segment_number_to_index.assign(m_segment_number_to_index.size(), -1);
+        // top segment will always be the first one
+        setSegmentIndex(1, 0);
+        if (num_segments > 0)
+            add_inlets( m_segments[0].segmentNumber() );
+
+        for (int current = 1; current < num_segments; ++current) {
+            // the branch number of the last segment that is done re-ordering
+            const int last_branch_number = m_segments[ at_position[current - 1] ].branchNumber();
+            const auto& same_branch = branch_candidates[ last_branch_number ];
+
+            Candidate target;
+            if (same_branch.size() > 1) {
+                throw std::logic_error("two segments in the same branch share the same outlet segment !!\n");
+            } else if (same_branch.size() == 1) {
+                target = *same_branch.begin();
+            } else if (!candidates.empty()) {
+                target = *candidates.begin();
+            } else {
                 throw std::logic_error("could not find candidate segment to swap in before the re-odering process get done !!\n");
             }
-            assert(target_segment_index>= current_index);
-            if (target_segment_index> current_index) {
-                std::swap(m_segments[current_index], m_segments[target_segment_index]);
+
+            const int target_index = target.second;
+            candidates.erase( target );
+            branch_candidates[ m_segments[target_index].branchNumber() ].erase( target );
+
+            // swap the target into the current position
+            const int displaced = at_position[current];
+            const int target_position = target.first;
+            if (displaced != target_index) {
+                const Candidate old_key( current, displaced );
+                const bool is_candidate = candidates.erase( old_key ) > 0;
+
+                position[displaced] = target_position;
+                at_position[target_position] = displaced;
+                position[target_index] = current;
+                at_position[current] = target_index;
+
+                if (is_candidate) {
+                    const Candidate new_key( target_position, displaced );
+                    auto& branch_set = branch_candidates[ m_segments[displaced].branchNumber() ];
+                    branch_set.erase( old_key );
+                    branch_set.insert( new_key );
+                    candidates.insert( new_key );
+                }
             }
-            const int segment_number = m_segments[current_index].segmentNumber();
-            m_segment_number_to_index[segment_number] = current_index;
-            current_index++;
+
+            const int segment_number = m_segments[target_index].segmentNumber();
+            setSegmentIndex(segment_number, current);
+            add_inlets( segment_number );
         }
+
+        std::vector< Segment > ordered;
+        ordered.reserve( num_segments );
+        for (int pos = 0; pos < num_segments; ++pos)
+            ordered.push_back( std::move( m_segments[ at_position[pos] ] ) );
+
+        m_segments.swap( ordered );
     }
 
     bool SegmentSet::operator==( const SegmentSet& rhs ) const {
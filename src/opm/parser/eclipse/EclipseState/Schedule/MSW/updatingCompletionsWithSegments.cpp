@@ -23,15 +23,35 @@
 
 namespace Opm {
 
-    CompletionSet updatingCompletionsWithSegments(const DeckKeyword& compsegs,
-                                                  const CompletionSet& input_completions,
-                                                  const SegmentSet& segment_set)
+namespace {
+
+    CompletionSet updateCompletions(const DeckKeyword& compsegs,
+                                    const CompletionSet& input_completions,
+                                    const SegmentSet& segment_set,
+                                    const EclipseGrid* grid)
     {
         CompletionSet new_completion_set(input_completions);
 
-        std::vector<Compsegs> compsegs_vector = Compsegs::compsegsFromCOMPSEGSKeyword( compsegs );
+        std::vector<Compsegs> compsegs_vector = Compsegs::compsegsFromCOMPSEGSKeyword( compsegs, grid );
         Compsegs::processCOMPSEGS(compsegs_vector, segment_set);
         Compsegs::updateCompletionsWithSegment(compsegs_vector, new_completion_set);
         return new_completion_set;
     }
+
+}
+
+    CompletionSet updatingCompletionsWithSegments(const DeckKeyword& compsegs,
+                                                  const CompletionSet& input_completions,
+                                                  const SegmentSet& segment_set)
+    {
+        return updateCompletions(compsegs, input_completions, segment_set, nullptr);
+    }
+
+    CompletionSet updatingCompletionsWithSegments(const DeckKeyword& compsegs,
+                                                  const CompletionSet& input_completions,
+                                                  const SegmentSet& segment_set,
+                                                  const EclipseGrid& grid)
+    {
+        return updateCompletions(compsegs, input_completions, segment_set, &grid);
+    }
 }
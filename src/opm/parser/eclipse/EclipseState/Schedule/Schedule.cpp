@@ -17,6 +17,10 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include <stdexcept>
@@ -36,6 +40,7 @@
 #include <opm/parser/eclipse/Parser/ParserKeywords/W.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/ActionX.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/CompletionSet.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/DynamicState.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/DynamicVector.hpp>
@@ -48,17 +53,35 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/OilVaporizationProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Tuning.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellInjectionProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellPolymerProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellProductionProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WellTracerProperties.hpp>
 #include <opm/parser/eclipse/Units/Dimension.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
+#include <opm/parser/eclipse/Utility/Hash.hpp>
 
 namespace Opm {
 
+namespace {
+
+    /*
+      The keywords which can be used in the keyword block of an ACTIONX
+      keyword; these must be handled in Schedule::handleActionKeyword().
+    */
+    const std::set<std::string>& actionKeywords() {
+        static const std::set<std::string> keywords = {"WELOPEN", "WCONPROD", "WCONHIST", "WCONINJE",
+                                                       "WCONINJH", "WELTARG", "WEFAC", "WECON",
+                                                       "WTEST", "WELPI", "GCONPROD", "GCONINJE", "GEFAC"};
+        return keywords;
+    }
+
+}
+
     Schedule::Schedule( const Deck& deck,
                         const EclipseGrid& grid,
                         const Eclipse3DProperties& eclipseProperties,
@@ -72,7 +95,9 @@ namespace Opm {
         m_tuning( this->m_timeMap ),
         m_messageLimits( this->m_timeMap ),
         m_phases(phases),
-        wtest_config(this->m_timeMap, std::make_shared<WellTestConfig>() )
+        wtest_config(this->m_timeMap, std::make_shared<WellTestConfig>() ),
+        wlist_manager(this->m_timeMap, std::make_shared<WListManager>() ),
+        m_unit_system( deck.getActiveUnitSystem() )
     {
         m_controlModeWHISTCTL = WellProducer::CMODE_UNDEFINED;
         addGroup( "FIELD", 0 );
@@ -81,6 +106,8 @@ namespace Opm {
           We can have the MESSAGES keyword anywhere in the deck, we
           must therefor also scan the part of the deck prior to the
           SCHEDULE section to initialize valid MessageLimits object.
+          The tracer names from the PROPS section are collected in the
+          same pass, they are used to validate the WTRACER keyword.
         */
         for (size_t keywordIdx = 0; keywordIdx < deck.size(); ++keywordIdx) {
             const auto& keyword = deck.getKeyword(keywordIdx);
@@ -89,10 +116,18 @@ namespace Opm {
 
             if (keyword.name() == "MESSAGES")
                 handleMESSAGES(keyword, 0);
+
+            if (keyword.name() == "TRACER") {
+                for (const auto& record : keyword)
+                    m_tracer_names.push_back( record.getItem("NAME").getTrimmedString(0) );
+            }
         }
 
         if (Section::hasSCHEDULE(deck))
             iterateScheduleSection( parseContext, SCHEDULESection( deck ), grid, eclipseProperties );
+
+        const auto sectionHash = Section::contentHash( deck, { "RUNSPEC", "SUMMARY", "SCHEDULE" } );
+        m_hash = ContentHash::combine( ContentHash::combine( grid.hash(), eclipseProperties.hash() ), sectionHash );
     }
 
 
@@ -173,7 +208,7 @@ namespace Opm {
                 handleWCONPROD(keyword, currentStep, parseContext);
 
             else if (keyword.name() == "WCONINJE")
-                handleWCONINJE(section, keyword, currentStep, parseContext);
+                handleWCONINJE(unit_system, keyword, currentStep, parseContext);
 
             else if (keyword.name() == "WPOLYMER")
                 handleWPOLYMER(keyword, currentStep, parseContext);
@@ -181,9 +216,15 @@ namespace Opm {
             else if (keyword.name() == "WSOLVENT")
                 handleWSOLVENT(keyword, currentStep, parseContext);
 
+            else if (keyword.name() == "WTRACER")
+                handleWTRACER(keyword, currentStep, parseContext);
+
             else if (keyword.name() == "WTEST")
                 handleWTEST(keyword, currentStep, parseContext);
 
+            else if (keyword.name() == "WLIST")
+                handleWLIST(keyword, currentStep, parseContext);
+
             else if (keyword.name() == "WTEMP")
                 handleWTEMP(keyword, currentStep, parseContext);
 
@@ -191,7 +232,7 @@ namespace Opm {
                 handleWINJTEMP(keyword, currentStep, parseContext);
 
             else if (keyword.name() == "WCONINJH")
-                handleWCONINJH(section, keyword, currentStep, parseContext);
+                handleWCONINJH(unit_system, keyword, currentStep, parseContext);
 
             else if (keyword.name() == "WGRUPCON")
                 handleWGRUPCON(keyword, currentStep);
@@ -203,13 +244,13 @@ namespace Opm {
                 handleWELSEGS(keyword, currentStep);
 
             else if (keyword.name() == "COMPSEGS")
-                handleCOMPSEGS(keyword, currentStep);
+                handleCOMPSEGS(keyword, currentStep, grid);
 
             else if (keyword.name() == "WELOPEN")
                 handleWELOPEN(keyword, currentStep, parseContext);
 
             else if (keyword.name() == "WELTARG")
-                handleWELTARG(section, keyword, currentStep, parseContext);
+                handleWELTARG(unit_system, keyword, currentStep, parseContext);
 
             else if (keyword.name() == "GRUPTREE")
                 handleGRUPTREE(keyword, currentStep);
@@ -218,7 +259,7 @@ namespace Opm {
                 handleGRUPNET(keyword, currentStep);
 
             else if (keyword.name() == "GCONINJE")
-                handleGCONINJE(section, keyword, currentStep, parseContext);
+                handleGCONINJE(unit_system, keyword, currentStep, parseContext);
 
             else if (keyword.name() == "GCONPROD")
                 handleGCONPROD(keyword, currentStep, parseContext);
@@ -238,6 +279,9 @@ namespace Opm {
             else if (keyword.name() == "WPIMULT")
                 handleWPIMULT(keyword, currentStep);
 
+            else if (keyword.name() == "WELPI")
+                handleWELPI(unit_system, keyword, currentStep, parseContext);
+
             else if (keyword.name() == "COMPORD")
                 handleCOMPORD(parseContext , keyword, currentStep);
 
@@ -268,6 +312,9 @@ namespace Opm {
             else if (keyword.name() == "VFPPROD")
                 handleVFPPROD(keyword, unit_system, currentStep);
 
+            else if (keyword.name() == "ACTIONX")
+                keywordIdx = handleACTIONX(section, keywordIdx, currentStep, parseContext);
+
             else if (geoModifiers.find( keyword.name() ) != geoModifiers.end()) {
                 bool supported = geoModifiers.at( keyword.name() );
                 if (supported) {
@@ -297,6 +344,139 @@ namespace Opm {
         checkUnhandledKeywords(section);
     }
 
+    /*
+      The keywords between ACTIONX and ENDACTIO are not applied to the
+      schedule when the deck is loaded, they are stored with the action
+      and applied by applyActions() when the action triggers. The return
+      value is the index of the ENDACTIO keyword.
+    */
+    size_t Schedule::handleACTIONX(const SCHEDULESection& section, size_t keywordIdx, size_t currentStep, const ParseContext& parseContext) {
+        ActionX action( section.getKeyword(keywordIdx), this->m_timeMap.getStartTime(currentStep) );
+
+        for (size_t index = keywordIdx + 1; index < section.size(); ++index) {
+            const auto& keyword = section.getKeyword(index);
+            if (keyword.name() == "ENDACTIO") {
+                this->m_actions.add(action);
+                return index;
+            }
+
+            if (actionKeywords().count(keyword.name()) == 0) {
+                std::string msg = "The keyword " + keyword.name() + " is not supported in the ACTIONX block " + action.name();
+                parseContext.handleError( ParseContext::ACTIONX_ILLEGAL_KEYWORD , msg );
+                continue;
+            }
+
+            action.addKeyword(keyword);
+        }
+
+        throw std::invalid_argument("Missing ENDACTIO for ACTIONX " + action.name());
+    }
+
+
+    void Schedule::handleActionKeyword(const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
+        if (keyword.name() == "WELOPEN")
+            handleWELOPEN(keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "WCONPROD")
+            handleWCONPROD(keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "WCONHIST")
+            handleWCONHIST(keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "WCONINJE")
+            handleWCONINJE(this->m_unit_system, keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "WCONINJH")
+            handleWCONINJH(this->m_unit_system, keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "WELTARG")
+            handleWELTARG(this->m_unit_system, keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "WEFAC")
+            handleWEFAC(keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "WECON")
+            handleWECON(keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "WTEST")
+            handleWTEST(keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "WELPI")
+            handleWELPI(this->m_unit_system, keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "GCONPROD")
+            handleGCONPROD(keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "GCONINJE")
+            handleGCONINJE(this->m_unit_system, keyword, currentStep, parseContext);
+
+        else if (keyword.name() == "GEFAC")
+            handleGEFAC(keyword, currentStep, parseContext);
+
+        else
+            throw std::logic_error("The keyword " + keyword.name() + " can not be applied from an ACTIONX block");
+    }
+
+
+    const Actions& Schedule::actions() const {
+        return this->m_actions;
+    }
+
+
+    std::vector<std::string> Schedule::applyWellPI(size_t reportStep, const std::map<std::string, double>& well_pi) {
+        std::vector<std::string> rescaled;
+        if (!this->m_events.hasEvent( ScheduleEvents::WELL_PRODUCTIVITY_INDEX, reportStep ))
+            return rescaled;
+
+        for (auto& well : this->m_wells) {
+            if (!well.hasEvent( ScheduleEvents::WELL_PRODUCTIVITY_INDEX, reportStep ))
+                continue;
+
+            const auto pi_iter = well_pi.find( well.name() );
+            if (pi_iter == well_pi.end() || pi_iter->second <= 0)
+                continue;
+
+            const double factor = well.getPIScalingFactor( reportStep ) * well.getProductivityIndex( reportStep ) / pi_iter->second;
+            well.setPIScalingFactor( reportStep, factor );
+            rescaled.push_back( well.name() );
+
+            ContentHash hasher( this->m_hash );
+            hasher.update( well.name() ).update( factor ).update( static_cast< std::uint64_t >( reportStep ) );
+            this->m_hash = hasher.digest();
+        }
+
+        return rescaled;
+    }
+
+
+    std::vector<std::string> Schedule::applyActions(size_t reportStep,
+                                                    std::time_t sim_time,
+                                                    const SummaryState& summary_state,
+                                                    const ParseContext& parseContext) {
+        std::vector<std::string> triggered;
+
+        for (auto* action : this->m_actions.pending(sim_time)) {
+            const auto result = action->eval(sim_time, summary_state);
+            if (!result)
+                continue;
+
+            this->m_action_wells = result.wells;
+            for (const auto& keyword : *action)
+                handleActionKeyword(keyword, reportStep, parseContext);
+
+            action->markRun(sim_time);
+            triggered.push_back(action->name());
+
+            ContentHash hasher( this->m_hash );
+            hasher.update( action->name() ).update( static_cast< std::uint64_t >( reportStep ) );
+            this->m_hash = hasher.digest();
+        }
+        this->m_action_wells.clear();
+
+        return triggered;
+    }
+
+
     void Schedule::checkUnhandledKeywords(const SCHEDULESection& /*section*/) const
     {
     }
@@ -479,7 +659,23 @@ namespace Opm {
         }
     }
 
+    /*
+      The records of a WCONPROD or WCONHIST keyword are first collected
+      per well, where a later record for the same well replaces the
+      update from an earlier record. The updates are then applied in
+      one pass ordered by well index, so each well is only updated once
+      per keyword and a well name pattern is only resolved once, however
+      many records it appears in.
+    */
     void Schedule::handleWCONProducer( const DeckKeyword& keyword, size_t currentStep, bool isPredictionMode, const ParseContext& parseContext) {
+        struct ProducerUpdate {
+            WellCommon::StatusEnum status;
+            WellProductionProperties properties;
+        };
+
+        std::map< std::string, std::vector< size_t > > patterns;
+        std::map< size_t, ProducerUpdate > updates;
+
         for( const auto& record : keyword ) {
             const std::string& wellNamePattern =
                 record.getItem("WELL").getTrimmedString(0);
@@ -487,19 +683,27 @@ namespace Opm {
             const WellCommon::StatusEnum status =
                 WellCommon::StatusFromString(record.getItem("STATUS").getTrimmedString(0));
 
-            auto wells = getWells(wellNamePattern);
-            if (wells.empty())
+            auto pattern = patterns.find( wellNamePattern );
+            if( pattern == patterns.end() )
+                pattern = patterns.emplace( wellNamePattern, this->matchingWellIndices( wellNamePattern, currentStep ) ).first;
+
+            const auto& well_indices = pattern->second;
+            if (well_indices.empty())
                 invalidNamePattern(wellNamePattern, parseContext, keyword);
 
-            for( auto* well : wells ) {
+            for( const auto well_index : well_indices ) {
+                const auto& well = this->m_wells.get( well_index );
+                const auto prev_update = updates.find( well_index );
                 WellProductionProperties properties;
 
 
                 if (isPredictionMode) {
-                    auto addGrupProductionControl = well->isAvailableForGroupControl(currentStep);
+                    auto addGrupProductionControl = well.isAvailableForGroupControl(currentStep);
                     properties = WellProductionProperties::prediction( record, addGrupProductionControl );
                 } else {
-                    const WellProductionProperties& prev_properties = well->getProductionProperties(currentStep);
+                    const WellProductionProperties& prev_properties = (prev_update == updates.end())
+                        ? well.getProductionProperties(currentStep)
+                        : prev_update->second.properties;
                     const double BHPLimit = prev_properties.BHPLimit;
                     properties = WellProductionProperties::history( BHPLimit , record);
                 }
@@ -512,18 +716,26 @@ namespace Opm {
                         properties.controlMode = m_controlModeWHISTCTL;
                     }
                 }
-                updateWellStatus( *well , currentStep , status );
-                if (well->setProductionProperties(currentStep, properties))
-                    m_events.addEvent( ScheduleEvents::PRODUCTION_UPDATE , currentStep);
 
-                if ( !well->getAllowCrossFlow() && !isPredictionMode && (properties.OilRate + properties.WaterRate + properties.GasRate) == 0 ) {
+                updates[ well_index ] = ProducerUpdate{ status, std::move( properties ) };
+            }
+        }
 
-                    std::string msg =
-                            "Well " + well->name() + " is a history matched well with zero rate where crossflow is banned. " +
-                            "This well will be closed at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days";
-                    OpmLog::note(msg);
-                    updateWellStatus( *well, currentStep, WellCommon::StatusEnum::SHUT );
-                }
+        for( const auto& update : updates ) {
+            auto& well = this->m_wells.get( update.first );
+            const auto& properties = update.second.properties;
+
+            updateWellStatus( well , currentStep , update.second.status );
+            if (well.setProductionProperties(currentStep, properties))
+                m_events.addEvent( ScheduleEvents::PRODUCTION_UPDATE , currentStep);
+
+            if ( !well.getAllowCrossFlow() && !isPredictionMode && (properties.OilRate + properties.WaterRate + properties.GasRate) == 0 ) {
+
+                std::string msg =
+                        "Well " + well.name() + " is a history matched well with zero rate where crossflow is banned. " +
+                        "This well will be closed at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days";
+                OpmLog::note(msg);
+                updateWellStatus( well, currentStep, WellCommon::StatusEnum::SHUT );
             }
         }
     }
@@ -559,7 +771,7 @@ namespace Opm {
             const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
             double wellPi = record.getItem("WELLPI").get< double >(0);
 
-            for( auto* well : getWells( wellNamePattern ) ) {
+            for( auto* well : matchingWells( wellNamePattern, currentStep ) ) {
                 const auto& currentCompletionSet = well->getCompletions(currentStep);
 
                 CompletionSet newCompletionSet;
@@ -616,11 +828,36 @@ namespace Opm {
     }
 
 
-    void Schedule::handleWCONINJE( const SCHEDULESection& section, const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
+    /*
+      The WELPI value is a liquid productivity index for oil and water
+      wells, and a gas productivity index for gas wells.
+    */
+    void Schedule::handleWELPI( const UnitSystem& unit_system, const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
+        for( const auto& record : keyword ) {
+            const std::string& wellNamePattern = record.getItem("WELL_NAME").getTrimmedString(0);
+            const double input_pi = record.getItem("STEADY_STATE_PRODUCTIVITY_OR_INJECTIVITY_INDEX_VALUE").get< double >(0);
+            const auto wells = matchingWells( wellNamePattern, currentStep );
+
+            if (wells.empty())
+                invalidNamePattern(wellNamePattern, parseContext, keyword);
+
+            for( auto* well : wells ) {
+                const auto rate = (well->getPreferredPhase() == Phase::GAS) ? UnitSystem::measure::gas_surface_rate
+                                                                            : UnitSystem::measure::liquid_surface_rate;
+                const double pi = unit_system.to_si( rate, input_pi ) / unit_system.to_si( UnitSystem::measure::pressure, 1.0 );
+
+                well->setProductivityIndex( currentStep, pi );
+                m_events.addEvent( ScheduleEvents::WELL_PRODUCTIVITY_INDEX, currentStep );
+            }
+        }
+    }
+
+
+    void Schedule::handleWCONINJE( const UnitSystem& unit_system, const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
         for( const auto& record : keyword ) {
             const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
 
-            auto wells = getWells(wellNamePattern);
+            auto wells = matchingWells( wellNamePattern, currentStep );
             if (wells.empty())
                 invalidNamePattern(wellNamePattern, parseContext, keyword);
 
@@ -635,7 +872,7 @@ namespace Opm {
                 properties.predictionMode = true;
 
                 if (!record.getItem("RATE").defaultApplied(0)) {
-                    properties.surfaceInjectionRate = convertInjectionRateToSI(record.getItem("RATE").get< double >(0) , injectorType, section.unitSystem());
+                    properties.surfaceInjectionRate = convertInjectionRateToSI(record.getItem("RATE").get< double >(0) , injectorType, unit_system);
                     properties.addInjectionControl(WellInjector::RATE);
                 } else
                     properties.dropInjectionControl(WellInjector::RATE);
@@ -702,7 +939,7 @@ namespace Opm {
     void Schedule::handleWPOLYMER( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
         for( const auto& record : keyword ) {
             const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            const auto wells = getWells( wellNamePattern );
+            const auto wells = matchingWells( wellNamePattern, currentStep );
 
             if (wells.empty())
                 invalidNamePattern(wellNamePattern, parseContext, keyword);
@@ -730,11 +967,46 @@ namespace Opm {
 
 
 
+    void Schedule::handleWTRACER( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
+        for( const auto& record : keyword ) {
+            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
+            const auto wells = matchingWells( wellNamePattern, currentStep );
+
+            if (wells.empty())
+                invalidNamePattern(wellNamePattern, parseContext, keyword);
+
+            const std::string& tracer = record.getItem("TRACER").getTrimmedString(0);
+            if (std::find( m_tracer_names.begin(), m_tracer_names.end(), tracer ) == m_tracer_names.end()) {
+                std::string msg = "Error when handling " + keyword.name() + ". No such tracer: " + tracer;
+                parseContext.handleError( ParseContext::SCHEDULE_INVALID_NAME, msg );
+                continue;
+            }
+
+            const double concentration = record.getItem("CONCENTRATION").get< double >(0);
+
+            const auto& cum_factor_item = record.getItem("CUM_TRACER_FACTOR");
+            const auto& group_item = record.getItem("PRODUCTION_GROUP");
+
+            if (cum_factor_item.hasValue(0) && !cum_factor_item.defaultApplied(0))
+                throw std::logic_error("Sorry explicit setting of \'CUM_TRACER_FACTOR\' is not supported!");
+
+            if (group_item.hasValue(0) && !group_item.defaultApplied(0))
+                throw std::logic_error("Sorry explicit setting of \'PRODUCTION_GROUP\' is not supported!");
+
+            for( auto* well : wells) {
+                WellTracerProperties properties( well->getTracerProperties(currentStep) );
+                properties.setConcentration( tracer, concentration );
+                well->setTracerProperties(currentStep, properties);
+            }
+        }
+    }
+
+
     void Schedule::handleWECON( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
         for( const auto& record : keyword ) {
             const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
             WellEconProductionLimits econ_production_limits(record);
-            const auto wells = getWells( wellNamePattern );
+            const auto wells = matchingWells( wellNamePattern, currentStep );
 
             if (wells.empty())
                 invalidNamePattern(wellNamePattern, parseContext, keyword);
@@ -749,7 +1021,7 @@ namespace Opm {
         for( const auto& record : keyword ) {
             const std::string& wellNamePattern = record.getItem("WELLNAME").getTrimmedString(0);
             const double& efficiencyFactor = record.getItem("EFFICIENCY_FACTOR").get< double >(0);
-            const auto wells = getWells( wellNamePattern );
+            const auto wells = matchingWells( wellNamePattern, currentStep );
 
             if (wells.empty())
                 invalidNamePattern(wellNamePattern, parseContext, keyword);
@@ -766,7 +1038,7 @@ namespace Opm {
         std::shared_ptr<WellTestConfig> new_config(new WellTestConfig(current));
         for( const auto& record : keyword ) {
             const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            const auto wells = getWells( wellNamePattern );
+            const auto wells = matchingWells( wellNamePattern, currentStep );
             if (wells.empty())
                 invalidNamePattern(wellNamePattern, parseContext, keyword);
 
@@ -785,11 +1057,55 @@ namespace Opm {
         this->wtest_config.update(currentStep, new_config);
     }
 
+    void Schedule::handleWLIST(const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
+        const auto& current = *this->wlist_manager.get(currentStep);
+        std::shared_ptr<WListManager> new_wlm(new WListManager(current));
+
+        for( const auto& record : keyword ) {
+            const std::string& name = record.getItem("NAME").getTrimmedString(0);
+            const std::string& action = record.getItem("ACTION").getTrimmedString(0);
+
+            /*
+              The well names are resolved against the lists as they were
+              at the start of this WLIST keyword.
+            */
+            WList wells;
+            for( const auto& wellNamePattern : record.getItem("WELLS").getData<std::string>() ) {
+                const auto well_indices = this->matchingWellIndices( wellNamePattern, currentStep );
+                if (well_indices.empty())
+                    invalidNamePattern(wellNamePattern, parseContext, keyword);
+
+                for( auto index : well_indices )
+                    wells.add( index );
+            }
+
+            if (action == "NEW") {
+                new_wlm->newList(name).add(wells);
+                continue;
+            }
+
+            if (!new_wlm->hasList(name))
+                throw std::invalid_argument("The well list " + name + " must be created with WLIST NEW before " + action);
+
+            auto& wlist = new_wlm->getList(name);
+            if (action == "ADD")
+                wlist.add(wells);
+            else if (action == "DEL")
+                wlist.del(wells);
+            else if (action == "MOV") {
+                new_wlm->delWells(wells);
+                wlist.add(wells);
+            } else
+                throw std::invalid_argument("Invalid WLIST operation: " + action);
+        }
+        this->wlist_manager.update(currentStep, new_wlm);
+    }
+
     void Schedule::handleWSOLVENT( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
 
         for( const auto& record : keyword ) {
             const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            const auto wells = getWells( wellNamePattern );
+            const auto wells = matchingWells( wellNamePattern, currentStep );
 
             if (wells.empty())
                 invalidNamePattern(wellNamePattern, parseContext, keyword);
@@ -809,7 +1125,7 @@ namespace Opm {
     void Schedule::handleWTEMP( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
         for( const auto& record : keyword ) {
             const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            auto wells = getWells( wellNamePattern );
+            auto wells = matchingWells( wellNamePattern, currentStep );
 
             if (wells.empty())
                 invalidNamePattern( wellNamePattern, parseContext, keyword);
@@ -835,7 +1151,7 @@ namespace Opm {
         // question.
         for( const auto& record : keyword ) {
             const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            auto wells = getWells( wellNamePattern );
+            auto wells = matchingWells( wellNamePattern, currentStep );
 
             if (wells.empty())
                 invalidNamePattern( wellNamePattern, parseContext, keyword);
@@ -856,18 +1172,18 @@ namespace Opm {
         }
     }
 
-    void Schedule::handleWCONINJH( const SCHEDULESection& section,  const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
+    void Schedule::handleWCONINJH( const UnitSystem& unit_system, const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
         for( const auto& record : keyword ) {
             const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
 
             // convert injection rates to SI
             WellInjector::TypeEnum injectorType = WellInjector::TypeFromString( record.getItem("TYPE").getTrimmedString(0));
             double injectionRate = record.getItem("RATE").get< double >(0);
-            injectionRate = convertInjectionRateToSI(injectionRate, injectorType, section.unitSystem());
+            injectionRate = convertInjectionRateToSI(injectionRate, injectorType, unit_system);
 
             WellCommon::StatusEnum status = WellCommon::StatusFromString( record.getItem("STATUS").getTrimmedString(0));
 
-            auto wells = getWells( wellNamePattern );
+            auto wells = matchingWells( wellNamePattern, currentStep );
 
             if (wells.empty())
                 invalidNamePattern( wellNamePattern, parseContext, keyword);
@@ -939,7 +1255,7 @@ namespace Opm {
                 return { c, N };
             };
 
-            for( auto& well : this->getWells( wellname ) ) {
+            for( auto& well : this->matchingWells( wellname, timestep ) ) {
                 CompletionSet new_completions;
                 for( const auto& completion : well->getCompletions( timestep ) )
                     new_completions.add( new_completion( completion ) );
@@ -949,6 +1265,13 @@ namespace Opm {
         }
     }
 
+    /*
+      The well status and completion updates of a WELOPEN keyword are
+      collected per well in record order, and then applied in one pass
+      ordered by well index. Consecutive completion updates for a well
+      are combined, so the completion set of the well is only replaced
+      once for each run of completion records.
+    */
     void Schedule::handleWELOPEN( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext ) {
 
         auto all_defaulted = []( const DeckRecord& rec ) {
@@ -961,13 +1284,25 @@ namespace Opm {
 
         constexpr auto open = WellCommon::StatusEnum::OPEN;
 
+        struct WelopenUpdate {
+            bool well_status;
+            WellCommon::StatusEnum status;
+            std::function< Completion( const Completion& ) > completion;
+        };
+
+        std::map< std::string, std::vector< size_t > > patterns;
+        std::map< size_t, std::vector< WelopenUpdate > > updates;
+
         for( const auto& record : keyword ) {
             const auto& wellNamePattern = record.getItem( "WELL" ).getTrimmedString(0);
             const auto& status_str = record.getItem( "STATUS" ).getTrimmedString( 0 );
 
-            auto wells = getWells( wellNamePattern );
+            auto pattern = patterns.find( wellNamePattern );
+            if( pattern == patterns.end() )
+                pattern = patterns.emplace( wellNamePattern, this->matchingWellIndices( wellNamePattern, currentStep ) ).first;
 
-            if (wells.empty())
+            const auto& well_indices = pattern->second;
+            if (well_indices.empty())
                 invalidNamePattern( wellNamePattern, parseContext, keyword);
 
             /* if all records are defaulted or just the status is set, only
@@ -976,18 +1311,8 @@ namespace Opm {
             if( all_defaulted( record ) ) {
                 const auto status = WellCommon::StatusFromString( status_str );
 
-                for( auto* well : wells ) {
-                    if( status == open && !well->canOpen(currentStep) ) {
-                        auto days = m_timeMap.getTimePassedUntil( currentStep ) / (60 * 60 * 24);
-                        std::string msg = "Well " + well->name()
-                            + " where crossflow is banned has zero total rate."
-                            + " This well is prevented from opening at "
-                            + std::to_string( days ) + " days";
-                        OpmLog::note(msg);
-                    } else {
-                        this->updateWellStatus( *well, currentStep, status );
-                    }
-                }
+                for( const auto well_index : well_indices )
+                    updates[ well_index ].push_back( WelopenUpdate{ true, status, nullptr } );
 
                 continue;
             }
@@ -1026,13 +1351,48 @@ namespace Opm {
                 return { completion, status };
             };
 
-            for( auto* well : wells ) {
+            for( const auto well_index : well_indices )
+                updates[ well_index ].push_back( WelopenUpdate{ false, WellCommon::StatusEnum::OPEN, new_completion } );
+        }
+
+        for( const auto& well_updates : updates ) {
+            auto& well = this->m_wells.get( well_updates.first );
+            const auto& well_update = well_updates.second;
+
+            auto update = well_update.begin();
+            while( update != well_update.end() ) {
+                if( update->well_status ) {
+                    if( update->status == open && !well.canOpen(currentStep) ) {
+                        auto days = m_timeMap.getTimePassedUntil( currentStep ) / (60 * 60 * 24);
+                        std::string msg = "Well " + well.name()
+                            + " where crossflow is banned has zero total rate."
+                            + " This well is prevented from opening at "
+                            + std::to_string( days ) + " days";
+                        OpmLog::note(msg);
+                    } else {
+                        this->updateWellStatus( well, currentStep, update->status );
+                    }
+
+                    ++update;
+                    continue;
+                }
+
+                auto run_end = update;
+                while( run_end != well_update.end() && !run_end->well_status )
+                    ++run_end;
+
                 CompletionSet new_completions;
-                for( const auto& c : well->getCompletions( currentStep ) )
-                    new_completions.add( new_completion( c ) );
+                for( const auto& c : well.getCompletions( currentStep ) ) {
+                    auto completion = c;
+                    for( auto iter = update; iter != run_end; ++iter )
+                        completion = iter->completion( completion );
+
+                    new_completions.add( completion );
+                }
 
-                well->addCompletionSet( currentStep, new_completions );
+                well.addCompletionSet( currentStep, new_completions );
                 m_events.addEvent( ScheduleEvents::COMPLETION_CHANGE, currentStep );
+                update = run_end;
             }
         }
     }
@@ -1049,11 +1409,10 @@ namespace Opm {
       WCONxxxx keyword).
     */
 
-    void Schedule::handleWELTARG( const SCHEDULESection& section ,
+    void Schedule::handleWELTARG( const UnitSystem& unitSystem,
                                   const DeckKeyword& keyword,
                                   size_t currentStep,
                                   const ParseContext& parseContext) {
-        Opm::UnitSystem unitSystem = section.unitSystem();
         double siFactorL = unitSystem.parse("LiquidSurfaceVolume/Time").getSIScaling();
         double siFactorG = unitSystem.parse("GasSurfaceVolume/Time").getSIScaling();
         double siFactorP = unitSystem.parse("Pressure").getSIScaling();
@@ -1064,7 +1423,7 @@ namespace Opm {
             const std::string& cMode = record.getItem("CMODE").getTrimmedString(0);
             double newValue = record.getItem("NEW_VALUE").get< double >(0);
 
-            const auto wells = getWells( wellNamePattern );
+            const auto wells = matchingWells( wellNamePattern, currentStep );
 
             if( wells.empty() )
                 invalidNamePattern( wellNamePattern, parseContext, keyword);
@@ -1169,7 +1528,7 @@ namespace Opm {
         }
     }
 
-    void Schedule::handleGCONINJE( const SCHEDULESection& section,  const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
+    void Schedule::handleGCONINJE( const UnitSystem& unit_system, const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext) {
         for( const auto& record : keyword ) {
             const std::string& groupNamePattern = record.getItem("GROUP").getTrimmedString(0);
             auto groups = getGroups ( groupNamePattern );
@@ -1191,7 +1550,7 @@ namespace Opm {
 
                 // calculate SI injection rates for the group
                 double surfaceInjectionRate = record.getItem("SURFACE_TARGET").get< double >(0);
-                surfaceInjectionRate = convertInjectionRateToSI(surfaceInjectionRate, wellPhase, section.unitSystem());
+                surfaceInjectionRate = convertInjectionRateToSI(surfaceInjectionRate, wellPhase, unit_system);
                 double reservoirInjectionRate = record.getItem("RESV_TARGET").getSIDouble(0);
 
                 group->setSurfaceMaxRate( currentStep , surfaceInjectionRate);
@@ -1440,14 +1799,14 @@ namespace Opm {
         well.addSegmentSet(currentStep, newSegmentset);
     }
 
-    void Schedule::handleCOMPSEGS( const DeckKeyword& keyword, size_t currentStep) {
+    void Schedule::handleCOMPSEGS( const DeckKeyword& keyword, size_t currentStep, const EclipseGrid& grid) {
         const auto& record1 = keyword.getRecord(0);
         const std::string& well_name = record1.getItem("WELL").getTrimmedString(0);
         auto& well = this->m_wells.get( well_name );
 
         const auto& segment_set = well.getSegmentSet(currentStep);
         const auto& completion_set = well.getCompletions( currentStep );
-        const CompletionSet new_completion_set = updatingCompletionsWithSegments(keyword, completion_set, segment_set);
+        const CompletionSet new_completion_set = updatingCompletionsWithSegments(keyword, completion_set, segment_set, grid);
 
         well.addCompletionSet(currentStep, new_completion_set);
     }
@@ -1512,7 +1871,7 @@ namespace Opm {
 
             const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
 
-            for( auto* well : getWells( wellNamePattern ) )
+            for( auto* well : matchingWells( wellNamePattern, currentStep ) )
                 well->updateRFTActive( currentStep, RFTConnections::RFTEnum::YES);
         }
 
@@ -1528,7 +1887,7 @@ namespace Opm {
             RFTConnections::RFTEnum RFTKey = RFTConnections::RFTEnumFromString(record.getItem("OUTPUT_RFT").getTrimmedString(0));
             PLTConnections::PLTEnum PLTKey = PLTConnections::PLTEnumFromString(record.getItem("OUTPUT_PLT").getTrimmedString(0));
 
-            for( auto* well : getWells( wellNamePattern ) ) {
+            for( auto* well : matchingWells( wellNamePattern, currentStep ) ) {
                 well->updateRFTActive( currentStep, RFTKey );
                 well->updatePLTActive( currentStep, PLTKey );
             }
@@ -1672,25 +2031,82 @@ namespace Opm {
     }
 
     std::vector< const Well* > Schedule::getWellsMatching( const std::string& wellNamePattern ) const {
-        auto tmp = const_cast< Schedule* >( this )->getWells( wellNamePattern );
-        return { tmp.begin(), tmp.end() };
+        std::vector< size_t > well_indices;
+
+        if( WListManager::isListName( wellNamePattern ) ) {
+            /*
+              The well lists only change with the WLIST keyword, so
+              consecutive report steps will mostly share the same
+              WListManager instance.
+            */
+            WList wells;
+            const WListManager* prev = nullptr;
+            for( size_t step = 0; step < this->m_timeMap.size(); ++step ) {
+                const auto* wlm = this->wlist_manager.get( step ).get();
+                if( wlm == prev ) continue;
+
+                prev = wlm;
+                if( wlm->hasList( wellNamePattern ) )
+                    wells.add( wlm->getList( wellNamePattern ) );
+            }
+
+            if( !wells.empty() )
+                well_indices = wells.wells();
+        }
+
+        if( well_indices.empty() )
+            well_indices = this->matchingWellIndices( wellNamePattern, this->m_timeMap.size() - 1 );
+
+        std::vector< const Well* > wells;
+        for( auto index : well_indices )
+            wells.push_back( std::addressof( this->m_wells.get( index ) ) );
+
+        return wells;
     }
 
-    std::vector< Well* > Schedule::getWells(const std::string& wellNamePattern) {
+    /*
+      This is the well name matching used by all the keyword handlers;
+      the argument can be a well name, a well name template like 'OP*', a
+      well list like '*PROD', or '?' for the wells which triggered the
+      ACTIONX which is currently being applied. The well indices are
+      returned in increasing order.
+    */
+    std::vector< size_t > Schedule::matchingWellIndices(const std::string& wellNamePattern, size_t timeStep) const {
+        if( wellNamePattern == "?" ) {
+            std::vector< size_t > well_indices;
+            for( const auto& well_name : this->m_action_wells ) {
+                if( m_wells.hasKey( well_name ) )
+                    well_indices.push_back( m_wells.index( well_name ) );
+            }
+            std::sort( well_indices.begin(), well_indices.end() );
+            return well_indices;
+        }
+
+        const auto& wlm = *this->wlist_manager.get( timeStep );
+        if( wlm.hasList( wellNamePattern ) )
+            return wlm.getList( wellNamePattern ).wells();
+
         size_t wildcard_pos = wellNamePattern.find("*");
 
         if( wildcard_pos != wellNamePattern.length()-1 ) {
             if( !m_wells.hasKey( wellNamePattern ) ) return {};
-            return { std::addressof( m_wells.get( wellNamePattern ) ) };
+            return { m_wells.index( wellNamePattern ) };
         }
 
-        std::vector< Well* > wells;
-        for( auto& well : this->m_wells ) {
-            if( Well::wellNameInWellNamePattern( well.name(), wellNamePattern ) ) {
-                wells.push_back( std::addressof( well ) );
-            }
+        std::vector< size_t > well_indices;
+        for( size_t index = 0; index < this->m_wells.size(); ++index ) {
+            if( Well::wellNameInWellNamePattern( this->m_wells.get( index ).name(), wellNamePattern ) )
+                well_indices.push_back( index );
         }
 
+        return well_indices;
+    }
+
+    std::vector< Well* > Schedule::matchingWells(const std::string& wellNamePattern, size_t timeStep) {
+        std::vector< Well* > wells;
+        for( auto index : this->matchingWellIndices( wellNamePattern, timeStep ) )
+            wells.push_back( std::addressof( this->m_wells.get( index ) ) );
+
         return wells;
     }
 
@@ -1854,6 +2270,12 @@ namespace Opm {
     void Schedule::filterCompletions(const EclipseGrid& grid) {
         for (auto& well : this->m_wells)
             well.filterCompletions(grid);
+
+        this->m_hash = ContentHash::combine( this->m_hash, grid.hash() );
+    }
+
+    std::uint64_t Schedule::hash() const {
+        return this->m_hash;
     }
 
     const VFPProdTable& Schedule::getVFPProdTable(int table_id, size_t timeStep) const {
@@ -1905,5 +2327,10 @@ namespace Opm {
         const auto& ptr = this->wtest_config.get(timeStep);
         return *ptr;
     }
+
+    const WListManager& Schedule::getWListManager(size_t timeStep) const {
+        const auto& ptr = this->wlist_manager.get(timeStep);
+        return *ptr;
+    }
 }
 
@@ -0,0 +1,119 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdexcept>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
+
+namespace Opm {
+
+namespace {
+
+    const std::map<std::string, double> empty_values;
+
+    bool has_var(const std::unordered_map<std::string, std::map<std::string, double>>& vars,
+                 const std::string& name,
+                 const std::string& var) {
+        const auto var_iter = vars.find(var);
+        if (var_iter == vars.end())
+            return false;
+
+        return var_iter->second.count(name) > 0;
+    }
+
+}
+
+    void SummaryState::update(const std::string& key, double value) {
+        this->values[key] = value;
+    }
+
+    void SummaryState::update_well_var(const std::string& well, const std::string& var, double value) {
+        this->well_vars[var][well] = value;
+    }
+
+    void SummaryState::update_group_var(const std::string& group, const std::string& var, double value) {
+        this->group_vars[var][group] = value;
+    }
+
+
+    bool SummaryState::has(const std::string& key) const {
+        return this->values.count(key) > 0;
+    }
+
+    double SummaryState::get(const std::string& key) const {
+        const auto iter = this->values.find(key);
+        if (iter == this->values.end())
+            throw std::out_of_range("No such summary key: " + key);
+
+        return iter->second;
+    }
+
+
+    bool SummaryState::has_well_var(const std::string& well, const std::string& var) const {
+        return has_var(this->well_vars, well, var);
+    }
+
+    double SummaryState::get_well_var(const std::string& well, const std::string& var) const {
+        if (!this->has_well_var(well, var))
+            throw std::out_of_range("No such well variable: " + var + ":" + well);
+
+        return this->well_vars.at(var).at(well);
+    }
+
+    const std::map<std::string, double>& SummaryState::well_values(const std::string& var) const {
+        const auto iter = this->well_vars.find(var);
+        if (iter == this->well_vars.end())
+            return empty_values;
+
+        return iter->second;
+    }
+
+
+    bool SummaryState::has_group_var(const std::string& group, const std::string& var) const {
+        return has_var(this->group_vars, group, var);
+    }
+
+    double SummaryState::get_group_var(const std::string& group, const std::string& var) const {
+        if (!this->has_group_var(group, var))
+            throw std::out_of_range("No such group variable: " + var + ":" + group);
+
+        return this->group_vars.at(var).at(group);
+    }
+
+    const std::map<std::string, double>& SummaryState::group_values(const std::string& var) const {
+        const auto iter = this->group_vars.find(var);
+        if (iter == this->group_vars.end())
+            return empty_values;
+
+        return iter->second;
+    }
+
+
+    std::size_t SummaryState::size() const {
+        std::size_t count = this->values.size();
+        for (const auto& var : this->well_vars)
+            count += var.second.size();
+
+        for (const auto& var : this->group_vars)
+            count += var.second.size();
+
+        return count;
+    }
+}
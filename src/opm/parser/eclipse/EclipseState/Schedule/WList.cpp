@@ -0,0 +1,92 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/WList.hpp>
+
+namespace Opm {
+
+    void WList::add(std::size_t well_index) {
+        if (well_index >= this->members.size())
+            this->members.resize(well_index + 1, false);
+
+        this->members[well_index] = true;
+    }
+
+
+    void WList::add(const WList& other) {
+        if (other.members.size() > this->members.size())
+            this->members.resize(other.members.size(), false);
+
+        for (std::size_t well_index = 0; well_index < other.members.size(); well_index++) {
+            if (other.members[well_index])
+                this->members[well_index] = true;
+        }
+    }
+
+
+    void WList::del(std::size_t well_index) {
+        if (well_index < this->members.size())
+            this->members[well_index] = false;
+    }
+
+
+    void WList::del(const WList& other) {
+        const auto common_size = std::min(this->members.size(), other.members.size());
+        for (std::size_t well_index = 0; well_index < common_size; well_index++) {
+            if (other.members[well_index])
+                this->members[well_index] = false;
+        }
+    }
+
+
+    void WList::clear() {
+        this->members.clear();
+    }
+
+
+    bool WList::has(std::size_t well_index) const {
+        if (well_index >= this->members.size())
+            return false;
+
+        return this->members[well_index];
+    }
+
+
+    std::size_t WList::size() const {
+        return std::count(this->members.begin(), this->members.end(), true);
+    }
+
+
+    bool WList::empty() const {
+        return std::none_of(this->members.begin(), this->members.end(), [](bool member) { return member; });
+    }
+
+
+    std::vector<std::size_t> WList::wells() const {
+        std::vector<std::size_t> well_indices;
+        for (std::size_t well_index = 0; well_index < this->members.size(); well_index++) {
+            if (this->members[well_index])
+                well_indices.push_back(well_index);
+        }
+        return well_indices;
+    }
+}
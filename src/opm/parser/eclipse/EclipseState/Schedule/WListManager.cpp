@@ -0,0 +1,74 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdexcept>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/WListManager.hpp>
+
+namespace Opm {
+
+    bool WListManager::hasList(const std::string& name) const {
+        return this->wlists.count(name) > 0;
+    }
+
+
+    WList& WListManager::newList(const std::string& name) {
+        if (!isListName(name))
+            throw std::invalid_argument("Invalid well list name: " + name + " - well list names must start with '*'");
+
+        auto& wlist = this->wlists[name];
+        wlist.clear();
+        return wlist;
+    }
+
+
+    WList& WListManager::getList(const std::string& name) {
+        const auto iter = this->wlists.find(name);
+        if (iter == this->wlists.end())
+            throw std::invalid_argument("No such well list: " + name);
+
+        return iter->second;
+    }
+
+
+    const WList& WListManager::getList(const std::string& name) const {
+        const auto iter = this->wlists.find(name);
+        if (iter == this->wlists.end())
+            throw std::invalid_argument("No such well list: " + name);
+
+        return iter->second;
+    }
+
+
+    void WListManager::delWells(const WList& wells) {
+        for (auto& pair : this->wlists)
+            pair.second.del(wells);
+    }
+
+
+    std::size_t WListManager::size() const {
+        return this->wlists.size();
+    }
+
+
+    bool WListManager::isListName(const std::string& name) {
+        return name.size() > 1 && name[0] == '*';
+    }
+}
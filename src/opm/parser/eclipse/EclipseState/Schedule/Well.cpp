@@ -47,11 +47,14 @@ namespace Opm {
           m_guideRatePhase( timeMap, GuideRate::UNDEFINED ),
           m_guideRateScalingFactor( timeMap, 1.0 ),
           m_efficiencyFactors (timeMap, 1.0 ),
+          m_productivityIndex( timeMap, 0.0 ),
+          m_piScalingFactor( timeMap, 1.0 ),
           m_isProducer( timeMap, true ) ,
           m_completions( timeMap, CompletionSet{} ),
           m_productionProperties( timeMap, WellProductionProperties() ),
           m_injectionProperties( timeMap, WellInjectionProperties() ),
           m_polymerProperties( timeMap, WellPolymerProperties() ),
+          m_tracerProperties( timeMap, WellTracerProperties() ),
           m_econproductionlimits( timeMap, WellEconProductionLimits() ),
           m_solventFraction( timeMap, 0.0 ),
           m_groupName( timeMap, "" ),
@@ -198,6 +201,18 @@ namespace Opm {
         return m_polymerProperties.at(timeStep);
     }
 
+    bool Well::setTracerProperties(size_t timeStep , const WellTracerProperties& newProperties) {
+        bool update = m_tracerProperties.update(timeStep, newProperties);
+        if (update)
+            addEvent( ScheduleEvents::WELL_TRACER_UPDATE, timeStep );
+
+        return update;
+    }
+
+    const WellTracerProperties& Well::getTracerProperties(size_t timeStep) const {
+        return m_tracerProperties.at(timeStep);
+    }
+
     bool Well::setSolventFraction(size_t timeStep , const double fraction) {
         m_isProducer.update(timeStep , false);
         return m_solventFraction.update(timeStep, fraction);
@@ -291,6 +306,47 @@ namespace Opm {
         m_efficiencyFactors.update(timeStep, scalingFactor);
     }
 
+    /*
+      The WELPI event is added also when the target is unchanged, the
+      connection factors might have changed since the previous WELPI.
+    */
+    void Well::setProductivityIndex(size_t timeStep, double productivityIndex) {
+        if (productivityIndex <= 0)
+            throw std::invalid_argument("WELPI: the productivity index of well " + m_name + " must be positive");
+
+        m_productivityIndex.update(timeStep, productivityIndex);
+        addEvent( ScheduleEvents::WELL_PRODUCTIVITY_INDEX , timeStep );
+    }
+
+    double Well::getProductivityIndex(size_t timeStep) const {
+        return m_productivityIndex.get(timeStep);
+    }
+
+    void Well::setPIScalingFactor(size_t timeStep, double scalingFactor) {
+        m_piScalingFactor.update(timeStep, scalingFactor);
+    }
+
+    double Well::getPIScalingFactor(size_t timeStep) const {
+        return m_piScalingFactor.get(timeStep);
+    }
+
+    std::vector<double> Well::getConnectionMultipliers(size_t timeStep) const {
+        const auto& completions = this->getCompletions( timeStep );
+        const double scalingFactor = this->getPIScalingFactor( timeStep );
+
+        std::vector<double> multipliers;
+        multipliers.reserve( completions.size() );
+        for (const auto& completion : completions) {
+            double multiplier = completion.getWellPi();
+            if (completion.getState() == WellCompletion::OPEN)
+                multiplier *= scalingFactor;
+
+            multipliers.push_back( multiplier );
+        }
+
+        return multipliers;
+    }
+
     /*****************************************************************/
 
     // WELSPECS
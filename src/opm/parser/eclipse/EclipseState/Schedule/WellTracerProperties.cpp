@@ -0,0 +1,49 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <opm/parser/eclipse/EclipseState/Schedule/WellTracerProperties.hpp>
+
+#include <string>
+
+namespace Opm {
+
+    void WellTracerProperties::setConcentration(const std::string& tracer, double concentration) {
+        m_tracerConcentrations[tracer] = concentration;
+    }
+
+    double WellTracerProperties::getConcentration(const std::string& tracer) const {
+        const auto iter = m_tracerConcentrations.find(tracer);
+        if (iter == m_tracerConcentrations.end())
+            return 0.0;
+
+        return iter->second;
+    }
+
+    const std::map<std::string, double>& WellTracerProperties::concentrations() const {
+        return m_tracerConcentrations;
+    }
+
+    bool WellTracerProperties::operator==(const WellTracerProperties& other) const {
+        return m_tracerConcentrations == other.m_tracerConcentrations;
+    }
+
+    bool WellTracerProperties::operator!=(const WellTracerProperties& other) const {
+        return !(*this == other);
+    }
+}
@@ -141,6 +141,14 @@ void handleMissingGroup( const ParseContext& parseContext , const std::string& k
     parseContext.handleError( ParseContext::SUMMARY_UNKNOWN_GROUP , msg );
 }
 
+void handleMissingActionKey( const ParseContext& parseContext, const std::string& action, const std::string& key) {
+    std::string msg = std::string("Error in ACTIONX ") + action + std::string(": summary key ") + key + std::string(" is not in the SUMMARY section");
+    if (parseContext.get( ParseContext::ACTIONX_UNKNOWN_SUMMARY_KEY) == InputError::WARN)
+        std::cerr << "ERROR: " << msg << std::endl;
+
+    parseContext.handleError( ParseContext::ACTIONX_UNKNOWN_SUMMARY_KEY , msg );
+}
+
 inline void keywordW( std::vector< ERT::smspec_node >& list,
                       const ParseContext& parseContext,
                       const DeckKeyword& keyword,
@@ -310,6 +318,53 @@ inline void keywordC( std::vector< ERT::smspec_node >& list,
     }
 }
 
+/*
+  Segment keywords are only added for wells which are multi segment at the
+  end of the simulation, and only for segments which exist in the segment
+  set. A defaulted segment number selects all segments of the well.
+*/
+inline void keywordS( std::vector< ERT::smspec_node >& list,
+                      const ParseContext& parseContext,
+                      const DeckKeyword& keyword,
+                      const Schedule& schedule,
+                      const GridDims& dims) {
+
+    const auto type = ECL_SMSPEC_SEGMENT_VAR;
+    const auto& keywordstring = keyword.name();
+    const auto last_timestep = schedule.getTimeMap().last();
+
+    for( const auto& record : keyword ) {
+
+        const auto& wellitem = record.getItem( 0 );
+        const auto& segmentitem = record.getItem( 1 );
+
+        const auto wells = wellitem.defaultApplied( 0 )
+                         ? schedule.getWells()
+                         : schedule.getWellsMatching( wellitem.getTrimmedString( 0 ) );
+
+        if( wells.empty() )
+            handleMissingWell( parseContext, keyword.name(), wellitem.getTrimmedString( 0 ) );
+
+        for( const auto* well : wells ) {
+            if( !well->isMultiSegment( last_timestep ) )
+                continue;
+
+            const auto& segments = well->getSegmentSet( last_timestep );
+
+            if( segmentitem.defaultApplied( 0 ) ) {
+                for( int i = 0; i < segments.numberSegment(); ++i )
+                    list.emplace_back( type, well->name(), keywordstring, "", ":",
+                                       dims.getNXYZ().data(), segments[ i ].segmentNumber() );
+            } else {
+                const int segment_number = segmentitem.get< int >( 0 );
+                if( segments.segmentNumberToIndex( segment_number ) >= 0 )
+                    list.emplace_back( type, well->name(), keywordstring, "", ":",
+                                       dims.getNXYZ().data(), segment_number );
+            }
+        }
+    }
+}
+
 inline void handleKW( std::vector< ERT::smspec_node >& list,
                       const DeckKeyword& keyword,
                       const Schedule& schedule,
@@ -325,6 +380,7 @@ inline void handleKW( std::vector< ERT::smspec_node >& list,
         case ECL_SMSPEC_BLOCK_VAR: return keywordB( list, keyword, dims );
         case ECL_SMSPEC_REGION_VAR: return keywordR( list, keyword, tables, dims );
         case ECL_SMSPEC_COMPLETION_VAR: return keywordC( list, parseContext, keyword, schedule, dims);
+        case ECL_SMSPEC_SEGMENT_VAR: return keywordS( list, parseContext, keyword, schedule, dims );
         case ECL_SMSPEC_MISC_VAR: return keywordMISC( list, keyword );
 
         default: return;
@@ -385,7 +441,12 @@ SummaryConfig::SummaryConfig( const Deck& deck,
                               const ParseContext& parseContext) :
     SummaryConfig( deck , schedule, tables, parseContext, GridDims( deck ))
 {
-
+    for (const auto& action : schedule.actions()) {
+        for (const auto& key : action.program().summaryKeys()) {
+            if (!(this->hasKeyword( key ) || this->hasSummaryKey( key )))
+                handleMissingActionKey( parseContext, action.name(), key );
+        }
+    }
 }
 
 SummaryConfig::const_iterator SummaryConfig::begin() const {
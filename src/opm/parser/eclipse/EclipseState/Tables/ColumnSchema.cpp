@@ -99,6 +99,11 @@ namespace Opm {
     }
 
 
+    Table::ColumnOrderEnum ColumnSchema::getOrder( ) const {
+        return m_order;
+    }
+
+
     Table::DefaultAction ColumnSchema::getDefaultMode( ) const {
         return m_defaultAction;
     }
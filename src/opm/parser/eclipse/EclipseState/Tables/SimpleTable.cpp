@@ -80,18 +80,17 @@ namespace Opm {
                     "inconsistent with the ones specified");
 
         size_t rows = deckItem.size() / numColumns();
+        const auto& data = m_jfunc ? deckItem.getData<double>() : deckItem.getSIDoubleData();
+        std::vector<double> values( rows );
+        std::vector<bool> defaulted( rows );
         for (size_t colIdx = 0; colIdx < numColumns(); ++colIdx) {
             auto& column = getColumn( colIdx );
             for (size_t rowIdx = 0; rowIdx < rows; rowIdx++) {
                 size_t deckItemIdx = rowIdx*numColumns() + colIdx;
-                if (deckItem.defaultApplied(deckItemIdx))
-                    column.addDefault( );
-                else if (m_jfunc) {
-                    column.addValue( deckItem.getData<double>()[deckItemIdx] );
-                }
-                else
-                    column.addValue( deckItem.getSIDouble(deckItemIdx) );
+                defaulted[rowIdx] = deckItem.defaultApplied(deckItemIdx);
+                values[rowIdx] = data[deckItemIdx];
             }
+            column.addValues( values , defaulted );
             if (colIdx > 0)
                 column.applyDefaults(getColumn( 0 ));
         }
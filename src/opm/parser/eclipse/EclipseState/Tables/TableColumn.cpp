@@ -26,6 +26,23 @@
 
 namespace Opm {
 
+namespace {
+
+    /*
+      The loop is written without early exit so that the compiler can
+      vectorize the comparisons over the full column.
+    */
+    template <typename Valid>
+    bool validOrder( const std::vector<double>& values , size_t first , Valid valid ) {
+        bool result = true;
+        for (size_t index = first; index < values.size(); ++index)
+            result &= valid( values[index - 1] , values[index] );
+
+        return result;
+    }
+
+}
+
     TableColumn::TableColumn(const ColumnSchema& schema) :
         m_schema( schema )
     {
@@ -78,6 +95,87 @@ namespace Opm {
 
 
 
+    /*
+      Validate the ordering of all values from index first and out;
+      as in the row by row checks in assertUpdate() a pair of values
+      is only compared if neither of them is defaulted.
+    */
+    void TableColumn::assertOrder(size_t first) const {
+        if (!m_schema.lookupValid( ))
+            return;
+
+        if (first == 0)
+            first = 1;
+
+        bool valid = true;
+        if (m_defaultCount == 0) {
+            switch (m_schema.getOrder( )) {
+            case Table::INCREASING:
+                valid = validOrder( m_values , first , []( double v1 , double v2 ) { return v2 >= v1; });
+                break;
+            case Table::STRICTLY_INCREASING:
+                valid = validOrder( m_values , first , []( double v1 , double v2 ) { return v2 > v1; });
+                break;
+            case Table::DECREASING:
+                valid = validOrder( m_values , first , []( double v1 , double v2 ) { return v2 <= v1; });
+                break;
+            case Table::STRICTLY_DECREASING:
+                valid = validOrder( m_values , first , []( double v1 , double v2 ) { return v2 < v1; });
+                break;
+            default:
+                break;
+            }
+        } else {
+            for (size_t index = first; index < m_values.size(); ++index) {
+                if (m_default[index - 1] || m_default[index])
+                    continue;
+
+                valid = valid && m_schema.validOrder( m_values[index - 1] , m_values[index] );
+            }
+        }
+
+        if (!valid)
+            throw std::invalid_argument("Incorrect ordering of values in column: " + m_schema.name());
+    }
+
+
+    void TableColumn::addValues(const std::vector<double>& values, const std::vector<bool>& defaulted) {
+        if (values.size() != defaulted.size())
+            throw std::invalid_argument("Size mismatch between values and default flags");
+
+        const size_t first = m_values.size();
+        const size_t defaultCount = m_defaultCount;
+        const Table::DefaultAction defaultAction = m_schema.getDefaultMode( );
+        if (defaultAction == Table::DEFAULT_NONE && std::find( defaulted.begin() , defaulted.end() , true ) != defaulted.end())
+            throw std::invalid_argument("The column does not accept default values");
+
+        m_values.reserve( first + values.size() );
+        m_default.reserve( first + values.size() );
+        for (size_t index = 0; index < values.size(); ++index) {
+            if (!defaulted[index]) {
+                m_values.push_back( values[index] );
+                m_default.push_back( false );
+            } else if (defaultAction == Table::DEFAULT_CONST) {
+                m_values.push_back( m_schema.getDefaultValue( ) );
+                m_default.push_back( false );
+            } else {
+                m_values.push_back( -1 ); // Should never even be read.
+                m_default.push_back( true );
+                m_defaultCount += 1;
+            }
+        }
+
+        try {
+            assertOrder( first );
+        } catch (...) {
+            m_values.resize( first );
+            m_default.resize( first );
+            m_defaultCount = defaultCount;
+            throw;
+        }
+    }
+
+
     void TableColumn::addValue(double value) {
         assertUpdate( m_values.size() , value );
         m_values.push_back( value );
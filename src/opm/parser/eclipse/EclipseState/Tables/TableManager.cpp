@@ -19,12 +19,14 @@
  */
 
 #include <opm/common/OpmLog/LogUtil.hpp>
+#include <opm/common/utility/Executor.hpp>
 
 #include <opm/parser/eclipse/Parser/ParserKeywords/E.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/M.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/V.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/T.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/E.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/M.hpp>
@@ -93,7 +95,8 @@ namespace Opm {
         hasImptvd (deck.hasKeyword("IMPTVD")),
         hasEnptvd (deck.hasKeyword("ENPTVD")),
         hasEqlnum (deck.hasKeyword("EQLNUM")),
-        m_jfunc( deck )
+        m_jfunc( deck ),
+        m_inputHash( Section::contentHash( deck, { "RUNSPEC", "PROPS", "SOLUTION" } ) )
     {
         // determine the default resevoir temperature in Kelvin
         m_rtemp = ParserKeywords::RTEMP::TEMP::defaultValue;
@@ -103,6 +106,7 @@ namespace Opm {
         initSimpleTables( deck );
         initFullTables(deck, "PVTG", m_pvtgTables);
         initFullTables(deck, "PVTO", m_pvtoTables);
+        runTableTasks( );
         if( deck.hasKeyword( "PVTW" ) )
             this->m_pvtwTable = PvtwTable( deck.getKeyword( "PVTW" ) );
 
@@ -127,6 +131,19 @@ namespace Opm {
             m_rtemp = deck.getKeyword("RTEMPA").getRecord(0).getItem("TEMP").getSIDouble( 0 );
     }
 
+    void TableManager::runTableTasks() {
+        auto tasks = std::move( this->m_tableTasks );
+        this->m_tableTasks.clear();
+
+        Executor::instance().parallelFor( 0, tasks.size(), [&tasks]( size_t index ) {
+            tasks[index].build();
+        });
+
+        for (auto& task : tasks)
+            task.commit();
+    }
+
+
     void TableManager::initDims(const Deck& deck) {
         using namespace Opm::ParserKeywords;
 
@@ -748,6 +765,10 @@ namespace Opm {
         return this->m_rtemp;
     }
 
+    std::uint64_t TableManager::hash() const {
+        return this->m_inputHash;
+    }
+
 }
 
 
@@ -0,0 +1,196 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
+#include <opm/parser/eclipse/EclipseState/TracerConfig.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+namespace Opm {
+
+namespace {
+
+    Phase tracer_phase( const std::string& fluid ) {
+        if (fluid == "OIL")
+            return Phase::OIL;
+
+        if (fluid == "WAT")
+            return Phase::WATER;
+
+        if (fluid == "GAS")
+            return Phase::GAS;
+
+        throw std::invalid_argument("Tracer fluid: " + fluid + " is not supported - must be OIL, WAT or GAS");
+    }
+
+
+    /*
+      Linear interpolation in a table of (depth, concentration) pairs;
+      outside the table the end values are used.
+    */
+    double tvdp_value( const std::vector<double>& depth, const std::vector<double>& conc, double z ) {
+        if (z <= depth.front())
+            return conc.front();
+
+        if (z >= depth.back())
+            return conc.back();
+
+        const auto upper = std::upper_bound( depth.begin(), depth.end(), z );
+        const size_t i = std::distance( depth.begin(), upper );
+        const double w = (z - depth[i - 1]) / (depth[i] - depth[i - 1]);
+        return conc[i - 1] + w * (conc[i] - conc[i - 1]);
+    }
+
+
+    std::vector<double> tvdp_concentration( const DeckKeyword& keyword,
+                                            const UnitSystem& units,
+                                            const EclipseGrid& grid,
+                                            const std::vector<int>& eqlnum ) {
+        std::vector<std::vector<double>> depth_tables;
+        std::vector<std::vector<double>> conc_tables;
+
+        for (const auto& record : keyword) {
+            const auto& table = record.getItem( 0 ).getData< double >();
+            if (table.empty() || (table.size() % 2) != 0)
+                throw std::invalid_argument("The " + keyword.name() + " table must have a concentration for every depth");
+
+            std::vector<double> depth;
+            std::vector<double> conc;
+            for (size_t i = 0; i < table.size(); i += 2) {
+                depth.push_back( units.to_si( UnitSystem::measure::length, table[i] ));
+                conc.push_back( table[i + 1] );
+            }
+
+            if (!std::is_sorted( depth.begin(), depth.end() ))
+                throw std::invalid_argument("The depth values in " + keyword.name() + " must be increasing");
+
+            depth_tables.push_back( std::move( depth ));
+            conc_tables.push_back( std::move( conc ));
+        }
+
+        std::vector<double> concentration( grid.getCartesianSize() );
+        for (size_t g = 0; g < concentration.size(); g++) {
+            if (eqlnum[g] < 1 || static_cast<size_t>( eqlnum[g] ) > depth_tables.size())
+                throw std::invalid_argument("The EQLNUM region " + std::to_string( eqlnum[g] ) + " has no " + keyword.name()
+                                            + " table - only " + std::to_string( depth_tables.size() ) + " tables are given");
+
+            const size_t table = eqlnum[g] - 1;
+            concentration[g] = tvdp_value( depth_tables[table], conc_tables[table], grid.getCellDepth( g ));
+        }
+
+        return concentration;
+    }
+
+}
+
+
+    std::string TracerConfig::TracerEntry::restartKey() const {
+        return this->name + "F";
+    }
+
+
+    TracerConfig::TracerConfig(const Deck& deck, const EclipseGrid& grid, const Eclipse3DProperties& props) {
+        if (!deck.hasKeyword( "TRACER" ))
+            return;
+
+        const auto& units = deck.getActiveUnitSystem();
+        for (const auto& record : deck.getKeyword( "TRACER" )) {
+            TracerEntry tracer;
+            tracer.name = record.getItem( "NAME" ).getTrimmedString( 0 );
+            tracer.phase = tracer_phase( record.getItem( "FLUID" ).getTrimmedString( 0 ));
+
+            const auto& unit_item = record.getItem( "UNIT" );
+            if (unit_item.hasValue( 0 ))
+                tracer.unit_string = unit_item.getTrimmedString( 0 );
+
+            if (this->has( tracer.name ))
+                throw std::invalid_argument("The tracer: " + tracer.name + " has been defined more than once");
+
+            const std::string tblk = "TBLKF" + tracer.name;
+            const std::string tvdp = "TVDPF" + tracer.name;
+
+            if (deck.hasKeyword( tblk )) {
+                tracer.concentration = deck.getKeyword( tblk ).getRawDoubleData();
+                if (tracer.concentration.size() != grid.getCartesianSize())
+                    throw std::invalid_argument("The " + tblk + " keyword has " + std::to_string( tracer.concentration.size() )
+                                                + " elements - expected " + std::to_string( grid.getCartesianSize() ));
+            } else if (deck.hasKeyword( tvdp )) {
+                const auto& eqlnum = props.getIntGridProperty( "EQLNUM" ).getData();
+                tracer.concentration = tvdp_concentration( deck.getKeyword( tvdp ), units, grid, eqlnum );
+            } else
+                tracer.concentration.assign( grid.getCartesianSize(), 0.0 );
+
+            this->tracers.push_back( std::move( tracer ));
+        }
+    }
+
+
+    size_t TracerConfig::size() const {
+        return this->tracers.size();
+    }
+
+
+    bool TracerConfig::empty() const {
+        return this->tracers.empty();
+    }
+
+
+    bool TracerConfig::has(const std::string& name) const {
+        return std::any_of( this->tracers.begin(), this->tracers.end(),
+                            [&name](const TracerEntry& tracer) { return tracer.name == name; });
+    }
+
+
+    size_t TracerConfig::index(const std::string& name) const {
+        const auto iter = std::find_if( this->tracers.begin(), this->tracers.end(),
+                                        [&name](const TracerEntry& tracer) { return tracer.name == name; });
+        if (iter == this->tracers.end())
+            throw std::invalid_argument("No such tracer: " + name);
+
+        return std::distance( this->tracers.begin(), iter );
+    }
+
+
+    const TracerConfig::TracerEntry& TracerConfig::operator[](const std::string& name) const {
+        return this->tracers[ this->index( name ) ];
+    }
+
+
+    const TracerConfig::TracerEntry& TracerConfig::operator[](size_t index) const {
+        return this->tracers.at( index );
+    }
+
+
+    std::vector<TracerConfig::TracerEntry>::const_iterator TracerConfig::begin() const {
+        return this->tracers.begin();
+    }
+
+
+    std::vector<TracerConfig::TracerEntry>::const_iterator TracerConfig::end() const {
+        return this->tracers.end();
+    }
+}
@@ -86,6 +86,8 @@ namespace Opm {
         addKey(SUMMARY_UNKNOWN_WELL, InputError::THROW_EXCEPTION);
         addKey(SUMMARY_UNKNOWN_GROUP, InputError::THROW_EXCEPTION);
         addKey(SCHEDULE_INVALID_NAME, InputError::THROW_EXCEPTION);
+        addKey(ACTIONX_ILLEGAL_KEYWORD, InputError::THROW_EXCEPTION);
+        addKey(ACTIONX_UNKNOWN_SUMMARY_KEY, InputError::THROW_EXCEPTION);
     }
 
     void ParseContext::initEnv() {
@@ -260,6 +262,9 @@ namespace Opm {
     const std::string ParseContext::SUMMARY_UNKNOWN_GROUP = "SUMMARY_UNKNOWN_GROUP";
 
     const std::string ParseContext::SCHEDULE_INVALID_NAME = "SCHEDULE_INVALID_NAME";
+
+    const std::string ParseContext::ACTIONX_ILLEGAL_KEYWORD = "ACTIONX_ILLEGAL_KEYWORD";
+    const std::string ParseContext::ACTIONX_UNKNOWN_SUMMARY_KEY = "ACTIONX_UNKNOWN_SUMMARY_KEY";
 }
 
 
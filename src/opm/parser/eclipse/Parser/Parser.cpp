@@ -33,6 +33,7 @@
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Deck/IncludeGraph.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
@@ -181,27 +182,30 @@ inline std::string clean( const std::string& str ) {
 const std::string emptystr = "";
 
 struct file {
-    file( boost::filesystem::path p, const std::string& in ) :
-        input( in ), path( p )
+    file( boost::filesystem::path p, const std::string& in, size_t index ) :
+        input( in ), path( p ), graph_index( index )
     {}
 
     string_view input;
     size_t lineNR = 0;
     boost::filesystem::path path;
+    size_t graph_index;
 };
 
 class InputStack : public std::stack< file, std::vector< file > > {
     public:
-        void push( std::string&& input, boost::filesystem::path p = "" );
+        void push( std::string&& input,
+                   boost::filesystem::path p = "",
+                   size_t graph_index = IncludeGraph::npos );
 
     private:
         std::list< std::string > string_storage;
         using base = std::stack< file, std::vector< file > >;
 };
 
-void InputStack::push( std::string&& input, boost::filesystem::path p ) {
+void InputStack::push( std::string&& input, boost::filesystem::path p, size_t graph_index ) {
     this->string_storage.push_back( std::move( input ) );
-    this->emplace( p, this->string_storage.back() );
+    this->emplace( p, this->string_storage.back(), graph_index );
 }
 
 class ParserState {
@@ -211,6 +215,7 @@ class ParserState {
 
         void loadString( const std::string& );
         void loadFile( const boost::filesystem::path& );
+        void loadInclude( const std::string& );
         void openRootFile( const boost::filesystem::path& );
 
         void handleRandomText(const string_view& ) const;
@@ -225,11 +230,22 @@ class ParserState {
         void closeFile();
 
     private:
+        void readFile( const boost::filesystem::path& canonical,
+                       const boost::filesystem::path& inputFile );
+
         InputStack input_stack;
 
         std::map< std::string, std::string > pathMap;
         boost::filesystem::path rootPath;
 
+        /*
+          Memoised include path resolution, keyed by the directory
+          relative includes are resolved against and the raw path as
+          written in the deck. The value is the canonical path.
+        */
+        std::map< std::pair< std::string, std::string >,
+                  boost::filesystem::path > resolvedIncludes;
+
     public:
         std::shared_ptr< RawKeyword > rawKeyword;
         ParserKeywordSizeEnum lastSizeType = SLASH_TERMINATED;
@@ -299,6 +315,37 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
         return;
     }
 
+    this->readFile( inputFileCanonical, inputFile );
+}
+
+/*
+ * Decks with many INCLUDE statements will often reference the same
+ * files and directories over and over again; the alias substitution
+ * and canonicalization is therefor only done once for each distinct
+ * include path.
+ */
+void ParserState::loadInclude( const std::string& includeFileAsString ) {
+    const auto key = std::make_pair( this->rootPath.string(), includeFileAsString );
+    auto iter = this->resolvedIncludes.find( key );
+
+    if( iter == this->resolvedIncludes.end() ) {
+        const auto includeFile = this->getIncludeFilePath( includeFileAsString );
+        boost::system::error_code ec;
+        const auto includeFileCanonical = boost::filesystem::canonical( includeFile, ec );
+        if( ec ) {
+            std::string msg = "Could not open file: " + includeFile.string();
+            parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , msg);
+            return;
+        }
+
+        iter = this->resolvedIncludes.emplace( key, includeFileCanonical ).first;
+    }
+
+    this->readFile( iter->second, iter->second );
+}
+
+void ParserState::readFile( const boost::filesystem::path& inputFileCanonical,
+                            const boost::filesystem::path& inputFile ) {
     const auto closer = []( std::FILE* f ) { std::fclose( f ); };
     std::unique_ptr< std::FILE, decltype( closer ) > ufp(
             std::fopen( inputFileCanonical.string().c_str(), "rb" ),
@@ -329,7 +376,20 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
         throw std::runtime_error( "Error when reading input file '"
                                 + inputFileCanonical.string() + "'" );
 
-    this->input_stack.push( clean( buffer ), inputFileCanonical );
+    auto& graph = this->deck.getIncludeGraph();
+    auto graph_index = graph.index( inputFileCanonical.string() );
+    if( graph_index == IncludeGraph::npos ) {
+        boost::system::error_code ec;
+        auto mtime = boost::filesystem::last_write_time( inputFileCanonical, ec );
+        if( ec ) mtime = 0;
+
+        graph_index = graph.addFile( inputFileCanonical.string(), readc, mtime );
+    }
+
+    if( !this->input_stack.empty() && this->input_stack.top().graph_index != IncludeGraph::npos )
+        graph.addInclude( this->input_stack.top().graph_index, graph_index );
+
+    this->input_stack.push( clean( buffer ), inputFileCanonical, graph_index );
 }
 
 /*
@@ -572,9 +632,8 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         if (parserState.rawKeyword->getKeywordName() == Opm::RawConsts::include) {
             auto& firstRecord = parserState.rawKeyword->getFirstRecord( );
             std::string includeFileAsString = readValueToken<std::string>(firstRecord.getItem(0));
-            boost::filesystem::path includeFile = parserState.getIncludeFilePath( includeFileAsString );
 
-            parserState.loadFile( includeFile );
+            parserState.loadInclude( includeFileAsString );
             continue;
         }
 
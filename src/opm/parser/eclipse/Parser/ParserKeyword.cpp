@@ -506,6 +506,7 @@ void set_dimensions( ParserItem& item,
         if (this->m_keywordSizeType == UNKNOWN)
             keyword.setFixedSize( );
 
+        keyword.updateHash( );
         return keyword;
     }
 
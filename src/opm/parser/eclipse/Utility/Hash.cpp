@@ -0,0 +1,215 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include <opm/parser/eclipse/Utility/Hash.hpp>
+
+namespace Opm {
+
+namespace {
+
+    const std::uint64_t prime1 = 11400714785074694791ULL;
+    const std::uint64_t prime2 = 14029467366897019727ULL;
+    const std::uint64_t prime3 =  1609587929392839161ULL;
+    const std::uint64_t prime4 =  9650029242287828579ULL;
+    const std::uint64_t prime5 =  2870177450012600261ULL;
+
+    inline std::uint64_t rotl( std::uint64_t x, int r ) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    /*
+      The digest should not depend on the endianness of the host, all
+      multibyte reads are therefor done explicitly little endian.
+    */
+    inline std::uint64_t read64( const unsigned char* p ) {
+        std::uint64_t v = 0;
+        for( int i = 7; i >= 0; --i )
+            v = (v << 8) | p[i];
+        return v;
+    }
+
+    inline std::uint32_t read32( const unsigned char* p ) {
+        std::uint32_t v = 0;
+        for( int i = 3; i >= 0; --i )
+            v = (v << 8) | p[i];
+        return v;
+    }
+
+    inline std::uint64_t mix_round( std::uint64_t acc, std::uint64_t input ) {
+        acc += input * prime2;
+        acc = rotl( acc, 31 );
+        return acc * prime1;
+    }
+
+    inline std::uint64_t merge_round( std::uint64_t acc, std::uint64_t val ) {
+        acc ^= mix_round( 0, val );
+        return acc * prime1 + prime4;
+    }
+
+    inline std::uint64_t avalanche( std::uint64_t h ) {
+        h ^= h >> 33;
+        h *= prime2;
+        h ^= h >> 29;
+        h *= prime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+}
+
+    ContentHash::ContentHash( std::uint64_t seed_arg ) :
+        seed( seed_arg )
+    {
+        this->acc[0] = seed_arg + prime1 + prime2;
+        this->acc[1] = seed_arg + prime2;
+        this->acc[2] = seed_arg;
+        this->acc[3] = seed_arg - prime1;
+    }
+
+
+    ContentHash& ContentHash::update( const void* data, std::size_t size ) {
+        const auto* p = static_cast< const unsigned char* >( data );
+        const auto* end = p + size;
+        this->total_size += size;
+
+        if( this->buffer_size + size < sizeof this->buffer ) {
+            std::memcpy( this->buffer + this->buffer_size, p, size );
+            this->buffer_size += size;
+            return *this;
+        }
+
+        if( this->buffer_size > 0 ) {
+            const auto fill = sizeof this->buffer - this->buffer_size;
+            std::memcpy( this->buffer + this->buffer_size, p, fill );
+            for( int i = 0; i < 4; ++i )
+                this->acc[i] = mix_round( this->acc[i], read64( this->buffer + 8*i ) );
+
+            p += fill;
+            this->buffer_size = 0;
+        }
+
+        while( p + 32 <= end ) {
+            for( int i = 0; i < 4; ++i )
+                this->acc[i] = mix_round( this->acc[i], read64( p + 8*i ) );
+            p += 32;
+        }
+
+        this->buffer_size = end - p;
+        std::memcpy( this->buffer, p, this->buffer_size );
+        return *this;
+    }
+
+
+    ContentHash& ContentHash::update( int value ) {
+        return this->update( static_cast< std::uint64_t >( static_cast< std::int64_t >( value ) ) );
+    }
+
+
+    ContentHash& ContentHash::update( std::uint64_t value ) {
+        unsigned char bytes[8];
+        for( int i = 0; i < 8; ++i )
+            bytes[i] = static_cast< unsigned char >( value >> (8 * i) );
+
+        return this->update( bytes, sizeof bytes );
+    }
+
+
+    /*
+      Doubles are hashed by bit pattern, with the exception of 0.0 and
+      -0.0 which compare equal and should also hash equal.
+    */
+    ContentHash& ContentHash::update( double value ) {
+        if( value == 0 )
+            value = 0;
+
+        std::uint64_t bits;
+        std::memcpy( &bits, &value, sizeof bits );
+        return this->update( bits );
+    }
+
+
+    ContentHash& ContentHash::update( const std::string& value ) {
+        this->update( static_cast< std::uint64_t >( value.size() ) );
+        return this->update( value.data(), value.size() );
+    }
+
+
+    ContentHash& ContentHash::update( const std::vector< int >& data ) {
+        this->update( static_cast< std::uint64_t >( data.size() ) );
+        for( const auto& value : data )
+            this->update( value );
+
+        return *this;
+    }
+
+
+    ContentHash& ContentHash::update( const std::vector< double >& data ) {
+        this->update( static_cast< std::uint64_t >( data.size() ) );
+        for( const auto& value : data )
+            this->update( value );
+
+        return *this;
+    }
+
+
+    std::uint64_t ContentHash::digest() const {
+        std::uint64_t h;
+
+        if( this->total_size >= 32 ) {
+            h = rotl( this->acc[0], 1 ) + rotl( this->acc[1], 7 )
+              + rotl( this->acc[2], 12 ) + rotl( this->acc[3], 18 );
+
+            for( int i = 0; i < 4; ++i )
+                h = merge_round( h, this->acc[i] );
+        } else
+            h = this->seed + prime5;
+
+        h += this->total_size;
+
+        const unsigned char* p = this->buffer;
+        const unsigned char* end = p + this->buffer_size;
+
+        while( p + 8 <= end ) {
+            h ^= mix_round( 0, read64( p ) );
+            h = rotl( h, 27 ) * prime1 + prime4;
+            p += 8;
+        }
+
+        if( p + 4 <= end ) {
+            h ^= static_cast< std::uint64_t >( read32( p ) ) * prime1;
+            h = rotl( h, 23 ) * prime2 + prime3;
+            p += 4;
+        }
+
+        while( p < end ) {
+            h ^= (*p) * prime5;
+            h = rotl( h, 11 ) * prime1;
+            ++p;
+        }
+
+        return avalanche( h );
+    }
+
+
+    std::uint64_t ContentHash::combine( std::uint64_t first, std::uint64_t second ) {
+        return ContentHash( first ).update( second ).digest();
+    }
+}
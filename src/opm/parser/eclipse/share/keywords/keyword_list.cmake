@@ -13,6 +13,7 @@
 set( keywords
      000_Eclipse100/A/ACTDIMS
      000_Eclipse100/A/ACTION
+     000_Eclipse100/A/ACTIONX
      000_Eclipse100/A/ACTNUM
      000_Eclipse100/A/ADD
      000_Eclipse100/A/ADDREG
@@ -45,6 +46,7 @@ set( keywords
      000_Eclipse100/C/COORD
      000_Eclipse100/C/COORDSYS
      000_Eclipse100/C/COPY
+     000_Eclipse100/C/COPYBOX
      000_Eclipse100/C/COPYREG
      000_Eclipse100/C/CPR
      000_Eclipse100/D/DATE
@@ -276,6 +278,7 @@ set( keywords
      000_Eclipse100/S/SCALECRS
      000_Eclipse100/S/SCHEDULE
      000_Eclipse100/S/SDENSITY
+     000_Eclipse100/S/SEGMENT_PROBE
      000_Eclipse100/S/SEPARATE
      000_Eclipse100/S/SGAS
      000_Eclipse100/S/SGCR
@@ -319,6 +322,7 @@ set( keywords
      000_Eclipse100/S/SWOF
      000_Eclipse100/S/SWU
      000_Eclipse100/T/TABDIMS
+     000_Eclipse100/T/TBLK
      000_Eclipse100/T/TEMP
      000_Eclipse100/T/THCONR
      000_Eclipse100/T/THPRES
@@ -377,6 +381,7 @@ set( keywords
      000_Eclipse100/W/WINJMULT
      000_Eclipse100/W/WLIFT
      000_Eclipse100/W/WLIMTOL
+     000_Eclipse100/W/WLIST
      000_Eclipse100/W/WORKLIM
      000_Eclipse100/W/WORKTHP
      000_Eclipse100/W/WPAVE
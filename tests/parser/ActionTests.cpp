@@ -0,0 +1,311 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#define BOOST_TEST_MODULE ActionTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/ActionProgram.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/ActionX.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Actions.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    ActionProgram compile(const std::vector<std::string>& input) {
+        return ActionProgram(ActionProgram::tokenize(input));
+    }
+
+}
+
+
+BOOST_AUTO_TEST_CASE(TOKENIZE) {
+    const std::vector<std::string> input = {"(WWCT", "'OP*'", ">=0.75)", "AND", "FPR<", "100"};
+    const std::vector<std::string> expected = {"(", "WWCT", "OP*", ">=", "0.75", ")", "AND", "FPR", "<", "100"};
+    const auto tokens = ActionProgram::tokenize(input);
+    BOOST_CHECK_EQUAL_COLLECTIONS(tokens.begin(), tokens.end(), expected.begin(), expected.end());
+}
+
+
+BOOST_AUTO_TEST_CASE(PARSE_ACTIONX) {
+    const std::string input = R"(
+SCHEDULE
+
+ACTIONX
+   'ACTION' 10 30 /
+   WWCT 'OP*' > 0.75 AND /
+   FPR < 150 /
+/
+
+WELOPEN
+   '?' 'SHUT' /
+/
+
+ENDACTIO
+)";
+
+    Parser parser;
+    auto deck = parser.parseString(input, ParseContext());
+    const auto& kw = deck.getKeyword("ACTIONX");
+    ActionX action(kw, 0);
+
+    BOOST_CHECK_EQUAL(action.name(), "ACTION");
+    BOOST_CHECK_EQUAL(action.maxRun(), 10);
+    BOOST_CHECK_EQUAL(action.minWait(), 30 * 86400);
+    BOOST_CHECK_EQUAL(action.program().size(), 7);
+    BOOST_CHECK_EQUAL(action.size(), 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(INVALID_CONDITION) {
+    BOOST_CHECK_THROW(compile({}), std::invalid_argument);
+    BOOST_CHECK_THROW(compile({"FPR", "100"}), std::invalid_argument);
+    BOOST_CHECK_THROW(compile({"FPR", "<"}), std::invalid_argument);
+    BOOST_CHECK_THROW(compile({"(", "FPR", "<", "100"}), std::invalid_argument);
+    BOOST_CHECK_THROW(compile({"FPR", "<", "100", "AND"}), std::invalid_argument);
+    BOOST_CHECK_THROW(compile({"FPR", "<", "100", "FOPR"}), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE(EVAL_SCALAR) {
+    SummaryState st;
+    const auto sim_time = TimeMap::mkdate(2018, 7, 15);
+    st.update("FPR", 125);
+    st.update("FOPR", 1000);
+
+    BOOST_CHECK( compile({"FPR", "<", "150"}).eval(sim_time, st) );
+    BOOST_CHECK( !compile({"FPR", ".GT.", "150"}).eval(sim_time, st) );
+    BOOST_CHECK( compile({"FPR", "<", "150", "AND", "FOPR", ">=", "1000"}).eval(sim_time, st) );
+    BOOST_CHECK( compile({"FPR", ">", "150", "OR", "FOPR", "=", "1000"}).eval(sim_time, st) );
+
+    // AND binds stronger than OR
+    BOOST_CHECK( compile({"FPR", "<", "150", "OR", "FPR", ">", "150", "AND", "FOPR", ">", "2000"}).eval(sim_time, st) );
+    BOOST_CHECK( !compile({"(", "FPR", "<", "150", "OR", "FPR", ">", "150", ")", "AND", "FOPR", ">", "2000"}).eval(sim_time, st) );
+
+    BOOST_CHECK( compile({"MNTH", ">", "JUN", "AND", "YEAR", "=", "2018", "AND", "DAY", "<=", "15"}).eval(sim_time, st) );
+    BOOST_CHECK( !compile({"MNTH", ">", "JUL"}).eval(sim_time, st) );
+
+    // A quantity without value behaves like a well quantity without value.
+    BOOST_CHECK( !compile({"FGOR", ">", "100"}).eval(sim_time, st) );
+    BOOST_CHECK( !compile({"FGOR", "<", "100"}).eval(sim_time, st) );
+    BOOST_CHECK( compile({"FGOR", ">", "100", "OR", "FPR", "<", "150"}).eval(sim_time, st) );
+}
+
+
+BOOST_AUTO_TEST_CASE(SUMMARY_KEYS) {
+    const auto program = compile({"WWCT", "'OP*'", ">", "0.75", "AND", "WGOR", "OP1", ">", "GGOR", "G1",
+                                  "AND", "FPR", "<", "150", "AND", "MNTH", ">", "JUN", "AND", "GWCT", ">", "0.5"});
+    const std::vector<std::string> expected = {"WWCT", "WGOR:OP1", "GGOR:G1", "FPR", "GWCT"};
+    const auto keys = program.summaryKeys();
+    BOOST_CHECK_EQUAL_COLLECTIONS(keys.begin(), keys.end(), expected.begin(), expected.end());
+}
+
+
+BOOST_AUTO_TEST_CASE(EVAL_WELLS) {
+    SummaryState st;
+    const auto sim_time = TimeMap::mkdate(2018, 7, 15);
+    st.update("FPR", 125);
+    st.update_well_var("OP1", "WWCT", 0.80);
+    st.update_well_var("OP2", "WWCT", 0.50);
+    st.update_well_var("OP3", "WWCT", 0.90);
+    st.update_well_var("OP1", "WGOR", 200);
+    st.update_well_var("OP2", "WGOR", 300);
+    st.update_well_var("OP3", "WGOR", 100);
+    st.update_group_var("G1", "GWCT", 0.60);
+
+    {
+        const auto res = compile({"WWCT", "'OP*'", ">", "0.75"}).eval(sim_time, st);
+        const std::vector<std::string> expected = {"OP1", "OP3"};
+        BOOST_CHECK( res );
+        BOOST_CHECK_EQUAL_COLLECTIONS(res.wells.begin(), res.wells.end(), expected.begin(), expected.end());
+    }
+    {
+        const auto res = compile({"WWCT", "OP2", ">", "0.75"}).eval(sim_time, st);
+        BOOST_CHECK( !res );
+        BOOST_CHECK( res.wells.empty() );
+    }
+    {
+        const auto res = compile({"WWCT", ">", "0.75", "AND", "WGOR", "'OP*'", ">", "150"}).eval(sim_time, st);
+        const std::vector<std::string> expected = {"OP1"};
+        BOOST_CHECK( res );
+        BOOST_CHECK_EQUAL_COLLECTIONS(res.wells.begin(), res.wells.end(), expected.begin(), expected.end());
+    }
+    {
+        const auto res = compile({"WWCT", ">", "0.85", "OR", "WGOR", ">", "250"}).eval(sim_time, st);
+        const std::vector<std::string> expected = {"OP2", "OP3"};
+        BOOST_CHECK_EQUAL_COLLECTIONS(res.wells.begin(), res.wells.end(), expected.begin(), expected.end());
+    }
+    {
+        const auto res = compile({"WWCT", "'OP*'", ">", "0.75", "AND", "FPR", "<", "150"}).eval(sim_time, st);
+        const std::vector<std::string> expected = {"OP1", "OP3"};
+        BOOST_CHECK_EQUAL_COLLECTIONS(res.wells.begin(), res.wells.end(), expected.begin(), expected.end());
+    }
+    {
+        const auto res = compile({"GWCT", "G1", ">", "0.5"}).eval(sim_time, st);
+        BOOST_CHECK( res );
+        BOOST_CHECK( res.wells.empty() );
+    }
+    BOOST_CHECK( !compile({"WWCT", "'XX*'", ">", "0"}).eval(sim_time, st) );
+}
+
+
+BOOST_AUTO_TEST_CASE(ACTIONS_PENDING) {
+    const auto start = TimeMap::mkdate(2018, 1, 1);
+    const double day = 86400;
+    SummaryState st;
+    st.update("FPR", 100);
+
+    Actions actions;
+    ActionX action1("A1", 2, 10 * day, start);
+    ActionX action2("A2", 1, 0, start + 100 * day);
+    actions.add(action1);
+    actions.add(action2);
+
+    BOOST_CHECK_EQUAL(actions.pending(start).size(), 1);
+    BOOST_CHECK_EQUAL(actions.pending(start + 100 * day).size(), 2);
+
+    auto* a1 = actions.pending(start).front();
+    a1->markRun(start);
+    BOOST_CHECK(!a1->ready(start + 5 * day));
+    BOOST_CHECK(a1->ready(start + 10 * day));
+    a1->markRun(start + 10 * day);
+    BOOST_CHECK(!a1->ready(start + 100 * day));
+    BOOST_CHECK_EQUAL(actions.pending(start + 100 * day).size(), 1);
+
+    // A redefinition replaces the old action from the time it is defined.
+    actions.add(ActionX("A1", 1, 0, start + 200 * day));
+    BOOST_CHECK_EQUAL(actions.size(), 3);
+    BOOST_CHECK_EQUAL(actions.pending(start + 150 * day).size(), 1);
+    BOOST_CHECK_EQUAL(actions.pending(start + 200 * day).size(), 2);
+    BOOST_CHECK_EQUAL(actions.get("A1").startTime(), start + 200 * day);
+}
+
+
+BOOST_AUTO_TEST_CASE(SCHEDULE_ACTIONX) {
+    const std::string input = R"(
+START
+  1 'JAN' 2018 /
+
+SCHEDULE
+
+WELSPECS
+  'OP1' 'G1' 1 1 10 'OIL' /
+  'OP2' 'G1' 2 2 10 'OIL' /
+/
+
+COMPDAT
+  'OP1' 1 1 1 1 'OPEN' /
+  'OP2' 2 2 1 1 'OPEN' /
+/
+
+WCONPROD
+  'OP*' 'OPEN' 'ORAT' 1000 /
+/
+
+ACTIONX
+   'SHUT_WET' 10 /
+   WWCT 'OP*' > 0.75 /
+/
+
+WELOPEN
+   '?' 'SHUT' /
+/
+
+ENDACTIO
+
+DATES
+  1 'FEB' 2018 /
+  1 'MAR' 2018 /
+  1 'APR' 2018 /
+/
+)";
+
+    Parser parser;
+    auto deck = parser.parseString(input, ParseContext());
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Schedule schedule(deck, grid , eclipseProperties, Phases(true, true, true) , ParseContext());
+
+    const auto& actions = schedule.actions();
+    BOOST_CHECK_EQUAL(actions.size(), 1);
+    BOOST_CHECK_EQUAL(actions.get("SHUT_WET").size(), 1);
+
+    const auto* op1 = schedule.getWell("OP1");
+    const auto* op2 = schedule.getWell("OP2");
+    BOOST_CHECK_EQUAL(op1->getStatus(3), WellCommon::OPEN);
+
+    SummaryState st;
+    st.update_well_var("OP1", "WWCT", 0.50);
+    st.update_well_var("OP2", "WWCT", 0.80);
+    const auto hash = schedule.hash();
+
+    BOOST_CHECK( schedule.applyActions(1, TimeMap::mkdate(2018, 1, 15), SummaryState(), ParseContext()).empty() );
+    const auto triggered = schedule.applyActions(2, TimeMap::mkdate(2018, 2, 15), st, ParseContext());
+    BOOST_CHECK_EQUAL(triggered.size(), 1);
+    BOOST_CHECK_EQUAL(triggered[0], "SHUT_WET");
+    BOOST_CHECK(schedule.hash() != hash);
+
+    BOOST_CHECK_EQUAL(op1->getStatus(2), WellCommon::OPEN);
+    BOOST_CHECK_EQUAL(op2->getStatus(1), WellCommon::OPEN);
+    BOOST_CHECK_EQUAL(op2->getStatus(2), WellCommon::SHUT);
+    BOOST_CHECK_EQUAL(op2->getStatus(3), WellCommon::SHUT);
+}
+
+
+BOOST_AUTO_TEST_CASE(ACTIONX_ILLEGAL_KEYWORD) {
+    const std::string input = R"(
+SCHEDULE
+
+ACTIONX
+   'ACTION' /
+   FPR < 150 /
+/
+
+COMPDAT
+  'OP1' 1 1 1 1 'OPEN' /
+/
+
+ENDACTIO
+)";
+
+    Parser parser;
+    auto deck = parser.parseString(input, ParseContext());
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    ParseContext parseContext;
+
+    parseContext.update(ParseContext::ACTIONX_ILLEGAL_KEYWORD, InputError::THROW_EXCEPTION);
+    BOOST_CHECK_THROW(Schedule(deck, grid , eclipseProperties, Phases(true, true, true) , parseContext), std::invalid_argument);
+
+    parseContext.update(ParseContext::ACTIONX_ILLEGAL_KEYWORD, InputError::IGNORE);
+    Schedule schedule(deck, grid , eclipseProperties, Phases(true, true, true) , parseContext);
+    BOOST_CHECK_EQUAL(schedule.actions().get("ACTION").size(), 0);
+}
@@ -189,3 +189,20 @@ BOOST_AUTO_TEST_CASE(BoxNineArg) {
     // K2 >= Nz
     BOOST_CHECK_THROW( Opm::Box(nx,ny,nz,1,1,2,2,3,nz), std::invalid_argument);
 }
+
+
+BOOST_AUTO_TEST_CASE(BoxRows) {
+    const Opm::Box globalBox( 10, 7, 6 );
+    const Opm::Box subBox( globalBox, 2, 5, 1, 3, 4, 5 );
+
+    BOOST_CHECK_EQUAL( globalBox.numRows(), 7U * 6U );
+    BOOST_CHECK_EQUAL( subBox.numRows(), 3U * 2U );
+
+    const auto& indexList = subBox.getIndexList();
+    for (size_t row = 0; row < subBox.numRows(); row++) {
+        for (size_t i = 0; i < subBox.getDim(0); i++)
+            BOOST_CHECK_EQUAL( subBox.rowStart( row ) + i, indexList[ row * subBox.getDim(0) + i ] );
+    }
+
+    BOOST_CHECK_EQUAL( subBox.rowStart( 0 ), 2U + 1U*10U + 4U*70U );
+}
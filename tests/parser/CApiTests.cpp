@@ -0,0 +1,189 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE CApiTests
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include <opm/parser/eclipse/CApi.h>
+#include <opm/parser/eclipse/EclipseState/Grid/GridPropertyStorage.hpp>
+
+namespace {
+
+    const char* deck_data =
+        "RUNSPEC\n"
+        "OIL\n"
+        "WATER\n"
+        "DIMENS\n"
+        " 2 2 1 /\n"
+        "TABDIMS\n"
+        "/\n"
+        "WELLDIMS\n"
+        " 2 2 1 2 /\n"
+        "START\n"
+        " 1 JAN 2000 /\n"
+        "GRID\n"
+        "DX\n"
+        " 4*100 /\n"
+        "DY\n"
+        " 4*100 /\n"
+        "DZ\n"
+        " 4*10 /\n"
+        "TOPS\n"
+        " 4*1000 /\n"
+        "ACTNUM\n"
+        " 1 0 1 1 /\n"
+        "PORO\n"
+        " 4*0.25 /\n"
+        "PROPS\n"
+        "SWOF\n"
+        " 0.1 0.0 1.0 0.0\n"
+        " 1.0 1.0 0.0 0.0 /\n"
+        "SCHEDULE\n"
+        "WELSPECS\n"
+        " 'P1' 'G' 2 1 1* 'OIL' /\n"
+        "/\n"
+        "COMPDAT\n"
+        " 'P1' 2 1 1 1 'OPEN' /\n"
+        "/\n"
+        "DATES\n"
+        " 1 FEB 2000 /\n"
+        "/\n";
+
+}
+
+
+BOOST_AUTO_TEST_CASE(Handles) {
+    BOOST_CHECK_EQUAL( opm_api_version(), OPM_C_API_VERSION );
+
+    opm_parser* parser = opm_parser_alloc();
+    BOOST_REQUIRE( parser );
+
+    BOOST_CHECK( !opm_parser_parse_file( parser, "/does/not/exist.DATA" ) );
+    BOOST_CHECK( std::string( opm_last_error() ).size() > 0 );
+    BOOST_CHECK( !opm_parser_parse_string( parser, nullptr ) );
+
+    opm_deck* deck = opm_parser_parse_string( parser, deck_data );
+    BOOST_REQUIRE( deck );
+    BOOST_CHECK( opm_deck_size( deck ) > 0 );
+
+    opm_eclipse_state* state = opm_eclipse_state_alloc( deck );
+    BOOST_REQUIRE( state );
+
+    int dims[3];
+    BOOST_CHECK_EQUAL( opm_eclipse_state_grid_dims( state, dims ), 0 );
+    BOOST_CHECK_EQUAL( dims[0], 2 );
+    BOOST_CHECK_EQUAL( dims[1], 2 );
+    BOOST_CHECK_EQUAL( dims[2], 1 );
+
+    opm_array_view view;
+    BOOST_CHECK_EQUAL( opm_eclipse_state_double_property( state, "PORO", &view ), 0 );
+    BOOST_CHECK_EQUAL( view.dtype, OPM_DTYPE_FLOAT64 );
+    BOOST_CHECK_EQUAL( view.size, 4U );
+    BOOST_CHECK_EQUAL( static_cast< const double* >( view.data )[0], 0.25 );
+
+    // The view is borrowed; asking again gives the same memory.
+    opm_array_view poro2;
+    opm_eclipse_state_double_property( state, "PORO", &poro2 );
+    BOOST_CHECK_EQUAL( poro2.data, view.data );
+
+    BOOST_CHECK_EQUAL( opm_eclipse_state_int_property( state, "SATNUM", &view ), 0 );
+    BOOST_CHECK_EQUAL( view.dtype, OPM_DTYPE_INT32 );
+    BOOST_CHECK_EQUAL( static_cast< const int* >( view.data )[3], 1 );
+    BOOST_CHECK( opm_eclipse_state_int_property( state, "NO_SUCH_KW", &view ) != 0 );
+
+    BOOST_CHECK_EQUAL( opm_eclipse_state_active_map( state, &view ), 0 );
+    BOOST_CHECK_EQUAL( view.size, 3U );
+    const int* active_map = static_cast< const int* >( view.data );
+    BOOST_CHECK_EQUAL( active_map[0], 0 );
+    BOOST_CHECK_EQUAL( active_map[1], 2 );
+    BOOST_CHECK_EQUAL( active_map[2], 3 );
+
+    BOOST_CHECK_EQUAL( opm_eclipse_state_table_column( state, "SWOF", 0, "SW", &view ), 0 );
+    BOOST_CHECK_EQUAL( view.size, 2U );
+    BOOST_CHECK_EQUAL( static_cast< const double* >( view.data )[1], 1.0 );
+    BOOST_CHECK( opm_eclipse_state_table_column( state, "SWOF", 5, "SW", &view ) != 0 );
+
+    opm_schedule* schedule = opm_schedule_alloc( deck, state );
+    BOOST_REQUIRE( schedule );
+    BOOST_CHECK_EQUAL( opm_schedule_num_steps( schedule ), 2U );
+
+    const opm_well_snapshot* wells;
+    size_t num_wells;
+    BOOST_CHECK_EQUAL( opm_schedule_wells( schedule, 1, &wells, &num_wells ), 0 );
+    BOOST_CHECK_EQUAL( num_wells, 1U );
+    BOOST_CHECK_EQUAL( std::string( wells[0].name ), "P1" );
+    BOOST_CHECK_EQUAL( wells[0].head_i, 1 );
+    BOOST_CHECK_EQUAL( wells[0].head_j, 0 );
+    BOOST_CHECK( !std::isnan( wells[0].ref_depth ) );
+
+    const opm_well_snapshot* wells2;
+    opm_schedule_wells( schedule, 1, &wells2, &num_wells );
+    BOOST_CHECK_EQUAL( wells2, wells );
+    BOOST_CHECK( opm_schedule_wells( schedule, 10, &wells, &num_wells ) != 0 );
+
+    opm_schedule_free( schedule );
+    opm_eclipse_state_free( state );
+    opm_deck_free( deck );
+    opm_parser_free( parser );
+}
+
+
+/*
+  With spilling enabled a view must stay valid while another state is
+  built, and also across an explicit trim by the host.
+*/
+BOOST_AUTO_TEST_CASE(ViewsSurviveSpilling) {
+    auto& storage = Opm::GridPropertyStorage::instance();
+    storage.configure( boost::filesystem::temp_directory_path().string(), 1 );
+
+    opm_parser* parser = opm_parser_alloc();
+    opm_deck* deck = opm_parser_parse_string( parser, deck_data );
+    BOOST_REQUIRE( deck );
+
+    opm_eclipse_state* state1 = opm_eclipse_state_alloc( deck );
+    BOOST_REQUIRE( state1 );
+
+    opm_array_view poro;
+    BOOST_REQUIRE_EQUAL( opm_eclipse_state_double_property( state1, "PORO", &poro ), 0 );
+    const auto* data = static_cast< const double* >( poro.data );
+    const std::vector< double > expected( data, data + poro.size );
+
+    opm_eclipse_state* state2 = opm_eclipse_state_alloc( deck );
+    BOOST_REQUIRE( state2 );
+    storage.trim();
+
+    opm_array_view again;
+    BOOST_REQUIRE_EQUAL( opm_eclipse_state_double_property( state1, "PORO", &again ), 0 );
+    BOOST_CHECK_EQUAL( again.data, poro.data );
+    BOOST_CHECK_EQUAL_COLLECTIONS( data, data + poro.size, expected.begin(), expected.end() );
+
+    opm_eclipse_state_free( state2 );
+    opm_eclipse_state_free( state1 );
+    opm_deck_free( deck );
+    opm_parser_free( parser );
+
+    BOOST_CHECK_EQUAL( storage.residentBytes(), 0U );
+    storage.configure( "", 0 );
+}
@@ -28,7 +28,9 @@
 #include <opm/parser/eclipse/Deck/DeckOutput.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
@@ -709,3 +711,61 @@ BOOST_AUTO_TEST_CASE(DeckItemEqual) {
     BOOST_CHECK( item3.equal( item5 , false, true ));
     BOOST_CHECK( !item3.equal( item5 , false, false ));
 }
+
+
+BOOST_AUTO_TEST_CASE(DeckKeywordHash) {
+    auto make_keyword = []( const std::string& name, int value ) {
+        DeckKeyword kw( name );
+        DeckItem item( "ITEM", int() );
+        item.push_back( value );
+        kw.addRecord( DeckRecord( { item } ) );
+        return kw;
+    };
+
+    const auto kw1 = make_keyword( "KW", 1 );
+    const auto kw2 = make_keyword( "KW", 1 );
+    const auto kw3 = make_keyword( "KW", 2 );
+    const auto kw4 = make_keyword( "XX", 1 );
+
+    BOOST_CHECK_EQUAL( kw1.hash(), kw2.hash() );
+    BOOST_CHECK( kw1.hash() != kw3.hash() );
+    BOOST_CHECK( kw1.hash() != kw4.hash() );
+
+    auto kw5 = make_keyword( "KW", 1 );
+    const auto h5 = kw5.hash();
+    kw5.addRecord( DeckRecord( { DeckItem( "ITEM", int() ) } ) );
+    BOOST_CHECK( h5 != kw5.hash() );
+
+    Deck deck1( { kw1, kw3 } );
+    Deck deck2( { kw2, kw3 } );
+    Deck deck3( { kw3, kw1 } );
+    BOOST_CHECK_EQUAL( deck1.hash(), deck2.hash() );
+    BOOST_CHECK( deck1.hash() != deck3.hash() );
+}
+
+
+BOOST_AUTO_TEST_CASE(SectionContentHash) {
+    const std::string base = R"(
+RUNSPEC
+DIMENS
+ 10 10 10 /
+TABDIMS
+/
+GRID
+DX
+ 1000*0.25 /
+PROPS
+)";
+
+    Parser parser;
+    const auto deck1 = parser.parseString( base + "SWOF\n 0.1 0 1 0\n 1.0 1 0 0 /\n", ParseContext() );
+    const auto deck2 = parser.parseString( base + "SWOF\n 0.2 0 1 0\n 1.0 1 0 0 /\n", ParseContext() );
+
+    BOOST_CHECK_EQUAL( Section::contentHash( deck1, { "RUNSPEC", "GRID" } ),
+                       Section::contentHash( deck2, { "RUNSPEC", "GRID" } ) );
+
+    BOOST_CHECK( Section::contentHash( deck1, { "RUNSPEC", "GRID", "PROPS" } ) !=
+                 Section::contentHash( deck2, { "RUNSPEC", "GRID", "PROPS" } ) );
+
+    BOOST_CHECK( deck1.hash() != deck2.hash() );
+}
@@ -273,3 +273,41 @@ BOOST_AUTO_TEST_CASE( update_elm ) {
     BOOST_CHECK_EQUAL( state[3],90  );
     BOOST_CHECK_EQUAL( state[4],139 );
 }
+
+
+BOOST_AUTO_TEST_CASE( update_sequence ) {
+    const std::time_t startDate = Opm::TimeMap::mkdate(2010, 1, 1);
+    Opm::TimeMap timeMap{ startDate };
+    for (size_t i = 0; i < 10; i++)
+        timeMap.addTStep((i+1) * 24 * 60 * 60);
+
+    Opm::DynamicState<int> state(timeMap , 137);
+
+    for (size_t i = 1; i < 10; i++)
+        BOOST_CHECK( state.update( i , 100 + i ) );
+
+    BOOST_CHECK_EQUAL( state[0] , 137 );
+    BOOST_CHECK_EQUAL( state[5] , 105 );
+    BOOST_CHECK_EQUAL( state[9] , 109 );
+    BOOST_CHECK_EQUAL( state[10] , 109 );
+    BOOST_CHECK_EQUAL( state.back() , 109 );
+    BOOST_CHECK_EQUAL( state.find( 109 ) , 9 );
+    BOOST_CHECK_EQUAL( false , state.update( 10 , 109 ));
+
+    state.update( 3 , 50 );
+    BOOST_CHECK_EQUAL( state[2] , 102 );
+    BOOST_CHECK_EQUAL( state[3] , 50 );
+    BOOST_CHECK_EQUAL( state[10] , 50 );
+    BOOST_CHECK_EQUAL( state.find( 105 ) , -1 );
+
+    state.update_elm( 5 , 77 );
+    BOOST_CHECK_EQUAL( state[4] , 50 );
+    BOOST_CHECK_EQUAL( state[5] , 77 );
+    BOOST_CHECK_EQUAL( state[6] , 50 );
+    BOOST_CHECK_EQUAL( state[10] , 50 );
+
+    state.update( 8 , 60 );
+    BOOST_CHECK_EQUAL( state[5] , 77 );
+    BOOST_CHECK_EQUAL( state[7] , 50 );
+    BOOST_CHECK_EQUAL( state[10] , 60 );
+}
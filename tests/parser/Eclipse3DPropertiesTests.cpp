@@ -295,6 +295,28 @@ BOOST_AUTO_TEST_CASE(SupportsProperty) {
 
 }
 
+BOOST_AUTO_TEST_CASE(ReadDefaultedPropertyDoesNotCreate) {
+    Setup s(createDeck());
+    const auto& double_props = s.props.getDoubleProperties();
+    const auto& int_props = s.props.getIntProperties();
+
+    const auto& poro = s.props.getDoubleGridProperty("PORO");
+    BOOST_CHECK_EQUAL(poro.getData().size(), 1000U);
+    BOOST_CHECK(!double_props.hasKeyword("PORO"));
+
+    const auto& ntg = s.props.getDoubleGridProperty("NTG");
+    BOOST_CHECK_EQUAL(ntg.getData()[0], 1.0);
+    BOOST_CHECK(!double_props.hasKeyword("NTG"));
+
+    const auto& eqlnum = s.props.getIntGridProperty("EQLNUM");
+    BOOST_CHECK_EQUAL(eqlnum.getData()[0], 1);
+    BOOST_CHECK(!int_props.hasKeyword("EQLNUM"));
+    BOOST_CHECK(!s.props.hasDeckIntGridProperty("EQLNUM"));
+
+    BOOST_CHECK(int_props.hasKeyword("SATNUM"));
+    BOOST_CHECK_EQUAL(&s.props.getIntGridProperty("SATNUM"), &int_props.getKeyword("SATNUM"));
+}
+
 BOOST_AUTO_TEST_CASE(DefaultRegionFluxnum) {
     Setup s(createDeck());
     BOOST_CHECK_EQUAL(s.props.getDefaultRegionKeyword(), "FLUXNUM");
@@ -700,3 +722,192 @@ BOOST_AUTO_TEST_CASE(DefaultedBoxFailMultiply) {
     // PORO has not been defined
     BOOST_CHECK_THROW( const Setup s(createMultiplyPorvFailDeck()), std::logic_error);
 }
+
+
+static Opm::Deck createCopyBoxDeck() {
+    const auto* input = R"(
+RUNSPEC
+
+DIMENS
+  4 4 3 /
+
+GRID
+
+DX
+  48*10
+/
+
+DY
+  48*10
+/
+
+DZ
+  48*10
+/
+
+TOPS
+  16*1000.0
+/
+
+PERMX
+  48*100
+/
+
+EQUALS
+  PERMX 50  1 2  1 2  1 1 /
+  PERMX 75  1 2  1 2  2 2 /
+/
+
+COPYBOX
+  PERMX  1 2  1 2  1 2    3 4  3 4  2 3 /
+/
+
+-- Overlapping source and target
+EQUALS
+  MULTX 2  1 1  1 4  1 3 /
+/
+
+COPYBOX
+  MULTX  1 3  1 4  1 3    2 4  1 4  1 3 /
+/
+)";
+
+    Opm::Parser parser;
+    return parser.parseString(input, Opm::ParseContext() );
+}
+
+
+BOOST_AUTO_TEST_CASE(COPYBOX) {
+    const Setup s(createCopyBoxDeck());
+    const auto& permx = s.props.getDoubleGridProperty("PERMX");
+    const auto& multx = s.props.getDoubleGridProperty("MULTX");
+
+    BOOST_CHECK_CLOSE( permx.iget(2,2,1), 50 * Opm::Metric::Permeability, 1e-5 );
+    BOOST_CHECK_CLOSE( permx.iget(3,3,1), 50 * Opm::Metric::Permeability, 1e-5 );
+    BOOST_CHECK_CLOSE( permx.iget(2,3,2), 75 * Opm::Metric::Permeability, 1e-5 );
+    BOOST_CHECK_CLOSE( permx.iget(2,2,0), 100 * Opm::Metric::Permeability, 1e-5 );
+    BOOST_CHECK_CLOSE( permx.iget(1,1,0), 50 * Opm::Metric::Permeability, 1e-5 );
+
+    for (size_t k = 0; k < 3; k++) {
+        for (size_t j = 0; j < 4; j++) {
+            BOOST_CHECK_EQUAL( multx.iget(0,j,k), 2 );
+            BOOST_CHECK_EQUAL( multx.iget(1,j,k), 2 );
+            BOOST_CHECK_EQUAL( multx.iget(2,j,k), 1 );
+            BOOST_CHECK_EQUAL( multx.iget(3,j,k), 1 );
+        }
+    }
+}
+
+
+static Opm::Deck createCopyBoxShapeDeck() {
+    const auto* input = R"(
+RUNSPEC
+
+DIMENS
+  4 4 3 /
+
+GRID
+
+DX
+  48*10
+/
+
+DY
+  48*10
+/
+
+DZ
+  48*10
+/
+
+TOPS
+  16*1000.0
+/
+
+PERMX
+  48*100
+/
+
+COPYBOX
+  PERMX  1 2  1 2  1 2    3 4  3 4  2 2 /
+/
+)";
+
+    Opm::Parser parser;
+    return parser.parseString(input, Opm::ParseContext() );
+}
+
+
+BOOST_AUTO_TEST_CASE(COPYBOX_ShapeMismatch) {
+    BOOST_CHECK_THROW( const Setup s(createCopyBoxShapeDeck()), std::invalid_argument );
+}
+
+
+static Opm::Deck createOperateRDeck() {
+    const auto* input = R"(
+RUNSPEC
+
+DIMENS
+  4 4 3 /
+
+GRID
+
+DX
+  48*10
+/
+
+DY
+  48*10
+/
+
+DZ
+  48*10
+/
+
+TOPS
+  16*1000.0
+/
+
+PORO
+  48*0.25
+/
+
+OPERNUM
+  16*1 16*2 16*3
+/
+
+EDIT
+
+OPERATER
+  PORO     2  MULTX  PORO     2.0 /
+  NTG      3  ADDX   PORO     0.1 /
+  NTG      4  ADDX   PORO     0.1 /
+  OPERNUM  1  ADDX   OPERNUM  10  /
+  PORO    11  MULTX  PORO     3.0 /
+/
+)";
+
+    Opm::Parser parser;
+    return parser.parseString(input, Opm::ParseContext() );
+}
+
+
+BOOST_AUTO_TEST_CASE(OPERATER) {
+    const Setup s(createOperateRDeck());
+    const auto& poro = s.props.getDoubleGridProperty("PORO");
+    const auto& ntg = s.props.getDoubleGridProperty("NTG");
+    const auto& opernum = s.props.getIntGridProperty("OPERNUM");
+
+    for (size_t j = 0; j < 4; j++) {
+        for (size_t i = 0; i < 4; i++) {
+            BOOST_CHECK_CLOSE( poro.iget(i,j,0), 0.75, 1e-8 );
+            BOOST_CHECK_CLOSE( poro.iget(i,j,1), 0.50, 1e-8 );
+            BOOST_CHECK_CLOSE( poro.iget(i,j,2), 0.25, 1e-8 );
+
+            BOOST_CHECK_CLOSE( ntg.iget(i,j,0), 1.0, 1e-8 );
+            BOOST_CHECK_CLOSE( ntg.iget(i,j,2), 0.35, 1e-8 );
+
+            BOOST_CHECK_EQUAL( opernum.iget(i,j,0), 11 );
+        }
+    }
+}
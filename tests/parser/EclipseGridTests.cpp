@@ -32,6 +32,7 @@
 #include <opm/parser/eclipse/Deck/Section.hpp>
 
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
+#include <opm/parser/eclipse/Units/Units.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
@@ -1396,3 +1397,251 @@ BOOST_AUTO_TEST_CASE(CoordMapper) {
 
     BOOST_CHECK_EQUAL( cmp.index(10,7,2,1) + 1 , cmp.size( ));
 }
+
+
+static Opm::Deck createLGRDeck() {
+    const char* deckData =
+        "RUNSPEC\n"
+        "\n"
+        "DIMENS\n"
+        " 4 4 3 /\n"
+        "GRID\n"
+        "DX\n"
+        "48*100 /\n"
+        "DY\n"
+        "48*50 /\n"
+        "DZ\n"
+        "48*10 /\n"
+        "TOPS\n"
+        "16*1000 /\n"
+        "PORO\n"
+        "48*0.25 /\n"
+        "PERMX\n"
+        "48*100 /\n"
+        "CARFIN\n"
+        "'LGR1'  2  3  2  3  1  2  4  6  3 /\n"
+        "EQUALS\n"
+        "  PERMX 500 1 2 1 6 1 1 /\n"
+        "/\n"
+        "MULTIPLY\n"
+        "  PORO 2 /\n"
+        "/\n"
+        "ENDFIN\n"
+        "CARFIN\n"
+        "'LGR2'  4  4  4  4  3  3  3  3  1 /\n"
+        "ENDFIN\n"
+        "EDIT\n"
+        "REFINE\n"
+        "  'LGR2' /\n"
+        "EQUALS\n"
+        "  PORO 0.10 /\n"
+        "/\n"
+        "ENDFIN\n"
+        "\n";
+
+    Opm::Parser parser;
+    return parser.parseString( deckData, Opm::ParseContext() );
+}
+
+
+BOOST_AUTO_TEST_CASE(LGR_Geometry) {
+    auto deck = createLGRDeck();
+    Opm::EclipseGrid grid( deck );
+
+    BOOST_CHECK_EQUAL( grid.numLGR(), 2U );
+    BOOST_CHECK( grid.hasLGR( "LGR1" ));
+    BOOST_CHECK( !grid.hasLGR( "LGR3" ));
+    BOOST_CHECK_THROW( grid.getLGR( "LGR3" ), std::invalid_argument );
+    BOOST_CHECK_THROW( grid.getLGR( 0 ), std::invalid_argument );
+
+    const auto& lgr1 = grid.getLGR( "LGR1" );
+    BOOST_CHECK_EQUAL( lgr1.lgrNumber(), 1U );
+    BOOST_CHECK_EQUAL( lgr1.parent(), "GLOBAL" );
+    BOOST_CHECK_EQUAL( lgr1.getNX(), 4U );
+    BOOST_CHECK_EQUAL( lgr1.getNY(), 6U );
+    BOOST_CHECK_EQUAL( lgr1.getNZ(), 3U );
+
+    const auto& lgr_grid = lgr1.grid();
+    BOOST_CHECK_EQUAL( lgr_grid.getCartesianSize(), 72U );
+
+    /*
+      Two host cells in each direction; split in 2 x 3 x 2 for the
+      first layer of host cells and 2 x 3 x 1 for the second layer.
+    */
+    {
+        const auto dims = lgr_grid.getCellDims( 0, 0, 0 );
+        BOOST_CHECK_CLOSE( dims[0], 50.0, 1e-6 );
+        BOOST_CHECK_CLOSE( dims[1], 50.0 / 3, 1e-6 );
+        BOOST_CHECK_CLOSE( dims[2], 5.0, 1e-6 );
+    }
+
+    /* The refined cells fill the host box exactly. */
+    {
+        double volume = 0;
+        for (size_t g = 0; g < lgr_grid.getCartesianSize(); g++)
+            volume += lgr_grid.getCellVolume( g );
+
+        double host_volume = 0;
+        for (auto host : lgr1.hostBox())
+            host_volume += grid.getCellVolume( host );
+
+        BOOST_CHECK_CLOSE( volume, host_volume, 1e-6 );
+    }
+
+    {
+        const auto center = lgr_grid.getCellCenter( 0, 0, 0 );
+        BOOST_CHECK_CLOSE( center[0], 125.0, 1e-6 );
+        BOOST_CHECK_CLOSE( center[2], 1002.5, 1e-6 );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(LGR_HostMapping) {
+    auto deck = createLGRDeck();
+    Opm::EclipseGrid grid( deck );
+    const auto& lgr1 = grid.getLGR( 1 );
+
+    BOOST_CHECK_EQUAL( lgr1.getHostCell( lgr1.getGlobalIndex( 0, 0, 0 )), grid.getGlobalIndex( 1, 1, 0 ));
+    BOOST_CHECK_EQUAL( lgr1.getHostCell( lgr1.getGlobalIndex( 3, 5, 2 )), grid.getGlobalIndex( 2, 2, 1 ));
+    BOOST_CHECK_EQUAL( lgr1.getHostCell( lgr1.getGlobalIndex( 2, 2, 1 )), grid.getGlobalIndex( 2, 1, 0 ));
+
+    BOOST_CHECK( lgr1.isHost( grid.getGlobalIndex( 1, 1, 0 )));
+    BOOST_CHECK( !lgr1.isHost( grid.getGlobalIndex( 0, 0, 0 )));
+
+    size_t children = 0;
+    for (auto host : lgr1.hostBox())
+        children += lgr1.getChildCells( host ).size();
+    BOOST_CHECK_EQUAL( children, lgr1.getCartesianSize() );
+    BOOST_CHECK( lgr1.getChildCells( grid.getGlobalIndex( 0, 0, 0 )).empty() );
+    BOOST_CHECK_EQUAL( lgr1.getChildCells( grid.getGlobalIndex( 1, 1, 0 )).size(), 12U );
+}
+
+
+BOOST_AUTO_TEST_CASE(LGR_HierarchicalIndex) {
+    auto deck = createLGRDeck();
+    Opm::EclipseGrid grid( deck );
+    const auto& lgr1 = grid.getLGR( "LGR1" );
+    const auto& lgr2 = grid.getLGR( "LGR2" );
+
+    BOOST_CHECK_EQUAL( lgr1.offset(), 48U );
+    BOOST_CHECK_EQUAL( lgr2.offset(), 48U + 72U );
+    BOOST_CHECK_EQUAL( grid.getTotalSize(), 48U + 72U + 9U );
+
+    BOOST_CHECK_EQUAL( grid.getHierarchicalIndex( 0, 17 ), 17U );
+    BOOST_CHECK_EQUAL( grid.getHierarchicalIndex( 2, 4 ), 124U );
+    BOOST_CHECK_EQUAL( lgr2.getHierarchicalIndex( 1, 1, 0 ), 124U );
+    BOOST_CHECK_THROW( grid.getHierarchicalIndex( 3, 0 ), std::invalid_argument );
+    BOOST_CHECK_THROW( grid.getHierarchicalIndex( 2, 9 ), std::invalid_argument );
+
+    {
+        const auto index = grid.getGridIndex( 124 );
+        BOOST_CHECK_EQUAL( index.first, 2U );
+        BOOST_CHECK_EQUAL( index.second, 4U );
+    }
+    {
+        const auto index = grid.getGridIndex( 47 );
+        BOOST_CHECK_EQUAL( index.first, 0U );
+        BOOST_CHECK_EQUAL( index.second, 47U );
+    }
+    BOOST_CHECK_THROW( grid.getGridIndex( grid.getTotalSize() ), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE(LGR_Properties) {
+    auto deck = createLGRDeck();
+    Opm::EclipseState es( deck, Opm::ParseContext() );
+    const auto& grid = es.getInputGrid();
+    const auto& props = es.get3DProperties();
+    const auto& lgr1 = grid.getLGR( "LGR1" );
+    const auto& lgr2 = grid.getLGR( "LGR2" );
+
+    /* The keywords in the LGR blocks do not modify the main grid. */
+    for (double poro : props.getDoubleGridProperty( "PORO" ).getData())
+        BOOST_CHECK_CLOSE( poro, 0.25, 1e-6 );
+
+    const auto& permx = props.getDoubleGridProperty( "PERMX" ).getData();
+    for (double perm : permx)
+        BOOST_CHECK_CLOSE( perm, 100 * Opm::Metric::Permeability, 1e-6 );
+
+    {
+        const auto& poro = props.getDoubleGridProperty( "PORO" ).getData();
+        const auto lgr_poro = lgr1.property( "PORO", poro );
+        for (double value : lgr_poro)
+            BOOST_CHECK_CLOSE( value, 0.50, 1e-6 );
+
+        const auto lgr2_poro = lgr2.property( "PORO", poro );
+        BOOST_CHECK_EQUAL( lgr2_poro.size(), 9U );
+        for (double value : lgr2_poro)
+            BOOST_CHECK_CLOSE( value, 0.10, 1e-6 );
+    }
+
+    {
+        const auto lgr_permx = lgr1.property( "PERMX", permx, Opm::Metric::Permeability );
+        BOOST_CHECK_CLOSE( lgr_permx[ lgr1.getGlobalIndex( 0, 0, 0 ) ], 500 * Opm::Metric::Permeability, 1e-6 );
+        BOOST_CHECK_CLOSE( lgr_permx[ lgr1.getGlobalIndex( 1, 5, 0 ) ], 500 * Opm::Metric::Permeability, 1e-6 );
+        BOOST_CHECK_CLOSE( lgr_permx[ lgr1.getGlobalIndex( 2, 0, 0 ) ], 100 * Opm::Metric::Permeability, 1e-6 );
+        BOOST_CHECK_CLOSE( lgr_permx[ lgr1.getGlobalIndex( 0, 0, 1 ) ], 100 * Opm::Metric::Permeability, 1e-6 );
+    }
+
+    {
+        const auto refined = lgr1.refine( std::vector<int>( grid.getCartesianSize(), 7 ));
+        BOOST_CHECK_EQUAL( refined.size(), lgr1.getCartesianSize() );
+        BOOST_CHECK_EQUAL( refined[0], 7 );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(LGR_MissingENDFIN_throws) {
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 4 4 3 /\n"
+        "GRID\n"
+        "DX\n"
+        "48*100 /\n"
+        "DY\n"
+        "48*50 /\n"
+        "DZ\n"
+        "48*10 /\n"
+        "TOPS\n"
+        "16*1000 /\n"
+        "CARFIN\n"
+        "'LGR1'  2  3  2  3  1  2  4  6  3 /\n"
+        "\n";
+
+    auto deck = Opm::Parser().parseString( deckData, Opm::ParseContext() );
+    BOOST_CHECK_THROW( Opm::EclipseGrid{ deck }, std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE(LGR_ACTNUM_does_not_modify_main_grid) {
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 2 2 1 /\n"
+        "GRID\n"
+        "DX\n"
+        "4*100 /\n"
+        "DY\n"
+        "4*50 /\n"
+        "DZ\n"
+        "4*10 /\n"
+        "TOPS\n"
+        "4*1000 /\n"
+        "ACTNUM\n"
+        "0 1 1 1 /\n"
+        "CARFIN\n"
+        "'LGR1'  2  2  2  2  1  1  2  2  1 /\n"
+        "ACTNUM\n"
+        "4*1 /\n"
+        "ENDFIN\n"
+        "\n";
+
+    auto deck = Opm::Parser().parseString( deckData, Opm::ParseContext() );
+    Opm::EclipseGrid grid( deck );
+
+    BOOST_CHECK_EQUAL( grid.getNumActive(), 3U );
+    BOOST_CHECK( !grid.cellActive( 0 ));
+    BOOST_CHECK( grid.cellActive( 3 ));
+    BOOST_CHECK_EQUAL( grid.getLGR( "LGR1" ).getCartesianSize(), 4U );
+}
@@ -37,6 +37,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridPropertyStorage.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 
 static const Opm::DeckKeyword createSATNUMKeyword( ) {
@@ -555,3 +556,115 @@ BOOST_AUTO_TEST_CASE(hasKeyword_assertKeyword) {
 
     BOOST_CHECK_THROW( gridProperties.getKeyword( "NOT-SUPPORTED" ), std::invalid_argument );
 }
+
+
+BOOST_AUTO_TEST_CASE(getDefaultedKeyword) {
+    typedef Opm::GridProperties<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    std::vector<SupportedKeywordInfo> supportedKeywords = {
+        SupportedKeywordInfo("SATNUM" , 3, "1", true),
+        SupportedKeywordInfo("IMBNUM" , 0, "1", false)
+    };
+    const Opm::EclipseGrid grid(10, 7, 9);
+    const Opm::GridProperties<int> gridProperties( grid, std::move( supportedKeywords ) );
+
+    // getDefaultedKeyword() returns the default values without creating the keyword
+    const auto& satnum = gridProperties.getDefaultedKeyword("SATNUM");
+    BOOST_CHECK_EQUAL( satnum.getData().size(), 10U * 7 * 9 );
+    BOOST_CHECK_EQUAL( satnum.getData()[0], 3 );
+    BOOST_CHECK(!gridProperties.hasKeyword("SATNUM"));
+    BOOST_CHECK_EQUAL( gridProperties.size(), 0U );
+
+    const auto& fipxyz = gridProperties.getDefaultedKeyword("FIPXYZ");
+    BOOST_CHECK_EQUAL( fipxyz.getData()[0], 1 );
+    BOOST_CHECK(!gridProperties.hasKeyword("FIPXYZ"));
+
+    const auto& imbnum = gridProperties.getDefaultedKeyword("IMBNUM");
+    BOOST_CHECK_EQUAL( imbnum.getData()[0], 0 );
+    BOOST_CHECK(!gridProperties.hasKeyword("IMBNUM"));
+    BOOST_CHECK_THROW( gridProperties.getDefaultedKeyword( "NOT-SUPPORTED" ), std::invalid_argument );
+
+    // an existing keyword is returned as is
+    gridProperties.getKeyword("SATNUM");
+    BOOST_CHECK_EQUAL( &gridProperties.getDefaultedKeyword("SATNUM"), &gridProperties.getKeyword("SATNUM") );
+}
+
+
+BOOST_AUTO_TEST_CASE(SpillToScratch) {
+    typedef Opm::GridProperty<double>::SupportedKeywordInfo SupportedKeywordInfo;
+    SupportedKeywordInfo keywordInfo("PORO" , 0.0 , "1");
+    const size_t bytes = 10 * 10 * 10 * sizeof(double);
+    auto& storage = Opm::GridPropertyStorage::instance();
+    storage.configure( boost::filesystem::temp_directory_path().string(), 2 * bytes );
+
+    {
+        Opm::GridProperty<double> p1( 10, 10, 10, keywordInfo );
+        Opm::GridProperty<double> p2( 10, 10, 10, keywordInfo );
+        Opm::GridProperty<double> p3( 10, 10, 10, keywordInfo );
+
+        for (size_t g = 0; g < 1000; g++) {
+            p1.iset( g, g );
+            p2.iset( g, 2.0 * g );
+            p3.iset( g, 3.0 * g );
+        }
+
+        p1.getData();
+        p2.getData();
+        p3.getData();
+        BOOST_CHECK_EQUAL( storage.residentBytes(), 3 * bytes );
+
+        storage.trim();
+        BOOST_CHECK_EQUAL( storage.residentBytes(), 2 * bytes );
+        BOOST_CHECK_EQUAL( storage.spilledBytes(), bytes );
+        BOOST_CHECK_EQUAL( p1.getCartesianSize(), 1000U );
+
+        /* Reading the least recently used property brings it back. */
+        BOOST_CHECK_EQUAL( p1.iget( 999 ), 999.0 );
+        BOOST_CHECK_EQUAL( p1.getData().size(), 1000U );
+        BOOST_CHECK_EQUAL( storage.spilledBytes(), 0U );
+
+        /* Pinned properties are never spilled. */
+        p3.pin();
+        storage.trim();
+        BOOST_CHECK_EQUAL( storage.spilledBytes(), bytes );
+        BOOST_CHECK_EQUAL( p3.iget( 10 ), 30.0 );
+
+        /* A copy of a spilled property shares the scratch data. */
+        Opm::GridProperty<double> copy( p2 );
+        BOOST_CHECK_EQUAL( copy.iget( 10 ), 20.0 );
+        BOOST_CHECK_EQUAL( p2.getData()[10], 20.0 );
+
+        p3.unpin();
+        BOOST_CHECK_THROW( p3.unpin(), std::logic_error );
+    }
+
+    BOOST_CHECK_EQUAL( storage.residentBytes(), 0U );
+    storage.configure( "", 0 );
+    BOOST_CHECK( !storage.enabled() );
+}
+
+
+BOOST_AUTO_TEST_CASE(SpillOnlyOwners) {
+    typedef Opm::GridProperty<double>::SupportedKeywordInfo SupportedKeywordInfo;
+    SupportedKeywordInfo keywordInfo("PORO" , 0.0 , "1");
+    const size_t bytes = 10 * 10 * 10 * sizeof(double);
+    auto& storage = Opm::GridPropertyStorage::instance();
+    storage.configure( boost::filesystem::temp_directory_path().string(), bytes );
+
+    {
+        Opm::GridProperty<double> p1( 10, 10, 10, keywordInfo );
+        Opm::GridProperty<double> p2( 10, 10, 10, keywordInfo );
+        Opm::GridProperty<double> p3( 10, 10, 10, keywordInfo );
+
+        const auto* p1_data = p1.getData().data();
+        p2.getData();
+        p3.getData();
+
+        /* p1 is the least recently used, but it is not in the owners. */
+        storage.trim( { &p2, &p3 } );
+        BOOST_CHECK_EQUAL( storage.spilledBytes(), 2 * bytes );
+        BOOST_CHECK_EQUAL( storage.residentBytes(), bytes );
+        BOOST_CHECK_EQUAL( p1.getData().data(), p1_data );
+    }
+
+    storage.configure( "", 0 );
+}
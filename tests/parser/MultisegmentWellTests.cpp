@@ -32,6 +32,7 @@
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Completion.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/CompletionSet.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
@@ -121,3 +122,132 @@ BOOST_AUTO_TEST_CASE(MultisegmentWellTest) {
     BOOST_CHECK_EQUAL(center_depth_completion7, 2534.5);
 }
 
+
+
+namespace {
+
+    Opm::CompletionSet horizontalCompletions() {
+        Opm::CompletionSet completion_set;
+        for (int i = 0; i < 6; ++i)
+            completion_set.add(Opm::Completion( i, 0, 0, 1, 2000.0 + i, Opm::WellCompletion::OPEN , Opm::Value<double>("ConnectionTransmissibilityFactor", 200.), Opm::Value<double>("D", 0.5), Opm::Value<double>("SKIN", 0.), 0,  Opm::WellCompletion::DirectionEnum::X) );
+
+        return completion_set;
+    }
+
+    const std::string horizontal_welsegs =
+        "WELSEGS \n"
+        "'PROD01' 2000.0 0.0 1.0e-5 'ABS' 'H--' 'HO' /\n"
+        "2         7      1      1    60.0 2000.0  0.3   0.00010 /\n"
+        "/\n"
+        "\n";
+
+}
+
+
+BOOST_AUTO_TEST_CASE(COMPSEGS_RANGE_AND_DEFAULTS) {
+    const auto completion_set = horizontalCompletions();
+
+    /*
+      The first record covers the cells I=1..3 as a range; the second
+      record starts where the first one ended and the depth of the
+      connection in cell 6 is taken from COMPDAT.
+    */
+    const std::string deck_string = horizontal_welsegs +
+        "COMPSEGS\n"
+        "PROD01 / \n"
+        "1    1     1     1   0.0   30.0  'X'  3 /\n"
+        "4    1     1     1   1*    50.0 /\n"
+        "6    1     1     1   50.0  60.0  1*   1* -1.0 /\n"
+        "/\n";
+
+    Opm::Parser parser;
+    Opm::Deck deck = parser.parseString(deck_string, Opm::ParseContext());
+
+    Opm::SegmentSet segment_set;
+    segment_set.segmentsFromWELSEGSKeyword(deck.getKeyword("WELSEGS"));
+    segment_set.processABS();
+    BOOST_CHECK_EQUAL(7, segment_set.numberSegment());
+
+    BOOST_CHECK_THROW( Opm::updatingCompletionsWithSegments(deck.getKeyword("COMPSEGS"), completion_set, segment_set),
+                       std::runtime_error );
+
+    /* With the cell I=5 attached as well all the completions get a segment. */
+    const std::string deck_string2 = horizontal_welsegs +
+        "COMPSEGS\n"
+        "PROD01 / \n"
+        "1    1     1     1   0.0   30.0  'X'  3 /\n"
+        "4    1     1     1   1*    50.0 /\n"
+        "5    1     1     1   45.0  50.0 /\n"
+        "6    1     1     1   52.0  60.0  1*   1* -1.0 /\n"
+        "/\n";
+
+    const Opm::Deck deck2 = parser.parseString(deck_string2, Opm::ParseContext());
+    const auto new_completion_set = Opm::updatingCompletionsWithSegments(deck2.getKeyword("COMPSEGS"), completion_set, segment_set);
+    BOOST_CHECK_EQUAL(6U, new_completion_set.size());
+
+    // the range 0 - 30 is split in three cells of ten; the centres are
+    // halfway between two segment nodes and go to the first segment
+    BOOST_CHECK_EQUAL(1, new_completion_set.get(0).getSegmentNumber());
+    BOOST_CHECK_EQUAL(2, new_completion_set.get(1).getSegmentNumber());
+    BOOST_CHECK_EQUAL(3, new_completion_set.get(2).getSegmentNumber());
+    // DISTANCE_START is the end of the previous record, centre at 40
+    BOOST_CHECK_EQUAL(5, new_completion_set.get(3).getSegmentNumber());
+    BOOST_CHECK_EQUAL(6, new_completion_set.get(4).getSegmentNumber());
+    BOOST_CHECK_EQUAL(7, new_completion_set.get(5).getSegmentNumber());
+    BOOST_CHECK_EQUAL(2005.0, new_completion_set.get(5).getCenterDepth());
+}
+
+
+BOOST_AUTO_TEST_CASE(COMPSEGS_DISTANCE_FROM_GRID) {
+    const auto completion_set = horizontalCompletions();
+    const Opm::EclipseGrid grid(6, 1, 1, 10.0, 10.0, 10.0);
+
+    const std::string deck_string = horizontal_welsegs +
+        "COMPSEGS\n"
+        "PROD01 / \n"
+        "1    1     1     1   1.0   1*  'X'  6 /\n"
+        "/\n";
+
+    Opm::Parser parser;
+    Opm::Deck deck = parser.parseString(deck_string, Opm::ParseContext());
+
+    Opm::SegmentSet segment_set;
+    segment_set.segmentsFromWELSEGSKeyword(deck.getKeyword("WELSEGS"));
+    segment_set.processABS();
+
+    const auto& compsegs = deck.getKeyword("COMPSEGS");
+    BOOST_CHECK_THROW( Opm::updatingCompletionsWithSegments(compsegs, completion_set, segment_set),
+                       std::runtime_error );
+
+    const auto new_completion_set = Opm::updatingCompletionsWithSegments(compsegs, completion_set, segment_set, grid);
+    for (size_t ic = 0; ic < new_completion_set.size(); ++ic)
+        BOOST_CHECK_EQUAL(static_cast< int >(ic) + 2, new_completion_set.get(ic).getSegmentNumber());
+}
+
+
+BOOST_AUTO_TEST_CASE(ORDER_LONG_MULTILATERAL) {
+    /*
+      A main stem of 2000 segments with a lateral of 1000 segments
+      joining at segment 1000, entered with the lateral first.
+    */
+    Opm::SegmentSet segment_set;
+    segment_set.addSegment( Opm::Segment( 1, 1, 0, 0., 0., 0.1, 0., 0., 0., true ) );
+    for (int segment = 2001; segment <= 3000; ++segment) {
+        const int outlet = segment == 2001 ? 1000 : segment - 1;
+        segment_set.addSegment( Opm::Segment( segment, 2, outlet, segment, 0., 0.1, 0., 0., 0., true ) );
+    }
+    for (int segment = 2; segment <= 2000; ++segment)
+        segment_set.addSegment( Opm::Segment( segment, 1, segment - 1, segment, 0., 0.1, 0., 0., 0., true ) );
+
+    segment_set.orderSegments();
+    BOOST_CHECK_EQUAL(3000, segment_set.numberSegment());
+    for (int index = 0; index < 2000; ++index)
+        BOOST_CHECK_EQUAL(index + 1, segment_set[index].segmentNumber());
+    for (int index = 2000; index < 3000; ++index)
+        BOOST_CHECK_EQUAL(index + 1, segment_set[index].segmentNumber());
+
+    for (int index = 1; index < segment_set.numberSegment(); ++index) {
+        const int outlet = segment_set[index].outletSegment();
+        BOOST_CHECK( segment_set.segmentNumberToIndex( outlet ) < index );
+    }
+}
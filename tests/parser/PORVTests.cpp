@@ -282,6 +282,11 @@ BOOST_AUTO_TEST_CASE(PORV_initFromPoro) {
 
     BOOST_CHECK_CLOSE( cell_volume * 1.00 , porv.iget(0,0,9) , 0.001);
     BOOST_CHECK_CLOSE( cell_volume * 1.00 , porv.iget(9,9,9) , 0.001);
+
+    const auto& bulkVolume = props.getBulkVolume();
+    BOOST_CHECK_EQUAL( bulkVolume.size() , grid.getCartesianSize() );
+    for (const auto& volume : bulkVolume)
+        BOOST_CHECK_CLOSE( cell_volume , volume , 0.001);
 }
 
 BOOST_AUTO_TEST_CASE(PORV_initFromPoroWithCellVolume) {
@@ -303,6 +308,30 @@ BOOST_AUTO_TEST_CASE(PORV_initFromPoroWithCellVolume) {
     BOOST_CHECK_CLOSE( cell_volume * 1.00 , porv.iget(9,9,9) , 0.001);
 }
 
+BOOST_AUTO_TEST_CASE(PORV_postProcessorSchedule) {
+    Opm::Deck deck = createDeckWithPORVPORO();
+    Opm::TableManager tm( deck );
+    Opm::EclipseGrid grid( deck );
+    Opm::Eclipse3DProperties props( deck, tm, grid );
+
+    const auto& poroInfo = props.getDoubleProperties().getKeyword("PORO").getKeywordInfo();
+    BOOST_CHECK( !poroInfo.hasPostProcessor() );
+
+    {
+        const auto schedule = props.postProcessorSchedule("ACTNUM");
+        BOOST_CHECK_EQUAL( 2U , schedule.size() );
+        BOOST_CHECK( schedule[0] == std::vector< std::string >{ "PORV" } );
+        BOOST_CHECK( schedule[1] == std::vector< std::string >{ "ACTNUM" } );
+    }
+
+    const auto& actnum = props.getIntGridProperty("ACTNUM");
+    const auto& porv = props.getDoubleProperties().getKeyword("PORV");
+    BOOST_CHECK( actnum.hasRunPostProcessor() );
+    BOOST_CHECK( porv.hasRunPostProcessor() );
+    BOOST_CHECK( porv.getKeywordInfo().dependencies() == (std::vector< std::string >{ "PORO", "NTG", "MULTPV" }) );
+    BOOST_CHECK( props.postProcessorSchedule("ACTNUM").empty() );
+}
+
 BOOST_AUTO_TEST_CASE(PORV_multpv) {
     /* Check that MULTPV is correctly accounted for. */
     Opm::Deck deck = createDeckWithMULTPV();
@@ -19,7 +19,7 @@
 
 
 #define BOOST_TEST_MODULE ParserTests
-#include <boost/filesystem/path.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
@@ -102,6 +102,47 @@ BOOST_AUTO_TEST_CASE(ParserKeyword_includeValid) {
 
 
 
+BOOST_AUTO_TEST_CASE(ParserKeyword_includeGraph) {
+    boost::filesystem::path inputFilePath(prefix() + "includeGraph.data");
+
+    Opm::Parser parser;
+    auto deck = parser.parseFile(inputFilePath.string() , Opm::ParseContext());
+    const auto& graph = deck.getIncludeGraph();
+
+    const auto root = boost::filesystem::canonical(inputFilePath).string();
+    const auto flags = boost::filesystem::canonical(prefix() + "include/some_flags.inc").string();
+    const auto nested = boost::filesystem::canonical(prefix() + "include/graph_nested.inc").string();
+
+    // some_flags.inc is included three times, but only registered once.
+    BOOST_CHECK_EQUAL( 3U , graph.size() );
+    BOOST_CHECK_EQUAL( 3U , deck.count("OIL") );
+
+    const auto root_index = graph.index( root );
+    const auto flags_index = graph.index( flags );
+    const auto nested_index = graph.index( nested );
+    BOOST_CHECK_EQUAL( 0U , root_index );
+    BOOST_CHECK( flags_index != Opm::IncludeGraph::npos );
+    BOOST_CHECK( nested_index != Opm::IncludeGraph::npos );
+
+    const std::vector< size_t > root_includes = { flags_index, nested_index };
+    const auto& includes = graph.includes( root_index );
+    BOOST_CHECK_EQUAL_COLLECTIONS( includes.begin(), includes.end(),
+                                   root_includes.begin(), root_includes.end() );
+
+    BOOST_CHECK_EQUAL( 1U , graph.includes( nested_index ).size() );
+    BOOST_CHECK_EQUAL( flags_index , graph.includes( nested_index ).front() );
+    BOOST_CHECK( graph.includes( flags_index ).empty() );
+
+    const auto roots = graph.roots();
+    BOOST_CHECK_EQUAL( 1U , roots.size() );
+    BOOST_CHECK_EQUAL( root_index , roots.front() );
+
+    BOOST_CHECK_EQUAL( boost::filesystem::file_size( flags ) , graph.getFile( flags_index ).size );
+    BOOST_CHECK_EQUAL( boost::filesystem::last_write_time( flags ) , graph.getFile( flags_index ).mtime );
+    BOOST_CHECK_EQUAL( 3U , graph.dependencies().size() );
+}
+
+
 BOOST_AUTO_TEST_CASE(ParserKeyword_includeWrongCase) {
     boost::filesystem::path inputFile1Path(prefix() + "includeWrongCase1.data");
     boost::filesystem::path inputFile2Path(prefix() + "includeWrongCase2.data");
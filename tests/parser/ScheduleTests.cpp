@@ -42,6 +42,7 @@
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Units/Dimension.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
+#include <opm/parser/eclipse/Units/Units.hpp>
 
 using namespace Opm;
 
@@ -805,6 +806,71 @@ BOOST_AUTO_TEST_CASE(CreateScheduleDeckWithWELOPEN_CombineShutCompletionsAndAddN
   BOOST_CHECK_EQUAL(WellCommon::StatusEnum::SHUT, well->getStatus(5));
 }
 
+BOOST_AUTO_TEST_CASE(CreateScheduleDeckWithWELOPEN_MixedStatusAndCompletionRecords) {
+  Opm::Parser parser;
+  std::string input =
+          "START             -- 0 \n"
+                  "1 NOV 1979 / \n"
+                  "SCHEDULE\n"
+                  "DATES             -- 1\n"
+                  " 1 DES 1979/ \n"
+                  "/\n"
+                  "WELSPECS\n"
+                  "    'OP_1'       'OP'   9   9 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+                  "    'OP_2'       'OP'   8   8 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+                  "/\n"
+                  "COMPDAT\n"
+                  " 'OP_1'  9  9   1   3 'OPEN' 1*   32.948   0.311  3047.839 1*  1*  'X'  22.100 / \n"
+                  " 'OP_2'  8  8   1   2 'OPEN' 1*   46.825   0.311  4332.346 1*  1*  'X'  22.123 / \n"
+                  "/\n"
+                  "DATES             -- 2\n"
+                  " 10  JUL 2008 / \n"
+                  "/\n"
+                  "WELOPEN\n"
+                  " 'OP_1' SHUT 0 0 1 / \n"
+                  " 'OP_2' SHUT 0 0 0 / \n"
+                  " 'OP_1' SHUT 0 0 2 / \n"
+                  " 'OP_2' SHUT / \n"
+                  " 'OP_1' OPEN 0 0 1 / \n"
+                  " 'OP_2' OPEN / \n"
+                  " 'OP_1' OPEN / \n"
+                  " 'OP_2' OPEN 0 0 1 / \n"
+                  "/\n"
+                  "DATES             -- 3\n"
+                  " 10  AUG 2008 / \n"
+                  "/\n";
+
+  EclipseGrid grid(10,10,10);
+  ParseContext parseContext;
+  auto deck = parser.parseString(input, parseContext);
+  TableManager table ( deck );
+  Eclipse3DProperties eclipseProperties ( deck , table, grid);
+  Schedule schedule(deck, grid , eclipseProperties, Phases(true, true, true) , parseContext);
+
+  constexpr auto shut = WellCompletion::StateEnum::SHUT;
+  constexpr auto open = WellCompletion::StateEnum::OPEN;
+
+  // The consecutive completion records for OP_1 are applied in record order;
+  // the last record reopens the first completion.
+  auto* well = schedule.getWell("OP_1");
+  const auto& cs1 = well->getCompletions( 2 );
+  BOOST_CHECK_EQUAL( 3U, cs1.size() );
+  BOOST_CHECK_EQUAL(open, cs1.getFromIJK( 8, 8, 0 ).getState());
+  BOOST_CHECK_EQUAL(shut, cs1.getFromIJK( 8, 8, 1 ).getState());
+  BOOST_CHECK_EQUAL(open, cs1.getFromIJK( 8, 8, 2 ).getState());
+  BOOST_CHECK_EQUAL(WellCommon::StatusEnum::OPEN, well->getStatus( 2 ));
+  BOOST_CHECK( well->hasEvent( ScheduleEvents::COMPLETION_CHANGE , 2 ));
+
+  // OP_2 is opened while all its completions are shut, so it stays shut even
+  // though a later record reopens the first completion.
+  well = schedule.getWell("OP_2");
+  const auto& cs2 = well->getCompletions( 2 );
+  BOOST_CHECK_EQUAL(open, cs2.getFromIJK( 7, 7, 0 ).getState());
+  BOOST_CHECK_EQUAL(shut, cs2.getFromIJK( 7, 7, 1 ).getState());
+  BOOST_CHECK_EQUAL(WellCommon::StatusEnum::SHUT, well->getStatus( 2 ));
+  BOOST_CHECK_EQUAL(WellCommon::StatusEnum::SHUT, well->getStatus( 3 ));
+}
+
 BOOST_AUTO_TEST_CASE(CreateScheduleDeckWithWRFT) {
     Opm::Parser parser;
     std::string input =
@@ -1096,6 +1162,90 @@ BOOST_AUTO_TEST_CASE(createDeckWithWPIMULT) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(createDeckWithWELPI) {
+    Opm::Parser parser;
+    std::string input =
+            "START             -- 0 \n"
+                    "19 JUN 2007 / \n"
+                    "SCHEDULE\n"
+                    "WELSPECS\n"
+                    "    'OP_1'       'OP'   9   9 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+                    "/\n"
+                    "COMPDAT\n"
+                    " 'OP_1'  9  9   1   1 'OPEN' 1*   32.948   0.311  3047.839 1*  1*  'X'  22.100 / \n"
+                    " 'OP_1'  9  9   2   2 'OPEN' 1*   46.825   0.311  4332.346 1*  1*  'X'  22.123 / \n"
+                    " 'OP_1'  9  9   3   3 'SHUT' 1*   32.948   0.311  3047.839 1*  1*  'X'  22.100 / \n"
+                    "/\n"
+                    "DATES             -- 1\n"
+                    " 10  OKT 2008 / \n"
+                    "/\n"
+                    "WPIMULT\n"
+                    "OP_1  1.50 1* 1* 1 /\n"
+                    "/\n"
+                    "WELPI\n"
+                    "OP_1  10 /\n"
+                    "/\n"
+                    "DATES             -- 2\n"
+                    " 20  JAN 2010 / \n"
+                    "/\n"
+                    "DATES             -- 3\n"
+                    " 20  JAN 2011 / \n"
+                    "/\n"
+                    "WELPI\n"
+                    "'OP*'  10 /\n"
+                    "/\n";
+
+    ParseContext parseContext;
+    auto deck = parser.parseString(input, parseContext);
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Schedule schedule(deck, grid , eclipseProperties, Phases(true, true, true) , parseContext);
+    auto* well = schedule.getWell("OP_1");
+
+    const double pi_unit = Metric::LiquidSurfaceVolume / Metric::Time / Metric::Pressure;
+    BOOST_CHECK_EQUAL( well->getProductivityIndex( 0 ), 0.0 );
+    BOOST_CHECK_CLOSE( well->getProductivityIndex( 1 ), 10 * pi_unit, 1e-8 );
+    BOOST_CHECK( well->hasEvent( ScheduleEvents::WELL_PRODUCTIVITY_INDEX, 1 ));
+    BOOST_CHECK( !well->hasEvent( ScheduleEvents::WELL_PRODUCTIVITY_INDEX, 2 ));
+    BOOST_CHECK( schedule.getEvents().hasEvent( ScheduleEvents::WELL_PRODUCTIVITY_INDEX, 3 ));
+
+    BOOST_CHECK( schedule.applyWellPI( 0, {{ "OP_1", 5 * pi_unit }} ).empty() );
+    BOOST_CHECK( schedule.applyWellPI( 1, {{ "OP_2", 5 * pi_unit }} ).empty() );
+    BOOST_CHECK_EQUAL( well->getPIScalingFactor( 1 ), 1.0 );
+
+    {
+        const auto hash = schedule.hash();
+        const auto rescaled = schedule.applyWellPI( 1, {{ "OP_1", 5 * pi_unit }} );
+        BOOST_CHECK_EQUAL( rescaled.size(), 1U );
+        BOOST_CHECK_EQUAL( rescaled[0], "OP_1" );
+        BOOST_CHECK( hash != schedule.hash() );
+    }
+    BOOST_CHECK_EQUAL( well->getPIScalingFactor( 0 ), 1.0 );
+    BOOST_CHECK_CLOSE( well->getPIScalingFactor( 1 ), 2.0, 1e-8 );
+    BOOST_CHECK_CLOSE( well->getPIScalingFactor( 2 ), 2.0, 1e-8 );
+
+    {
+        /* WPIMULT on the first connection, the shut connection is not rescaled. */
+        const auto multipliers = well->getConnectionMultipliers( 1 );
+        BOOST_CHECK_EQUAL( multipliers.size(), 3U );
+        BOOST_CHECK_CLOSE( multipliers[0], 3.0, 1e-8 );
+        BOOST_CHECK_CLOSE( multipliers[1], 2.0, 1e-8 );
+        BOOST_CHECK_CLOSE( multipliers[2], 1.0, 1e-8 );
+
+        const auto initial = well->getConnectionMultipliers( 0 );
+        for (double multiplier : initial)
+            BOOST_CHECK_EQUAL( multiplier, 1.0 );
+    }
+
+    BOOST_CHECK( schedule.applyWellPI( 2, {{ "OP_1", 5 * pi_unit }} ).empty() );
+
+    /* The reported productivity index includes the current scaling. */
+    schedule.applyWellPI( 3, {{ "OP_1", 40 * pi_unit }} );
+    BOOST_CHECK_CLOSE( well->getPIScalingFactor( 3 ), 0.5, 1e-8 );
+    BOOST_CHECK_CLOSE( well->getPIScalingFactor( 2 ), 2.0, 1e-8 );
+}
+
 BOOST_AUTO_TEST_CASE(createDeckModifyMultipleGCONPROD) {
         Opm::Parser parser;
         const std::string input = R"(
@@ -1349,6 +1499,52 @@ BOOST_AUTO_TEST_CASE(changeBhpLimitInHistoryModeWithWeltarg) {
     BOOST_CHECK_EQUAL( false , well_i->getInjectionProperties(4).hasInjectionControl(Opm::WellInjector::BHP) );
 }
 
+BOOST_AUTO_TEST_CASE(repeatedWellInWCONHIST) {
+    Opm::Parser parser;
+    std::string input =
+            "START             -- 0 \n"
+            "19 JUN 2007 / \n"
+            "SCHEDULE\n"
+            "DATES             -- 1\n"
+            " 10  OKT 2008 / \n"
+            "/\n"
+            "WELSPECS\n"
+            "    'P'       'OP'   9   9 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+            "/\n"
+            "COMPDAT\n"
+            " 'P'  9  9   1   1 'OPEN' 1*   32.948   0.311  3047.839 1*  1*  'X'  22.100 / \n"
+            " 'P'  9  9   2   2 'OPEN' 1*   46.825   0.311  4332.346 1*  1*  'X'  22.123 / \n"
+            "/\n"
+            "WCONHIST\n"
+            " 'P' 'SHUT' 'BHP' 1 2 3 3* 150 / \n"
+            " 'P' 'OPEN' 'ORAT' 200 10 20 / \n"
+            "/\n"
+            "DATES             -- 2\n"
+            " 15  OKT 2008 / \n"
+            "/\n"
+            ;
+
+    ParseContext parseContext;
+    auto deck = parser.parseString(input, parseContext);
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Schedule schedule(deck, grid , eclipseProperties, Phases(true, true, true) , parseContext);
+    auto* well_p = schedule.getWell("P");
+    const auto& properties = well_p->getProductionProperties(1);
+
+    // The last record for the well wins
+    BOOST_CHECK_EQUAL(WellCommon::StatusEnum::OPEN, well_p->getStatus(1));
+    BOOST_CHECK_EQUAL(properties.controlMode, Opm::WellProducer::ORAT);
+    BOOST_CHECK_CLOSE(properties.OilRate, 200.0 / (60 * 60 * 24), 1e-8);
+    BOOST_CHECK_CLOSE(properties.WaterRate, 10.0 / (60 * 60 * 24), 1e-8);
+
+    // The BHP limit is carried over from the earlier record in the same keyword
+    BOOST_CHECK_EQUAL(properties.BHPLimit, 150 * 1e5);
+    BOOST_CHECK( properties.hasProductionControl(Opm::WellProducer::BHP) );
+    BOOST_CHECK_EQUAL(well_p->getProductionProperties(2).BHPLimit, 150 * 1e5);
+}
+
 BOOST_AUTO_TEST_CASE(changeModeWithWHISTCTL) {
     Opm::Parser parser;
     std::string input =
@@ -621,3 +621,153 @@ BOOST_AUTO_TEST_CASE( SUMMARY_MISC) {
     }
 }
 
+
+BOOST_AUTO_TEST_CASE( SUMMARY_SEGMENTS ) {
+    const std::string input = R"(
+START
+ 10 MAI 2007 /
+RUNSPEC
+DIMENS
+ 10 10 3 /
+WELLDIMS
+ 2 10 2 2 /
+WSEGDIMS
+ 1 10 2 /
+GRID
+DX
+ 300*100 /
+DY
+ 300*100 /
+DZ
+ 300*10 /
+TOPS
+ 100*2000 /
+SCHEDULE
+WELSPECS
+ 'PROD' 'G' 1 1 2000 'OIL' /
+ 'INJ'  'G' 10 10 2000 'WATER' /
+/
+COMPDAT
+ 'PROD' 1 1 1 3 'OPEN' /
+ 'INJ' 10 10 1 3 'OPEN' /
+/
+WELSEGS
+ 'PROD' 2000 2000 1e-5 'ABS' 'HFA' 'HO' /
+ 2 4 1 1 2090 2030 0.1 1e-3 /
+ 5 6 2 3 2100 2040 0.2 1e-3 /
+/
+SUMMARY
+SOFR
+ 'PROD' 4 /
+ 'PROD' 5 /
+/
+SWFR
+ 'PROD' /
+/
+SGFR
+ 'INJ' /
+ 'PROD' 17 /
+/
+SPR
+ '*' 6 /
+/
+)";
+
+    const auto deck = Parser().parseString( input, ParseContext() );
+    const EclipseState state( deck, ParseContext() );
+    const Schedule schedule( deck, state.getInputGrid(), state.get3DProperties(),
+                             state.runspec().phases(), ParseContext() );
+    const SummaryConfig summary( deck, schedule, state.getTableManager(), ParseContext() );
+
+    // A defaulted segment selects every segment of the well, while wells
+    // which are not multi segment and segments which do not exist are
+    // skipped.
+    const auto keywords = { "SOFR", "SOFR", "SPR",
+                            "SWFR", "SWFR", "SWFR", "SWFR", "SWFR", "SWFR" };
+    const auto names = sorted_keywords( summary );
+    BOOST_CHECK_EQUAL_COLLECTIONS( keywords.begin(), keywords.end(),
+                                   names.begin(), names.end() );
+
+    BOOST_CHECK( !summary.hasKeyword( "SGFR" ) );
+    BOOST_CHECK( summary.hasSummaryKey( "SOFR:PROD:4" ) );
+    BOOST_CHECK( !summary.hasSummaryKey( "SGFR:PROD:17" ) );
+
+    std::vector< int > sofr_segments;
+    for( const auto& node : summary ) {
+        BOOST_CHECK_EQUAL( std::string( node.wgname() ), "PROD" );
+
+        if( node.keyword() == std::string( "SOFR" ) )
+            sofr_segments.push_back( node.num() );
+
+        if( node.keyword() == std::string( "SPR" ) )
+            BOOST_CHECK_EQUAL( node.num(), 6 );
+    }
+
+    std::sort( sofr_segments.begin(), sofr_segments.end() );
+    const std::vector< int > expected_segments = { 4, 5 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( sofr_segments.begin(), sofr_segments.end(),
+                                   expected_segments.begin(), expected_segments.end() );
+}
+
+BOOST_AUTO_TEST_CASE( ACTIONX_SUMMARY_KEYS ) {
+    const auto deck_string = []( const std::string& summary ) {
+        return std::string( R"(
+START
+ 10 MAI 2007 /
+RUNSPEC
+DIMENS
+ 10 10 10 /
+GRID
+DXV
+ 10*400 /
+DYV
+ 10*400 /
+DZV
+ 10*400 /
+TOPS
+ 100*2202 /
+SUMMARY
+)" ) + summary + R"(
+SCHEDULE
+WELSPECS
+ 'OP1' 'G1' 1 1 10 'OIL' /
+ 'OP2' 'G1' 2 2 10 'OIL' /
+/
+COMPDAT
+ 'OP1' 1 1 1 1 'OPEN' /
+ 'OP2' 2 2 1 1 'OPEN' /
+/
+ACTIONX
+ 'SHUT_WET' 10 /
+ WWCT 'OP*' > 0.75 AND FPR < 150 AND /
+ WGOR OP1 > 100 /
+/
+WELOPEN
+ '?' 'SHUT' /
+/
+ENDACTIO
+TSTEP
+ 10 /
+)";
+    };
+
+    const auto summary_config = []( const std::string& input, const ParseContext& parseContext ) {
+        const auto deck = Parser().parseString( input, ParseContext() );
+        const EclipseState state( deck, parseContext );
+        const Schedule schedule( deck, state.getInputGrid(), state.get3DProperties(),
+                                 state.runspec().phases(), parseContext );
+        return SummaryConfig( deck, schedule, state.getTableManager(), parseContext );
+    };
+
+    ParseContext parseContext;
+    BOOST_CHECK_NO_THROW( summary_config( deck_string( "WWCT\n/\nWGOR\n'OP1' /\n/\nFPR\n" ), parseContext ) );
+
+    // WGOR is configured, but not for OP1.
+    BOOST_CHECK_THROW( summary_config( deck_string( "WWCT\n/\nWGOR\n'OP2' /\n/\nFPR\n" ), parseContext ), std::invalid_argument );
+
+    // FPR is missing.
+    BOOST_CHECK_THROW( summary_config( deck_string( "WWCT\n/\nWGOR\n/\n" ), parseContext ), std::invalid_argument );
+
+    parseContext.update( ParseContext::ACTIONX_UNKNOWN_SUMMARY_KEY, InputError::IGNORE );
+    BOOST_CHECK_NO_THROW( summary_config( deck_string( "WWCT\n/\nWGOR\n/\n" ), parseContext ) );
+}
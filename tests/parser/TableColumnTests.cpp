@@ -322,3 +322,42 @@ BOOST_AUTO_TEST_CASE( Test_LINEAR_DEFAULT ) {
     BOOST_CHECK_CLOSE( valueColumn[3] , 1.00 , 1e-6);
     BOOST_CHECK_CLOSE( valueColumn[5] , 0.25 , 1e-6);
 }
+
+
+BOOST_AUTO_TEST_CASE( Test_ADD_VALUES ) {
+    ColumnSchema schema("COLUMN" , Table::STRICTLY_INCREASING , Table::DEFAULT_LINEAR );
+    {
+        TableColumn column( schema );
+        column.addValues( { 1 , 2 , 3 } , { false , false , false } );
+        BOOST_CHECK_EQUAL( column.size() , 3 );
+        BOOST_CHECK_EQUAL( column[2] , 3 );
+        BOOST_CHECK( !column.hasDefault( ) );
+
+        BOOST_CHECK_THROW( column.addValues( { 3 } , { false } ) , std::invalid_argument );
+        BOOST_CHECK_EQUAL( column.size() , 3 );
+        BOOST_CHECK_THROW( column.addValues( { 4 } , { false , false } ) , std::invalid_argument );
+    }
+    {
+        TableColumn column( schema );
+        BOOST_CHECK_THROW( column.addValues( { 1 , 3 , 2 } , { false , false , false } ) , std::invalid_argument );
+    }
+    {
+        // The values on both sides of a defaulted element are not compared.
+        TableColumn column( schema );
+        column.addValues( { 3 , 0 , 2 } , { false , true , false } );
+        BOOST_CHECK( column.hasDefault( ) );
+        BOOST_CHECK( column.defaultApplied( 1 ) );
+    }
+    {
+        ColumnSchema constSchema("COLUMN" , Table::INCREASING , 1.0 );
+        TableColumn column( constSchema );
+        column.addValues( { 0 , 0 , 2 } , { false , true , false } );
+        BOOST_CHECK_EQUAL( column[1] , 1.0 );
+        BOOST_CHECK( !column.hasDefault( ) );
+    }
+    {
+        ColumnSchema noDefault("COLUMN" , Table::RANDOM , Table::DEFAULT_NONE );
+        TableColumn column( noDefault );
+        BOOST_CHECK_THROW( column.addValues( { 0 } , { true } ) , std::invalid_argument );
+    }
+}
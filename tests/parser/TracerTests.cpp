@@ -0,0 +1,261 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define BOOST_TEST_MODULE TracerTests
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/EclipseState/TracerConfig.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    const std::string tracer_deck = R"(
+RUNSPEC
+
+DIMENS
+  2 2 3 /
+
+OIL
+WATER
+GAS
+
+EQLDIMS
+  1 100 20 1 /
+
+TRACERS
+  1 1 1 /
+
+GRID
+
+DX
+  12*10 /
+DY
+  12*10 /
+DZ
+  12*10 /
+TOPS
+  4*1000 /
+
+PORO
+  12*0.25 /
+
+PROPS
+
+TRACER
+  SEA WAT /
+  GS  GAS /
+  OL  OIL /
+/
+
+SOLUTION
+
+TBLKFSEA
+  4*1 4*2 4*3 /
+
+TVDPFGS
+  1000 0.0
+  1020 1.0 /
+
+SCHEDULE
+
+WELSPECS
+  'INJ'  'G1'  1 1 1000 'WATER' /
+  'PROD' 'G1'  2 2 1000 'OIL' /
+/
+
+COMPDAT
+  'INJ'  1 1 1 3 'OPEN' /
+  'PROD' 2 2 1 3 'OPEN' /
+/
+
+WCONINJE
+  'INJ' 'WATER' 'OPEN' 'RATE' 100 /
+/
+
+WTRACER
+  'INJ' 'SEA' 1.0 /
+/
+
+TSTEP
+  10 /
+
+WTRACER
+  'INJ' 'SEA' 0.5 /
+  'INJ' 'GS'  2.0 /
+/
+
+TSTEP
+  10 /
+)";
+
+}
+
+
+BOOST_AUTO_TEST_CASE(TracerConfigFromDeck) {
+    Parser parser;
+    const auto deck = parser.parseString( tracer_deck, ParseContext() );
+    const EclipseState state( deck );
+    const auto& tracers = state.tracer();
+
+    BOOST_CHECK_EQUAL( tracers.size(), 3U );
+    BOOST_CHECK( tracers.has( "SEA" ));
+    BOOST_CHECK( !tracers.has( "XXX" ));
+    BOOST_CHECK_EQUAL( tracers.index( "GS" ), 1U );
+    BOOST_CHECK_THROW( tracers.index( "XXX" ), std::invalid_argument );
+
+    const auto& sea = tracers[ "SEA" ];
+    BOOST_CHECK( sea.phase == Phase::WATER );
+    BOOST_CHECK_EQUAL( sea.restartKey(), "SEAF" );
+    BOOST_CHECK_EQUAL( sea.concentration.size(), 12U );
+    BOOST_CHECK_EQUAL( sea.concentration[0], 1.0 );
+    BOOST_CHECK_EQUAL( sea.concentration[11], 3.0 );
+
+    /* Cell centers are at 1005, 1015 and 1025 meters. */
+    const auto& gs = tracers[ "GS" ];
+    BOOST_CHECK( gs.phase == Phase::GAS );
+    BOOST_CHECK_CLOSE( gs.concentration[0], 0.25, 1e-8 );
+    BOOST_CHECK_CLOSE( gs.concentration[4], 0.75, 1e-8 );
+    BOOST_CHECK_CLOSE( gs.concentration[8], 1.0, 1e-8 );
+
+    const auto& ol = tracers[ 2 ];
+    BOOST_CHECK_EQUAL( ol.name, "OL" );
+    BOOST_CHECK( ol.phase == Phase::OIL );
+    BOOST_CHECK_EQUAL( ol.concentration.size(), 12U );
+    BOOST_CHECK_EQUAL( ol.concentration[5], 0.0 );
+}
+
+
+BOOST_AUTO_TEST_CASE(WTRACER) {
+    Parser parser;
+    const auto deck = parser.parseString( tracer_deck, ParseContext() );
+    const EclipseGrid grid( deck );
+    const TableManager table( deck );
+    const Eclipse3DProperties props( deck, table, grid );
+    const Schedule schedule( deck, grid, props, Phases( true, true, true ), ParseContext() );
+    const auto* well = schedule.getWell( "INJ" );
+
+    BOOST_CHECK_EQUAL( well->getTracerProperties( 0 ).getConcentration( "SEA" ), 1.0 );
+    BOOST_CHECK_EQUAL( well->getTracerProperties( 0 ).getConcentration( "GS" ), 0.0 );
+    BOOST_CHECK_EQUAL( well->getTracerProperties( 1 ).getConcentration( "SEA" ), 0.5 );
+    BOOST_CHECK_EQUAL( well->getTracerProperties( 1 ).getConcentration( "GS" ), 2.0 );
+    BOOST_CHECK( well->hasEvent( ScheduleEvents::WELL_TRACER_UPDATE, 1 ));
+    BOOST_CHECK( schedule.getWell( "PROD" )->getTracerProperties( 1 ).concentrations().empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE(WTRACER_UNKNOWN_TRACER) {
+    std::string input = tracer_deck;
+    input.replace( input.find( "'INJ' 'GS'  2.0" ), 15, "'INJ' 'XX'  2.0" );
+
+    Parser parser;
+    const auto deck = parser.parseString( input, ParseContext() );
+    const EclipseGrid grid( deck );
+    const TableManager table( deck );
+    const Eclipse3DProperties props( deck, table, grid );
+    ParseContext parseContext;
+
+    parseContext.update( ParseContext::SCHEDULE_INVALID_NAME, InputError::THROW_EXCEPTION );
+    BOOST_CHECK_THROW( Schedule( deck, grid, props, Phases( true, true, true ), parseContext ), std::invalid_argument );
+
+    parseContext.update( ParseContext::SCHEDULE_INVALID_NAME, InputError::IGNORE );
+    const Schedule schedule( deck, grid, props, Phases( true, true, true ), parseContext );
+    const auto& tracer_properties = schedule.getWell( "INJ" )->getTracerProperties( 1 );
+    BOOST_CHECK_EQUAL( tracer_properties.getConcentration( "SEA" ), 0.5 );
+    BOOST_CHECK_EQUAL( tracer_properties.concentrations().count( "XX" ), 0U );
+}
+
+
+BOOST_AUTO_TEST_CASE(TracerInvalidFluid) {
+    const std::string input = R"(
+RUNSPEC
+DIMENS
+  1 1 1 /
+GRID
+DX
+  10 /
+DY
+  10 /
+DZ
+  10 /
+TOPS
+  1000 /
+PROPS
+TRACER
+  ENV XXX /
+/
+)";
+    Parser parser;
+    const auto deck = parser.parseString( input, ParseContext() );
+    const EclipseGrid grid( deck );
+    const TableManager table( deck );
+    const Eclipse3DProperties props( deck, table, grid );
+
+    BOOST_CHECK_THROW( TracerConfig( deck, grid, props ), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE(TracerTVDPMissingTable) {
+    const std::string input = R"(
+RUNSPEC
+DIMENS
+  1 1 2 /
+EQLDIMS
+  2 100 20 1 /
+TRACERS
+  1 1 1 /
+GRID
+DX
+  2*10 /
+DY
+  2*10 /
+DZ
+  2*10 /
+TOPS
+  1000 /
+PROPS
+TRACER
+  SEA WAT /
+/
+REGIONS
+EQLNUM
+  1 2 /
+SOLUTION
+TVDPFSEA
+  1000 0.0
+  1020 1.0 /
+)";
+    Parser parser;
+    const auto deck = parser.parseString( input, ParseContext() );
+    const EclipseGrid grid( deck );
+    const TableManager table( deck );
+    const Eclipse3DProperties props( deck, table, grid );
+
+    BOOST_CHECK_THROW( TracerConfig( deck, grid, props ), std::invalid_argument );
+}
@@ -0,0 +1,210 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE WLIST
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WList.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/WListManager.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+
+using namespace Opm;
+
+
+BOOST_AUTO_TEST_CASE(CreateWList) {
+    WList wlist;
+    BOOST_CHECK(wlist.empty());
+    BOOST_CHECK_EQUAL(wlist.size(), 0);
+
+    wlist.add(5);
+    wlist.add(1);
+    wlist.add(1);
+    BOOST_CHECK_EQUAL(wlist.size(), 2);
+    BOOST_CHECK(wlist.has(1));
+    BOOST_CHECK(!wlist.has(2));
+    BOOST_CHECK(!wlist.has(100));
+
+    const std::vector<std::size_t> expected = {1, 5};
+    const auto wells = wlist.wells();
+    BOOST_CHECK_EQUAL_COLLECTIONS(wells.begin(), wells.end(), expected.begin(), expected.end());
+
+    WList other;
+    other.add(5);
+    other.add(10);
+    wlist.add(other);
+    BOOST_CHECK_EQUAL(wlist.size(), 3);
+
+    wlist.del(other);
+    BOOST_CHECK_EQUAL(wlist.size(), 1);
+    BOOST_CHECK(wlist.has(1));
+
+    wlist.del(1);
+    wlist.del(100);
+    BOOST_CHECK(wlist.empty());
+}
+
+
+BOOST_AUTO_TEST_CASE(CreateWListManager) {
+    WListManager wlm;
+    BOOST_CHECK(!wlm.hasList("*LIST"));
+    BOOST_CHECK_THROW(wlm.getList("*LIST"), std::invalid_argument);
+    BOOST_CHECK_THROW(wlm.newList("LIST"), std::invalid_argument);
+
+    auto& wlist1 = wlm.newList("*LIST1");
+    wlist1.add(0);
+    wlist1.add(1);
+    auto& wlist2 = wlm.newList("*LIST2");
+    wlist2.add(1);
+    wlist2.add(2);
+    BOOST_CHECK_EQUAL(wlm.size(), 2);
+
+    WList wells;
+    wells.add(1);
+    wlm.delWells(wells);
+    BOOST_CHECK(!wlm.getList("*LIST1").has(1));
+    BOOST_CHECK(!wlm.getList("*LIST2").has(1));
+
+    BOOST_CHECK_EQUAL(wlm.newList("*LIST1").size(), 0);
+
+    BOOST_CHECK(WListManager::isListName("*PROD"));
+    BOOST_CHECK(!WListManager::isListName("*"));
+    BOOST_CHECK(!WListManager::isListName("PROD"));
+}
+
+
+static Deck createDeckWLIST() {
+    Opm::Parser parser;
+    std::string input = R"(
+START
+  10 MAI 2007 /
+
+SCHEDULE
+
+WELSPECS
+  'P1' 'G1' 1 1 3.33 'OIL' /
+  'P2' 'G1' 2 2 3.33 'OIL' /
+  'P3' 'G1' 3 3 3.33 'OIL' /
+  'I1' 'G2' 4 4 3.33 'WATER' /
+/
+
+WLIST
+  '*PROD' NEW 'P1' 'P2' /
+  '*INJ'  NEW 'I1' /
+/
+
+WELOPEN
+  '*PROD' 'SHUT' /
+/
+
+DATES
+  10 JUN 2007 /
+/
+
+WLIST
+  '*PROD' ADD 'P3' /
+  '*PROD' DEL 'P1' /
+/
+
+DATES
+  10 JLY 2007 /
+/
+
+WLIST
+  '*INJ' MOV 'P*' /
+/
+
+WELOPEN
+  '*INJ' 'OPEN' /
+/
+
+DATES
+  10 AUG 2007 /
+/
+)";
+
+    return parser.parseString(input, ParseContext());
+}
+
+
+BOOST_AUTO_TEST_CASE(WLIST_SCHEDULE) {
+    auto deck = createDeckWLIST();
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Schedule schedule(deck, grid , eclipseProperties, Phases(true, true, true) , ParseContext() );
+
+    const auto& wlm0 = schedule.getWListManager(0);
+    BOOST_CHECK_EQUAL(wlm0.size(), 2);
+    BOOST_CHECK_EQUAL(wlm0.getList("*PROD").size(), 2);
+    BOOST_CHECK(wlm0.getList("*INJ").has(3));
+
+    const auto& wlm1 = schedule.getWListManager(1);
+    const std::vector<std::size_t> prod1 = {1, 2};
+    const auto wells1 = wlm1.getList("*PROD").wells();
+    BOOST_CHECK_EQUAL_COLLECTIONS(wells1.begin(), wells1.end(), prod1.begin(), prod1.end());
+
+    const auto& wlm2 = schedule.getWListManager(2);
+    BOOST_CHECK(wlm2.getList("*PROD").empty());
+    BOOST_CHECK_EQUAL(wlm2.getList("*INJ").size(), 4);
+    BOOST_CHECK_EQUAL(std::addressof(wlm2), std::addressof(schedule.getWListManager(3)));
+
+    BOOST_CHECK_EQUAL(schedule.getWell("P1")->getStatus(0), WellCommon::SHUT);
+    BOOST_CHECK_EQUAL(schedule.getWell("P1")->getStatus(2), WellCommon::OPEN);
+    BOOST_CHECK_EQUAL(schedule.getWell("I1")->getStatus(2), WellCommon::OPEN);
+
+    BOOST_CHECK_EQUAL(schedule.getWellsMatching("*PROD").size(), 3);
+    BOOST_CHECK_EQUAL(schedule.getWellsMatching("*INJ").size(), 4);
+    BOOST_CHECK_EQUAL(schedule.getWellsMatching("*UNKNOWN").size(), 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(WLIST_INVALID) {
+    Opm::Parser parser;
+    std::string input = R"(
+START
+  10 MAI 2007 /
+
+SCHEDULE
+
+WELSPECS
+  'P1' 'G1' 1 1 3.33 'OIL' /
+/
+
+WLIST
+  '*PROD' ADD 'P1' /
+/
+)";
+
+    auto deck = parser.parseString(input, ParseContext());
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    BOOST_CHECK_THROW(Schedule(deck, grid , eclipseProperties, Phases(true, true, true) , ParseContext() ), std::invalid_argument);
+}
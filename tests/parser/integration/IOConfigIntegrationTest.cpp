@@ -306,6 +306,8 @@ BOOST_AUTO_TEST_CASE( NorneRestartConfig ) {
 
     Parser parser;
     ParseContext ctx;
+    /* The deck has WTRACER keywords for wells and tracers which are not defined. */
+    ctx.update( ParseContext::SCHEDULE_INVALID_NAME, InputError::IGNORE );
     auto deck = parser.parseFile( prefix() + "IOConfig/RPTRST_DECK.DATA" , ctx);
     EclipseState state(deck, ctx);
     Schedule schedule(deck, state.getInputGrid(), state.get3DProperties(), state.runspec().phases(), ctx);
@@ -0,0 +1,331 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "config.h"
+
+#define BOOST_TEST_MODULE EclBinaryIO
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+
+#include <ert/util/TestArea.hpp>
+
+#include <opm/output/eclipse/EclBinaryIO.hpp>
+
+using namespace Opm::EclIO;
+
+namespace {
+
+    std::vector< char > readBytes( const std::string& filename ) {
+        std::ifstream stream( filename, std::ios_base::binary );
+        return std::vector< char >( std::istreambuf_iterator< char >( stream ),
+                                    std::istreambuf_iterator< char >() );
+    }
+
+    int bigEndianInt( const std::vector< char >& bytes, std::size_t offset ) {
+        unsigned int value = 0;
+        for (std::size_t i = 0; i < 4; i++)
+            value = (value << 8) | static_cast< unsigned char >( bytes[offset + i] );
+
+        return static_cast< int >( value );
+    }
+
+    /*
+      Reference formatting of floating point values, as done by ERT
+      for formatted files.
+    */
+    std::string scientific( double x, const char* fmt ) {
+        double pow_x = std::ceil( std::log10( std::fabs( x ) ) );
+        double arg_x = x / std::pow( 10.0, pow_x );
+        if (x != 0.0) {
+            if (std::fabs( arg_x ) == 1.0) {
+                arg_x *= 0.10;
+                pow_x += 1;
+            }
+        } else {
+            arg_x = 0.0;
+            pow_x = 0.0;
+        }
+
+        char buffer[64];
+        std::snprintf( buffer, sizeof buffer, fmt, arg_x, static_cast< int >( pow_x ) );
+        return buffer;
+    }
+
+}
+
+
+BOOST_AUTO_TEST_CASE(RoundTrip) {
+    ERT::TestArea ta("test_EclBinaryIO");
+
+    std::vector< int > ints = { 1, -2, 3, 1 << 20 };
+    std::vector< float > floats = { 1.5f, -0.25f };
+    std::vector< double > doubles = { 3.141592653589793, -1e100, 0 };
+    std::vector< bool > bools = { true, false, true };
+    std::vector< std::string > strings = { "OIL", "WATER", "GAS12345" };
+
+    {
+        EclOutput output( "TEST.EGRID" );
+        output.write( "INTS", ints );
+        output.write( "FLOATS", floats );
+        output.write( "DOUBLES", doubles );
+        output.write( "BOOLS", bools );
+        output.write( "STRINGS", strings );
+        output.message( "ENDGRID" );
+        output.write( "INTS", std::vector< int >{ 7 } );
+        output.writeFloat( "CONV", doubles );
+        output.write( "EMPTY", std::vector< int >{} );
+    }
+
+    EclFile file( "TEST.EGRID" );
+    BOOST_CHECK_EQUAL( file.size(), 9U );
+    BOOST_CHECK( file.hasKey( "ENDGRID" ) );
+    BOOST_CHECK( !file.hasKey( "MISSING" ) );
+    BOOST_CHECK_THROW( file.index( "MISSING" ), std::invalid_argument );
+    BOOST_CHECK_THROW( file.index( "INTS", 2 ), std::invalid_argument );
+    BOOST_CHECK_THROW( file.getDouble( file.index( "INTS" ) ), std::invalid_argument );
+
+    BOOST_CHECK( file.getInt( file.index( "INTS" ) ) == ints );
+    BOOST_CHECK( file.getInt( file.index( "INTS", 1 ) ) == std::vector< int >{ 7 } );
+    BOOST_CHECK( file.getFloat( file.index( "FLOATS" ) ) == floats );
+    BOOST_CHECK( file.getDouble( file.index( "DOUBLES" ) ) == doubles );
+    BOOST_CHECK( file.getBool( file.index( "BOOLS" ) ) == bools );
+    BOOST_CHECK( file.getString( file.index( "STRINGS" ) ) == strings );
+    BOOST_CHECK( file.getInt( file.index( "EMPTY" ) ).empty() );
+
+    const auto& endgrid = file.arrays()[ file.index( "ENDGRID" ) ];
+    BOOST_CHECK( endgrid.type == ArrayType::MESS );
+    BOOST_CHECK_EQUAL( endgrid.size, 0U );
+
+    const auto conv = file.getFloat( file.index( "CONV" ) );
+    BOOST_CHECK_EQUAL( conv.size(), doubles.size() );
+    BOOST_CHECK_CLOSE( conv[0], 3.141592653589793, 1e-5 );
+
+    BOOST_CHECK_THROW( EclOutput( "TEST.X" ).write( "TOOLONGNAME", ints ), std::invalid_argument );
+    BOOST_CHECK_THROW( EclFile( "NO_SUCH_FILE" ), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE(RecordLayout) {
+    ERT::TestArea ta("test_EclBinaryIO");
+
+    std::vector< double > doubles( 2500 );
+    for (std::size_t i = 0; i < doubles.size(); i++)
+        doubles[i] = i * 0.5;
+
+    std::vector< std::string > strings( 210, "NAME" );
+
+    {
+        EclOutput output( "TEST.UNRST" );
+        output.write( "DOUBLES", doubles );
+        output.write( "STRINGS", strings );
+    }
+
+    const auto bytes = readBytes( "TEST.UNRST" );
+
+    // Header record: 16 byte payload with name, size and type.
+    BOOST_CHECK_EQUAL( bigEndianInt( bytes, 0 ), 16 );
+    BOOST_CHECK_EQUAL( std::string( bytes.data() + 4, 8 ), "DOUBLES " );
+    BOOST_CHECK_EQUAL( bigEndianInt( bytes, 12 ), 2500 );
+    BOOST_CHECK_EQUAL( std::string( bytes.data() + 16, 4 ), "DOUB" );
+    BOOST_CHECK_EQUAL( bigEndianInt( bytes, 20 ), 16 );
+
+    // Numeric data is split in records of at most 1000 elements.
+    std::size_t pos = 24;
+    for (int count : { 1000, 1000, 500 }) {
+        BOOST_CHECK_EQUAL( bigEndianInt( bytes, pos ), 8 * count );
+        pos += 4 + 8 * count;
+        BOOST_CHECK_EQUAL( bigEndianInt( bytes, pos ), 8 * count );
+        pos += 4;
+    }
+
+    // Character data is split in records of at most 105 elements.
+    pos += 24;
+    for (int count : { 105, 105 }) {
+        BOOST_CHECK_EQUAL( bigEndianInt( bytes, pos ), 8 * count );
+        pos += 8 + 8 * count;
+    }
+    BOOST_CHECK_EQUAL( pos, bytes.size() );
+
+    EclFile file( "TEST.UNRST" );
+    BOOST_CHECK( file.getDouble( 0 ) == doubles );
+    BOOST_CHECK( file.getString( 1 ) == strings );
+}
+
+
+BOOST_AUTO_TEST_CASE(CorruptFile) {
+    ERT::TestArea ta("test_EclBinaryIO");
+
+    {
+        EclOutput output( "TEST.EGRID" );
+        output.write( "INTS", std::vector< int >( 10, 1 ) );
+    }
+
+    auto bytes = readBytes( "TEST.EGRID" );
+    bytes.pop_back();
+    {
+        std::ofstream stream( "TRUNC.EGRID", std::ios_base::binary );
+        stream.write( bytes.data(), bytes.size() );
+    }
+
+    BOOST_CHECK_THROW( EclFile( "TRUNC.EGRID" ), std::runtime_error );
+}
+
+
+BOOST_AUTO_TEST_CASE(MalformedHeader) {
+    ERT::TestArea ta("test_EclBinaryIO");
+
+    {
+        EclOutput output( "TEST.UNRST" );
+        output.message( "STARTSOL" );
+        output.write( "INTS", std::vector< int >( 10, 1 ) );
+    }
+
+    const auto bytes = readBytes( "TEST.UNRST" );
+    const auto writeWithSize = [&bytes]( const std::string& filename, std::size_t offset, int size ) {
+        auto modified = bytes;
+        for (std::size_t i = 0; i < 4; i++)
+            modified[offset + i] = static_cast< char >( (static_cast< unsigned int >( size ) >> (24 - 8*i)) & 0xFF );
+
+        std::ofstream stream( filename, std::ios_base::binary );
+        stream.write( modified.data(), modified.size() );
+    };
+
+    // A MESS array does not have any elements.
+    writeWithSize( "MESS.UNRST", 12, 10 );
+    BOOST_CHECK_THROW( EclFile( "MESS.UNRST" ), std::runtime_error );
+
+    // The INTS header starts after the 24 byte STARTSOL header record.
+    writeWithSize( "NEGATIVE.UNRST", 24 + 12, -1 );
+    BOOST_CHECK_THROW( EclFile( "NEGATIVE.UNRST" ), std::runtime_error );
+
+    EclFile file( "TEST.UNRST" );
+    BOOST_CHECK_EQUAL( file.size(), 2U );
+}
+
+
+BOOST_AUTO_TEST_CASE(FormattedLayout) {
+    ERT::TestArea ta("test_EclBinaryIO");
+
+    {
+        EclOutput output( "TEST.FEGRID", true );
+        output.write( "INTS", std::vector< int >{ 1, -2, 3, 4, 5, 6, -2147483647 - 1 } );
+        output.writeFloat( "FLOATS", { 1.0, -0.25, 0 } );
+        output.write( "DOUBLES", std::vector< double >{ 1234.5 } );
+        output.write( "BOOLS", std::vector< bool >{ true, false } );
+        output.write( "STRINGS", std::vector< std::string >{ "METRES", "" } );
+        output.message( "ENDGRID" );
+    }
+
+    const auto bytes = readBytes( "TEST.FEGRID" );
+    const std::string expected =
+        " 'INTS    '           7 'INTE'\n"
+        "           1          -2           3           4           5           6\n"
+        " -2147483648\n"
+        " 'FLOATS  '           3 'REAL'\n"
+        "   0.10000000E+01  -0.25000000E+00   0.00000000E+00\n"
+        " 'DOUBLES '           1 'DOUB'\n"
+        "   0.12345000000000D+04\n"
+        " 'BOOLS   '           2 'LOGI'\n"
+        "  T  F\n"
+        " 'STRINGS '           2 'CHAR'\n"
+        " 'METRES  ' '        '\n"
+        " 'ENDGRID '           0 'MESS'\n";
+    BOOST_CHECK_EQUAL( std::string( bytes.begin(), bytes.end() ), expected );
+
+    EclFile file( "TEST.FEGRID" );
+    BOOST_CHECK( file.formatted() );
+    BOOST_CHECK_EQUAL( file.size(), 6U );
+    BOOST_CHECK( file.getInt( 0 ) == (std::vector< int >{ 1, -2, 3, 4, 5, 6, -2147483647 - 1 }) );
+    BOOST_CHECK( file.getFloat( 1 ) == (std::vector< float >{ 1.0f, -0.25f, 0.0f }) );
+    BOOST_CHECK( file.getDouble( 2 ) == std::vector< double >{ 1234.5 } );
+    BOOST_CHECK( file.getBool( 3 ) == (std::vector< bool >{ true, false }) );
+    BOOST_CHECK( file.getString( 4 ) == (std::vector< std::string >{ "METRES", "" }) );
+    BOOST_CHECK( file.arrays()[5].type == ArrayType::MESS );
+}
+
+
+BOOST_AUTO_TEST_CASE(FormattedNumbers) {
+    ERT::TestArea ta("test_EclBinaryIO");
+
+    std::mt19937 gen( 42 );
+    std::uniform_real_distribution< double > mantissa( -1, 1 );
+    std::uniform_int_distribution< int > exponent( -30, 30 );
+
+    std::vector< float > floats;
+    std::vector< double > doubles;
+    for (int i = 0; i < 5000; i++) {
+        const double value = mantissa( gen ) * std::pow( 10.0, exponent( gen ) );
+        floats.push_back( value );
+        doubles.push_back( value );
+    }
+    for (double value : { 0.1, 1.0, 10.0, 0.5, 123456789.0, 1e-10, 0.05, 99.999999999 }) {
+        floats.push_back( value );
+        doubles.push_back( value );
+    }
+
+    {
+        EclOutput output( "TEST.FUNRST", true );
+        output.write( "FLOATS", floats );
+        output.write( "DOUBLES", doubles );
+    }
+
+    std::string expected;
+    const auto append = [&expected]( const std::string& header, const std::vector< std::string >& values, std::size_t columns ) {
+        expected += header;
+        for (std::size_t first = 0; first < values.size(); first += 1000) {
+            const auto count = std::min< std::size_t >( 1000, values.size() - first );
+            for (std::size_t i = 0; i < count; i++) {
+                expected += values[first + i];
+                if ((i + 1) % columns == 0)
+                    expected += "\n";
+            }
+            if (count % columns != 0)
+                expected += "\n";
+        }
+    };
+
+    std::vector< std::string > float_text;
+    for (float value : floats)
+        float_text.push_back( scientific( value, "  %11.8fE%+03d" ) );
+
+    std::vector< std::string > double_text;
+    for (double value : doubles)
+        double_text.push_back( scientific( value, "  %17.14fD%+03d" ) );
+
+    append( " 'FLOATS  '        5008 'REAL'\n", float_text, 4 );
+    append( " 'DOUBLES '        5008 'DOUB'\n", double_text, 3 );
+
+    const auto bytes = readBytes( "TEST.FUNRST" );
+    BOOST_CHECK( std::string( bytes.begin(), bytes.end() ) == expected );
+
+    EclFile file( "TEST.FUNRST" );
+    const auto float_data = file.getFloat( 0 );
+    const auto double_data = file.getDouble( 1 );
+    for (std::size_t i = 0; i < floats.size(); i++) {
+        BOOST_CHECK_CLOSE( float_data[i], floats[i], 1e-5 );
+        BOOST_CHECK_CLOSE( double_data[i], doubles[i], 1e-11 );
+    }
+}
@@ -397,5 +397,188 @@ BOOST_AUTO_TEST_CASE(EclipseIOIntegration) {
     BOOST_CHECK_EQUAL( file_size, write_and_check( 3, 5 ) );
 }
 
+BOOST_AUTO_TEST_CASE(EGRID_NNC) {
+    const char *deckString =
+        "RUNSPEC\n"
+        "OIL\n"
+        "WATER\n"
+        "DIMENS\n"
+        "2 2 2/\n"
+        "GRID\n"
+        "DX\n"
+        "8*1.0 /\n"
+        "DY\n"
+        "8*1.0 /\n"
+        "DZ\n"
+        "8*1.0 /\n"
+        "TOPS\n"
+        "4*100 /\n"
+        "PORO\n"
+        "8*0.3 /\n"
+        "SCHEDULE\n";
+
+    ERT::TestArea ta("test_egrid_nnc");
+    ParseContext parse_context;
+    auto deck = Parser().parseString( deckString, parse_context );
+    auto es = Parser::parse( deck );
+    auto& eclGrid = es.getInputGrid();
+    Schedule schedule(deck, eclGrid, es.get3DProperties(), es.runspec().phases(), parse_context);
+    SummaryConfig summary_config( deck, schedule, es.getTableManager( ), parse_context);
+    es.getIOConfig().setBaseName( "FOO" );
+
+    NNC nnc;
+    nnc.addNNC( 0, 7, 1.0 );
+    nnc.addNNC( 1, 6, 2.0 );
+
+    EclipseIO eclWriter( es, eclGrid , schedule, summary_config);
+
+    /* Writing twice should not add the NNCs twice. */
+    for (int i = 0; i < 2; i++) {
+        eclWriter.writeInitial( data::Solution(), {}, nnc );
+
+        ERT::ert_unique_ptr<ecl_file_type , ecl_file_close> egridFile(ecl_file_open( "FOO.EGRID" , 0 ));
+        const auto* nnc1 = ecl_file_iget_named_kw( egridFile.get(), "NNC1", 0 );
+        const auto* nnc2 = ecl_file_iget_named_kw( egridFile.get(), "NNC2", 0 );
+        BOOST_CHECK_EQUAL( 2, ecl_kw_get_size( nnc1 ));
+        BOOST_CHECK_EQUAL( 1, ecl_kw_iget_int( nnc1, 0 ));
+        BOOST_CHECK_EQUAL( 8, ecl_kw_iget_int( nnc2, 0 ));
+        BOOST_CHECK_EQUAL( 2, ecl_kw_iget_int( nnc1, 1 ));
+        BOOST_CHECK_EQUAL( 7, ecl_kw_iget_int( nnc2, 1 ));
+        BOOST_CHECK_EQUAL( 1, ecl_file_get_num_named_kw( egridFile.get(), "NNCHEAD" ));
+    }
+
+    checkEgridFile( eclGrid );
+}
+
+BOOST_AUTO_TEST_CASE(LGR_OUTPUT) {
+    const char *deckString =
+        "RUNSPEC\n"
+        "OIL\n"
+        "WATER\n"
+        "DIMENS\n"
+        "2 2 2/\n"
+        "GRID\n"
+        "DX\n"
+        "8*1.0 /\n"
+        "DY\n"
+        "8*1.0 /\n"
+        "DZ\n"
+        "8*1.0 /\n"
+        "TOPS\n"
+        "4*100 /\n"
+        "PORO\n"
+        "8*0.3 /\n"
+        "NTG\n"
+        "8*0.5 /\n"
+        "CARFIN\n"
+        "'LGR1'  1  1  1  1  1  1  2  2  2 /\n"
+        "EQUALS\n"
+        "  MULTPV 2.0  1 1 1 1 1 1 /\n"
+        "  PORV 0.01   2 2 2 2 2 2 /\n"
+        "/\n"
+        "ENDFIN\n"
+        "SCHEDULE\n";
+
+    ERT::TestArea ta("test_lgr_output");
+    ParseContext parse_context;
+    auto deck = Parser().parseString( deckString, parse_context );
+    auto es = Parser::parse( deck );
+    auto& eclGrid = es.getInputGrid();
+    Schedule schedule(deck, eclGrid, es.get3DProperties(), es.runspec().phases(), parse_context);
+    SummaryConfig summary_config( deck, schedule, es.getTableManager( ), parse_context);
+    es.getIOConfig().setBaseName( "FOO" );
+
+    EclipseIO eclWriter( es, eclGrid , schedule, summary_config);
+    eclWriter.writeInitial( );
+
+    {
+        ERT::ert_unique_ptr<ecl_file_type , ecl_file_close> egridFile(ecl_file_open( "FOO.EGRID" , 0 ));
+        BOOST_CHECK_EQUAL( 1, ecl_file_get_num_named_kw( egridFile.get(), "LGR" ));
+        BOOST_CHECK_EQUAL( 2, ecl_file_get_num_named_kw( egridFile.get(), "GRIDHEAD" ));
+        BOOST_CHECK_EQUAL( 1, ecl_file_get_num_named_kw( egridFile.get(), "ENDLGR" ));
+
+        const auto* gridhead = ecl_file_iget_named_kw( egridFile.get(), "GRIDHEAD", 1 );
+        BOOST_CHECK_EQUAL( 2, ecl_kw_iget_int( gridhead, 1 ));
+        BOOST_CHECK_EQUAL( 2, ecl_kw_iget_int( gridhead, 2 ));
+        BOOST_CHECK_EQUAL( 2, ecl_kw_iget_int( gridhead, 3 ));
+        BOOST_CHECK_EQUAL( 1, ecl_kw_iget_int( gridhead, 4 ));
+
+        const auto* hostnum = ecl_file_iget_named_kw( egridFile.get(), "HOSTNUM", 0 );
+        BOOST_CHECK_EQUAL( 8, ecl_kw_get_size( hostnum ));
+        for (int i = 0; i < 8; i++)
+            BOOST_CHECK_EQUAL( 1, ecl_kw_iget_int( hostnum, i ));
+    }
+
+    {
+        ERT::ert_unique_ptr<ecl_file_type , ecl_file_close> initFile(ecl_file_open( "FOO.INIT" , 0 ));
+        BOOST_CHECK_EQUAL( 1, ecl_file_get_num_named_kw( initFile.get(), "LGR" ));
+        BOOST_CHECK_EQUAL( 1, ecl_file_get_num_named_kw( initFile.get(), "LGRHEADI" ));
+        BOOST_CHECK_EQUAL( 1, ecl_file_get_num_named_kw( initFile.get(), "ENDLGR" ));
+        BOOST_CHECK_EQUAL( 1, ecl_kw_iget_int( ecl_file_iget_named_kw( initFile.get(), "LGRHEADI", 0 ), 0 ));
+
+        /*
+          The refined cells have a volume of 0.125; the first one has
+          MULTPV 2 and the last one has PORV 0.01 from the LGR block.
+        */
+        const auto* porv = ecl_file_iget_named_kw( initFile.get(), "PORV", 1 );
+        BOOST_CHECK_EQUAL( 8, ecl_kw_get_size( porv ));
+        BOOST_CHECK_CLOSE( 0.3 * 0.5 * 0.125 * 2, ecl_kw_iget_float( porv, 0 ), 1e-4 );
+        for (int i = 1; i < 7; i++)
+            BOOST_CHECK_CLOSE( 0.3 * 0.5 * 0.125, ecl_kw_iget_float( porv, i ), 1e-4 );
+        BOOST_CHECK_CLOSE( 0.01, ecl_kw_iget_float( porv, 7 ), 1e-4 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(LGR_OUTPUT_PORV) {
+    const char *deckString =
+        "RUNSPEC\n"
+        "OIL\n"
+        "WATER\n"
+        "DIMENS\n"
+        "2 2 2/\n"
+        "GRID\n"
+        "DX\n"
+        "8*1.0 /\n"
+        "DY\n"
+        "8*1.0 /\n"
+        "DZ\n"
+        "8*1.0 /\n"
+        "TOPS\n"
+        "4*100 /\n"
+        "PORV\n"
+        "8*0.4 /\n"
+        "CARFIN\n"
+        "'LGR1'  1  1  1  1  1  1  2  2  2 /\n"
+        "ENDFIN\n"
+        "SCHEDULE\n";
+
+    ERT::TestArea ta("test_lgr_output_porv");
+    ParseContext parse_context;
+    auto deck = Parser().parseString( deckString, parse_context );
+    auto es = Parser::parse( deck );
+    auto& eclGrid = es.getInputGrid();
+    Schedule schedule(deck, eclGrid, es.get3DProperties(), es.runspec().phases(), parse_context);
+    SummaryConfig summary_config( deck, schedule, es.getTableManager( ), parse_context);
+    es.getIOConfig().setBaseName( "FOO" );
+
+    EclipseIO eclWriter( es, eclGrid , schedule, summary_config);
+    eclWriter.writeInitial( );
+
+    {
+        ERT::ert_unique_ptr<ecl_file_type , ecl_file_close> initFile(ecl_file_open( "FOO.INIT" , 0 ));
+        BOOST_CHECK_EQUAL( 1, ecl_file_get_num_named_kw( initFile.get(), "LGR" ));
+
+        /* Neither the main grid nor the LGR get a PORO array */
+        BOOST_CHECK_EQUAL( 0, ecl_file_get_num_named_kw( initFile.get(), "PORO" ));
+        BOOST_CHECK( !es.get3DProperties().getDoubleProperties().hasKeyword( "PORO" ));
+
+        /* The host pore volume is distributed over the eight refined cells */
+        const auto* porv = ecl_file_iget_named_kw( initFile.get(), "PORV", 1 );
+        BOOST_CHECK_EQUAL( 8, ecl_kw_get_size( porv ));
+        for (int i = 0; i < 8; i++)
+            BOOST_CHECK_CLOSE( 0.4 / 8, ecl_kw_iget_float( porv, i ), 1e-4 );
+    }
+}
+
 BOOST_AUTO_TEST_CASE(OPM_XWEL) {
 }
@@ -0,0 +1,172 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define BOOST_TEST_MODULE ExecutorTests
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <opm/common/utility/Executor.hpp>
+
+using namespace Opm;
+
+
+BOOST_AUTO_TEST_CASE(ParallelFor) {
+    Executor executor;
+    executor.setConcurrency( 4 );
+    BOOST_CHECK_EQUAL( executor.concurrency(), 4U );
+
+    std::vector< int > count( 10007, 0 );
+    executor.parallelFor( 0, count.size(), [&count]( std::size_t index ) { count[index]++; }, 13 );
+    for (const auto& c : count)
+        BOOST_CHECK_EQUAL( c, 1 );
+
+    executor.parallelFor( 5, 5, []( std::size_t ) { throw std::logic_error("Empty range"); } );
+
+    executor.setConcurrency( 0 );
+    BOOST_CHECK( executor.concurrency() >= 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE(DeterministicReduce) {
+    std::vector< double > values( 100000 );
+    for (std::size_t i = 0; i < values.size(); i++)
+        values[i] = 1.0 / (i + 1);
+
+    const auto sum = [&values]( std::size_t concurrency ) {
+        Executor executor;
+        executor.setConcurrency( concurrency );
+        return executor.parallelReduce( 0, values.size(), 1000, 0.0,
+                                        [&values]( std::size_t first, std::size_t last ) {
+                                            double partial = 0;
+                                            for (auto i = first; i < last; i++)
+                                                partial += values[i];
+                                            return partial;
+                                        },
+                                        []( double a, double b ) { return a + b; } );
+    };
+
+    const double serial = sum( 1 );
+    BOOST_CHECK_EQUAL( serial, sum( 3 ) );
+    BOOST_CHECK_EQUAL( serial, sum( 8 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE(FirstExceptionRethrown) {
+    Executor executor;
+    executor.setConcurrency( 4 );
+
+    std::atomic< int > calls( 0 );
+    try {
+        executor.parallelFor( 0, 100, [&calls]( std::size_t index ) {
+            calls++;
+            if (index == 17 || index == 80)
+                throw std::invalid_argument( std::to_string( index ) );
+        });
+        BOOST_FAIL( "Expected exception" );
+    } catch (const std::invalid_argument& e) {
+        BOOST_CHECK_EQUAL( std::string( e.what() ), "17" );
+    }
+
+    BOOST_CHECK_EQUAL( calls.load(), 100 );
+}
+
+
+BOOST_AUTO_TEST_CASE(HostHook) {
+    Executor executor;
+    executor.setConcurrency( 3 );
+
+    std::size_t hook_workers = 0;
+    executor.setHostHook( [&hook_workers]( std::size_t num_workers, const Executor::Worker& worker ) {
+        hook_workers = num_workers;
+        std::vector< std::thread > threads;
+        for (std::size_t i = 1; i < num_workers; i++)
+            threads.emplace_back( worker, i );
+
+        worker( 0 );
+        for (auto& thread : threads)
+            thread.join();
+    });
+
+    std::vector< int > count( 100, 0 );
+    executor.parallelFor( 0, count.size(), [&count]( std::size_t index ) { count[index]++; } );
+    BOOST_CHECK_EQUAL( hook_workers, 3U );
+    for (const auto& c : count)
+        BOOST_CHECK_EQUAL( c, 1 );
+
+    // A hook which only runs one of the workers still completes all chunks.
+    executor.setHostHook( []( std::size_t, const Executor::Worker& worker ) { worker( 0 ); } );
+    executor.parallelFor( 0, count.size(), [&count]( std::size_t index ) { count[index]++; } );
+    for (const auto& c : count)
+        BOOST_CHECK_EQUAL( c, 2 );
+
+    executor.setHostHook( Executor::HostHook() );
+    executor.parallelFor( 0, count.size(), [&count]( std::size_t index ) { count[index]++; } );
+    for (const auto& c : count)
+        BOOST_CHECK_EQUAL( c, 3 );
+}
+
+
+BOOST_AUTO_TEST_CASE(NestedAndTaskGroup) {
+    Executor executor;
+    executor.setConcurrency( 4 );
+
+    std::vector< std::vector< int > > results( 8 );
+    TaskGroup group( executor );
+    for (std::size_t task = 0; task < results.size(); task++)
+        group.run( [&executor, &results, task]() {
+            results[task].resize( 100 );
+            executor.parallelFor( 0, 100, [&results, task]( std::size_t index ) {
+                results[task][index] = task * 100 + index;
+            });
+        });
+
+    BOOST_CHECK_EQUAL( group.size(), 8U );
+    group.wait();
+    BOOST_CHECK_EQUAL( group.size(), 0U );
+
+    for (std::size_t task = 0; task < results.size(); task++)
+        for (std::size_t index = 0; index < 100; index++)
+            BOOST_CHECK_EQUAL( results[task][index], int( task * 100 + index ) );
+
+    // Parallel calls from several external threads at the same time.
+    std::vector< std::thread > threads;
+    std::vector< long > sums( 4, 0 );
+    for (std::size_t t = 0; t < sums.size(); t++)
+        threads.emplace_back( [&executor, &sums, t]() {
+            sums[t] = executor.parallelReduce( 0, 1000, 10, 0L,
+                                               []( std::size_t first, std::size_t last ) {
+                                                   long s = 0;
+                                                   for (auto i = first; i < last; i++)
+                                                       s += i;
+                                                   return s;
+                                               },
+                                               []( long a, long b ) { return a + b; } );
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (const auto& sum : sums)
+        BOOST_CHECK_EQUAL( sum, 499500 );
+}
@@ -0,0 +1,76 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define BOOST_TEST_MODULE LargeArrayTests
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <numeric>
+
+#include <opm/common/utility/LargeArray.hpp>
+
+using namespace Opm;
+
+
+BOOST_AUTO_TEST_CASE(LargeVectorContent) {
+    LargeVector< double > small( 10, 1.5 );
+    BOOST_CHECK_EQUAL( std::accumulate( small.begin(), small.end(), 0.0 ), 15.0 );
+
+    const std::size_t size = 3 * largeArrayThreshold / sizeof( double ) + 7;
+    LargeVector< double > large( size, 2.0 );
+    BOOST_CHECK_EQUAL( reinterpret_cast< std::uintptr_t >( large.data() ) % (2 << 20), 0U );
+    BOOST_CHECK_EQUAL( large.front(), 2.0 );
+    BOOST_CHECK_EQUAL( large.back(), 2.0 );
+
+    large.resize( 2 * size, 3.0 );
+    BOOST_CHECK_EQUAL( large[size - 1], 2.0 );
+    BOOST_CHECK_EQUAL( large[size], 3.0 );
+
+    LargeVector< double > copy( large );
+    BOOST_CHECK( copy == large );
+}
+
+
+BOOST_AUTO_TEST_CASE(Hooks) {
+    std::size_t allocated = 0;
+    std::size_t released = 0;
+    setLargeArrayHooks( [&allocated]( std::size_t bytes ) {
+                            allocated += bytes;
+                            return ::operator new( bytes );
+                        },
+                        [&released]( void* ptr, std::size_t bytes ) {
+                            released += bytes;
+                            ::operator delete( ptr );
+                        } );
+
+    {
+        LargeVector< int > small( 100 );
+        BOOST_CHECK_EQUAL( allocated, 0U );
+
+        LargeVector< int > large( largeArrayThreshold );
+        BOOST_CHECK_EQUAL( allocated, largeArrayThreshold * sizeof( int ) );
+    }
+    BOOST_CHECK_EQUAL( released, allocated );
+
+    setLargeArrayHooks( LargeArrayAllocateHook(), LargeArrayDeallocateHook() );
+    LargeVector< int > large( largeArrayThreshold, 1 );
+    BOOST_CHECK_EQUAL( released, allocated );
+    BOOST_CHECK_EQUAL( large.back(), 1 );
+}
@@ -574,6 +574,94 @@ BOOST_AUTO_TEST_CASE(ExtraData_content) {
 }
 
 
+BOOST_AUTO_TEST_CASE(Tracer_content) {
+    Setup setup("FIRST_SIM_TRACER.DATA");
+    {
+        ERT::TestArea testArea("test_Restart");
+        auto num_cells = setup.grid.getNumActive( );
+        auto cells = mkSolution( num_cells );
+        auto wells = mkWells();
+        const auto& sea = setup.es.tracer()[ "SEA" ];
+        std::vector<double> concentration( num_cells );
+        for (size_t i = 0; i < concentration.size(); i++)
+            concentration[i] = 0.5 * i;
+
+        {
+            RestartValue restart_value(cells, wells);
+
+            restart_value.addTracer(sea, concentration);
+            BOOST_CHECK( restart_value.hasTracer(sea) );
+            RestartIO::save("FILE.UNRST", 1 ,
+                            100,
+                            restart_value,
+                            setup.es,
+                            setup.grid,
+                            setup.schedule);
+
+            {
+                ecl_file_type * f = ecl_file_open( "FILE.UNRST" , 0 );
+                BOOST_CHECK( ecl_file_has_kw( f , "SEAF"));
+                {
+                    ecl_kw_type * kw = ecl_file_iget_named_kw( f , "SEAF" , 0 );
+                    BOOST_CHECK_EQUAL( static_cast<size_t>( ecl_kw_get_size( kw )), num_cells );
+                }
+                ecl_file_close( f );
+            }
+
+            /* The tracer keys are loaded without being requested */
+            const auto rst_value = RestartIO::load( "FILE.UNRST" , 1 , { RestartKey("SWAT", UnitSystem::measure::identity)},
+                                                    setup.es, setup.grid , setup.schedule);
+
+            BOOST_CHECK( rst_value.hasTracer(sea) );
+            const auto& loaded = rst_value.getTracer(sea);
+            BOOST_CHECK_EQUAL( loaded.size(), concentration.size() );
+            for (size_t i = 0; i < concentration.size(); i++)
+                BOOST_CHECK_CLOSE( loaded[i], concentration[i], 1e-5 );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(UnifiedRestartFile_offsets) {
+    Setup setup("FIRST_SIM.DATA");
+    {
+        ERT::TestArea testArea("test_Restart");
+        auto num_cells = setup.grid.getNumActive( );
+        auto cells = mkSolution( num_cells );
+        auto wells = mkWells();
+        RestartIO::UnifiedRestartFile rst_file("FILE.UNRST");
+
+        BOOST_CHECK_THROW( RestartIO::UnifiedRestartFile("FILE.X0001"), std::invalid_argument );
+        for (int report_step = 1; report_step <= 3; report_step++)
+            RestartIO::save(rst_file, report_step, 100 * report_step, RestartValue(cells, wells), setup.es, setup.grid, setup.schedule);
+
+        BOOST_CHECK_EQUAL( rst_file.offset(1), 0U );
+        BOOST_CHECK( rst_file.offset(1) < rst_file.offset(2) );
+        BOOST_CHECK( rst_file.offset(2) < rst_file.offset(3) );
+        const auto offset2 = rst_file.offset(2);
+        const auto offset3 = rst_file.offset(3);
+
+        /* Rewriting report step 2 should remove report step 3. */
+        RestartIO::save(rst_file, 2, 200, RestartValue(cells, wells), setup.es, setup.grid, setup.schedule);
+        BOOST_CHECK_EQUAL( rst_file.offset(2), offset2 );
+        BOOST_CHECK( !rst_file.hasStep(3) );
+        BOOST_CHECK_THROW( rst_file.offset(3), std::invalid_argument );
+        {
+            ecl_file_type * f = ecl_file_open( "FILE.UNRST" , 0 );
+            BOOST_CHECK_EQUAL( 2, ecl_file_get_num_named_kw( f, "SEQNUM" ));
+            ecl_file_close( f );
+        }
+
+        RestartIO::save(rst_file, 3, 300, RestartValue(cells, wells), setup.es, setup.grid, setup.schedule);
+        BOOST_CHECK_EQUAL( rst_file.offset(3), offset3 );
+
+        const auto rst_value = RestartIO::load( "FILE.UNRST" , 3 , { RestartKey("SWAT", UnitSystem::measure::identity) },
+                                                setup.es, setup.grid , setup.schedule );
+        BOOST_CHECK( rst_value.solution.has("SWAT") );
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(STORE_THPRES) {
     Setup setup("FIRST_SIM_THPRES.DATA");
     {
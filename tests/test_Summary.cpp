@@ -1099,6 +1099,43 @@ BOOST_AUTO_TEST_CASE(EXTRA) {
     BOOST_CHECK(  ecl_sum_get_general_var( resp , 4 , "FOPR") > 0.0 );
 }
 
+BOOST_AUTO_TEST_CASE(REGISTERED_VALUES) {
+    setup cfg( "test_registered");
+
+    {
+        out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule , cfg.name );
+        const int tcpu = writer.register_value( "TCPU" );
+        const int fpr = writer.register_value( "FPR" );
+        const int bpr = writer.register_block_value( "BPR", 1 );
+        /* Not requested in the SUMMARY section - the value is ignored. */
+        const int bpr_missing = writer.register_block_value( "BPR", 2 );
+
+        BOOST_CHECK_THROW( writer.register_value( "FOPR" ), std::invalid_argument );
+        BOOST_CHECK_EQUAL( 4U, writer.num_registered_values() );
+        BOOST_CHECK_EQUAL( 3, bpr_missing );
+
+        std::vector< double > values( writer.num_registered_values() );
+        for (int step = 0; step < 3; step++) {
+            values[tcpu] = step;
+            values[fpr] = 10 * step;
+            values[bpr] = 100 * step;
+            values[bpr_missing] = -1;
+            writer.add_registered_timestep( step, step * day, cfg.es, cfg.schedule, cfg.wells , values );
+        }
+
+        BOOST_CHECK_THROW( writer.add_registered_timestep( 3, 3 * day, cfg.es, cfg.schedule, cfg.wells , { 1.0 } ), std::invalid_argument );
+        writer.write();
+    }
+
+    auto res = readsum( cfg.name );
+    const auto* resp = res.get();
+    UnitSystem units( UnitSystem::UnitType::UNIT_TYPE_METRIC );
+
+    BOOST_CHECK_CLOSE( 2 , ecl_sum_get_general_var( resp , 2 , "TCPU") , 0.001);
+    BOOST_CHECK_CLOSE( 20 , units.to_si( UnitSystem::measure::pressure , ecl_sum_get_general_var( resp, 2, "FPR")) , 1e-5);
+    BOOST_CHECK_CLOSE( 200 , units.to_si( UnitSystem::measure::pressure , ecl_sum_get_general_var( resp, 2, "BPR:1,1,1")) , 1e-5);
+}
+
 struct MessageBuffer
 {
   std::stringstream str_;
@@ -1151,6 +1188,24 @@ BOOST_AUTO_TEST_CASE(READ_WRITE_WELLDATA) {
 
 }
 
+BOOST_AUTO_TEST_CASE(READ_WRITE_TRACER_RATES) {
+            Opm::data::Wells wellRates = result_wells();
+            wellRates[ "W_1" ].tracer_rates = { 1.5, -2.5 };
+
+            MessageBuffer buffer;
+            wellRates.write(buffer);
+
+            Opm::data::Wells wellRatesCopy;
+            wellRatesCopy.read(buffer);
+
+            const auto& tracer_rates = wellRatesCopy.at( "W_1" ).tracer_rates;
+            BOOST_CHECK_EQUAL( tracer_rates.size(), 2U );
+            BOOST_CHECK_EQUAL( tracer_rates[ 0 ], 1.5 );
+            BOOST_CHECK_EQUAL( tracer_rates[ 1 ], -2.5 );
+            BOOST_CHECK( wellRatesCopy.at( "W_2" ).tracer_rates.empty() );
+            BOOST_CHECK_CLOSE( wellRatesCopy.get( "W_2" , rt::wat) , wellRates.get( "W_2" , rt::wat), 1e-16);
+}
+
 BOOST_AUTO_TEST_CASE(efficiency_factor) {
         setup cfg( "test_efficiency_factor", "SUMMARY_EFF_FAC.DATA" );
 
@@ -1218,3 +1273,65 @@ BOOST_AUTO_TEST_CASE(efficiency_factor) {
         BOOST_CHECK_CLOSE( 200.1, ecl_sum_get_well_completion_var( resp, 1, "W_2", "COPR", 2 ), 1e-5 );
         BOOST_CHECK_CLOSE( 200.1 * 0.2 * 0.01, ecl_sum_get_well_completion_var( resp, 1, "W_2", "COPT", 2 ), 1e-5 );
 }
+
+BOOST_AUTO_TEST_CASE(segment_keywords) {
+    setup cfg( "test_summary_segment", "summary_deck_msw.DATA" );
+    const auto& units = cfg.es.getUnits();
+
+    data::Wells wells;
+    auto& segments = wells[ "PROD" ].segments;
+    segments.resize( 6 );
+    segments.oil_rate[ 3 ]   = -units.to_si( UnitSystem::measure::liquid_surface_rate, 30.0 );
+    segments.water_rate[ 3 ] = -units.to_si( UnitSystem::measure::liquid_surface_rate, 10.0 );
+    segments.gas_rate[ 3 ]   = -units.to_si( UnitSystem::measure::gas_surface_rate, 2000.0 );
+    for( size_t i = 0; i < segments.size(); ++i )
+        segments.pressure[ i ] = units.to_si( UnitSystem::measure::pressure, 200.0 + 10 * i );
+
+    out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    writer.add_timestep( 0, 0 * day, cfg.es, cfg.schedule, wells, {} );
+    writer.add_timestep( 1, 1 * day, cfg.es, cfg.schedule, wells, {} );
+    writer.write();
+
+    auto res = readsum( cfg.name );
+    const auto* resp = res.get();
+
+    /* Segment rates are reported as positive production rates */
+    BOOST_CHECK_CLOSE( 30.0, ecl_sum_get_general_var( resp, 1, "SOFR:PROD:4" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 10.0, ecl_sum_get_general_var( resp, 1, "SWFR:PROD:4" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 2000.0, ecl_sum_get_general_var( resp, 1, "SGFR:PROD:4" ), 1e-5 );
+
+    /* A defaulted segment number in SPR selects every segment of the well */
+    BOOST_CHECK_CLOSE( 200.0, ecl_sum_get_general_var( resp, 1, "SPR:PROD:1" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 230.0, ecl_sum_get_general_var( resp, 1, "SPR:PROD:4" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 250.0, ecl_sum_get_general_var( resp, 1, "SPR:PROD:6" ), 1e-5 );
+    BOOST_CHECK( !ecl_sum_has_general_var( resp, "SPR:PROD:7" ) );
+    BOOST_CHECK( !ecl_sum_has_general_var( resp, "SOFR:PROD:5" ) );
+}
+
+BOOST_AUTO_TEST_CASE(tracer_keywords) {
+    setup cfg( "test_summary_tracer", "summary_deck_tracer.DATA" );
+    const auto& units = cfg.es.getUnits();
+
+    /* The SEA tracer is carried by the water phase, production rates are negative */
+    data::Wells wells;
+    wells[ "PROD" ].tracer_rates = { -units.to_si( UnitSystem::measure::liquid_surface_rate, 3.0 ) };
+    wells[ "INJ" ].tracer_rates  = {  units.to_si( UnitSystem::measure::liquid_surface_rate, 5.0 ) };
+
+    out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    writer.add_timestep( 0, 0 * day, cfg.es, cfg.schedule, wells, {} );
+    writer.add_timestep( 1, 1 * day, cfg.es, cfg.schedule, wells, {} );
+    writer.add_timestep( 2, 2 * day, cfg.es, cfg.schedule, wells, {} );
+    writer.write();
+
+    auto res = readsum( cfg.name );
+    const auto* resp = res.get();
+
+    BOOST_CHECK_CLOSE( 3.0, ecl_sum_get_well_var( resp, 1, "PROD", "WTPRSEA" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 5.0, ecl_sum_get_well_var( resp, 1, "INJ", "WTIRSEA" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 3.0, ecl_sum_get_field_var( resp, 1, "FTPRSEA" ), 1e-5 );
+
+    /* The totals accumulate over the time steps */
+    BOOST_CHECK_CLOSE( 3.0, ecl_sum_get_field_var( resp, 1, "FTPTSEA" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 2 * 3.0, ecl_sum_get_field_var( resp, 2, "FTPTSEA" ), 1e-5 );
+    BOOST_CHECK_CLOSE( 2 * 5.0, ecl_sum_get_field_var( resp, 2, "FTITSEA" ), 1e-5 );
+}
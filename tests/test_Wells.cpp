@@ -23,6 +23,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <stdexcept>
+#include <utility>
 
 #include <opm/output/data/Wells.hpp>
 
@@ -123,3 +124,71 @@ BOOST_AUTO_TEST_CASE(get_completions) {
     BOOST_CHECK_EQUAL( 0.0, wellRates.get("OP_2" , 10000 , data::Rates::opt::wat) );
     BOOST_CHECK_EQUAL( 26.41 , wellRates.get( "OP_2" , 188 , data::Rates::opt::wat));
 }
+
+
+BOOST_AUTO_TEST_CASE(completion_index) {
+    data::Rates rc;
+    data::Well w1, w2;
+
+    for( size_t i = 0; i < 100; ++i ) {
+        rc.set( data::Rates::opt::wat, 1000 - i );
+        w1.completions.push_back( { 1000 - i, rc, 0.0, 0.0 } );
+    }
+    w1.index_completions();
+
+    rc.set( data::Rates::opt::wat, 7.0 );
+    w2.completions.push_back( { 7, rc, 0.0, 0.0 } );
+
+    BOOST_CHECK( w1.completions_indexed() );
+    BOOST_CHECK( !w2.completions_indexed() );
+
+    /* The copies in the map have their own completion buffers. */
+    data::Wells wellRates;
+    wellRates["W1"] = w1;
+    wellRates["W2"] = w2;
+    BOOST_CHECK( !wellRates.at( "W1" ).completions_indexed() );
+    BOOST_CHECK_EQUAL( 950.0, wellRates.get( "W1", 950, data::Rates::opt::wat ) );
+
+    wellRates.index_completions();
+    BOOST_CHECK( wellRates.at( "W1" ).completions_indexed() );
+    BOOST_CHECK_EQUAL( 950.0, wellRates.get( "W1", 950, data::Rates::opt::wat ) );
+    BOOST_CHECK_EQUAL( 0.0, wellRates.get( "W1", 900, data::Rates::opt::wat ) );
+    BOOST_CHECK( !wellRates.at( "W1" ).find_completion( 1001 ) );
+
+    /* Adding completions makes the index stale, and the completions are searched. */
+    rc.set( data::Rates::opt::wat, 3.0 );
+    wellRates.at( "W2" ).completions.push_back( { 3, rc, 0.0, 0.0 } );
+    BOOST_CHECK( !wellRates.at( "W2" ).completions_indexed() );
+    BOOST_CHECK_EQUAL( 3.0, wellRates.get( "W2", 3, data::Rates::opt::wat ) );
+
+    /* A hit in an index made stale by in-place edits is not trusted. */
+    auto& w1_completions = wellRates.at( "W1" ).completions;
+    std::swap( w1_completions[ 50 ].index, w1_completions[ 51 ].index );
+    BOOST_CHECK( wellRates.at( "W1" ).completions_indexed() );
+    BOOST_CHECK_EQUAL( 949.0, wellRates.get( "W1", 950, data::Rates::opt::wat ) );
+    BOOST_CHECK_EQUAL( &w1_completions[ 51 ], wellRates.at( "W1" ).find_completion( 950 ) );
+    std::swap( w1_completions[ 50 ].index, w1_completions[ 51 ].index );
+
+    /* Changing a global index in place requires a new index. */
+    wellRates.at( "W1" ).completions[ 0 ].index = 5;
+    wellRates.index_completions();
+    BOOST_CHECK_EQUAL( 1000.0, wellRates.get( "W1", 5, data::Rates::opt::wat ) );
+    BOOST_CHECK_EQUAL( 0.0, wellRates.get( "W1", 1000, data::Rates::opt::wat ) );
+
+    const std::vector< data::CompletionRate > requests = {
+        { "W1", 999, data::Rates::opt::wat },
+        { "W1", 5, data::Rates::opt::wat },
+        { "W2", 7, data::Rates::opt::wat },
+        { "W2", 8, data::Rates::opt::wat },
+        { "NO_SUCH_WELL", 7, data::Rates::opt::wat },
+        { "W1", 901, data::Rates::opt::wat },
+        { "W1", 901, data::Rates::opt::oil },
+    };
+
+    std::vector< double > values;
+    wellRates.gather( requests, values );
+
+    const std::vector< double > expected = { 999.0, 1000.0, 7.0, 0.0, 0.0, 901.0, 0.0 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( values.begin(), values.end(),
+                                   expected.begin(), expected.end() );
+}
@@ -0,0 +1,185 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE serialize_ISEG_TEST
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/output/data/Wells.hpp>
+#include <opm/output/eclipse/WriteRestartHelpers.hpp>
+
+namespace {
+
+    const std::string input = R"(
+RUNSPEC
+DIMENS
+ 10 10 3 /
+OIL
+WATER
+GAS
+METRIC
+WELLDIMS
+ 2 10 2 2 /
+WSEGDIMS
+ 1 10 2 /
+GRID
+DX
+ 300*100 /
+DY
+ 300*100 /
+DZ
+ 300*10 /
+TOPS
+ 100*2000 /
+PORO
+ 300*0.3 /
+PERMX
+ 300*100 /
+PERMY
+ 300*100 /
+PERMZ
+ 300*10 /
+SCHEDULE
+WELSPECS
+ 'PROD' 'G' 1 1 2000 'OIL' /
+ 'INJ'  'G' 10 10 2000 'WATER' /
+/
+COMPDAT
+ 'PROD' 1 1 1 3 'OPEN' /
+ 'INJ' 10 10 1 3 'OPEN' /
+/
+WELSEGS
+ 'PROD' 2000 2000 1e-5 'ABS' 'HFA' 'HO' /
+ 2 4 1 1 2090 2030 0.1 1e-3 /
+ 5 6 2 3 2100 2040 0.2 1e-3 /
+/
+TSTEP
+ 10 /
+)";
+
+    const int NISEGZ = 22;  // normally obtained from InteHead
+    const int NRSEGZ = 140;
+    const int NILBRZ = 10;
+}
+
+BOOST_AUTO_TEST_CASE( serialize_segment_arrays )
+{
+    const Opm::Deck deck(Opm::Parser{}.parseString(input, Opm::ParseContext()));
+    const Opm::UnitSystem units(Opm::UnitSystem::UnitType::UNIT_TYPE_METRIC);
+    const Opm::EclipseState state(deck);
+    const Opm::Schedule schedule(deck, state);
+
+    const size_t tstep = 0;
+    const auto wells = schedule.getWells(tstep);
+    const auto& segments = schedule.getWell("PROD")->getSegmentSet(tstep);
+
+    BOOST_CHECK_EQUAL(1, Opm::RestartIO::Helpers::numSegmentedWells(tstep, wells));
+
+    const auto dims = Opm::RestartIO::Helpers::maxSegmentDimensions(tstep, wells);
+    const int nsegmx = dims.first;
+    const int nlbrmx = dims.second;
+    BOOST_CHECK_EQUAL(6, nsegmx);
+    BOOST_CHECK_EQUAL(2, nlbrmx);
+
+    {
+        const auto iseg = Opm::RestartIO::Helpers::serialize_ISEG(tstep, nsegmx, NISEGZ, wells);
+        BOOST_CHECK_EQUAL(iseg.size(), size_t(nsegmx * NISEGZ));
+
+        // segment number, order, outlet, inlet on branch, branch, number of inlets
+        const std::vector<std::array<int, 6>> expected = {{
+            {{ 1, 1, 0, 2, 1, 1 }},
+            {{ 2, 2, 1, 3, 1, 1 }},
+            {{ 3, 3, 2, 4, 1, 2 }},
+            {{ 4, 4, 3, 0, 1, 0 }},
+            {{ 5, 5, 3, 6, 2, 1 }},
+            {{ 6, 6, 5, 0, 2, 0 }},
+        }};
+
+        for (const auto& e : expected) {
+            const size_t offset = (e[0] - 1) * NISEGZ;
+            BOOST_CHECK_EQUAL(iseg[offset + 0], e[1]);
+            BOOST_CHECK_EQUAL(iseg[offset + 1], e[2]);
+            BOOST_CHECK_EQUAL(iseg[offset + 2], e[3]);
+            BOOST_CHECK_EQUAL(iseg[offset + 3], e[4]);
+            BOOST_CHECK_EQUAL(iseg[offset + 4], e[5]);
+        }
+    }
+
+    {
+        Opm::data::Wells well_data;
+        auto& segment_data = well_data["PROD"].segments;
+        segment_data.resize(6);
+        segment_data.oil_rate[3] = -units.to_si(Opm::UnitSystem::measure::liquid_surface_rate, 30.0);
+        segment_data.water_rate[3] = -units.to_si(Opm::UnitSystem::measure::liquid_surface_rate, 10.0);
+        segment_data.pressure[3] = units.to_si(Opm::UnitSystem::measure::pressure, 250.0);
+
+        const auto rseg = Opm::RestartIO::Helpers::serialize_RSEG(tstep, nsegmx, NRSEGZ, wells, well_data, units);
+        BOOST_CHECK_EQUAL(rseg.size(), size_t(nsegmx * NRSEGZ));
+
+        const size_t offset = 3 * NRSEGZ;
+        const auto& segment = segments.getFromSegmentNumber(4);
+        const auto& outlet = segments.getFromSegmentNumber(3);
+        BOOST_CHECK_CLOSE(rseg[offset + 0], segment.totalLength() - outlet.totalLength(), 1e-8);
+        BOOST_CHECK_CLOSE(rseg[offset + 1], segment.depth() - outlet.depth(), 1e-8);
+        BOOST_CHECK_CLOSE(rseg[offset + 2], 0.1, 1e-8);
+        BOOST_CHECK_CLOSE(rseg[offset + 4], M_PI * 0.1 * 0.1 / 4, 1e-8);
+        BOOST_CHECK_CLOSE(rseg[offset + 6], 2090.0, 1e-8);
+        BOOST_CHECK_CLOSE(rseg[offset + 7], 2030.0, 1e-8);
+        BOOST_CHECK_CLOSE(rseg[offset + 8], 40.0, 1e-8);
+        BOOST_CHECK_CLOSE(rseg[offset + 9], 0.25, 1e-8);
+        BOOST_CHECK_EQUAL(rseg[offset + 10], 0.0);
+        BOOST_CHECK_CLOSE(rseg[offset + 11], 250.0, 1e-8);
+
+        // The top segment has no outlet, and no results in the wells data.
+        BOOST_CHECK_EQUAL(rseg[0], 0.0);
+        BOOST_CHECK_CLOSE(rseg[6], 2000.0, 1e-8);
+        BOOST_CHECK_EQUAL(rseg[11], 0.0);
+    }
+
+    {
+        const auto ilbs = Opm::RestartIO::Helpers::serialize_ILBS(tstep, nlbrmx, wells);
+        BOOST_CHECK_EQUAL(ilbs.size(), size_t(nlbrmx));
+        BOOST_CHECK_EQUAL(ilbs[0], 5);
+        BOOST_CHECK_EQUAL(ilbs[1], 0);
+    }
+
+    {
+        const auto ilbr = Opm::RestartIO::Helpers::serialize_ILBR(tstep, nlbrmx, NILBRZ, wells);
+        BOOST_CHECK_EQUAL(ilbr.size(), size_t(nlbrmx * NILBRZ));
+
+        // outlet, number of segments, first, last, position of first
+        const std::vector<int> main_stem = { 0, 4, 1, 4, 0 };
+        const std::vector<int> lateral = { 3, 2, 5, 6, 4 };
+        BOOST_CHECK_EQUAL_COLLECTIONS(ilbr.begin(), ilbr.begin() + 5,
+                                      main_stem.begin(), main_stem.end());
+        BOOST_CHECK_EQUAL_COLLECTIONS(ilbr.begin() + NILBRZ, ilbr.begin() + NILBRZ + 5,
+                                      lateral.begin(), lateral.end());
+    }
+}
@@ -53,13 +53,15 @@ BOOST_AUTO_TEST_CASE( serialize_scon_test )
         for (const auto w : wells) {
 
             size_t c_offset = 0;
+            size_t c_index = 0;
+            const auto multipliers = w->getConnectionMultipliers(tstep);
             for (const auto c : w->getCompletions(tstep)) {
 
                 const size_t offset = w_offset + c_offset;
                 const auto ctf = c.getConnectionTransmissibilityFactorAsValueObject();
                 const double expected =
                     ctf.hasValue()
-                    ? units.from_si(Opm::UnitSystem::measure::transmissibility, ctf.getValue())
+                    ? units.from_si(Opm::UnitSystem::measure::transmissibility, ctf.getValue() * multipliers[c_index])
                     : Opm::RestartIO::Helpers::UNIMPLEMENTED_VALUE;
                 BOOST_CHECK_EQUAL(scondata[offset + SCON_CF_INDEX],
                                   expected);
@@ -67,9 +69,69 @@ BOOST_AUTO_TEST_CASE( serialize_scon_test )
                                   Opm::RestartIO::Helpers::UNIMPLEMENTED_VALUE);
 
                 c_offset += SCONZ;
+                c_index++;
             }
             w_offset += (SCONZ * ncwmax);
         }
     }
 };
   
+
+BOOST_AUTO_TEST_CASE( serialize_scon_multipliers )
+{
+    const std::string input = R"(
+START
+ 1 JAN 2018 /
+RUNSPEC
+DIMENS
+ 10 10 3 /
+OIL
+WATER
+METRIC
+GRID
+DX
+ 300*100 /
+DY
+ 300*100 /
+DZ
+ 300*10 /
+TOPS
+ 100*2000 /
+PORO
+ 300*0.3 /
+SCHEDULE
+WELSPECS
+ 'PROD' 'G' 1 1 2000 'OIL' /
+/
+COMPDAT
+ 'PROD' 1 1 1 1 'OPEN' 1* 10.0 /
+ 'PROD' 1 1 2 2 'OPEN' 1* 20.0 /
+/
+DATES
+ 1 FEB 2018 /
+/
+WPIMULT
+ 'PROD' 2.0 1 1 2 /
+/
+TSTEP
+ 10 /
+)";
+
+    const Opm::Deck deck(Opm::Parser{}.parseString(input, Opm::ParseContext()));
+    const Opm::UnitSystem units(Opm::UnitSystem::UnitType::UNIT_TYPE_METRIC);
+    const Opm::EclipseState state(deck);
+    const Opm::Schedule schedule(deck, state);
+
+    const int SCONZ = 40; // normally obtained from InteHead
+
+    for (size_t tstep = 0; tstep < 2; ++tstep) {
+        const auto wells = schedule.getWells(tstep);
+        const auto scondata =
+            Opm::RestartIO::Helpers::serialize_SCON(tstep, 2, SCONZ, wells, units);
+
+        // WPIMULT applies to the second connection from report step 1.
+        const double multiplier = (tstep == 0) ? 1.0 : 2.0;
+        BOOST_CHECK_CLOSE(scondata[SCON_CF_INDEX], 10.0, 1e-8);
+        BOOST_CHECK_CLOSE(scondata[SCONZ + SCON_CF_INDEX], 20.0 * multiplier, 1e-8);
+    }
+}